@@ -20,6 +20,7 @@
 #include <thread>
 
 #include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
 
 auto setup_assoc_args(argparse::ArgumentParser& cmd) -> void
 {
@@ -39,7 +40,7 @@ auto setup_assoc_args(argparse::ArgumentParser& cmd) -> void
         .default_value(2)
         .scan<'i', int>();
     cmd.add_argument("-b", "--bfile")
-        .help("PLINK binary file prefix (.bed/.bim/.fam)")
+        .help("PLINK binary file prefix (.bed/.bim/.fam or .pgen/.pvar/.psam)")
         .metavar("<BFILE>")
         .required();
     cmd.add_argument("--grm")
@@ -109,6 +110,8 @@ auto setup_assoc_args(argparse::ArgumentParser& cmd) -> void
         .help("INT offset parameter k (default: 3/8 Blom offset)")
         .default_value(3.0 / 8.0)
         .scan<'g', double>();
+    gelex::cli::add_variant_filter_args(cmd);
+
     // ================================================================
     // Performance
     // ================================================================
@@ -119,6 +122,8 @@ auto setup_assoc_args(argparse::ArgumentParser& cmd) -> void
             std::max(
                 1, static_cast<int>(std::thread::hardware_concurrency() / 2)))
         .scan<'i', int>();
+    gelex::cli::add_numa_arg(cmd);
+    gelex::cli::add_memory_args(cmd);
 
     cmd.add_epilog(
         gelex::cli::format_epilog(
@@ -23,6 +23,7 @@
 #include "cli/cli_helper.h"
 #include "cli/data_pipe_config.h"
 #include "cli/data_pipe_reporter.h"
+#include "cli/memory_plan.h"
 #include "cli/reml_reporter.h"
 #include "gelex/infra/logging/assoc_event.h"
 #include "gelex/pipeline/assoc_loco_engine.h"
@@ -36,6 +37,7 @@ auto assoc_execute(argparse::ArgumentParser& cmd) -> int
     bool loco = cmd.get<bool>("--loco");
     int threads = cmd.get<int>("--threads");
     gelex::cli::setup_parallelization(threads);
+    gelex::cli::setup_numa(cmd);
 
     auto pheno_config = gelex::cli::make_pheno_config(cmd);
     pheno_config.transform_type
@@ -67,9 +69,30 @@ auto assoc_execute(argparse::ArgumentParser& cmd) -> int
     gelex::PhenoPipe pheno(pheno_config, data_reporter.as_observer());
     gelex::GrmPipe grm(grm_paths, data_reporter.as_observer());
     pheno.load(grm.sample_id_sets());
-    grm.load(pheno.sample_manager());
 
     auto config = gelex::cli::make_assoc_config(cmd);
+    const auto [num_samples, num_snps] = gelex::cli::genotype_dimensions(
+        config.bed_path, pheno.sample_manager());
+    const auto plan = gelex::plan_memory(
+        gelex::MemoryRequest{
+            .workload = gelex::MemoryWorkload::Assoc,
+            .num_samples = num_samples,
+            .num_snps = num_snps,
+            .chunk_size = config.chunk_size,
+            .auto_chunk_size = !cmd.is_used("--chunk-size"),
+            .dominance = config.model_type == gelex::ModelType::D,
+            // LOCO GRMs are assembled in place from the mapped files
+            .num_grms = static_cast<int>(grm_paths.size()),
+            .sparse_grm_entries = grm.num_sparse_entries(),
+            .limit_bytes = gelex::cli::memory_limit(cmd),
+        });
+    if (!gelex::cli::commit_memory_plan(cmd, plan))
+    {
+        return 0;
+    }
+    config.chunk_size = static_cast<int>(plan.chunk_size);
+
+    grm.load(pheno.sample_manager());
 
     if (loco)
     {
@@ -19,6 +19,8 @@
 #include <argparse.h>
 
 #include "cli/cli_helper.h"
+#include "cli/data_pipe_config.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/types/genetic_effect_type.h"
 
 namespace gelex::cli
@@ -56,8 +58,9 @@ auto make_assoc_config(argparse::ArgumentParser& cmd)
         .chunk_size = cmd.get<int>("--chunk-size"),
         .max_iter = cmd.get<int>("--max-iter"),
         .tol = cmd.get<double>("--tol"),
-        .bed_path = cmd.get("--bfile"),
-        .out_prefix = cmd.get("--out")};
+        .bed_path = format_bed_path(cmd.get("--bfile")),
+        .out_prefix = cmd.get("--out"),
+        .variant_filter = make_variant_filter(cmd)};
 }
 
 }  // namespace gelex::cli
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "gelex/infra/logger.h"
 #include "gelex/infra/utils/formatter.h"
+#include "gelex/infra/utils/numa.h"
 
 namespace gelex::cli
 {
@@ -43,6 +44,22 @@ auto setup_parallelization(int num_threads) -> void
     }
 }
 
+auto add_numa_arg(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_argument("--numa")
+        .help(
+            "Page placement of large buffers on multi-socket machines: "
+            "none, interleave or partition")
+        .metavar("<POLICY>")
+        .default_value(std::string("none"))
+        .choices("none", "interleave", "partition");
+}
+
+auto setup_numa(const argparse::ArgumentParser& cmd) -> void
+{
+    set_numa_policy(parse_numa_policy(cmd.get<std::string>("--numa")));
+}
+
 auto print_gelex_banner_message(std::string_view version) -> void
 {
     std::cout << "Gelex [version " << version
@@ -67,6 +84,41 @@ For more information, see the documentation at: https://github.com/r1cheu/gelex
 )";
 }
 
+auto add_variant_filter_args(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_group("Variant Filters");
+    cmd.add_argument("--extract")
+        .help("Keep only the SNP IDs listed in this file (one per line)")
+        .metavar("<FILE>");
+    cmd.add_argument("--exclude")
+        .help("Drop the SNP IDs listed in this file (one per line)")
+        .metavar("<FILE>");
+    cmd.add_argument("--chr")
+        .help("Keep only these chromosomes")
+        .metavar("<CHR>")
+        .nargs(argparse::nargs_pattern::at_least_one);
+    cmd.add_argument("--from-bp")
+        .help("Keep SNPs at or after this position (requires one --chr)")
+        .metavar("<BP>")
+        .scan<'i', int>();
+    cmd.add_argument("--to-bp")
+        .help("Keep SNPs at or before this position (requires one --chr)")
+        .metavar("<BP>")
+        .scan<'i', int>();
+    cmd.add_argument("--maf")
+        .help("Drop SNPs with minor allele frequency below this threshold")
+        .metavar("<MAF>")
+        .scan<'g', double>();
+    cmd.add_argument("--geno")
+        .help("Drop SNPs with a missing call rate above this threshold")
+        .metavar("<RATE>")
+        .scan<'g', double>();
+    cmd.add_argument("--hwe")
+        .help("Drop SNPs with an exact HWE p-value below this threshold")
+        .metavar("<P>")
+        .scan<'g', double>();
+}
+
 auto format_epilog(std::string_view text) -> std::string
 {
     namespace c = argparse::colors;
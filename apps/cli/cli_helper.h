@@ -85,6 +85,12 @@ auto is_tty() -> bool;
 
 auto setup_parallelization(int num_threads) -> void;
 
+// Adds --numa <POLICY>: none, interleave or partition.
+auto add_numa_arg(argparse::ArgumentParser& cmd) -> void;
+
+// Applies --numa process-wide; placement is a no-op on a single node.
+auto setup_numa(const argparse::ArgumentParser& cmd) -> void;
+
 inline auto create_progress_bar(
     size_t& counter,
     size_t total,
@@ -97,6 +103,10 @@ auto print_gelex_banner_message(std::string_view version) -> void;
 
 auto format_epilog(std::string_view text) -> std::string;
 
+// Adds the "Variant Filters" group: --extract, --exclude, --chr,
+// --from-bp/--to-bp, --maf, --geno and --hwe.
+auto add_variant_filter_args(argparse::ArgumentParser& cmd) -> void;
+
 }  // namespace gelex::cli
 
 #endif  // GELEX_CLI_CLI_HELPER_H_
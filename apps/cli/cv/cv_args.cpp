@@ -0,0 +1,49 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cv_args.h"
+
+#include <argparse.h>
+
+#include "cli/cli_helper.h"
+#include "cli/fit/fit_args.h"
+
+auto setup_cv_args(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_description(
+        "K-fold cross-validation of Bayesian genomic prediction models");
+
+    add_fit_model_args(cmd);
+
+    cmd.add_group("Cross-Validation");
+    cmd.add_argument("-k", "--folds")
+        .help("Number of folds")
+        .default_value(5)
+        .scan<'i', int>();
+    cmd.add_argument("--jobs")
+        .help(
+            "Folds run concurrently (default: min(folds, threads)); each "
+            "fold uses one thread")
+        .scan<'i', int>();
+
+    cmd.add_epilog(
+        gelex::cli::format_epilog(
+            "{bg}Example:{rs}\n"
+            "  {bc}gelex cv{rs} {cy}-p{rs} pheno.tsv {cy}-b{rs} geno "
+            "{cy}-m{rs} RR {cy}-k{rs} 5\n\n"
+            "{bg}Docs:{rs}\n"
+            "  https://gelex.readthedocs.io/en/latest/cli/cv.html"));
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cv_command.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <argparse.h>
+
+#include "cli/cli_helper.h"
+#include "cli/data_pipe_config.h"
+#include "cli/data_pipe_reporter.h"
+#include "cli/memory_plan.h"
+#include "cli/fit/fit_config.h"
+#include "cv_config.h"
+#include "cv_reporter.h"
+#include "gelex/infra/logging/cv_event.h"
+#include "gelex/pipeline/cv_engine.h"
+#include "gelex/pipeline/geno_pipe.h"
+#include "gelex/pipeline/pheno_pipe.h"
+
+auto cv_execute(argparse::ArgumentParser& cv) -> int
+{
+    auto cv_config = gelex::cli::make_cv_config(cv);
+    auto [pheno_config, geno_config]
+        = gelex::cli::make_fit_data_configs(cv, cv.get<bool>("--mmap"));
+
+    geno_config.model_type = gelex::cli::has_dominance(cv_config.fit.method)
+                                 ? gelex::ModelType::AD
+                                 : gelex::ModelType::A;
+
+    gelex::cli::CvReporter reporter;
+    gelex::cli::DataPipeReporter data_reporter;
+    gelex::cli::setup_parallelization(cv.get<int>("--threads"));
+    gelex::cli::setup_numa(cv);
+
+    reporter.on_event(
+        gelex::CvConfigLoadedEvent{
+            .method = fmt::format("{}", cv_config.fit.method),
+            .n_folds = cv_config.n_folds,
+            .n_jobs = cv_config.n_jobs,
+            .n_iters = static_cast<int>(cv_config.fit.mcmc_params.n_iters),
+            .n_burnin = static_cast<int>(cv_config.fit.mcmc_params.n_burnin),
+            .seed = cv_config.fit.seed,
+        });
+
+    gelex::PhenoPipe pheno(pheno_config, data_reporter.as_observer());
+    pheno.load();
+
+    auto request = gelex::cli::make_fit_memory_request(
+        cv, cv_config.fit, geno_config, pheno.sample_manager());
+    request.num_chains = std::min(cv_config.n_jobs, cv_config.n_folds);
+    const auto plan = gelex::plan_memory(request);
+    if (!gelex::cli::commit_memory_plan(cv, plan))
+    {
+        return 0;
+    }
+    geno_config.use_mmap = plan.use_mmap;
+    geno_config.chunk_size = static_cast<int>(plan.chunk_size);
+    cv_config.fit.mcmc_params.sample_storage = plan.sample_storage;
+
+    gelex::GenoPipe geno(geno_config, data_reporter.as_observer());
+    geno.load(pheno.sample_manager());
+
+    gelex::CvEngine engine(std::move(cv_config));
+    engine.run(std::move(pheno), std::move(geno), reporter.as_observer());
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cv_config.h"
+
+#include <algorithm>
+
+#include <argparse.h>
+
+#include "cli/fit/fit_config.h"
+
+namespace gelex::cli
+{
+
+auto make_cv_config(argparse::ArgumentParser& cmd) -> CvEngine::Config
+{
+    CvEngine::Config config{
+        .fit = make_fit_model_config(cmd),
+        .n_folds = cmd.get<int>("--folds"),
+    };
+    config.n_jobs = cmd.is_used("--jobs")
+                        ? cmd.get<int>("--jobs")
+                        : std::min(config.n_folds, cmd.get<int>("--threads"));
+    return config;
+}
+
+}  // namespace gelex::cli
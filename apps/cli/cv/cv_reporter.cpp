@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cv_reporter.h"
+
+#include "config.h"
+#include "gelex/infra/logger.h"
+#include "gelex/infra/logging/cv_event.h"
+#include "gelex/infra/utils/formatter.h"
+
+namespace gelex::cli
+{
+
+CvReporter::CvReporter() : logger_(gelex::logging::get()) {}
+
+auto CvReporter::on_event(const CvConfigLoadedEvent& event) const -> void
+{
+    logger_->info(gelex::command_banner(PROJECT_VERSION, "Cross-Validation"));
+    logger_->info("");
+    logger_->info(gelex::section("[Config]"));
+    logger_->info("  {:<12}: {}", "Method", event.method);
+    logger_->info(
+        "  {:<12}: {} folds ({} concurrent)",
+        "Folds",
+        event.n_folds,
+        event.n_jobs);
+    logger_->info(
+        "  {:<12}: {} iters ({} burn-in, {} sampling)",
+        "Chain",
+        event.n_iters,
+        event.n_burnin,
+        event.n_iters - event.n_burnin);
+    logger_->info("  {:<12}: {}", "Seed", event.seed);
+    logger_->info("");
+}
+
+auto CvReporter::on_event(const CvFoldCompleteEvent& event) -> void
+{
+    if (!header_printed_)
+    {
+        header_printed_ = true;
+        logger_->info(gelex::section("[Folds]"));
+        logger_->info(
+            "  {:>4}  {:>8}  {:>8}  {:>9}  {:>7}",
+            "Fold",
+            "Train",
+            "Test",
+            "Accuracy",
+            "Bias");
+    }
+    logger_->info(
+        "  {:>4}  {:>8}  {:>8}  {:>9.4f}  {:>7.4f}",
+        event.fold,
+        event.n_train,
+        event.n_test,
+        event.accuracy,
+        event.bias);
+}
+
+auto CvReporter::on_event(const CvCompleteEvent& event) const -> void
+{
+    logger_->info("");
+    logger_->info(gelex::section("[Summary]"));
+    logger_->info(
+        gelex::success(
+            "Mean accuracy: {:.4f} | mean bias: {:.4f} | pooled accuracy: "
+            "{:.4f}",
+            event.mean_accuracy,
+            event.mean_bias,
+            event.pooled_accuracy));
+    logger_->info(
+        gelex::success(
+            "Out-of-fold GEBVs saved to '{}.cv'", event.out_prefix));
+}
+
+}  // namespace gelex::cli
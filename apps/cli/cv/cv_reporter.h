@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_CLI_CV_REPORTER_H_
+#define GELEX_CLI_CV_REPORTER_H_
+
+#include <memory>
+
+#include "gelex/infra/logging/cv_event.h"
+
+namespace spdlog
+{
+class logger;
+}
+
+namespace gelex::cli
+{
+
+class CvReporter
+{
+   public:
+    CvReporter();
+
+    auto on_event(const CvConfigLoadedEvent& event) const -> void;
+    auto on_event(const CvFoldCompleteEvent& event) -> void;
+    auto on_event(const CvCompleteEvent& event) const -> void;
+
+    auto as_observer() -> CvObserver
+    {
+        return [this](const CvEvent& e)
+        { std::visit([this](const auto& ev) { this->on_event(ev); }, e); };
+    }
+
+   private:
+    std::shared_ptr<spdlog::logger> logger_;
+    bool header_printed_ = false;
+};
+
+}  // namespace gelex::cli
+
+#endif  // GELEX_CLI_CV_REPORTER_H_
@@ -18,10 +18,13 @@
 
 #include <argparse.h>
 #include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "cli/cli_helper.h"
 #include "gelex/data/genotype/bed_path.h"
+#include "gelex/exception.h"
 
 namespace gelex::cli
 {
@@ -43,6 +46,47 @@ auto make_pheno_config(argparse::ArgumentParser& cmd) -> PhenoPipe::Config
     };
 }
 
+auto make_variant_filter(argparse::ArgumentParser& cmd) -> VariantFilter
+{
+    VariantFilter filter;
+    if (cmd.is_used("--extract"))
+    {
+        filter.extract_path = cmd.get("--extract");
+    }
+    if (cmd.is_used("--exclude"))
+    {
+        filter.exclude_path = cmd.get("--exclude");
+    }
+    if (cmd.is_used("--chr"))
+    {
+        filter.chromosomes = cmd.get<std::vector<std::string>>("--chr");
+    }
+    filter.from_bp = cmd.present<int>("--from-bp");
+    filter.to_bp = cmd.present<int>("--to-bp");
+    if ((filter.from_bp || filter.to_bp) && filter.chromosomes.size() != 1)
+    {
+        throw ArgumentValidationException(
+            "--from-bp/--to-bp require exactly one --chr");
+    }
+
+    filter.min_maf = cmd.present<double>("--maf").value_or(0.0);
+    filter.max_missing_rate = cmd.present<double>("--geno").value_or(1.0);
+    filter.min_hwe_pvalue = cmd.present<double>("--hwe").value_or(0.0);
+    if (filter.min_maf < 0.0 || filter.min_maf > 0.5)
+    {
+        throw ArgumentValidationException("--maf must be within [0, 0.5]");
+    }
+    if (filter.max_missing_rate < 0.0 || filter.max_missing_rate > 1.0)
+    {
+        throw ArgumentValidationException("--geno must be within [0, 1]");
+    }
+    if (filter.min_hwe_pvalue < 0.0 || filter.min_hwe_pvalue > 1.0)
+    {
+        throw ArgumentValidationException("--hwe must be within [0, 1]");
+    }
+    return filter;
+}
+
 auto make_fit_data_configs(argparse::ArgumentParser& cmd, bool use_mmap)
     -> std::pair<PhenoPipe::Config, GenoPipe::Config>
 {
@@ -69,6 +113,7 @@ auto make_fit_data_configs(argparse::ArgumentParser& cmd, bool use_mmap)
         .use_mmap = use_mmap,
         .chunk_size = cmd.get<int>("--chunk-size"),
         .output_prefix = cmd.get("--out"),
+        .variant_filter = make_variant_filter(cmd),
     };
 
     return {std::move(pheno_config), std::move(geno_config)};
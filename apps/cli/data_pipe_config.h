@@ -19,6 +19,7 @@
 
 #include <utility>
 
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/pipeline/geno_pipe.h"
 #include "gelex/pipeline/pheno_pipe.h"
 
@@ -32,6 +33,9 @@ namespace gelex::cli
 
 auto make_pheno_config(argparse::ArgumentParser& cmd) -> PhenoPipe::Config;
 
+// Reads the options added by add_variant_filter_args.
+auto make_variant_filter(argparse::ArgumentParser& cmd) -> VariantFilter;
+
 auto make_fit_data_configs(argparse::ArgumentParser& cmd, bool use_mmap)
     -> std::pair<PhenoPipe::Config, GenoPipe::Config>;
 
@@ -85,12 +85,14 @@ auto DataPipeReporter::on_event(const GenotypeLoadedEvent& event) const -> void
     const auto effective_snps = event.num_snps - event.monomorphic_snps;
     const std::string label = event.is_dominance ? "Dominance" : "Additive";
     const std::string msg = gelex::success(
-        "{:<13}: {} SNPs ({} monomorphic excluded)",
+        "{:<13}: {} SNPs ({} monomorphic excluded){}",
         label,
         gelex::AbbrNumber(effective_snps),
-        gelex::AbbrNumber(event.monomorphic_snps));
+        gelex::AbbrNumber(event.monomorphic_snps),
+        event.from_cache ? ", cached" : "");
 
-    if (isatty(fileno(stdout)) != 0)
+    // a cache hit shows no progress line to overwrite
+    if (!event.from_cache && isatty(fileno(stdout)) != 0)
     {
         logger_->info("{}", "\033[A\r" + msg + "\033[K");
     }
@@ -20,18 +20,17 @@
 #include <thread>
 
 #include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
 
-auto setup_fit_args(argparse::ArgumentParser& cmd) -> void
+auto add_fit_model_args(argparse::ArgumentParser& cmd) -> void
 {
-    cmd.add_description("Fit genomic prediction models using Bayesian methods");
-
     cmd.add_group("Data Files");
     cmd.add_argument("-p", "--pheno")
         .help("Phenotype file (TSV format: FID, IID, trait1, ...)")
         .metavar("<PHENOTYPE>")
         .required();
     cmd.add_argument("-b", "--bfile")
-        .help("PLINK binary file prefix (.bed/.bim/.fam)")
+        .help("PLINK binary file prefix (.bed/.bim/.fam or .pgen/.pvar/.psam)")
         .metavar("<BFILE>")
         .required();
     cmd.add_argument("--qcovar")
@@ -60,6 +59,8 @@ auto setup_fit_args(argparse::ArgumentParser& cmd) -> void
         .default_value(std::string("OSH"))
         .metavar("<STR>");
 
+    gelex::cli::add_variant_filter_args(cmd);
+
     cmd.add_group("Model Configuration");
     cmd.add_argument("-m", "--method")
         .help(
@@ -130,6 +131,22 @@ auto setup_fit_args(argparse::ArgumentParser& cmd) -> void
             "Use memory-mapped I/O for genotype matrix(much lower RAM, may be "
             "slower)")
         .flag();
+    gelex::cli::add_numa_arg(cmd);
+    gelex::cli::add_memory_args(cmd);
+}
+
+auto setup_fit_args(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_description("Fit genomic prediction models using Bayesian methods");
+
+    add_fit_model_args(cmd);
+
+    cmd.add_group("Prediction");
+    cmd.add_argument("--predict-bfile")
+        .help(
+            "PLINK binary prefix of target individuals; GEBVs are "
+            "accumulated during MCMC and written to <OUT>.gebv")
+        .metavar("<BFILE>");
 
     cmd.add_epilog(
         gelex::cli::format_epilog(
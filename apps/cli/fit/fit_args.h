@@ -22,6 +22,8 @@ namespace argparse
 class ArgumentParser;
 }
 
+// Data, model, MCMC and performance options shared by `fit` and `cv`.
+auto add_fit_model_args(argparse::ArgumentParser& cmd) -> void;
 auto setup_fit_args(argparse::ArgumentParser& cmd) -> void;
 
 #endif  // GELEX_CLI_FIT_ARGS_H_
@@ -21,6 +21,7 @@
 #include "cli/cli_helper.h"
 #include "cli/data_pipe_config.h"
 #include "cli/data_pipe_reporter.h"
+#include "cli/memory_plan.h"
 #include "fit_config.h"
 #include "fit_reporter.h"
 #include "gelex/infra/logging/data_pipe_event.h"
@@ -45,6 +46,7 @@ auto fit_execute(argparse::ArgumentParser& fit) -> int
     gelex::cli::FitReporter reporter;
     gelex::cli::DataPipeReporter data_reporter;
     gelex::cli::setup_parallelization(threads);
+    gelex::cli::setup_numa(fit);
 
     reporter.on_event(
         gelex::FitConfigLoadedEvent{
@@ -58,6 +60,17 @@ auto fit_execute(argparse::ArgumentParser& fit) -> int
     gelex::PhenoPipe pheno(pheno_config, data_reporter.as_observer());
     pheno.load();
 
+    const auto plan = gelex::plan_memory(
+        gelex::cli::make_fit_memory_request(
+            fit, fit_config, geno_config, pheno.sample_manager()));
+    if (!gelex::cli::commit_memory_plan(fit, plan))
+    {
+        return 0;
+    }
+    geno_config.use_mmap = plan.use_mmap;
+    geno_config.chunk_size = static_cast<int>(plan.chunk_size);
+    fit_config.mcmc_params.sample_storage = plan.sample_storage;
+
     gelex::GenoPipe geno(geno_config, data_reporter.as_observer());
     geno.load(pheno.sample_manager());
 
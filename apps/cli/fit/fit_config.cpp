@@ -18,6 +18,9 @@
 
 #include <argparse.h>
 
+#include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/exception.h"
 #include "gelex/pipeline/fit_engine.h"
 
@@ -41,7 +44,36 @@ auto has_dominance(BayesAlphabet type) -> bool
     }
 }
 
-auto make_fit_config(argparse::ArgumentParser& cmd) -> FitEngine::Config
+namespace
+{
+
+// Marker-wise components tracked by the mixture priors; 0 for the others.
+auto mixture_components(const FitEngine::Config& config) -> Eigen::Index
+{
+    switch (config.method)
+    {
+        case BayesAlphabet::B:
+        case BayesAlphabet::Bpi:
+        case BayesAlphabet::Bd:
+        case BayesAlphabet::Bdpi:
+        case BayesAlphabet::C:
+        case BayesAlphabet::Cpi:
+        case BayesAlphabet::Cd:
+        case BayesAlphabet::Cdpi:
+            return config.pi ? static_cast<Eigen::Index>(config.pi->size())
+                             : 2;
+        case BayesAlphabet::R:
+        case BayesAlphabet::Rd:
+            return config.pi ? static_cast<Eigen::Index>(config.pi->size())
+                             : 5;
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+auto make_fit_model_config(argparse::ArgumentParser& cmd) -> FitEngine::Config
 {
     auto method = gelex::get_bayesalphabet(cmd.get("-m"))
                       .value_or(gelex::BayesAlphabet::RR);
@@ -56,7 +88,10 @@ auto make_fit_config(argparse::ArgumentParser& cmd) -> FitEngine::Config
             cmd.get<int>("--iters"),
             cmd.get<int>("--burn-in"),
             cmd.get<int>("--thin")),
-        .out_prefix = cmd.get("--out")};
+        .out_prefix = cmd.get("--out"),
+        .genotype_method
+        = parse_genotype_process_method(cmd.get<std::string>("--geno-method")),
+    };
 
     auto extract_opt_vec
         = [&](std::string_view arg) -> std::optional<std::vector<double>>
@@ -81,4 +116,37 @@ auto make_fit_config(argparse::ArgumentParser& cmd) -> FitEngine::Config
     return config;
 }
 
+auto make_fit_memory_request(
+    argparse::ArgumentParser& cmd,
+    const FitEngine::Config& config,
+    const GenoPipe::Config& geno_config,
+    std::shared_ptr<SampleManager> samples) -> MemoryRequest
+{
+    const auto [num_samples, num_snps]
+        = genotype_dimensions(geno_config.bed_path, std::move(samples));
+    return MemoryRequest{
+        .workload = MemoryWorkload::Fit,
+        .num_samples = num_samples,
+        .num_snps = num_snps,
+        .chunk_size = geno_config.chunk_size,
+        .auto_chunk_size = !cmd.is_used("--chunk-size"),
+        .dominance = has_dominance(config.method),
+        .use_mmap = geno_config.use_mmap,
+        .num_records = config.mcmc_params.n_records,
+        .num_components = mixture_components(config),
+        .limit_bytes = memory_limit(cmd),
+    };
+}
+
+auto make_fit_config(argparse::ArgumentParser& cmd) -> FitEngine::Config
+{
+    auto config = make_fit_model_config(cmd);
+    if (cmd.is_used("--predict-bfile"))
+    {
+        config.predict_bed_path
+            = format_bed_path(cmd.get<std::string>("--predict-bfile"));
+    }
+    return config;
+}
+
 }  // namespace gelex::cli
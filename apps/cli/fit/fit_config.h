@@ -17,7 +17,12 @@
 #ifndef GELEX_CLI_FIT_CONFIG_H_
 #define GELEX_CLI_FIT_CONFIG_H_
 
+#include <memory>
+
+#include "gelex/data/genotype/sample_manager.h"
 #include "gelex/pipeline/fit_engine.h"
+#include "gelex/pipeline/geno_pipe.h"
+#include "gelex/pipeline/memory_planner.h"
 
 namespace argparse
 {
@@ -26,9 +31,17 @@ class ArgumentParser;
 
 namespace gelex::cli
 {
+auto make_fit_model_config(argparse::ArgumentParser& cmd) -> FitEngine::Config;
 auto make_fit_config(argparse::ArgumentParser& cmd) -> FitEngine::Config;
 auto has_dominance(BayesAlphabet type) -> bool;
 
+// Memory request of a fit/cv run over the samples kept by the phenotypes.
+auto make_fit_memory_request(
+    argparse::ArgumentParser& cmd,
+    const FitEngine::Config& config,
+    const GenoPipe::Config& geno_config,
+    std::shared_ptr<SampleManager> samples) -> MemoryRequest;
+
 }  // namespace gelex::cli
 
 #endif  // GELEX_CLI_FIT_CONFIG_H_
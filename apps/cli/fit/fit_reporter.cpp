@@ -137,6 +137,13 @@ auto FitReporter::on_event(const FitResultsSavedEvent& event) const -> void
         gelex::success(
             "Results saved to '{}' (.param, .snp.eff, .log)",
             event.out_prefix));
+    if (event.num_predicted > 0)
+    {
+        logger_->info(
+            gelex::subtask(
+                "In-chain GEBVs for {} target individuals (.gebv)",
+                event.num_predicted));
+    }
 }
 
 // --- Private helpers ---
@@ -21,6 +21,7 @@
 #include <argparse.h>
 
 #include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
 
 auto setup_grm_args(argparse::ArgumentParser& cmd) -> void
 {
@@ -30,9 +31,10 @@ auto setup_grm_args(argparse::ArgumentParser& cmd) -> void
 
     cmd.add_group("Data Files");
     cmd.add_argument("-b", "--bfile")
-        .help("PLINK binary file prefix (.bed/.bim/.fam)")
-        .metavar("<BFILE>")
-        .required();
+        .help(
+            "PLINK binary file prefix (.bed/.bim/.fam or .pgen/.pvar/.psam); "
+            "required unless merging parts")
+        .metavar("<BFILE>");
     cmd.add_argument("-o", "--out")
         .help("Output file prefix")
         .metavar("<OUT>")
@@ -51,15 +53,65 @@ auto setup_grm_args(argparse::ArgumentParser& cmd) -> void
         .metavar("<SIZE>")
         .default_value(10000)
         .scan<'i', int>();
+    cmd.add_argument("--precision")
+        .help(
+            "Chunk product precision: double, or mixed (float ssyrk, double "
+            "accumulation; about twice as fast)")
+        .metavar("<STR>")
+        .default_value(std::string("double"))
+        .choices("double", "mixed");
+    cmd.add_argument("--kernel")
+        .help(
+            "GRM kernel: dense (decoded chunks, syrk), or packed (2-bit "
+            "chunks, 32x smaller; popcount products for center methods, "
+            "small decoded panels otherwise)")
+        .metavar("<STR>")
+        .default_value(std::string("dense"))
+        .choices("dense", "packed");
     cmd.add_argument("-t", "--threads")
         .help("Number of threads (-1 for all cores)")
         .metavar("<N>")
         .default_value(
             static_cast<int>(std::thread::hardware_concurrency() / 2))
         .scan<'i', int>();
+    gelex::cli::add_numa_arg(cmd);
     cmd.add_argument("--add").help("Compute additive GRM").flag();
     cmd.add_argument("--dom").help("Compute dominance GRM").flag();
     cmd.add_argument("--loco").help("Compute GRM for each chromosome").flag();
+    cmd.add_argument("--part")
+        .help(
+            "Compute only part i of N balanced row slices of the GRM, "
+            "written to <OUT>.part_N_i")
+        .metavar("<i/N>");
+    cmd.add_argument("--sparse-cutoff")
+        .help(
+            "Write a sparse GRM (<OUT>.sp.bin) keeping only pairs above this "
+            "relatedness, plus the diagonal")
+        .metavar("<FLOAT>")
+        .scan<'g', double>();
+    cmd.add_argument("--eigen")
+        .help(
+            "Also write the eigendecomposition of each GRM (<OUT>.<type>.eig) "
+            "for later spectral analyses")
+        .flag();
+    cmd.add_argument("--epistasis")
+        .help(
+            "Also write the epistatic GRMs <OUT>.{aa,ad,dd}, Hadamard products "
+            "of the additive and dominance GRMs (A x D and D x D need --dom)")
+        .flag();
+    cmd.add_argument("--update")
+        .help(
+            "Extend the GRM at <PREFIX> with the --bfile samples it lacks, "
+            "encoded with the frequencies and scaling of its .loci")
+        .metavar("<PREFIX>");
+    cmd.add_argument("--merge-parts")
+        .help("Concatenate the N parts under <OUT> into the full GRM")
+        .metavar("<N>")
+        .scan<'i', int>();
+
+    gelex::cli::add_memory_args(cmd);
+
+    gelex::cli::add_variant_filter_args(cmd);
 
     cmd.add_epilog(
         gelex::cli::format_epilog(
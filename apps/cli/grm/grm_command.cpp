@@ -16,17 +16,87 @@
 
 #include "grm_command.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <argparse.h>
 #include <fmt/format.h>
 
 #include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
+#include "gelex/data/grm/grm_part.h"
+#include "gelex/exception.h"
 #include "gelex/infra/logging/grm_event.h"
+#include "gelex/io/parser.h"
 #include "gelex/pipeline/grm_engine.h"
 #include "grm_config.h"
 #include "grm_reporter.h"
 
+namespace
+{
+
+// grm --merge-parts N: <out>.part_N_{1..N}.<type> into <out>.<type>
+auto merge_parts(argparse::ArgumentParser& cmd) -> int
+{
+    const int num_parts = cmd.get<int>("--merge-parts");
+    if (num_parts < 1)
+    {
+        throw gelex::ArgumentValidationException(
+            "--merge-parts must be positive");
+    }
+    const auto out_prefix = cmd.get("--out");
+    std::vector<std::string> types;
+    if (cmd.get<bool>("--add") || !cmd.get<bool>("--dom"))
+    {
+        types.emplace_back("add");
+    }
+    if (cmd.get<bool>("--dom"))
+    {
+        types.emplace_back("dom");
+    }
+
+    for (const auto& type : types)
+    {
+        std::vector<std::filesystem::path> parts;
+        for (int index = 1; index <= num_parts; ++index)
+        {
+            parts.emplace_back(
+                fmt::format(
+                    "{}.{}",
+                    gelex::grm_part_prefix(out_prefix, index, num_parts),
+                    type));
+        }
+        gelex::merge_grm_parts(parts, fmt::format("{}.{}", out_prefix, type));
+    }
+
+    gelex::cli::GrmReporter reporter;
+    reporter.on_event(
+        gelex::GrmFilesWrittenEvent{
+            .num_files = types.size() * 2,
+            .output_dir = std::filesystem::absolute(
+                              std::filesystem::path(out_prefix))
+                              .parent_path()
+                              .string(),
+            .file_pattern = fmt::format(
+                "{}.{}.{{bin|id}}",
+                out_prefix,
+                types.size() == 1 ? types[0] : "{add|dom}"),
+        });
+    return 0;
+}
+
+}  // namespace
+
 auto grm_execute(argparse::ArgumentParser& cmd) -> int
 {
+    if (cmd.is_used("--merge-parts"))
+    {
+        return merge_parts(cmd);
+    }
+
     auto config = gelex::cli::make_grm_config(cmd);
     gelex::cli::GrmReporter reporter;
 
@@ -34,6 +104,7 @@ auto grm_execute(argparse::ArgumentParser& cmd) -> int
 
     auto threads = cmd.get<int>("--threads");
     gelex::cli::setup_parallelization(threads);
+    gelex::cli::setup_numa(cmd);
 
     reporter.on_event(
         gelex::GrmConfigLoadedEvent{
@@ -42,6 +113,48 @@ auto grm_execute(argparse::ArgumentParser& cmd) -> int
             .do_loco = config.do_loco,
         });
 
+    const auto [num_samples, num_snps]
+        = gelex::cli::genotype_dimensions(config.bed_path);
+    std::optional<gelex::GrmPart> part;
+    if (config.num_parts > 0)
+    {
+        part = gelex::balanced_grm_part(
+            num_samples, config.part_index, config.num_parts);
+    }
+    else if (!config.update_prefix.empty())
+    {
+        // the new samples' rows, the last ones of the updated GRM
+        auto id_path = config.update_prefix;
+        id_path += config.mode == gelex::freq::GrmType::D ? ".dom.id"
+                                                          : ".add.id";
+        const auto num_old = static_cast<Eigen::Index>(
+            gelex::detail::count_total_lines(id_path));
+        part = gelex::GrmPart{std::min(num_old, num_samples), num_samples};
+    }
+    const auto plan = gelex::plan_memory(
+        gelex::MemoryRequest{
+            .workload = gelex::MemoryWorkload::Grm,
+            .num_samples = num_samples,
+            .num_snps = num_snps,
+            .chunk_size = config.chunk_size,
+            .auto_chunk_size = !cmd.is_used("--chunk-size"),
+            .num_grms = config.mode == gelex::freq::GrmType::AD ? 2 : 1,
+            .loco = config.do_loco,
+            .mixed_precision = config.precision == gelex::GrmPrecision::Mixed,
+            .packed_codes = config.kernel == gelex::GrmKernel::Packed,
+            .part = part,
+            .eigen = config.eigen,
+            .epistasis = config.epistasis,
+            .limit_bytes = gelex::cli::memory_limit(cmd),
+        });
+    if (!gelex::cli::commit_memory_plan(cmd, plan))
+    {
+        return 0;
+    }
+    config.chunk_size = static_cast<int>(plan.chunk_size);
+    config.overlap_writes = plan.overlap_writes;
+    config.fuse_effects = plan.fuse_effects;
+
     gelex::GrmEngine engine(std::move(config));
 
     engine.compute(reporter.as_observer());
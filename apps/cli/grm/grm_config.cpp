@@ -16,10 +16,16 @@
 
 #include "grm_config.h"
 
+#include <filesystem>
+#include <optional>
+#include <tuple>
+
 #include <argparse.h>
 
 #include "cli/cli_helper.h"
+#include "cli/data_pipe_config.h"
 #include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/grm/grm_part.h"
 #include "gelex/exception.h"
 #include "gelex/types/freq_effect.h"
 
@@ -45,6 +51,68 @@ auto make_grm_config(argparse::ArgumentParser& cmd) -> gelex::GrmEngine::Config
         throw gelex::ArgumentValidationException("chunk_size must be positive");
     }
 
+    if (!cmd.is_used("--bfile"))
+    {
+        throw gelex::ArgumentValidationException(
+            "--bfile is required unless --merge-parts is given");
+    }
+    int part_index = 0;
+    int num_parts = 0;
+    if (cmd.is_used("--part"))
+    {
+        if (cmd.get<bool>("--loco"))
+        {
+            throw gelex::ArgumentValidationException(
+                "--part cannot be combined with --loco");
+        }
+        std::tie(part_index, num_parts)
+            = gelex::parse_grm_part(cmd.get("--part"));
+    }
+
+    std::optional<double> sparse_cutoff;
+    if (cmd.is_used("--sparse-cutoff"))
+    {
+        if (cmd.get<bool>("--loco") || cmd.is_used("--part"))
+        {
+            throw gelex::ArgumentValidationException(
+                "--sparse-cutoff cannot be combined with --loco or --part");
+        }
+        sparse_cutoff = cmd.get<double>("--sparse-cutoff");
+    }
+
+    const bool eigen = cmd.get<bool>("--eigen");
+    if (eigen
+        && (cmd.get<bool>("--loco") || cmd.is_used("--part")
+            || cmd.is_used("--sparse-cutoff") || cmd.is_used("--update")))
+    {
+        throw gelex::ArgumentValidationException(
+            "--eigen cannot be combined with --loco, --part, --sparse-cutoff "
+            "or --update");
+    }
+
+    const bool epistasis = cmd.get<bool>("--epistasis");
+    if (epistasis
+        && (cmd.get<bool>("--loco") || cmd.is_used("--part")
+            || cmd.is_used("--sparse-cutoff") || cmd.is_used("--update")))
+    {
+        throw gelex::ArgumentValidationException(
+            "--epistasis cannot be combined with --loco, --part, "
+            "--sparse-cutoff or --update");
+    }
+
+    std::filesystem::path update_prefix;
+    if (cmd.is_used("--update"))
+    {
+        if (cmd.get<bool>("--loco") || cmd.is_used("--part")
+            || cmd.is_used("--sparse-cutoff"))
+        {
+            throw gelex::ArgumentValidationException(
+                "--update cannot be combined with --loco, --part or "
+                "--sparse-cutoff");
+        }
+        update_prefix = cmd.get("--update");
+    }
+
     return gelex::GrmEngine::Config{
         .bed_path = gelex::format_bed_path(cmd.get("--bfile")),
         .mode = mode,
@@ -52,6 +120,19 @@ auto make_grm_config(argparse::ArgumentParser& cmd) -> gelex::GrmEngine::Config
             cmd.get<std::string>("--geno-method")),
         .do_loco = cmd.get<bool>("--loco"),
         .out_prefix = cmd.get("--out"),
-        .chunk_size = chunk_size};
+        .chunk_size = chunk_size,
+        .variant_filter = make_variant_filter(cmd),
+        .precision = cmd.get<std::string>("--precision") == "mixed"
+                         ? gelex::GrmPrecision::Mixed
+                         : gelex::GrmPrecision::Double,
+        .kernel = cmd.get<std::string>("--kernel") == "packed"
+                      ? gelex::GrmKernel::Packed
+                      : gelex::GrmKernel::Dense,
+        .part_index = part_index,
+        .num_parts = num_parts,
+        .sparse_cutoff = sparse_cutoff,
+        .eigen = eigen,
+        .epistasis = epistasis,
+        .update_prefix = update_prefix};
 }
 }  // namespace gelex::cli
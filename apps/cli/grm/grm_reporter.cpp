@@ -85,6 +85,14 @@ auto GrmReporter::on_event(const GrmProgressEvent& event) -> void
     }
 }
 
+auto GrmReporter::on_event(const GrmPackedKernelEvent& event) const -> void
+{
+    logger_->info(gelex::section("[Packed Kernel]"));
+    logger_->info("  Popcount  : {} SNPs", event.bitwise);
+    logger_->info("  Expanded  : {} SNPs", event.expanded);
+    logger_->info("");
+}
+
 auto GrmReporter::on_event(const GrmFilesWrittenEvent& event) const -> void
 {
     logger_->info(gelex::section("[File Summary]"));
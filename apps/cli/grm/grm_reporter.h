@@ -30,6 +30,7 @@ struct GrmConfigLoadedEvent;
 struct GrmDataLoadedEvent;
 struct GrmComputeStartedEvent;
 struct GrmProgressEvent;
+struct GrmPackedKernelEvent;
 struct GrmFilesWrittenEvent;
 }  // namespace gelex
 
@@ -50,6 +51,7 @@ class GrmReporter
     auto on_event(const GrmDataLoadedEvent& event) const -> void;
     auto on_event(const GrmComputeStartedEvent& event) -> void;
     auto on_event(const GrmProgressEvent& event) -> void;
+    auto on_event(const GrmPackedKernelEvent& event) const -> void;
     auto on_event(const GrmFilesWrittenEvent& event) const -> void;
 
     auto as_observer() -> GrmObserver
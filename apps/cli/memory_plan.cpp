@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_plan.h"
+
+#include <argparse.h>
+#include <format>
+#include <string>
+#include <utility>
+
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/exception.h"
+#include "gelex/infra/logger.h"
+#include "gelex/infra/utils/formatter.h"
+
+namespace gelex::cli
+{
+
+auto add_memory_args(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_argument("--memory-limit")
+        .help(
+            "Memory budget (e.g. 16G); storage, chunk size and MCMC draw "
+            "storage are chosen to fit it")
+        .metavar("<SIZE>");
+    cmd.add_argument("--dry-run")
+        .help("Print the memory plan and exit")
+        .flag();
+}
+
+auto memory_limit(argparse::ArgumentParser& cmd) -> std::optional<size_t>
+{
+    if (!cmd.is_used("--memory-limit"))
+    {
+        return std::nullopt;
+    }
+    return parse_memory_size(cmd.get("--memory-limit"));
+}
+
+auto genotype_dimensions(
+    const std::filesystem::path& bed_path,
+    std::shared_ptr<SampleManager> samples)
+    -> std::pair<Eigen::Index, Eigen::Index>
+{
+    if (!samples)
+    {
+        samples = std::make_shared<SampleManager>(sample_info_path(bed_path));
+        samples->finalize();
+    }
+    const BedPipe bed(bed_path, std::move(samples));
+    return {bed.num_samples(), bed.num_snps()};
+}
+
+auto commit_memory_plan(argparse::ArgumentParser& cmd, const MemoryPlan& plan)
+    -> bool
+{
+    const auto& logger = gelex::logging::get();
+    logger->info(gelex::section("[Memory Plan]"));
+    for (const auto& item : plan.items)
+    {
+        logger->info(
+            "  {:<24}: {}", item.label, format_memory_size(item.bytes));
+    }
+    logger->info("  {:<24}: {}", "Chunk Size", plan.chunk_size);
+    if (plan.workload == MemoryWorkload::Fit)
+    {
+        logger->info(
+            "  {:<24}: {}",
+            "Genotype Storage",
+            plan.use_mmap ? "memory-mapped" : "in-memory");
+        logger->info(
+            "  {:<24}: {}",
+            "MCMC Draws",
+            plan.sample_storage == SampleStorage::Full ? "stored"
+                                                       : "streamed");
+    }
+
+    std::string peak = format_memory_size(plan.peak_bytes);
+    if (plan.limit_bytes)
+    {
+        peak += std::format(" of {}", format_memory_size(*plan.limit_bytes));
+    }
+    logger->info(gelex::success("Estimated peak : {}", peak));
+    logger->info("");
+
+    if (cmd.get<bool>("--dry-run"))
+    {
+        return false;
+    }
+    if (!plan.fits())
+    {
+        throw InvalidInputException(
+            std::format(
+                "estimated peak memory {} exceeds --memory-limit {}; "
+                "raise the limit or reduce the data",
+                format_memory_size(plan.peak_bytes),
+                format_memory_size(*plan.limit_bytes)));
+    }
+    return true;
+}
+
+}  // namespace gelex::cli
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_CLI_MEMORY_PLAN_H_
+#define GELEX_CLI_MEMORY_PLAN_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/sample_manager.h"
+#include "gelex/pipeline/memory_planner.h"
+
+namespace argparse
+{
+class ArgumentParser;
+}
+
+namespace gelex::cli
+{
+
+// Adds --memory-limit and --dry-run.
+auto add_memory_args(argparse::ArgumentParser& cmd) -> void;
+
+auto memory_limit(argparse::ArgumentParser& cmd) -> std::optional<size_t>;
+
+// Samples and variants the genotype reader would see, read from the file
+// headers only. A null `samples` means every sample of the .fam/.psam.
+// Variant filters are not applied, so the count is an upper bound.
+auto genotype_dimensions(
+    const std::filesystem::path& bed_path,
+    std::shared_ptr<SampleManager> samples = nullptr)
+    -> std::pair<Eigen::Index, Eigen::Index>;
+
+/**
+ * @brief Logs the plan and decides whether the command goes on.
+ *
+ * @return false on --dry-run, true otherwise.
+ * @throws InvalidInputException if the plan exceeds --memory-limit.
+ */
+auto commit_memory_plan(argparse::ArgumentParser& cmd, const MemoryPlan& plan)
+    -> bool;
+
+}  // namespace gelex::cli
+
+#endif  // GELEX_CLI_MEMORY_PLAN_H_
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pca_args.h"
+
+#include <thread>
+
+#include <argparse.h>
+
+#include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
+
+auto setup_pca_args(argparse::ArgumentParser& cmd) -> void
+{
+    cmd.add_description(
+        "Compute the top principal components of the genotypes by "
+        "randomized subspace iteration, without forming the GRM");
+
+    cmd.add_group("Data Files");
+    cmd.add_argument("-b", "--bfile")
+        .help(
+            "PLINK binary file prefix (.bed/.bim/.fam or .pgen/.pvar/.psam)")
+        .metavar("<BFILE>")
+        .required();
+    cmd.add_argument("-o", "--out")
+        .help("Output file prefix")
+        .metavar("<OUT>")
+        .default_value(std::string("pca"));
+
+    cmd.add_group("PCA Options");
+    cmd.add_argument("-k", "--pcs")
+        .help("Number of principal components")
+        .metavar("<N>")
+        .default_value(10)
+        .scan<'i', int>();
+    cmd.add_argument("--geno-method", "--gm")
+        .help(
+            "Genotype method: StandardizeHWE(SH), CenterHWE(CH),"
+            " OrthStandardizeHWE(OSH), OrthCenterHWE(OCH),"
+            " Standardize(S), Center(C), OrthStandardize(OS), OrthCenter(OC)")
+        .metavar("<STR>")
+        .default_value(std::string("OSH"));
+    cmd.add_argument("--oversampling")
+        .help("Extra subspace columns beyond --pcs")
+        .metavar("<N>")
+        .default_value(10)
+        .scan<'i', int>();
+    cmd.add_argument("--max-iter")
+        .help("Maximum passes over the genotypes")
+        .metavar("<N>")
+        .default_value(30)
+        .scan<'i', int>();
+    cmd.add_argument("--tol")
+        .help("Relative eigenvector residual at which to stop")
+        .metavar("<FLOAT>")
+        .default_value(1e-4)
+        .scan<'g', double>();
+    cmd.add_argument("--seed")
+        .help("Random seed of the start subspace")
+        .metavar("<N>")
+        .default_value(42)
+        .scan<'i', int>();
+    cmd.add_argument("-c", "--chunk-size")
+        .help("SNPs per chunk")
+        .metavar("<SIZE>")
+        .default_value(10000)
+        .scan<'i', int>();
+    cmd.add_argument("-t", "--threads")
+        .help("Number of threads (-1 for all cores)")
+        .metavar("<N>")
+        .default_value(
+            static_cast<int>(std::thread::hardware_concurrency() / 2))
+        .scan<'i', int>();
+
+    gelex::cli::add_memory_args(cmd);
+
+    gelex::cli::add_variant_filter_args(cmd);
+
+    cmd.add_epilog(
+        gelex::cli::format_epilog(
+            "{bg}Example:{rs}\n"
+            "  {bc}gelex pca{rs} {cy}-b{rs} geno {cy}-k{rs} 20\n\n"
+            "{bg}Docs:{rs}\n"
+            "  https://gelex.readthedocs.io/en/latest/cli/pca.html"));
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_CLI_PCA_ARGS_H_
+#define GELEX_CLI_PCA_ARGS_H_
+
+namespace argparse
+{
+class ArgumentParser;
+}
+
+auto setup_pca_args(argparse::ArgumentParser& cmd) -> void;
+
+#endif  // GELEX_CLI_PCA_ARGS_H_
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pca_command.h"
+
+#include <string>
+#include <utility>
+
+#include <argparse.h>
+#include <fmt/format.h>
+
+#include "cli/cli_helper.h"
+#include "cli/memory_plan.h"
+#include "gelex/infra/logging/pca_event.h"
+#include "gelex/pipeline/pca_engine.h"
+#include "pca_config.h"
+#include "pca_reporter.h"
+
+auto pca_execute(argparse::ArgumentParser& cmd) -> int
+{
+    auto config = gelex::cli::make_pca_config(cmd);
+    gelex::cli::PcaReporter reporter;
+
+    auto threads = cmd.get<int>("--threads");
+    gelex::cli::setup_parallelization(threads);
+
+    reporter.on_event(
+        gelex::PcaConfigLoadedEvent{
+            .method = fmt::format("{}", config.method),
+            .num_components
+            = static_cast<size_t>(config.options.num_components),
+            .max_iter = config.options.max_iter,
+        });
+
+    const auto [num_samples, num_snps]
+        = gelex::cli::genotype_dimensions(config.bed_path);
+    const auto plan = gelex::plan_memory(
+        gelex::MemoryRequest{
+            .workload = gelex::MemoryWorkload::Pca,
+            .num_samples = num_samples,
+            .num_snps = num_snps,
+            .chunk_size = config.chunk_size,
+            .auto_chunk_size = !cmd.is_used("--chunk-size"),
+            .pca_width = config.options.num_components
+                         + config.options.oversampling,
+            .limit_bytes = gelex::cli::memory_limit(cmd),
+        });
+    if (!gelex::cli::commit_memory_plan(cmd, plan))
+    {
+        return 0;
+    }
+    config.chunk_size = static_cast<int>(plan.chunk_size);
+
+    gelex::PcaEngine engine(std::move(config));
+
+    engine.compute(reporter.as_observer());
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pca_config.h"
+
+#include <cstdint>
+
+#include <argparse.h>
+
+#include "cli/cli_helper.h"
+#include "cli/data_pipe_config.h"
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/exception.h"
+
+namespace gelex::cli
+{
+
+auto make_pca_config(argparse::ArgumentParser& cmd) -> gelex::PcaEngine::Config
+{
+    const auto chunk_size = cmd.get<int>("--chunk-size");
+    if (chunk_size <= 0)
+    {
+        throw gelex::ArgumentValidationException("chunk_size must be positive");
+    }
+    const auto num_pcs = cmd.get<int>("--pcs");
+    const auto oversampling = cmd.get<int>("--oversampling");
+    const auto max_iter = cmd.get<int>("--max-iter");
+    if (num_pcs <= 0 || oversampling < 0 || max_iter <= 0)
+    {
+        throw gelex::ArgumentValidationException(
+            "--pcs and --max-iter must be positive and --oversampling "
+            "non-negative");
+    }
+
+    return gelex::PcaEngine::Config{
+        .bed_path = gelex::format_bed_path(cmd.get("--bfile")),
+        .method = gelex::cli::parse_genotype_process_method(
+            cmd.get<std::string>("--geno-method")),
+        .out_prefix = cmd.get("--out"),
+        .chunk_size = chunk_size,
+        .variant_filter = make_variant_filter(cmd),
+        .options = {
+            .num_components = num_pcs,
+            .oversampling = oversampling,
+            .max_iter = static_cast<size_t>(max_iter),
+            .tol = cmd.get<double>("--tol"),
+            .seed = static_cast<uint64_t>(cmd.get<int>("--seed")),
+        }};
+}
+}  // namespace gelex::cli
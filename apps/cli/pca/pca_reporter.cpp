@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pca_reporter.h"
+
+#include <fmt/format.h>
+
+#include "config.h"
+#include "gelex/infra/logger.h"
+#include "gelex/infra/utils/formatter.h"
+
+namespace gelex::cli
+{
+
+PcaReporter::PcaReporter() : logger_(gelex::logging::get()) {}
+
+auto PcaReporter::on_event(const PcaConfigLoadedEvent& event) const -> void
+{
+    logger_->info(gelex::command_banner(PROJECT_VERSION, "PCA"));
+    logger_->info("");
+    logger_->info(gelex::section("[Config]"));
+    logger_->info("  {:<12}: {}", "Method", event.method);
+    logger_->info("  {:<12}: {}", "Components", event.num_components);
+    logger_->info("  {:<12}: {}", "Max Iter", event.max_iter);
+    logger_->info("");
+}
+
+auto PcaReporter::on_event(const PcaDataLoadedEvent& event) const -> void
+{
+    logger_->info(gelex::section("[Dataset Summary]"));
+    logger_->info(gelex::success("Samples    : {} samples", event.num_samples));
+    logger_->info(gelex::success("SNPs       : {} markers", event.num_snps));
+    logger_->info("");
+}
+
+auto PcaReporter::on_event(const PcaIterationEvent& event) -> void
+{
+    if (!header_printed_)
+    {
+        logger_->info("  {:<4} {:>12}", "Iter", "Residual");
+        logger_->info(gelex::table_separator(20));
+        header_printed_ = true;
+    }
+    logger_->info("  {:<4} {:>12.3e}", event.iter, event.residual);
+}
+
+auto PcaReporter::on_event(const PcaCompleteEvent& event) const -> void
+{
+    logger_->info(gelex::table_separator(20));
+    if (event.converged)
+    {
+        logger_->info(
+            gelex::success(
+                "Converged successfully in {} iterations", event.iterations));
+    }
+    else
+    {
+        logger_->warn(
+            "  ! PCA did not converge ({} iterations)", event.iterations);
+        logger_->warn(
+            "    Try to increase --max-iter or --oversampling.");
+    }
+    logger_->info("");
+    logger_->info("  {:<4} {:>12}", "PC", "Eigenvalue");
+    logger_->info(gelex::table_separator(20));
+    for (size_t i = 0; i < event.eigenvalues.size(); ++i)
+    {
+        logger_->info("  {:<4} {:>12.4f}", i + 1, event.eigenvalues[i]);
+    }
+    logger_->info("");
+}
+
+auto PcaReporter::on_event(const PcaFilesWrittenEvent& event) const -> void
+{
+    logger_->info(gelex::section("[File Summary]"));
+    logger_->info("  Eigenvectors : {}", event.eigenvec_path);
+    logger_->info("  Eigenvalues  : {}", event.eigenval_path);
+}
+
+}  // namespace gelex::cli
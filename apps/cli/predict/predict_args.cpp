@@ -30,7 +30,9 @@ auto setup_predict_args(argparse::ArgumentParser& cmd) -> void
     // ================================================================
     cmd.add_group("Data Files");
     cmd.add_argument("-b", "--bfile")
-        .help("PLINK binary file prefix for prediction data (.bed/.bim/.fam)")
+        .help(
+            "PLINK binary file prefix for prediction data "
+            "(.bed/.bim/.fam or .pgen/.pvar/.psam)")
         .metavar("<BFILE>")
         .required();
     cmd.add_argument("-e", "--snp-eff")
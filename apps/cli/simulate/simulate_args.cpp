@@ -27,7 +27,7 @@ auto setup_simulate_args(argparse::ArgumentParser& cmd) -> void
 
     cmd.add_group("Data Files");
     cmd.add_argument("-b", "--bfile")
-        .help("PLINK binary file prefix (.bed/.bim/.fam)")
+        .help("PLINK binary file prefix (.bed/.bim/.fam or .pgen/.pvar/.psam)")
         .metavar("<BFILE>")
         .required();
     cmd.add_argument("-o", "--out")
@@ -84,6 +84,8 @@ auto setup_simulate_args(argparse::ArgumentParser& cmd) -> void
         .default_value(42)
         .scan<'i', int>();
 
+    gelex::cli::add_variant_filter_args(cmd);
+
     cmd.add_epilog(
         gelex::cli::format_epilog(
             "{bg}Example:{rs}\n"
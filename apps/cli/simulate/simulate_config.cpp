@@ -23,6 +23,7 @@
 #include <string_view>
 #include <vector>
 
+#include "cli/data_pipe_config.h"
 #include "gelex/algo/sim/effect_sampler.h"
 #include "gelex/data/genotype/bed_path.h"
 #include "gelex/exception.h"
@@ -117,6 +118,8 @@ auto make_simulate_config(argparse::ArgumentParser& cmd)
               : std::vector<gelex::EffectSizeClass>{},
 
         .seed = cmd.get<int>("--seed"),
+
+        .variant_filter = make_variant_filter(cmd),
     };
 }
 
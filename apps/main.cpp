@@ -25,10 +25,14 @@
 #include "cli/assoc/assoc_args.h"
 #include "cli/assoc/assoc_command.h"
 #include "cli/cli_helper.h"
+#include "cli/cv/cv_args.h"
+#include "cli/cv/cv_command.h"
 #include "cli/fit/fit_args.h"
 #include "cli/fit/fit_command.h"
 #include "cli/grm/grm_args.h"
 #include "cli/grm/grm_command.h"
+#include "cli/pca/pca_args.h"
+#include "cli/pca/pca_command.h"
 #include "cli/post/post_args.h"
 #include "cli/post/post_command.h"
 #include "cli/predict/predict_args.h"
@@ -102,19 +106,23 @@ auto main(int argc, char* argv[]) -> int
 {
     argparse::ArgumentParser program(PROJECT_NAME, PROJECT_VERSION);
     argparse::ArgumentParser fit("fit");
+    argparse::ArgumentParser cv("cv");
     argparse::ArgumentParser simulate("simulate");
     argparse::ArgumentParser predict("predict");
     argparse::ArgumentParser grm("grm");
+    argparse::ArgumentParser pca("pca");
     argparse::ArgumentParser assoc("assoc");
     argparse::ArgumentParser post("post");
 
     const std::array commands
         = {CommandDescriptor{"fit", &fit, setup_fit_args, fit_execute},
+           CommandDescriptor{"cv", &cv, setup_cv_args, cv_execute},
            CommandDescriptor{
                "simulate", &simulate, setup_simulate_args, simulate_execute},
            CommandDescriptor{
                "predict", &predict, setup_predict_args, predict_execute},
            CommandDescriptor{"grm", &grm, setup_grm_args, grm_execute},
+           CommandDescriptor{"pca", &pca, setup_pca_args, pca_execute},
            CommandDescriptor{"assoc", &assoc, setup_assoc_args, assoc_execute},
            CommandDescriptor{"post", &post, setup_post_args, post_execute}};
 
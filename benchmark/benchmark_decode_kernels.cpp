@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nanobench.h>
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "data/bed_pipe/decode_kernels.h"
+#include "gelex/types/genetic_effect_type.h"
+
+// Throughput of every decode kernel the CPU supports, per sample decoded,
+// so a SIMD kernel is only kept where it beats the scalar tables.
+int main()
+{
+    constexpr Eigen::Index kSamples = 100'000;
+    constexpr Eigen::Index kVariants = 64;
+    constexpr auto kBytes = static_cast<size_t>((kSamples + 3) / 4);
+
+    std::mt19937_64 rng(42);
+    std::vector<uint8_t> packed(kBytes * kVariants);
+    for (auto& byte : packed)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    const gelex::GenotypeCodeTable table{-1.2, 0.0, 0.3, 1.8};
+    std::vector<double> doubles(static_cast<size_t>(kSamples));
+    std::vector<float> floats(static_cast<size_t>(kSamples));
+
+    ankerl::nanobench::Bench bench;
+    bench.title(std::format("decode n={} x {} variants", kSamples, kVariants))
+        .unit("sample")
+        .batch(kSamples * kVariants)
+        .relative(true);
+
+    auto run = [&](const std::string& name, auto&& decode_variant)
+    {
+        bench.run(
+            name,
+            [&]()
+            {
+                for (Eigen::Index j = 0; j < kVariants; ++j)
+                {
+                    decode_variant(packed.data() + (j * kBytes));
+                }
+                ankerl::nanobench::doNotOptimizeAway(doubles.data());
+                ankerl::nanobench::doNotOptimizeAway(floats.data());
+            });
+    };
+
+    for (const auto* kernel : gelex::detail::available_decode_kernels())
+    {
+        const std::string name(kernel->name);
+        run(name + " dense",
+            [&](const uint8_t* src)
+            { kernel->dense(src, kSamples, doubles.data()); });
+        run(name + " dense_mapped",
+            [&](const uint8_t* src)
+            { kernel->dense_mapped(src, kSamples, table, doubles.data()); });
+        run(name + " dense_mapped_f32",
+            [&](const uint8_t* src)
+            {
+                kernel->dense_mapped_f32(
+                    src, kSamples, table, floats.data());
+            });
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nanobench.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/grm/grm.h"
+#include "gelex/types/genetic_effect_type.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+// Random BED fileset, MAFs in [0.05, 0.5) and 0.5% missing calls.
+auto write_bed(const fs::path& prefix, Eigen::Index n, Eigen::Index m)
+    -> void
+{
+    std::ofstream fam(fs::path(prefix).replace_extension(".fam"));
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        fam << std::format("fam{0} ind{0} 0 0 1 -9\n", i);
+    }
+    std::ofstream bim(fs::path(prefix).replace_extension(".bim"));
+    for (Eigen::Index j = 0; j < m; ++j)
+    {
+        bim << std::format("1\trs{}\t0\t{}\tA\tG\n", j, j + 1);
+    }
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> maf(0.05, 0.5);
+    std::bernoulli_distribution missing(0.005);
+    std::ofstream bed(
+        fs::path(prefix).replace_extension(".bed"), std::ios::binary);
+    bed.put(0x6c).put(0x1b).put(0x01);
+    const auto row_bytes = static_cast<size_t>((n + 3) / 4);
+    std::vector<char> row(row_bytes);
+    for (Eigen::Index j = 0; j < m; ++j)
+    {
+        std::binomial_distribution<int> dosage(2, maf(rng));
+        std::fill(row.begin(), row.end(), 0);
+        for (Eigen::Index i = 0; i < n; ++i)
+        {
+            // BED codes of 2, 1 and 0 A1 alleles
+            constexpr uint8_t kCodes[] = {0b11, 0b10, 0b00};
+            const uint8_t code = missing(rng) ? 0b01 : kCodes[dosage(rng)];
+            row[static_cast<size_t>(i / 4)] = static_cast<char>(
+                static_cast<uint8_t>(row[static_cast<size_t>(i / 4)])
+                | (code << (2 * (i % 4))));
+        }
+        bed.write(row.data(), static_cast<std::streamsize>(row_bytes));
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    constexpr Eigen::Index kSamples = 4000;
+    constexpr Eigen::Index kSnps = 8000;
+    constexpr Eigen::Index kChunkSize = 2000;
+
+    const fs::path prefix = fs::temp_directory_path() / "bench_grm_kernel";
+    write_bed(prefix, kSamples, kSnps);
+    const fs::path bed_path = fs::path(prefix).replace_extension(".bed");
+
+    // standardized SNPs are expanded to panels by the packed kernel,
+    // centered ones multiplied with popcount
+    using gelex::GenotypeProcessMethod;
+    for (const auto [method_name, method] :
+         {std::pair{"StandardizeHWE", GenotypeProcessMethod::StandardizeHWE},
+          std::pair{"CenterHWE", GenotypeProcessMethod::CenterHWE}})
+    {
+        ankerl::nanobench::Bench bench;
+        bench.title(std::format("GRM n=4000 m=8000, {}", method_name))
+            .relative(true)
+            .epochs(3);
+
+        for (const auto [name, kernel] :
+             {std::pair{"dense", gelex::GrmKernel::Dense},
+              std::pair{"packed", gelex::GrmKernel::Packed}})
+        {
+            bench.run(
+                name,
+                [&]()
+                {
+                    gelex::GRM grm(bed_path);
+                    grm.set_kernel(kernel);
+                    auto result = grm.compute<gelex::GeneticEffectType::Add>(
+                        method, kChunkSize);
+                    ankerl::nanobench::doNotOptimizeAway(result);
+                });
+        }
+    }
+
+    for (const char* ext : {".bed", ".bim", ".fam"})
+    {
+        fs::remove(fs::path(prefix).replace_extension(ext));
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_ALGO_INFER_CHAIN_PREDICTOR_H_
+#define GELEX_ALGO_INFER_CHAIN_PREDICTOR_H_
+
+#include <Eigen/Core>
+
+#include "gelex/infra/utils/running_stats.h"
+
+namespace gelex
+{
+
+class BayesState;
+
+/**
+ * @brief Accumulates genomic values of target individuals inside the chain.
+ *
+ * Target genotypes must already be aligned to the training SNP order and
+ * standardized with the training statistics. Each stored MCMC draw costs one
+ * GEMV per genetic effect; only the running mean and variance per individual
+ * are kept, so no per-draw output is required.
+ */
+class ChainPredictor
+{
+   public:
+    ChainPredictor(Eigen::MatrixXd&& additive, Eigen::MatrixXd&& dominant);
+
+    auto update(const BayesState& state) -> void;
+
+    [[nodiscard]] auto result() const -> RunningStatsResult
+    {
+        return stats_.result();
+    }
+    [[nodiscard]] auto num_samples() const -> Eigen::Index
+    {
+        return additive_.rows();
+    }
+    [[nodiscard]] auto has_dominance() const -> bool
+    {
+        return dominant_.size() > 0;
+    }
+
+   private:
+    Eigen::MatrixXd additive_;
+    Eigen::MatrixXd dominant_;
+    Eigen::VectorXd gebv_;
+    RunningStats stats_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_ALGO_INFER_CHAIN_PREDICTOR_H_
@@ -21,6 +21,7 @@
 #include <omp.h>
 #include <Eigen/Core>
 
+#include "gelex/algo/infer/chain_predictor.h"
 #include "gelex/algo/infer/params.h"
 #include "gelex/algo/infer/posterior_calculator.h"
 #include "gelex/infra/logging/fit_event.h"
@@ -43,6 +44,9 @@ class MCMC
         std::string_view sample_prefix = "",
         const FitObserver& observer = {});
 
+    // Optional; updated with every stored draw. Not owned.
+    void set_predictor(ChainPredictor* predictor) { predictor_ = predictor; }
+
    private:
     void run_impl(
         const BayesModel& model,
@@ -52,6 +56,7 @@ class MCMC
 
     MCMCParams params_;
     TraitSampler trait_sampler_;
+    ChainPredictor* predictor_ = nullptr;
 };
 
 template <typename TraitSampler>
@@ -86,7 +91,7 @@ MCMCResult MCMC<TraitSampler>::run(
             .sigma2_e = std::nullopt,
         });
 
-    MCMCResult result(std::move(samples), model, 0.9);
+    MCMCResult result(std::move(samples), model);
     result.compute();
 
     notify(observer, FitMcmcCompleteEvent{&result, &model, params_.n_records});
@@ -131,6 +136,10 @@ void MCMC<TraitSampler>::run_impl(
             && (iter + 1 - params_.n_burnin) % params_.n_thin == 0)
         {
             samples.store(status, record_idx++);
+            if (predictor_ != nullptr)
+            {
+                predictor_->update(status);
+            }
         }
     }
 }
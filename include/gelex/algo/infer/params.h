@@ -17,12 +17,24 @@
 #ifndef GELEX_ESTIMATOR_BAYES_PARAMS_H_
 #define GELEX_ESTIMATOR_BAYES_PARAMS_H_
 #include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 
 #include <Eigen/Core>
 
 namespace gelex
 {
+
+// How draws are kept while sampling. Streaming, the default, keeps only
+// running moments, credible sketches and component counts, which yield the
+// summaries in O(m) memory; Full also stores every stored draw (m x
+// records) for callers that want the per-draw matrices.
+enum class SampleStorage : uint8_t
+{
+    Full,
+    Streaming,
+};
+
 struct MCMCParams
 {
     MCMCParams(Eigen::Index n_iters, Eigen::Index n_burnin, Eigen::Index n_thin)
@@ -41,6 +53,9 @@ struct MCMCParams
     Eigen::Index n_burnin;
     Eigen::Index n_thin;
     Eigen::Index n_records;
+    // Level of the streaming credible intervals tracked while sampling.
+    double credible_prob{0.9};
+    SampleStorage sample_storage{SampleStorage::Streaming};
 };
 }  // namespace gelex
 
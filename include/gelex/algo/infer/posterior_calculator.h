@@ -48,7 +48,10 @@ namespace PosteriorCalculator
 
 PosteriorSummary compute_param_summary(
     const Eigen::Ref<const Eigen::MatrixXd>& samples,
-    double prob);
+    const CredibleSketch& interval);
+
+// Mean and SD from the running moments, interval from the sketches.
+PosteriorSummary compute_param_summary(const ParamDraws& draws);
 
 PosteriorSummary compute_snp_summary(
     const Eigen::Ref<const Eigen::MatrixXd>& samples);
@@ -62,12 +65,22 @@ void compute_pve(
     const Eigen::Ref<const Eigen::MatrixXd>& samples,
     double phenotype_var);
 
+void compute_pve_from_mean(
+    PosteriorSummary& summary,
+    const Eigen::Ref<const Eigen::VectorXd>& mean_coeffs,
+    double phenotype_var);
+
 Eigen::Index get_n_params(const Eigen::Ref<const Eigen::MatrixXd>& samples);
 
 Eigen::MatrixXd compute_component_probs(
     const Eigen::Ref<const Eigen::MatrixXi>& tracker_samples,
     Eigen::Index n_components);
 
+// `counts(i, k)` draws put marker i in component k.
+Eigen::MatrixXd component_probs_from_counts(
+    const Eigen::Ref<const Eigen::MatrixXi>& counts,
+    Eigen::Index n_draws);
+
 }  // namespace PosteriorCalculator
 
 }  // namespace gelex::detail
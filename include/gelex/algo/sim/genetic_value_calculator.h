@@ -27,6 +27,7 @@
 #include "gelex/algo/sim/effect_sampler.h"
 #include "gelex/data/genotype/bed_pipe.h"
 #include "gelex/data/genotype/sample_manager.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/infra/logging/simulate_event.h"
 
 namespace gelex
@@ -51,6 +52,14 @@ class GeneticValueCalculator
 
     [[nodiscard]] auto sample_ids() const -> std::span<const std::string>;
 
+    // Keeps only the variants passing `filter`; `snps`, the full .bim, is
+    // subset alongside.
+    auto select_variants(const VariantFilter& filter, SnpEffects& snps)
+        -> void
+    {
+        apply_variant_filter(filter, bed_pipe_, snps);
+    }
+
    private:
     auto encode_chunk(const Eigen::Ref<const Eigen::MatrixXd>& chunk) const
         -> std::pair<Eigen::MatrixXd, Eigen::MatrixXd>;
@@ -17,6 +17,8 @@
 #ifndef GELEX_ESTIMATOR_FREQ_STATISTICS_H_
 #define GELEX_ESTIMATOR_FREQ_STATISTICS_H_
 
+#include <Eigen/Core>
+
 namespace gelex
 {
 
@@ -38,12 +40,16 @@ auto compute_bic(const FreqModel& model, double loglike) -> double;
 // se(σ) = sqrt(diag(-H⁻¹))
 auto compute_variance_se(FreqState& state, const OptimizerState& opt_state)
     -> void;
+auto compute_variance_se(FreqState& state, const Eigen::MatrixXd& hess_inv)
+    -> void;
 
 // Compute heritability and its standard error using delta method
 // h² = σ_g / Σσ
 // se(h²) = sqrt(g' * (-H⁻¹) * g)
 auto compute_heritability(FreqState& state, const OptimizerState& opt_state)
     -> void;
+auto compute_heritability(FreqState& state, const Eigen::MatrixXd& hess_inv)
+    -> void;
 
 }  // namespace statistics
 }  // namespace gelex
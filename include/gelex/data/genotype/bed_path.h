@@ -17,14 +17,33 @@
 #ifndef GELEX_DATA_BED_PATH_H
 #define GELEX_DATA_BED_PATH_H
 
+#include <cstdint>
 #include <filesystem>
 #include <string_view>
 
 namespace gelex
 {
 
+enum class GenotypeFormat : uint8_t
+{
+    Bed,   // PLINK 1 .bed/.bim/.fam
+    Pgen,  // PLINK 2 .pgen/.pvar/.psam
+};
+
+// Resolves a PLINK fileset given either as its genotype file or as a bare
+// prefix. A prefix prefers `<prefix>.bed` and falls back to `<prefix>.pgen`.
 auto format_bed_path(std::string_view bed_path) -> std::filesystem::path;
 
+auto genotype_format(const std::filesystem::path& bed_path) -> GenotypeFormat;
+
+// The .bim/.pvar file that belongs to a path returned by format_bed_path.
+auto variant_info_path(const std::filesystem::path& bed_path)
+    -> std::filesystem::path;
+
+// The .fam/.psam file that belongs to a path returned by format_bed_path.
+auto sample_info_path(const std::filesystem::path& bed_path)
+    -> std::filesystem::path;
+
 }  // namespace gelex
 
 #endif  // GELEX_DATA_BED_PATH_H
@@ -17,12 +17,16 @@
 #ifndef GELEX_DATA_BED_PIPE_H
 #define GELEX_DATA_BED_PIPE_H
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include <Eigen/Core>
 
 #include "gelex/data/genotype/sample_manager.h"
+#include "gelex/types/genetic_effect_type.h"
 
 namespace gelex
 {
@@ -32,10 +36,20 @@ namespace detail
 
 class SampleProjection;
 class BedMmapReader;
+class PgenReader;
 class BedVariantDecoder;
 
 }  // namespace detail
 
+// Sample-major 2-bit genotype codes: row i holds one sample's codes, four
+// variants per byte in BED bit order (variant 4b + q in bits 2q, 2q + 1 of
+// byte b).
+using PackedCodes
+    = Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// Decodes a PLINK fileset into sample-aligned dosages. `bed_prefix` may
+// name a .bed or a PLINK 2 .pgen; the latter is converted to BED-coded
+// rows per chunk and then takes the same decode paths.
 class BedPipe
 {
    public:
@@ -60,15 +74,133 @@ class BedPipe
         Eigen::Index start_col,
         Eigen::Index end_col) const;
 
+    // Decodes and processes in one pass: each variant's statistics come
+    // from its packed genotype codes and the values `planner` derives from
+    // them are written directly. `stats` receives one entry per column
+    // and `counts`, unless empty, the code counts the plans came from.
+    void load_chunk(
+        Eigen::Ref<Eigen::MatrixXd> target_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner planner,
+        std::span<LocusStatistic> stats,
+        std::span<GenotypeCodeCounts> counts = {}) const;
+
+    // The fused decode for two planners, e.g. the additive and dominance
+    // encodings side by side: each variant is read and counted once and
+    // expanded into both buffers.
+    void load_chunk(
+        Eigen::Ref<Eigen::MatrixXd> first_buf,
+        Eigen::Ref<Eigen::MatrixXd> second_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner first_planner,
+        LocusPlanner second_planner,
+        std::span<LocusStatistic> first_stats,
+        std::span<LocusStatistic> second_stats,
+        std::span<GenotypeCodeCounts> counts = {}) const;
+
+    // Single-precision counterparts of the two fused decodes, for float
+    // kernels: the planners' values are applied in float, so no double
+    // copy of the chunk is made.
+    void load_chunk(
+        Eigen::Ref<Eigen::MatrixXf> target_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner planner,
+        std::span<LocusStatistic> stats,
+        std::span<GenotypeCodeCounts> counts = {}) const;
+
+    void load_chunk(
+        Eigen::Ref<Eigen::MatrixXf> first_buf,
+        Eigen::Ref<Eigen::MatrixXf> second_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner first_planner,
+        LocusPlanner second_planner,
+        std::span<LocusStatistic> first_stats,
+        std::span<LocusStatistic> second_stats,
+        std::span<GenotypeCodeCounts> counts = {}) const;
+
+    // Genotype code counts of the target samples, without decoding.
+    void count_codes(
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        std::span<GenotypeCodeCounts> counts) const;
+
+    // Transposes the chunk's codes into target sample order without
+    // decoding, for kernels that work on codes. `codes` must be
+    // num_samples() x ceil((end_col - start_col) / 4); the unused bits of
+    // the last byte are zero and rows no sample feeds read as missing.
+    // `counts` receives each variant's code counts, as count_codes.
+    void load_codes(
+        Eigen::Ref<PackedCodes> codes,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        std::span<GenotypeCodeCounts> counts) const;
+
+    // Restricts the columns to the given raw variant indices (unique and
+    // ascending, see apply_variant_filter). Column j afterwards is
+    // variants[j]; unselected variants are never read.
+    void select_variants(std::vector<Eigen::Index> variants);
+
     [[nodiscard]] Eigen::Index num_samples() const;
+    // Number of columns: the selected variants, or all of them.
     [[nodiscard]] Eigen::Index num_snps() const;
 
    private:
+    template <typename Scalar>
+    using DecodeBuffer
+        = Eigen::Ref<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>;
+
+    template <typename Scalar>
+    auto prepare_chunk(
+        DecodeBuffer<Scalar> target_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        std::vector<uint8_t>& staging) const -> const uint8_t*;
+
+    // The fused decodes behind the double and float load_chunk overloads.
+    template <typename Scalar>
+    void load_planned(
+        DecodeBuffer<Scalar> target_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner planner,
+        std::span<LocusStatistic> stats,
+        std::span<GenotypeCodeCounts> counts) const;
+
+    template <typename Scalar>
+    void load_planned(
+        DecodeBuffer<Scalar> first_buf,
+        DecodeBuffer<Scalar> second_buf,
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        LocusPlanner first_planner,
+        LocusPlanner second_planner,
+        std::span<LocusStatistic> first_stats,
+        std::span<LocusStatistic> second_stats,
+        std::span<GenotypeCodeCounts> counts) const;
+
+    // Packed BED rows of columns [start_col, end_col): straight from the
+    // mapping when they are consecutive .bed rows, otherwise gathered or
+    // decoded into `staging`.
+    auto packed_rows(
+        Eigen::Index start_col,
+        Eigen::Index end_col,
+        std::vector<uint8_t>& staging) const -> const uint8_t*;
+
+    [[nodiscard]] auto raw_variant(Eigen::Index col) const -> Eigen::Index;
+
     std::shared_ptr<SampleManager> sample_manager_;
     std::unique_ptr<detail::SampleProjection> projection_;
     std::unique_ptr<detail::BedMmapReader> bed_reader_;
+    std::unique_ptr<detail::PgenReader> pgen_reader_;
     std::unique_ptr<detail::BedVariantDecoder> decoder_;
     Eigen::Index num_raw_snps_ = 0;
+    Eigen::Index bytes_per_variant_ = 0;
+    // selected raw variants; empty selects all
+    std::vector<Eigen::Index> variants_;
 };
 
 }  // namespace gelex
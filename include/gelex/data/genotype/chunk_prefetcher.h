@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GENOTYPE_CHUNK_PREFETCHER_H_
+#define GELEX_DATA_GENOTYPE_CHUNK_PREFETCHER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/types/genetic_effect_type.h"
+
+namespace gelex
+{
+
+/**
+ * @brief Produces BED chunks on a background thread while the caller
+ * consumes the previous ones.
+ *
+ * Chunks are handed out in range order from a fixed ring of `depth`
+ * buffers, so at most `depth` chunks are alive at any time: one held by
+ * the caller, the others being filled or waiting. An exception thrown by
+ * the producer is rethrown from next().
+ *
+ * The caller's OpenMP thread budget is split between the two sides (see
+ * split_threads()): the producer's decode runs with its share and the
+ * caller's own parallel regions and OpenMP-threaded BLAS with the rest
+ * until the prefetcher is destroyed, so the two do not oversubscribe the
+ * cores.
+ */
+class ChunkPrefetcher
+{
+   public:
+    struct Range
+    {
+        Eigen::Index start;
+        Eigen::Index end;
+    };
+
+    struct Chunk
+    {
+        Eigen::Index start{};
+        Eigen::Index end{};
+        Eigen::MatrixXd genotype;
+        // single-precision genotypes, filled by decode_f32() instead of
+        // `genotype`
+        Eigen::MatrixXf genotype_f32;
+        // sample-major codes and per-variant plans, filled by pack()
+        PackedCodes codes;
+        std::vector<LocusPlan> plans;
+        // second encoding of the same variants (the dominance one), filled
+        // by the producers given a dominance planner
+        Eigen::MatrixXd dominance;
+        Eigen::MatrixXf dominance_f32;
+        std::vector<LocusStatistic> dominance_stats;
+        std::vector<LocusPlan> dominance_plans;
+        std::vector<LocusStatistic> stats;
+        // code counts the plans came from, filled by every producer given
+        // a planner
+        std::vector<GenotypeCodeCounts> counts;
+    };
+
+    // Fills `chunk.genotype`/`chunk.stats` for [chunk.start, chunk.end).
+    using Producer = std::function<void(Chunk& chunk)>;
+
+    static constexpr size_t kDefaultDepth = 2;
+
+    ChunkPrefetcher(
+        std::vector<Range> ranges,
+        Producer producer,
+        size_t depth = kDefaultDepth);
+
+    ChunkPrefetcher(const ChunkPrefetcher&) = delete;
+    ChunkPrefetcher& operator=(const ChunkPrefetcher&) = delete;
+    ChunkPrefetcher(ChunkPrefetcher&&) = delete;
+    ChunkPrefetcher& operator=(ChunkPrefetcher&&) = delete;
+    ~ChunkPrefetcher();
+
+    // Blocks until the next chunk is ready; nullptr once all are consumed.
+    // The chunk belongs to the caller until the following call, which may
+    // swap its buffers out instead of copying them.
+    [[nodiscard]] auto next() -> Chunk*;
+
+    // OpenMP threads of the producer and of the caller out of `budget`:
+    // decoding is a linear pass next to the consumer's products, so it
+    // gets a quarter, and each side at least one.
+    static auto split_threads(int budget) -> std::pair<int, int>;
+
+    // Cuts every [start, end) range into chunks of at most `chunk_size`.
+    static auto split(
+        std::span<const std::pair<Eigen::Index, Eigen::Index>> ranges,
+        Eigen::Index chunk_size) -> std::vector<Range>;
+
+    // Raw dosages, as BedPipe::load_chunk.
+    static auto decode(const BedPipe& bed) -> Producer;
+
+    // Processed genotypes and their statistics via the fused decode path.
+    static auto decode(const BedPipe& bed, LocusPlanner planner) -> Producer;
+
+    // As decode(bed, planner), but into `genotype_f32` for single-precision
+    // kernels: the planner's values are applied in float and `genotype`
+    // stays empty.
+    static auto decode_f32(const BedPipe& bed, LocusPlanner planner)
+        -> Producer;
+
+    // Both encodings from one read of each chunk: `genotype`/`stats` from
+    // `planner` and `dominance`/`dominance_stats` from `dominance_planner`.
+    static auto decode(
+        const BedPipe& bed,
+        LocusPlanner planner,
+        LocusPlanner dominance_planner) -> Producer;
+
+    // Both encodings in single precision, into `genotype_f32` and
+    // `dominance_f32`.
+    static auto decode_f32(
+        const BedPipe& bed,
+        LocusPlanner planner,
+        LocusPlanner dominance_planner) -> Producer;
+
+    // Packed codes and plans only, via BedPipe::load_codes; `genotype`
+    // stays empty. The codes are shared by both encodings, so a dominance
+    // planner only adds `dominance_plans`.
+    static auto pack(
+        const BedPipe& bed,
+        LocusPlanner planner,
+        LocusPlanner dominance_planner = nullptr) -> Producer;
+
+   private:
+    void run(const std::stop_token& stop);
+
+    std::vector<Range> ranges_;
+    Producer producer_;
+    std::vector<Chunk> slots_;
+
+    std::mutex mutex_;
+    std::condition_variable_any ready_;
+    size_t produced_ = 0;
+    size_t released_ = 0;
+    size_t handed_out_ = 0;
+    std::exception_ptr error_;
+
+    // the caller's omp_get_max_threads(), restored on destruction
+    int thread_budget_;
+    int producer_threads_;
+
+    // last, so it is joined before the state above is destroyed
+    std::jthread worker_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GENOTYPE_CHUNK_PREFETCHER_H_
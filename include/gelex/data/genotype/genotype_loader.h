@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <fmt/format.h>
@@ -30,6 +31,7 @@
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/data/genotype/sample_manager.h"
 #include "gelex/infra/detail/indicator.h"
+#include "gelex/infra/utils/huge_pages.h"
 #include "gelex/infra/utils/formatter.h"
 
 namespace gelex
@@ -38,9 +40,12 @@ namespace gelex
 class GenotypeLoader
 {
    public:
+    // `variants` restricts the columns to those raw variants (see
+    // apply_variant_filter); empty keeps all.
     explicit GenotypeLoader(
         const std::filesystem::path& bed_path,
-        std::shared_ptr<SampleManager> sample_manager);
+        std::shared_ptr<SampleManager> sample_manager,
+        std::vector<Eigen::Index> variants = {});
 
     GenotypeLoader(const GenotypeLoader&) = delete;
     GenotypeLoader& operator=(const GenotypeLoader&) = delete;
@@ -53,21 +58,30 @@ class GenotypeLoader
         -> GenotypeMatrix
     {
         global_snp_idx_ = 0;
-        auto fn = get_genotype_process_method<GT>(method);
+        auto planner = get_genotype_planner<GT>(method);
         auto pbar = detail::create_progress_info();
         pbar.display->show();
         means_.resize(num_variants_);
         stddevs_.resize(num_variants_);
         monomorphic_indices_.reserve(num_variants_ / 100);
+        std::vector<LocusStatistic> stats;
 
         for (int64_t start_variant = 0; start_variant < num_variants_;)
         {
             int64_t end_variant = std::min(
                 static_cast<int64_t>(start_variant + chunk_size),
                 num_variants_);
-            auto chunk = bed_pipe_.load_chunk(start_variant, end_variant);
-            process_chunk(chunk, start_variant, fn);
-            global_snp_idx_ += chunk.cols();
+            const int64_t num_chunk_variants = end_variant - start_variant;
+            stats.resize(static_cast<size_t>(num_chunk_variants));
+            bed_pipe_.load_chunk(
+                data_matrix_.map().middleCols(
+                    start_variant, num_chunk_variants),
+                start_variant,
+                end_variant,
+                planner,
+                stats);
+            record_stats(stats, start_variant);
+            global_snp_idx_ += num_chunk_variants;
             pbar.progress_info->message(
                 fmt::format(
                     "  {}/{} SNPs",
@@ -89,10 +103,9 @@ class GenotypeLoader
     }
 
    private:
-    void process_chunk(
-        Eigen::MatrixXd& chunk,
-        Eigen::Index global_start,
-        LocusStatistic (*fn)(Eigen::Ref<Eigen::VectorXd>));
+    void record_stats(
+        std::span<const LocusStatistic> stats,
+        Eigen::Index global_start);
 
     GenotypeMatrix finalize();
 
@@ -107,7 +120,7 @@ class GenotypeLoader
     std::vector<double> stddevs_;
     std::vector<int64_t> monomorphic_indices_;
 
-    Eigen::MatrixXd data_matrix_;
+    HugePageMatrix data_matrix_;
 };
 
 }  // namespace gelex
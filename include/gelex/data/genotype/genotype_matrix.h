@@ -22,14 +22,18 @@
 
 #include <Eigen/Core>
 
+#include "gelex/infra/utils/huge_pages.h"
+
 namespace gelex
 {
 
 class GenotypeMatrix
 {
    public:
+    using MapType = HugePageMatrix::ConstMapType;
+
     GenotypeMatrix(
-        Eigen::MatrixXd&& data,
+        HugePageMatrix&& data,
         std::vector<int64_t>&& mono_indices,
         Eigen::VectorXd&& mean,
         Eigen::VectorXd&& stddev);
@@ -40,10 +44,7 @@ class GenotypeMatrix
     GenotypeMatrix& operator=(GenotypeMatrix&&) noexcept = default;
     ~GenotypeMatrix() = default;
 
-    [[nodiscard]] const Eigen::MatrixXd& matrix() const noexcept
-    {
-        return data_;
-    }
+    [[nodiscard]] MapType matrix() const noexcept { return data_.map(); }
 
     [[nodiscard]] bool is_monomorphic(Eigen::Index marker_idx) const noexcept
     {
@@ -64,7 +65,7 @@ class GenotypeMatrix
     [[nodiscard]] int64_t cols() const noexcept { return data_.cols(); }
 
    private:
-    Eigen::MatrixXd data_;
+    HugePageMatrix data_;
     std::vector<int64_t> mono_indices_;
     Eigen::VectorXd mean_;
     Eigen::VectorXd stddev_;
@@ -20,12 +20,17 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 #include <Eigen/Core>
 
 #include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/chunk_prefetcher.h"
 #include "gelex/data/genotype/genotype_mmap.h"
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/data/genotype/sample_manager.h"
@@ -37,13 +42,26 @@
 namespace gelex
 {
 
+/**
+ * @brief Preprocesses a BED file into the `.bmat`/`.snpstats` pair that backs
+ * GenotypeMap.
+ *
+ * The pair is treated as a cache: a `.cache` key next to it records the
+ * size and mtime of the BED/BIM/FAM files, the sample set, the variant
+ * subset, the processing method and the effect type. A matching key reuses
+ * the files as-is; anything else regenerates them through temporaries that
+ * are renamed into place only once complete.
+ */
 class GenotypePipe
 {
    public:
+    // `variants` restricts the columns to those raw variants and is part
+    // of the cache key; empty keeps all.
     GenotypePipe(
         const std::filesystem::path& bed_path,
         std::shared_ptr<SampleManager> sample_manager,
-        const std::filesystem::path& output_prefix);
+        const std::filesystem::path& output_prefix,
+        std::vector<Eigen::Index> variants = {});
 
     GenotypePipe(const GenotypePipe&) = delete;
     GenotypePipe(GenotypePipe&&) noexcept = default;
@@ -55,25 +73,34 @@ class GenotypePipe
     auto process(GenotypeProcessMethod method, size_t chunk_size = 10000)
         -> GenotypeMap
     {
+        const auto key = cache_key(GT, method);
+        if (auto cached = load_cached(key); cached)
+        {
+            return std::move(*cached);
+        }
+        open_writers();
+
         int64_t current_processed_snps = 0;
-        auto fn = get_genotype_process_method<GT>(method);
         auto pbar = detail::create_progress_info();
         means_.resize(num_variants_);
         variances_.resize(num_variants_);
         monomorphic_indices_.clear();
         monomorphic_indices_.reserve(num_variants_ / 100);
 
+        // the next chunk is decoded while the current one is written out
+        const std::pair<Eigen::Index, Eigen::Index> all{0, num_variants_};
+        ChunkPrefetcher prefetcher(
+            ChunkPrefetcher::split(
+                {&all, 1}, static_cast<Eigen::Index>(chunk_size)),
+            ChunkPrefetcher::decode(
+                bed_pipe_, get_genotype_planner<GT>(method)));
+
         pbar.display->show();
-        for (int64_t start_variant = 0; start_variant < num_variants_;)
+        while (auto* chunk = prefetcher.next())
         {
-            int64_t end_variant = std::min(
-                static_cast<int64_t>(start_variant + chunk_size),
-                num_variants_);
-
-            auto chunk = bed_pipe_.load_chunk(start_variant, end_variant);
-            process_chunk(chunk, start_variant, fn);
-            matrix_writer_->write(chunk);
-            current_processed_snps += (end_variant - start_variant);
+            record_stats(chunk->stats, static_cast<size_t>(chunk->start));
+            matrix_writer_->write(chunk->genotype);
+            current_processed_snps += chunk->end - chunk->start;
 
             pbar.progress_info->message(
                 fmt::format(
@@ -81,12 +108,10 @@ class GenotypePipe
                     gelex::AbbrNumber(
                         static_cast<size_t>(current_processed_snps)),
                     gelex::AbbrNumber(static_cast<size_t>(num_variants_))));
-
-            start_variant = end_variant;
         }
         pbar.display->done();
 
-        return finalize();
+        return finalize(key);
     }
 
     [[nodiscard]] Eigen::Index num_samples() const noexcept
@@ -97,19 +122,30 @@ class GenotypePipe
     {
         return num_variants_;
     }
+    // true when the last process() call reused an existing cache
+    [[nodiscard]] bool reused_cache() const noexcept { return reused_cache_; }
 
    private:
-    void process_chunk(
-        Eigen::MatrixXd& chunk,
-        size_t global_start,
-        LocusStatistic (*fn)(Eigen::Ref<Eigen::VectorXd>));
+    void record_stats(
+        std::span<const LocusStatistic> stats,
+        size_t global_start);
 
-    GenotypeMap finalize();
+    auto cache_key(GeneticEffectType type, GenotypeProcessMethod method) const
+        -> std::string;
+    auto load_cached(const std::string& key) -> std::optional<GenotypeMap>;
+    void open_writers();
+    GenotypeMap finalize(const std::string& key);
 
     BedPipe bed_pipe_;
     int64_t sample_size_{};
     int64_t num_variants_{};
 
+    std::filesystem::path matrix_path_;
+    std::filesystem::path stats_path_;
+    std::filesystem::path key_path_;
+    std::string source_fingerprint_;
+    bool reused_cache_ = false;
+
     std::vector<double> means_;
     std::vector<double> variances_;
     std::vector<int64_t> monomorphic_indices_;
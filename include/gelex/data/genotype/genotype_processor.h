@@ -125,6 +125,32 @@ auto get_genotype_process_method(GenotypeProcessMethod method)
     throw InvalidInputException("Invalid genotype process method.");
 }
 
+// Fused counterpart of get_genotype_process_method for BedPipe::load_chunk.
+template <GeneticEffectType GT>
+auto get_genotype_planner(GenotypeProcessMethod method) -> LocusPlanner
+{
+    switch (method)
+    {
+        case GenotypeProcessMethod::StandardizeHWE:
+            return &StandardizeHWE<GT>::plan;
+        case GenotypeProcessMethod::CenterHWE:
+            return &CenterHWE<GT>::plan;
+        case GenotypeProcessMethod::OrthStandardizeHWE:
+            return &OrthStandardizeHWE<GT>::plan;
+        case GenotypeProcessMethod::OrthCenterHWE:
+            return &OrthCenterHWE<GT>::plan;
+        case GenotypeProcessMethod::Standardize:
+            return &Standardize<GT>::plan;
+        case GenotypeProcessMethod::Center:
+            return &Center<GT>::plan;
+        case GenotypeProcessMethod::OrthStandardize:
+            return &OrthStandardize<GT>::plan;
+        case GenotypeProcessMethod::OrthCenter:
+            return &OrthCenter<GT>::plan;
+    }
+    throw InvalidInputException("Invalid genotype process method.");
+}
+
 template <GeneticEffectType GT>
 auto get_center_genotype_method(GenotypeProcessMethod method)
     -> LocusStatistic (*)(Eigen::Ref<Eigen::VectorXd>)
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GENOTYPE_VIEW_H_
+#define GELEX_DATA_GENOTYPE_VIEW_H_
+
+#include <algorithm>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+/**
+ * @brief Non-owning view of a processed genotype store.
+ *
+ * Lets several models (e.g. cross-validation folds) share one decoded
+ * GenotypeMatrix or GenotypeMap. The viewed store must outlive the view.
+ */
+class GenotypeView
+{
+   public:
+    using MapType = Eigen::Map<const Eigen::MatrixXd>;
+
+    template <typename Store>
+    explicit GenotypeView(const Store& store)
+        : mat_(store.matrix().data(), store.rows(), store.cols()),
+          mean_(&store.mean()),
+          stddev_(&store.stddev())
+    {
+        for (Eigen::Index i = 0; i < store.cols(); ++i)
+        {
+            if (store.is_monomorphic(i))
+            {
+                mono_indices_.push_back(i);
+            }
+        }
+    }
+
+    [[nodiscard]] const MapType& matrix() const noexcept { return mat_; }
+
+    [[nodiscard]] bool is_monomorphic(Eigen::Index marker_idx) const noexcept
+    {
+        return std::ranges::binary_search(mono_indices_, marker_idx);
+    }
+
+    [[nodiscard]] const Eigen::VectorXd& mean() const noexcept
+    {
+        return *mean_;
+    }
+    [[nodiscard]] const Eigen::VectorXd& stddev() const noexcept
+    {
+        return *stddev_;
+    }
+
+    [[nodiscard]] int64_t num_mono() const noexcept
+    {
+        return static_cast<int64_t>(mono_indices_.size());
+    }
+    [[nodiscard]] int64_t rows() const noexcept { return mat_.rows(); }
+    [[nodiscard]] int64_t cols() const noexcept { return mat_.cols(); }
+
+   private:
+    MapType mat_;
+    std::vector<int64_t> mono_indices_;
+    const Eigen::VectorXd* mean_;
+    const Eigen::VectorXd* stddev_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GENOTYPE_VIEW_H_
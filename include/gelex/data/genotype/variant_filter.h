@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GENOTYPE_VARIANT_FILTER_H_
+#define GELEX_DATA_GENOTYPE_VARIANT_FILTER_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/types/snp_info.h"
+
+namespace gelex
+{
+
+// Variant subset of an analysis. Default-constructed keeps everything.
+struct VariantFilter
+{
+    // one SNP ID per line (first column); empty paths are unused
+    std::filesystem::path extract_path;
+    std::filesystem::path exclude_path;
+    // chromosome names as in the .bim; empty keeps all
+    std::vector<std::string> chromosomes;
+    std::optional<int> from_bp;
+    std::optional<int> to_bp;
+
+    // genotype-based thresholds, over the samples of the analysis
+    double min_maf = 0.0;
+    double max_missing_rate = 1.0;
+    double min_hwe_pvalue = 0.0;
+
+    [[nodiscard]] auto empty() const -> bool;
+    [[nodiscard]] auto uses_genotypes() const -> bool;
+};
+
+/**
+ * @brief Resolves `filter` into the kept raw variant indices and applies
+ * them to `bed` and `snps`.
+ *
+ * `snps` must be the full .bim of `bed`. The metadata criteria are checked
+ * first; only the variants they keep are counted for the MAF, missingness
+ * and HWE thresholds. Afterwards `bed` reads only the kept variants and
+ * `snps` lists them in the same order, so column j of one is entry j of the
+ * other.
+ *
+ * @return The kept raw indices, ascending.
+ * @throws InvalidInputException if no variant passes.
+ */
+auto apply_variant_filter(
+    const VariantFilter& filter,
+    BedPipe& bed,
+    SnpEffects& snps) -> std::vector<Eigen::Index>;
+
+// Metadata of the given raw variants, in order.
+auto select_snps(const SnpEffects& snps, std::span<const Eigen::Index> variants)
+    -> SnpEffects;
+
+// Exact two-sided Hardy-Weinberg p-value (Wigginton et al. 2005).
+auto hwe_exact_pvalue(int64_t hets, int64_t hom1, int64_t hom2) -> double;
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GENOTYPE_VARIANT_FILTER_H_
@@ -17,26 +17,76 @@
 #ifndef GELEX_DATA_GRM_H_
 #define GELEX_DATA_GRM_H_
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Core>
 
 #include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/chunk_prefetcher.h"
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/data/genotype/sample_manager.h"
+#include "gelex/data/genotype/variant_filter.h"
+#include "gelex/data/grm/grm_part.h"
+#include "gelex/exception.h"
 #include "gelex/infra/logging/grm_event.h"
 #include "gelex/infra/logging/notify.h"
+#include "gelex/infra/utils/huge_pages.h"
+#include "gelex/infra/utils/numa.h"
 
 namespace gelex
 {
 
+// Double: dsyrk on double chunks. Mixed: chunks converted to float and
+// multiplied with ssyrk, each chunk's product added to the double GRM so
+// rounding error does not build up across chunks.
+enum class GrmPrecision : uint8_t
+{
+    Double,
+    Mixed,
+};
+
+// Dense: decoded, standardized chunks multiplied with syrk (see
+// GrmPrecision). Packed: chunks stay at two bits per genotype. Variants
+// whose values are integer levels less an offset (the center-family
+// methods, and their dominance coding) with few missing calls are
+// multiplied from bit planes of the codes with AND and popcount, the
+// offset applied algebraically; the rest are expanded a few hundred at a
+// time into a panel that takes the dgemm/dsyrk update. Exact for every
+// method and independent of the precision setting.
+enum class GrmKernel : uint8_t
+{
+    Dense,
+    Packed,
+};
+
+// Variants the Packed kernel has added to a GRM: `bitwise` through
+// popcount cross-products, `expanded` through double panels. A variant of
+// compute_add_dom() counts once per GRM.
+struct PackedKernelUsage
+{
+    Eigen::Index bitwise = 0;
+    Eigen::Index expanded = 0;
+};
+
+// `grm` is n x n, or part.num_rows() x part.row_end under set_part() with
+// only the slice's lower triangle filled. The denominator of a part is its
+// share of the whole one: the parts' denominators add up to it.
 struct GrmResult
 {
     Eigen::MatrixXd grm;
     double denominator;
+    // each variant's genotype code counts in range order, collected from
+    // the decode under set_record_counts(); a planner turns them back into
+    // the encoding applied (see GrmLociWriter)
+    std::vector<GenotypeCodeCounts> code_counts;
 };
 
 class GRM
@@ -63,6 +113,42 @@ class GRM
         Eigen::Index chunk_size,
         const GrmObserver& observer = {}) -> GrmResult;
 
+    /**
+     * @brief Additive and dominance GRMs of the same variants from one
+     * decode of each chunk.
+     *
+     * Each variant is read and counted once and both encodings are
+     * accumulated side by side, at the cost of a second n x n accumulator
+     * (and, for the dense kernel, a second decoded chunk).
+     */
+    auto compute_add_dom(
+        GenotypeProcessMethod method,
+        const std::vector<std::pair<Eigen::Index, Eigen::Index>>& ranges,
+        Eigen::Index chunk_size,
+        const GrmObserver& observer = {}) -> std::pair<GrmResult, GrmResult>;
+
+    // Called with each finished group's numerator. The callee may swap in
+    // another buffer (of any size); it is resized and zeroed afterwards.
+    using GroupSink = std::function<void(size_t group, Eigen::MatrixXd&)>;
+
+    /**
+     * @brief Numerators of several variant groups (e.g. chromosomes) and
+     * of their union, in one pass over the BED file.
+     *
+     * Groups hold ascending, disjoint ranges and are visited in order. Each
+     * group is accumulated into its own buffer, handed to `sink` when the
+     * group ends and added to the running total, so only two n x n buffers
+     * are needed. The returned result is the union's GRM.
+     */
+    template <GeneticEffectType GT>
+    auto compute_groups(
+        GenotypeProcessMethod method,
+        const std::vector<std::vector<std::pair<Eigen::Index, Eigen::Index>>>&
+            groups,
+        Eigen::Index chunk_size,
+        const GroupSink& sink,
+        const GrmObserver& observer = {}) -> GrmResult;
+
     [[nodiscard]] auto sample_ids() const -> const std::vector<std::string>&
     {
         return sample_manager_->common_ids();
@@ -73,13 +159,111 @@ class GRM
         return bed_.num_snps();
     }
 
+    auto set_precision(GrmPrecision precision) -> void
+    {
+        precision_ = precision;
+    }
+
+    auto set_kernel(GrmKernel kernel) -> void { kernel_ = kernel; }
+
+    // Totals over every compute call of this GRM; zero under Dense.
+    [[nodiscard]] auto packed_usage() const -> PackedKernelUsage
+    {
+        return packed_usage_;
+    }
+
+    // Keeps the code counts the compute pass reads anyway in
+    // GrmResult::code_counts; compute_add_dom() puts them in the additive
+    // result only.
+    auto set_record_counts(bool record) -> void { record_counts_ = record; }
+
+    // Restricts compute() and compute_add_dom() to one slice of rows (see
+    // GrmPart); compute_groups() needs the whole matrix.
+    auto set_part(GrmPart part) -> void;
+
+    [[nodiscard]] auto part() const -> GrmPart
+    {
+        return part_.value_or(GrmPart{0, bed_.num_samples()});
+    }
+
+    // Keeps only the variants passing `filter`; `snps`, the full .bim, is
+    // subset alongside so its ranges index the kept variants.
+    auto select_variants(const VariantFilter& filter, SnpEffects& snps)
+        -> void
+    {
+        apply_variant_filter(filter, bed_, snps);
+    }
+
    private:
     std::shared_ptr<SampleManager> sample_manager_;
     BedPipe bed_;
+    GrmPrecision precision_ = GrmPrecision::Double;
+    GrmKernel kernel_ = GrmKernel::Dense;
+    PackedKernelUsage packed_usage_;
+    std::optional<GrmPart> part_;
+    bool record_counts_ = false;
+    // n x n ssyrk product of one chunk, kept across chunks in Mixed mode
+    Eigen::MatrixXf chunk_product_;
+
+    template <GeneticEffectType GT>
+    auto producer(GenotypeProcessMethod method) const
+        -> ChunkPrefetcher::Producer
+    {
+        auto planner = get_genotype_planner<GT>(method);
+        if (kernel_ == GrmKernel::Packed)
+        {
+            return ChunkPrefetcher::pack(bed_, planner);
+        }
+        return precision_ == GrmPrecision::Mixed
+                   ? ChunkPrefetcher::decode_f32(bed_, planner)
+                   : ChunkPrefetcher::decode(bed_, planner);
+    }
+
+    auto add_dom_producer(GenotypeProcessMethod method) const
+        -> ChunkPrefetcher::Producer;
+
+    // Zeroed accumulator of the current part, placed as the NUMA policy
+    // asks.
+    [[nodiscard]] auto make_accumulator() const -> Eigen::MatrixXd;
+
+    // Trace of the part's diagonal block, over n.
+    [[nodiscard]] auto denominator(const Eigen::MatrixXd& grm) const
+        -> double;
+
+    // Appends the chunk's code counts if they are being recorded.
+    auto collect_counts(
+        std::vector<GenotypeCodeCounts>& counts,
+        const ChunkPrefetcher::Chunk& chunk) const -> void
+    {
+        if (record_counts_)
+        {
+            counts.insert(
+                counts.end(), chunk.counts.begin(), chunk.counts.end());
+        }
+    }
+
+    // Adds the chunk's contribution to the lower triangle of `grm`, from
+    // its dominance encoding when `dominance` is set.
+    auto accumulate(
+        Eigen::Ref<Eigen::MatrixXd> grm,
+        const ChunkPrefetcher::Chunk& chunk,
+        bool dominance = false) -> void;
 
     static auto update_grm(
         Eigen::Ref<Eigen::MatrixXd> grm,
         const Eigen::Ref<const Eigen::MatrixXd>& genotype) -> void;
+
+    static auto update_grm_mixed(
+        Eigen::Ref<Eigen::MatrixXd> grm,
+        Eigen::MatrixXf& product,
+        const Eigen::Ref<const Eigen::MatrixXf>& genotype) -> void;
+
+    // Returns how many of the variants went through the popcount path.
+    static auto update_grm_packed(
+        Eigen::Ref<Eigen::MatrixXd> grm,
+        const PackedCodes& codes,
+        std::span<const LocusPlan> plans,
+        std::span<const GenotypeCodeCounts> counts) -> Eigen::Index;
 };
 
 template <GeneticEffectType GT>
@@ -98,8 +282,7 @@ auto GRM::compute(
     Eigen::Index chunk_size,
     const GrmObserver& observer) -> GrmResult
 {
-    const Eigen::Index n = bed_.num_samples();
-    Eigen::MatrixXd grm = Eigen::MatrixXd::Zero(n, n);
+    Eigen::MatrixXd grm = make_accumulator();
 
     Eigen::Index total_snps_to_process = 0;
     for (const auto& [start, end] : ranges)
@@ -107,34 +290,116 @@ auto GRM::compute(
         total_snps_to_process += (end - start);
     }
 
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, chunk_size), producer<GT>(method));
+
+    std::vector<GenotypeCodeCounts> counts;
     Eigen::Index processed_snps = 0;
-    for (const auto& [range_start, range_end] : ranges)
+    while (auto* chunk = prefetcher.next())
     {
-        for (Eigen::Index start_col = range_start; start_col < range_end;
-             start_col += chunk_size)
+        accumulate(grm, *chunk);
+        collect_counts(counts, *chunk);
+
+        processed_snps += chunk->end - chunk->start;
+        notify(
+            observer,
+            GrmProgressEvent{
+                static_cast<size_t>(processed_snps),
+                static_cast<size_t>(total_snps_to_process),
+                false});
+    }
+
+    chunk_product_.resize(0, 0);
+    const double grm_denominator = denominator(grm);
+
+    return {std::move(grm), grm_denominator, std::move(counts)};
+}
+
+template <GeneticEffectType GT>
+auto GRM::compute_groups(
+    GenotypeProcessMethod method,
+    const std::vector<std::vector<std::pair<Eigen::Index, Eigen::Index>>>&
+        groups,
+    Eigen::Index chunk_size,
+    const GroupSink& sink,
+    const GrmObserver& observer) -> GrmResult
+{
+    if (part_)
+    {
+        throw InvalidOperationException(
+            "GRM::compute_groups: not available for a GRM part");
+    }
+    const Eigen::Index n = bed_.num_samples();
+    Eigen::MatrixXd total(n, n);
+    advise_huge_pages(total);
+    numa_first_touch(total);
+    Eigen::MatrixXd group_grm(n, n);
+    advise_huge_pages(group_grm);
+    numa_first_touch(group_grm);
+
+    std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges;
+    std::vector<Eigen::Index> group_ends;
+    Eigen::Index total_snps_to_process = 0;
+    for (const auto& group : groups)
+    {
+        for (const auto& range : group)
         {
-            const Eigen::Index end_col
-                = std::min(start_col + chunk_size, range_end);
-            Eigen::MatrixXd genotype_chunk
-                = bed_.load_chunk(start_col, end_col);
-
-            process_matrix<GT>(method, genotype_chunk);
-            update_grm(grm, genotype_chunk);
-
-            processed_snps += (end_col - start_col);
-            notify(
-                observer,
-                GrmProgressEvent{
-                    static_cast<size_t>(processed_snps),
-                    static_cast<size_t>(total_snps_to_process),
-                    false});
+            if (!ranges.empty() && range.first < ranges.back().second)
+            {
+                throw ArgumentValidationException(
+                    "GRM groups must hold ascending, disjoint ranges");
+            }
+            ranges.push_back(range);
+            total_snps_to_process += range.second - range.first;
         }
+        group_ends.push_back(ranges.empty() ? 0 : ranges.back().second);
     }
 
-    double denominator = grm.trace() / static_cast<double>(n);
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, chunk_size), producer<GT>(method));
 
-    return {grm, denominator};
+    size_t group = 0;
+    auto finish_group = [&]
+    {
+        total.triangularView<Eigen::Lower>() += group_grm;
+        sink(group, group_grm);
+        group_grm.resize(n, n);
+        numa_first_touch(group_grm);
+        ++group;
+    };
+
+    std::vector<GenotypeCodeCounts> counts;
+    Eigen::Index processed_snps = 0;
+    while (auto* chunk = prefetcher.next())
+    {
+        // chunks never straddle ranges, so one past a group's end starts
+        // the next non-empty group
+        while (chunk->start >= group_ends[group])
+        {
+            finish_group();
+        }
+        accumulate(group_grm, *chunk);
+        collect_counts(counts, *chunk);
+
+        processed_snps += chunk->end - chunk->start;
+        notify(
+            observer,
+            GrmProgressEvent{
+                static_cast<size_t>(processed_snps),
+                static_cast<size_t>(total_snps_to_process),
+                false});
+    }
+    while (group < groups.size())
+    {
+        finish_group();
+    }
+
+    chunk_product_.resize(0, 0);
+    double denominator = total.trace() / static_cast<double>(n);
+
+    return {std::move(total), denominator, std::move(counts)};
 }
+
 }  // namespace gelex
 
 #endif  // GELEX_DATA_GRM_H_
@@ -31,8 +31,15 @@ class GrmBinWriter
 {
    public:
     static constexpr size_t kDefaultBufferSize = static_cast<size_t>(64 * 1024);
+    // floats converted per write (16 MiB) and rows per conversion tile
+    static constexpr size_t kStageFloats = size_t{1} << 22;
+    static constexpr Eigen::Index kTileRows = 32;
 
-    explicit GrmBinWriter(const std::filesystem::path& file_path);
+    // `append` adds to an existing file (grm --update) instead of
+    // replacing it.
+    explicit GrmBinWriter(
+        const std::filesystem::path& file_path,
+        bool append = false);
 
     GrmBinWriter(const GrmBinWriter&) = delete;
     GrmBinWriter(GrmBinWriter&&) noexcept = default;
@@ -42,12 +49,32 @@ class GrmBinWriter
 
     auto write(const Eigen::Ref<const Eigen::MatrixXd>& grm) -> void;
 
+    // A rows x cols block holding rows [cols - rows, cols) of a larger
+    // GRM (see GrmPart), written as that slice of write()'s layout; a
+    // square block is a whole GRM.
+    auto write_rows(const Eigen::Ref<const Eigen::MatrixXd>& rows) -> void;
+
+    // scale * (left o right), the Hadamard product of two GRMs, written as
+    // write() would without forming it (grm --epistasis).
+    auto write_hadamard(
+        const Eigen::Ref<const Eigen::MatrixXd>& left,
+        const Eigen::Ref<const Eigen::MatrixXd>& right,
+        double scale) -> void;
+
     [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&
     {
         return path_;
     }
 
    private:
+    // Rows [begin, begin + num_rows) of a lower triangle whose block entry
+    // (r, j) is value(r, j).
+    template <typename Value>
+    auto write_lower(
+        Eigen::Index num_rows,
+        Eigen::Index begin,
+        const Value& value) -> void;
+
     std::filesystem::path path_;
     std::vector<char> io_buffer_;
     std::ofstream file_;
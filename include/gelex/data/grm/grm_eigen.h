@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_GRM_EIGEN_H_
+#define GELEX_DATA_GRM_GRM_EIGEN_H_
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/grm/grm_loader.h"
+#include "gelex/data/io/binary_mmap_loader.h"
+#include "gelex/types/freq_effect.h"
+
+namespace gelex
+{
+
+/**
+ * @brief Eigendecomposition of a GRM numerator, scaled by trace / n as
+ * GrmLoader::load() scales it.
+ *
+ * Uses LAPACK's divide-and-conquer dsyevd, which spends its time in
+ * threaded BLAS-3 calls, on the lower triangle of `grm`. The matrix
+ * becomes the eigenvectors, so the only extra memory is dsyevd's
+ * workspace of about 2 n^2 doubles.
+ */
+auto decompose_grm(Eigen::MatrixXd grm) -> freq::GrmEigen;
+
+// <prefix>.eig: a BinaryWriter<double> matrix of n rows and n + 1 columns,
+// the eigenvalues followed by the eigenvectors, in the .id's sample order.
+auto write_grm_eigen(
+    const freq::GrmEigen& eigen,
+    const std::filesystem::path& path) -> void;
+
+namespace detail
+{
+
+// Maps <prefix>.eig next to the <prefix>.bin/.id it decomposes.
+class GrmEigenLoader
+{
+   public:
+    explicit GrmEigenLoader(const std::filesystem::path& prefix);
+
+    GrmEigenLoader(const GrmEigenLoader&) = delete;
+    GrmEigenLoader(GrmEigenLoader&&) noexcept = default;
+    GrmEigenLoader& operator=(const GrmEigenLoader&) = delete;
+    GrmEigenLoader& operator=(GrmEigenLoader&&) noexcept = default;
+    ~GrmEigenLoader() = default;
+
+    // Views of the mapped file, in the .id's sample order.
+    [[nodiscard]] auto eigenvalues() const
+    {
+        return matrix_.matrix().col(0);
+    }
+
+    [[nodiscard]] auto eigenvectors() const
+    {
+        return matrix_.matrix().rightCols(num_samples());
+    }
+
+    /**
+     * @brief The decomposition with eigenvector rows in id_map order.
+     *
+     * Reordering samples keeps it exact, so id_map must list every sample
+     * of the GRM; a subset changes the matrix and has no decomposition on
+     * file (InvalidInputException).
+     */
+    [[nodiscard]] auto load(
+        const std::unordered_map<std::string, Eigen::Index>& id_map) const
+        -> freq::GrmEigen;
+
+    [[nodiscard]] auto sample_ids() const noexcept
+        -> const std::vector<std::string>&
+    {
+        return grm_.sample_ids();
+    }
+
+    [[nodiscard]] auto num_samples() const noexcept -> Eigen::Index
+    {
+        return grm_.num_samples();
+    }
+
+   private:
+    std::filesystem::path path_;
+    GrmLoader grm_;
+    BinaryMmapLoader<double> matrix_;
+};
+
+}  // namespace detail
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GRM_GRM_EIGEN_H_
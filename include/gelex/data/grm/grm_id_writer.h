@@ -30,7 +30,11 @@ namespace gelex
 class GrmIdWriter
 {
    public:
-    explicit GrmIdWriter(const std::filesystem::path& file_path);
+    // `append` adds to an existing file (grm --update) instead of
+    // replacing it.
+    explicit GrmIdWriter(
+        const std::filesystem::path& file_path,
+        bool append = false);
 
     GrmIdWriter(const GrmIdWriter&) = delete;
     GrmIdWriter(GrmIdWriter&&) noexcept = default;
@@ -19,18 +19,37 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <mio.h>
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
+#include "gelex/data/grm/sparse_grm_writer.h"
 #include "gelex/types/freq_effect.h"
 
 namespace gelex::detail
 {
 
+// Where the samples of a GRM file land in a target matrix; built once by
+// GrmLoader::permutation() and reusable for every file with the same IDs.
+struct GrmPermutation
+{
+    // file indices of the mapped samples, ascending
+    std::vector<Eigen::Index> sources;
+    // target row and column of each source
+    std::vector<Eigen::Index> targets;
+    // target matrices are target_size x target_size
+    Eigen::Index target_size = 0;
+    Eigen::Index num_file_samples = 0;
+};
+
+// Reads <prefix>.bin, or the sparse <prefix>.sp.bin (see SparseGrmWriter)
+// when there is no dense file. The dense loads expand a sparse GRM with
+// zeros for the pairs it leaves out.
 class GrmLoader
 {
    public:
@@ -57,6 +76,73 @@ class GrmLoader
         const std::unordered_map<std::string, Eigen::Index>& id_map,
         Eigen::MatrixXd& target) const -> void;
 
+    // Throws InvalidInputException if an ID of the map is not in the file.
+    [[nodiscard]] auto permutation(
+        const std::unordered_map<std::string, Eigen::Index>& id_map) const
+        -> GrmPermutation;
+
+    /**
+     * @brief Expands the packed triangle into target through a precomputed
+     * permutation.
+     *
+     * Columns are filled in parallel from contiguous runs of the packed
+     * rows, then the other triangle is mirrored in cache-sized tiles.
+     * Target entries of samples outside the permutation are zero.
+     */
+    auto load_unnormalized(
+        const GrmPermutation& permutation,
+        Eigen::MatrixXd& target) const -> void;
+
+    /**
+     * @brief target = (target - this GRM) * scale, in place.
+     *
+     * The LOCO step: with the whole-genome GRM expanded into target, a
+     * chromosome's is subtracted and the difference scaled in the same
+     * pass over its mapped triangle, so no second n x n buffer is needed.
+     * The permutation must cover every sample of the square target; dense
+     * files only.
+     */
+    auto subtract_scaled(
+        const GrmPermutation& permutation,
+        double scale,
+        Eigen::MatrixXd& target) const -> void;
+
+    // Trace of the unnormalized GRM over the permutation's samples, read
+    // from the diagonal of the file.
+    [[nodiscard]] auto trace(const GrmPermutation& permutation) const
+        -> double;
+
+    // Sparse files only: the GRM over the id_map samples scaled by its
+    // trace / n, as load(id_map) but without the n x n matrix.
+    [[nodiscard]] auto load_sparse(
+        const std::unordered_map<std::string, Eigen::Index>& id_map) const
+        -> Eigen::SparseMatrix<double>;
+
+    [[nodiscard]] auto load_sparse_unnormalized(
+        const GrmPermutation& permutation) const
+        -> Eigen::SparseMatrix<double>;
+
+    // The mapped lower triangle of a dense file, row by row, without
+    // expanding it; empty for a sparse file.
+    [[nodiscard]] auto packed() const noexcept -> std::span<const float>
+    {
+        if (sparse_)
+        {
+            return {};
+        }
+        return {
+            reinterpret_cast<const float*>(mmap_.data()),
+            lower_triangle_index(num_samples_, 0)};
+    }
+
+    // Entries (i, 0) .. (i, i) of the packed triangle.
+    [[nodiscard]] auto packed_row(Eigen::Index i) const noexcept
+        -> std::span<const float>
+    {
+        return packed().subspan(
+            lower_triangle_index(i, 0), static_cast<size_t>(i) + 1);
+    }
+
     [[nodiscard]] auto sample_ids() const noexcept
         -> const std::vector<std::string>&
     {
@@ -70,6 +156,14 @@ class GrmLoader
 
     [[nodiscard]] auto type() const noexcept -> freq::GrmType { return type_; }
 
+    [[nodiscard]] auto is_sparse() const noexcept -> bool { return sparse_; }
+
+    // Stored lower-triangle entries of a sparse file; 0 for a dense one.
+    [[nodiscard]] auto num_sparse_entries() const noexcept -> size_t
+    {
+        return sparse_ ? mmap_.size() / sizeof(SparseGrmEntry) : 0;
+    }
+
    private:
     std::filesystem::path bin_path_;
     std::filesystem::path id_path_;
@@ -77,15 +171,38 @@ class GrmLoader
     std::vector<std::string> sample_ids_;
     Eigen::Index num_samples_{};
     freq::GrmType type_;
+    bool sparse_{false};
 
     auto load_sample_ids() -> void;
     auto init_mmap() -> void;
+    [[nodiscard]] auto sparse_entries() const noexcept
+        -> std::span<const SparseGrmEntry>
+    {
+        return {
+            reinterpret_cast<const SparseGrmEntry*>(mmap_.data()),
+            num_sparse_entries()};
+    }
+    // Calls apply(entry, value) with the target entry, or a column block,
+    // and the file value for every mapped pair of a dense file, then
+    // mirrors the written triangle.
+    template <typename Apply>
+    auto expand_dense(
+        const GrmPermutation& permutation,
+        Eigen::MatrixXd& target,
+        Apply&& apply) const -> void;
+    // Calls visit(target_row, target_col, value) for every stored entry
+    // whose samples the permutation maps, after checking it is in range.
+    template <typename Visit>
+    auto for_each_sparse_entry(
+        const GrmPermutation& permutation,
+        Visit&& visit) const -> void;
 
     [[nodiscard]] static auto lower_triangle_index(
         Eigen::Index i,
         Eigen::Index j) noexcept -> size_t
     {
-        return (i * (i + 1) / 2) + j;
+        const auto row = static_cast<size_t>(i);
+        return (row * (row + 1) / 2) + static_cast<size_t>(j);
     }
 };
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_GRM_LOCI_H_
+#define GELEX_DATA_GRM_GRM_LOCI_H_
+
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "gelex/types/genetic_effect_type.h"
+#include "gelex/types/snp_info.h"
+
+namespace gelex
+{
+
+// One variant of a GRM and the value each 2-bit genotype code took in it.
+struct GrmLocus
+{
+    std::string id;
+    char A1{};
+    char A2{};
+    GenotypeCodeTable values{};
+};
+
+/**
+ * @brief Writes the variant encodings a GRM was built with (<prefix>.loci).
+ *
+ * A tab-separated table, one line per variant in GRM order: SNP, A1, A2
+ * and the values of the codes 00 (A1/A1), 01 (missing), 10 (het) and 11
+ * (A2/A2), printed to round-trip exactly. `grm --update` encodes new
+ * samples with these values, so their rows match the original run's
+ * frequencies and scaling.
+ */
+class GrmLociWriter
+{
+   public:
+    explicit GrmLociWriter(const std::filesystem::path& file_path);
+
+    GrmLociWriter(const GrmLociWriter&) = delete;
+    GrmLociWriter(GrmLociWriter&&) noexcept = default;
+    auto operator=(const GrmLociWriter&) -> GrmLociWriter& = delete;
+    auto operator=(GrmLociWriter&&) noexcept -> GrmLociWriter& = default;
+    ~GrmLociWriter() = default;
+
+    auto write(std::span<const SnpMeta> snps, std::span<const LocusPlan> plans)
+        -> void;
+
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&
+    {
+        return path_;
+    }
+
+   private:
+    std::filesystem::path path_;
+    std::ofstream file_;
+};
+
+// Reads a GrmLociWriter file.
+auto load_grm_loci(const std::filesystem::path& path)
+    -> std::vector<GrmLocus>;
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GRM_GRM_LOCI_H_
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_GRM_PART_H_
+#define GELEX_DATA_GRM_GRM_PART_H_
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+// Rows [row_begin, row_end) of a GRM's lower triangle, spanning columns
+// [0, row_end): one slice of `grm --part` (GCTA's --make-grm-part model).
+// A part's .bin holds exactly these rows of the full file's layout, so the
+// parts concatenate into it.
+struct GrmPart
+{
+    Eigen::Index row_begin = 0;
+    Eigen::Index row_end = 0;
+
+    [[nodiscard]] auto num_rows() const -> Eigen::Index
+    {
+        return row_end - row_begin;
+    }
+};
+
+// Part `index` (1-based) of `num_parts`, cut so that every part holds
+// about the same number of lower-triangle entries.
+auto balanced_grm_part(Eigen::Index num_samples, int index, int num_parts)
+    -> GrmPart;
+
+// "3/10" -> {3, 10}
+auto parse_grm_part(std::string_view text) -> std::pair<int, int>;
+
+// Output prefix of one part: "<out_prefix>.part_<num_parts>_<index>".
+auto grm_part_prefix(std::string_view out_prefix, int index, int num_parts)
+    -> std::string;
+
+/**
+ * @brief Concatenates part .bin/.id pairs, in part order, into the full
+ * GRM at `out_prefix`.
+ *
+ * Each part's .bin size is checked against the rows its .id lists and the
+ * rows before it, so missing, reordered or truncated parts are rejected
+ * before anything is written.
+ */
+auto merge_grm_parts(
+    const std::vector<std::filesystem::path>& part_prefixes,
+    const std::filesystem::path& out_prefix) -> void;
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GRM_GRM_PART_H_
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_GRM_UPDATE_H_
+#define GELEX_DATA_GRM_GRM_UPDATE_H_
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/chunk_prefetcher.h"
+#include "gelex/data/genotype/sample_manager.h"
+#include "gelex/infra/logging/grm_event.h"
+#include "gelex/types/genetic_effect_type.h"
+
+namespace gelex
+{
+
+/**
+ * @brief Rows of the samples a GRM lacks, encoded as the GRM was
+ * (`grm --update`).
+ *
+ * The BED file holds the GRM's samples and new ones, in any order. Only
+ * the variants of the GRM's .loci are read, matched by ID (a swapped
+ * A1/A2 swaps the homozygote values), and each genotype takes the value
+ * the original run gave it. The rows are therefore exactly those a full
+ * run would add with the original frequencies and scaling, at a cost of
+ * n_new x n x m instead of n x n x m.
+ */
+class GrmUpdater
+{
+   public:
+    // `grm_prefix` names the dense <prefix>.{bin,id,loci} to extend.
+    GrmUpdater(
+        const std::filesystem::path& bed_path,
+        const std::filesystem::path& grm_prefix);
+
+    GrmUpdater(const GrmUpdater&) = delete;
+    GrmUpdater(GrmUpdater&&) noexcept = default;
+    GrmUpdater& operator=(const GrmUpdater&) = delete;
+    GrmUpdater& operator=(GrmUpdater&&) noexcept = default;
+    ~GrmUpdater() = default;
+
+    /**
+     * @brief Numerator rows of the new samples against all samples.
+     *
+     * num_new() x (num_old() + num_new()), columns ordered as the GRM's
+     * .id and then new_sample_ids(): the slice GrmBinWriter::write_rows()
+     * appends to the existing .bin. Entries above the diagonal are filled
+     * as well.
+     */
+    auto compute(Eigen::Index chunk_size, const GrmObserver& observer = {})
+        -> Eigen::MatrixXd;
+
+    [[nodiscard]] auto new_sample_ids() const
+        -> const std::vector<std::string>&
+    {
+        return new_ids_;
+    }
+
+    [[nodiscard]] auto num_old() const -> Eigen::Index { return num_old_; }
+
+    [[nodiscard]] auto num_new() const -> Eigen::Index
+    {
+        return static_cast<Eigen::Index>(new_ids_.size());
+    }
+
+    [[nodiscard]] auto num_snps() const -> Eigen::Index
+    {
+        return bed_.num_snps();
+    }
+
+   private:
+    std::shared_ptr<SampleManager> sample_manager_;
+    BedPipe bed_;
+    // value of each code, per selected variant
+    std::vector<GenotypeCodeTable> tables_;
+    // BED row of each output sample: the GRM's, then the new ones
+    std::vector<Eigen::Index> rows_;
+    Eigen::Index num_old_ = 0;
+    std::vector<std::string> new_ids_;
+
+    // Writes the chunk's values, samples in output order, into `encoded`.
+    auto encode(
+        const ChunkPrefetcher::Chunk& chunk,
+        Eigen::MatrixXd& encoded) const -> void;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GRM_GRM_UPDATE_H_
@@ -23,13 +23,19 @@
 
 #include <Eigen/Core>
 
+#include "gelex/data/grm/grm_loader.h"
+
 namespace gelex
 {
-namespace detail
-{
-class GrmLoader;
-}
 
+/**
+ * @brief LOCO GRMs assembled in place from the mapped GRM files.
+ *
+ * The whole-genome GRM stays a float32 mapping; each chromosome's LOCO GRM
+ * is expanded into the caller's matrix, the chromosome GRM subtracted and
+ * the result scaled in one pass, so no n x n buffer is held besides the
+ * target.
+ */
 class LocoGRMLoader
 {
    public:
@@ -50,7 +56,8 @@ class LocoGRMLoader
      *
      * @param chr_grm_prefix Path prefix for the chromosome-specific GRM files.
      * @param id_map Map for sample IDs to matrix indices.
-     * @param target Output matrix to store the calculated LOCO GRM.
+     * @param target Output matrix to store the calculated LOCO GRM; a
+     *        matrix of the right size is reused without reallocation.
      */
     auto load_loco_grm(
         const std::filesystem::path& chr_grm_prefix,
@@ -62,14 +69,31 @@ class LocoGRMLoader
         const std::unordered_map<std::string, Eigen::Index>& id_map) const
         -> Eigen::MatrixXd;
 
+    /**
+     * @brief Load the LOCO GRM for a chromosome with the constructor's
+     * id_map.
+     *
+     * Chromosome files listing the same samples as the whole-genome file
+     * reuse its sample permutation instead of matching IDs again.
+     */
+    auto load_loco_grm(
+        const std::filesystem::path& chr_grm_prefix,
+        Eigen::MatrixXd& target) const -> void;
+
     [[nodiscard]] auto num_samples() const noexcept -> Eigen::Index;
 
    private:
-    Eigen::MatrixXd
-        g_whole_;           // Pre-filtered unnormalized whole matrix (Z * Z')
-    double k_whole_{};      // K_whole (= trace(g_whole_) / n)
-    double trace_whole_{};  // trace(g_whole_), saved for LOCO calculation
-    mutable Eigen::MatrixXd g_chr_buffer_;  // Buffer for chromosome GRM
+    detail::GrmLoader whole_;             // mapped whole-genome GRM (Z * Z')
+    detail::GrmPermutation permutation_;  // whole GRM file -> target
+    double trace_whole_{};  // trace over the mapped samples, for K_whole
+    std::unordered_map<std::string, Eigen::Index> id_map_;
+
+    // target = (G_whole - G_i) / (K_whole - K_i), G_i read through
+    // chr_permutation
+    auto assemble(
+        const detail::GrmLoader& chr_loader,
+        const detail::GrmPermutation& chr_permutation,
+        Eigen::MatrixXd& target) const -> void;
 };
 
 }  // namespace gelex
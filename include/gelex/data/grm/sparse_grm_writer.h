@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_SPARSE_GRM_WRITER_H_
+#define GELEX_DATA_GRM_SPARSE_GRM_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+// One stored pair of a sparse GRM (.sp.bin); row >= col.
+struct SparseGrmEntry
+{
+    uint32_t row;
+    uint32_t col;
+    float value;
+};
+
+static_assert(sizeof(SparseGrmEntry) == 12);
+
+/**
+ * @brief Writes a GRM as a sparse lower triangle (grm --sparse-cutoff).
+ *
+ * The .sp.bin file is a plain array of SparseGrmEntry, ordered by column
+ * and then row, holding every diagonal entry and the pairs whose value,
+ * divided by trace / n, is above the cutoff. Values are stored unscaled
+ * like the dense .bin, so the kept diagonal still gives the loader the
+ * same trace / n normalization.
+ */
+class SparseGrmWriter
+{
+   public:
+    static constexpr size_t kDefaultBufferSize = static_cast<size_t>(64 * 1024);
+
+    explicit SparseGrmWriter(const std::filesystem::path& file_path);
+
+    SparseGrmWriter(const SparseGrmWriter&) = delete;
+    SparseGrmWriter(SparseGrmWriter&&) noexcept = default;
+    auto operator=(const SparseGrmWriter&) -> SparseGrmWriter& = delete;
+    auto operator=(SparseGrmWriter&&) noexcept -> SparseGrmWriter& = default;
+    ~SparseGrmWriter() = default;
+
+    // Returns the number of off-diagonal pairs kept.
+    auto write(const Eigen::Ref<const Eigen::MatrixXd>& grm, double cutoff)
+        -> size_t;
+
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&
+    {
+        return path_;
+    }
+
+   private:
+    std::filesystem::path path_;
+    std::vector<char> io_buffer_;
+    std::ofstream file_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_DATA_GRM_SPARSE_GRM_WRITER_H_
@@ -29,6 +29,7 @@
 namespace gelex::detail
 {
 
+// Reads a .bim, or a PLINK 2 .pvar (biallelic: A1 = ALT, A2 = REF).
 class BimLoader
 {
    public:
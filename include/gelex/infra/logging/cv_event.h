@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_INFRA_LOGGING_CV_EVENT_H_
+#define GELEX_INFRA_LOGGING_CV_EVENT_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <variant>
+
+namespace gelex
+{
+
+struct CvConfigLoadedEvent
+{
+    std::string method;
+    int n_folds;
+    int n_jobs;
+    int n_iters;
+    int n_burnin;
+    int seed;
+};
+
+struct CvFoldCompleteEvent
+{
+    int fold;
+    std::ptrdiff_t n_train;
+    std::ptrdiff_t n_test;
+    double accuracy;
+    double bias;
+};
+
+struct CvCompleteEvent
+{
+    double mean_accuracy;
+    double mean_bias;
+    double pooled_accuracy;
+    std::string out_prefix;
+};
+
+using CvEvent
+    = std::variant<CvConfigLoadedEvent, CvFoldCompleteEvent, CvCompleteEvent>;
+
+using CvObserver = std::function<void(const CvEvent&)>;
+
+}  // namespace gelex
+
+#endif  // GELEX_INFRA_LOGGING_CV_EVENT_H_
@@ -57,6 +57,7 @@ struct GenotypeLoadedEvent
     bool is_dominance;  // false = Additive, true = Dominance
     int64_t num_snps;
     int64_t monomorphic_snps;
+    bool from_cache = false;  // reused a preprocessed --mmap cache
 };
 
 struct GrmLoadedEvent
@@ -66,6 +66,7 @@ struct FitMcmcCompleteEvent
 struct FitResultsSavedEvent
 {
     std::string out_prefix;
+    std::ptrdiff_t num_predicted{};
 };
 
 using FitEvent = std::variant<
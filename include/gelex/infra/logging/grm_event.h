@@ -50,6 +50,14 @@ struct GrmProgressEvent
     bool done;
 };
 
+// Variants the packed kernel multiplied from bit planes with popcount
+// (`bitwise`) and through expanded double panels (`expanded`).
+struct GrmPackedKernelEvent
+{
+    size_t bitwise;
+    size_t expanded;
+};
+
 struct GrmFilesWrittenEvent
 {
     size_t num_files;
@@ -62,6 +70,7 @@ using GrmEvent = std::variant<
     GrmDataLoadedEvent,
     GrmComputeStartedEvent,
     GrmProgressEvent,
+    GrmPackedKernelEvent,
     GrmFilesWrittenEvent>;
 
 using GrmObserver = std::function<void(const GrmEvent&)>;
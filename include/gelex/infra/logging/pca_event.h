@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_INFRA_LOGGING_PCA_EVENT_H_
+#define GELEX_INFRA_LOGGING_PCA_EVENT_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace gelex
+{
+
+struct PcaConfigLoadedEvent
+{
+    std::string method;
+    size_t num_components;
+    size_t max_iter;
+};
+
+struct PcaDataLoadedEvent
+{
+    size_t num_samples;
+    size_t num_snps;
+};
+
+// One pass over the genotypes; `residual` is the largest relative residual
+// of the leading Ritz pairs (see GenotypePca).
+struct PcaIterationEvent
+{
+    size_t iter;
+    double residual;
+};
+
+struct PcaCompleteEvent
+{
+    std::vector<double> eigenvalues;
+    size_t iterations;
+    bool converged;
+};
+
+struct PcaFilesWrittenEvent
+{
+    std::string eigenvec_path;
+    std::string eigenval_path;
+};
+
+using PcaEvent = std::variant<
+    PcaConfigLoadedEvent,
+    PcaDataLoadedEvent,
+    PcaIterationEvent,
+    PcaCompleteEvent,
+    PcaFilesWrittenEvent>;
+
+using PcaObserver = std::function<void(const PcaEvent&)>;
+
+}  // namespace gelex
+
+#endif  // GELEX_INFRA_LOGGING_PCA_EVENT_H_
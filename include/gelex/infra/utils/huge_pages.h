@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_UTILS_HUGE_PAGES_H_
+#define GELEX_UTILS_HUGE_PAGES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+inline constexpr size_t kHugePageSize = size_t{2} << 20;
+
+enum class HugePageMode : uint8_t
+{
+    None,         // regular pages
+    Transparent,  // madvise(MADV_HUGEPAGE); the kernel may still decline
+    HugeTlb,      // MAP_HUGETLB from the hugetlbfs pool
+};
+
+/**
+ * @brief Asks for transparent huge pages on the 2 MiB-aligned interior of
+ * [data, data + bytes).
+ *
+ * Only effective before the pages are first touched, so call it right after
+ * allocating a large buffer and before filling it. Returns None when the
+ * region is smaller than a huge page or the platform does not support it.
+ */
+auto advise_huge_pages(const void* data, size_t bytes) -> HugePageMode;
+
+template <typename Derived>
+auto advise_huge_pages(Eigen::PlainObjectBase<Derived>& matrix)
+    -> HugePageMode
+{
+    return advise_huge_pages(
+        matrix.data(),
+        static_cast<size_t>(matrix.size())
+            * sizeof(typename Derived::Scalar));
+}
+
+/**
+ * @brief Zero-initialised buffer aligned to a huge page.
+ *
+ * Requests at least one huge page come from hugetlbfs when its pool can
+ * reserve them, otherwise from an anonymous mapping advised for transparent
+ * huge pages. Elsewhere, and for small requests, it falls back to a 64-byte
+ * aligned allocation. Throws std::bad_alloc when no memory is available.
+ */
+class HugePageBuffer
+{
+   public:
+    HugePageBuffer() = default;
+    explicit HugePageBuffer(size_t bytes);
+
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+    HugePageBuffer(HugePageBuffer&& other) noexcept;
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept;
+    ~HugePageBuffer();
+
+    [[nodiscard]] auto data() noexcept -> void* { return data_; }
+    [[nodiscard]] auto data() const noexcept -> const void* { return data_; }
+    [[nodiscard]] auto size() const noexcept -> size_t { return bytes_; }
+    [[nodiscard]] auto mode() const noexcept -> HugePageMode { return mode_; }
+
+   private:
+    void* data_{nullptr};
+    size_t bytes_{0};
+    // length of the mapping; 0 when allocated with operator new
+    size_t mapped_{0};
+    HugePageMode mode_{HugePageMode::None};
+
+    auto release() noexcept -> void;
+};
+
+// Column-major double matrix stored in a HugePageBuffer, first touched
+// by numa_first_touch().
+class HugePageMatrix
+{
+   public:
+    using MapType = Eigen::Map<Eigen::MatrixXd, Eigen::Aligned64>;
+    using ConstMapType = Eigen::Map<const Eigen::MatrixXd, Eigen::Aligned64>;
+
+    HugePageMatrix() = default;
+    HugePageMatrix(Eigen::Index rows, Eigen::Index cols);
+
+    [[nodiscard]] auto map() noexcept -> MapType
+    {
+        return {static_cast<double*>(buffer_.data()), rows_, cols_};
+    }
+    [[nodiscard]] auto map() const noexcept -> ConstMapType
+    {
+        return {static_cast<const double*>(buffer_.data()), rows_, cols_};
+    }
+
+    [[nodiscard]] auto rows() const noexcept -> Eigen::Index { return rows_; }
+    [[nodiscard]] auto cols() const noexcept -> Eigen::Index { return cols_; }
+    [[nodiscard]] auto mode() const noexcept -> HugePageMode
+    {
+        return buffer_.mode();
+    }
+
+   private:
+    HugePageBuffer buffer_;
+    Eigen::Index rows_{0};
+    Eigen::Index cols_{0};
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_UTILS_HUGE_PAGES_H_
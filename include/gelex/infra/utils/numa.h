@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_UTILS_NUMA_H_
+#define GELEX_UTILS_NUMA_H_
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+enum class NumaPolicy : uint8_t
+{
+    None,        // pages land on the node of the thread that first writes
+    Interleave,  // pages spread round-robin over all nodes
+    Partition,   // contiguous column blocks bound to successive nodes
+};
+
+// "none", "interleave" or "partition"; throws ArgumentValidationException.
+auto parse_numa_policy(std::string_view text) -> NumaPolicy;
+
+// Process-wide, like the OpenMP thread count; set once by the CLI.
+auto set_numa_policy(NumaPolicy policy) -> void;
+auto numa_policy() -> NumaPolicy;
+
+// Online NUMA nodes; a single node 0 where the topology is unknown.
+auto numa_nodes() -> const std::vector<int>&;
+
+/**
+ * @brief Zero-fills a freshly allocated column-major buffer, placing its
+ * pages by the active policy.
+ *
+ * The fill runs in parallel with a static schedule over columns, the same
+ * partition the decode and scan loops use, so under the default policy each
+ * thread's columns are first touched, and hence allocated, on its own node.
+ * Interleave and Partition additionally mbind() the range before the fill.
+ * Partition gives node k the k-th of len(nodes) equal column blocks, which
+ * matches static scheduling when threads are spread over nodes in order
+ * (OMP_PROC_BIND=spread). On a single node only the parallel fill remains.
+ */
+auto numa_first_touch(double* data, Eigen::Index rows, Eigen::Index cols)
+    -> void;
+
+template <typename Derived>
+auto numa_first_touch(Eigen::PlainObjectBase<Derived>& matrix) -> void
+{
+    static_assert(std::is_same_v<typename Derived::Scalar, double>);
+    numa_first_touch(matrix.data(), matrix.rows(), matrix.cols());
+}
+
+}  // namespace gelex
+
+#endif  // GELEX_UTILS_NUMA_H_
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_UTILS_QUANTILE_SKETCH_H_
+#define GELEX_UTILS_QUANTILE_SKETCH_H_
+
+#include <array>
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace gelex
+{
+
+/**
+ * @brief Streaming P² estimate of one quantile for many parameters at once.
+ *
+ * Each parameter keeps five marker heights and positions (Jain & Chlamtac,
+ * 1985), so memory is O(n_params) no matter how many draws are pushed. The
+ * first five draws are kept exactly and the result is exact until then.
+ */
+class QuantileSketch
+{
+   public:
+    QuantileSketch() = default;
+    QuantileSketch(Eigen::Index n_params, double prob);
+
+    auto update(const Eigen::Ref<const Eigen::VectorXd>& draw) -> void;
+
+    auto result() const -> Eigen::VectorXd;
+
+    auto prob() const -> double { return prob_; }
+    auto count() const -> std::size_t { return count_; }
+    auto size() const -> Eigen::Index { return heights_.cols(); }
+
+   private:
+    static constexpr int kMarkers = 5;
+    using Markers = Eigen::Matrix<double, kMarkers, Eigen::Dynamic>;
+
+    auto adjust(Eigen::Index param, const std::array<double, kMarkers>& desired)
+        -> void;
+
+    double prob_{0.5};
+    std::size_t count_{0};
+    std::array<double, kMarkers> increments_{};
+    Markers heights_;
+    Markers positions_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_UTILS_QUANTILE_SKETCH_H_
@@ -27,6 +27,7 @@ template <typename T>
 concept EncodePolicy
     = requires(T policy, Eigen::Ref<Eigen::VectorXd>& locus, double maf) {
           { T::encode(locus, maf) } -> std::same_as<void>;
+          { T::encode_value(maf, maf) } -> std::same_as<double>;
       };
 
 template <gelex::GeneticEffectType GT>
@@ -42,15 +43,22 @@ struct RawPolicy
         {
             locus = locus.unaryExpr(
                 [](double element) -> double
-                {
-                    if (element == 2.0)
-                    {
-                        return 0;
-                    }
-                    return element;
-                });
+                { return encode_value(element, 0.0); });
         }
     };
+
+    static constexpr auto encode_value(double dosage, double /*maf*/)
+        -> double
+    {
+        if constexpr (GT == gelex::GeneticEffectType::Dom)
+        {
+            if (dosage == 2.0)
+            {
+                return 0;
+            }
+        }
+        return dosage;
+    }
 };
 
 template <gelex::GeneticEffectType GT>
@@ -65,19 +73,25 @@ struct OrthogonalPolicy
         {
             locus = locus.unaryExpr(
                 [maf](double element) -> double
-                {
-                    if (element == 2.0)
-                    {
-                        return (4 * maf) - 2;
-                    }
-                    if (element == 1.0)
-                    {
-                        return 2 * maf;
-                    }
-                    return element;
-                });
+                { return encode_value(element, maf); });
         }
     };
+
+    static constexpr auto encode_value(double dosage, double maf) -> double
+    {
+        if constexpr (GT == gelex::GeneticEffectType::Dom)
+        {
+            if (dosage == 2.0)
+            {
+                return (4 * maf) - 2;
+            }
+            if (dosage == 1.0)
+            {
+                return 2 * maf;
+            }
+        }
+        return dosage;
+    }
 };
 }  // namespace gelex::detail
 #endif  // GELEX_INTERNAL_GENOTYPE_PROCESSOR_ENCODE_POLICY_H_
@@ -17,6 +17,8 @@
 #ifndef GELEX_INTERNAL_GENOTYPE_PROCESSOR_GENOTYPE_PROCESSOR_H_
 #define GELEX_INTERNAL_GENOTYPE_PROCESSOR_GENOTYPE_PROCESSOR_H_
 
+#include <limits>
+
 #include <Eigen/Dense>
 
 #include "gelex/internal/genotype_processor/encode_policy.h"
@@ -56,6 +58,49 @@ struct GenotypeProcessorStrategy
         }
         return stats;
     }
+
+    // Same statistics and output as `process`, derived from the code counts
+    // of a locus alone: every sample carrying a code ends up with the same
+    // value, so the locus is never materialized before it is final.
+    static auto plan(const GenotypeCodeCounts& counts) -> LocusPlan
+    {
+        const auto total = counts[0] + counts[1] + counts[2] + counts[3];
+        const auto valid_count
+            = static_cast<double>(total - counts[kMissingGenotypeCode]);
+        if (valid_count <= 0)
+        {
+            constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+            return LocusPlan{LocusStatistic{}, {nan, nan, nan, nan}};
+        }
+        LocusStatistic stats{};
+        stats.maf = (static_cast<double>(counts[0]) * 2.0
+                     + static_cast<double>(counts[2]))
+                    / (2.0 * valid_count);
+
+        GenotypeCodeTable encoded{};
+        for (uint8_t code = 0; code < 4; ++code)
+        {
+            encoded[code]
+                = Encode::encode_value(kGenotypeDosages[code], stats.maf);
+        }
+        Stats::summarize(LocusCounts{counts, encoded, valid_count}, stats);
+
+        LocusPlan result{stats, {}};
+        for (uint8_t code = 0; code < 4; ++code)
+        {
+            result.values[code] = code == kMissingGenotypeCode
+                                      ? 0.0
+                                      : encoded[code] - stats.mean;
+            if constexpr (Scale)
+            {
+                if (!stats.is_monomorphic)
+                {
+                    result.values[code] /= stats.stddev;
+                }
+            }
+        }
+        return result;
+    }
 };
 
 }  // namespace gelex::detail
@@ -32,11 +32,24 @@ struct LocusContext
     double valid_count;
 };
 
+// Code-count view of a locus: `encoded` holds the encoded value of each
+// genotype code, `counts` how many samples carry it.
+struct LocusCounts
+{
+    const GenotypeCodeCounts& counts;
+    const GenotypeCodeTable& encoded;
+    double valid_count;
+};
+
 template <typename T>
-concept StatisticPolicy
-    = requires(T policy, LocusContext& locus, LocusStatistic& statistic) {
-          { T::process(locus, statistic) } -> std::same_as<void>;
-      };
+concept StatisticPolicy = requires(
+    T policy,
+    LocusContext& locus,
+    const LocusCounts& counts,
+    LocusStatistic& statistic) {
+    { T::process(locus, statistic) } -> std::same_as<void>;
+    { T::summarize(counts, statistic) } -> std::same_as<void>;
+};
 
 constexpr double MONOMORPHIC_TOL = 1e-10;
 
@@ -50,6 +63,39 @@ struct SamplePolicy
         stddev(context, statistic);
     }
 
+    static auto summarize(const LocusCounts& locus, LocusStatistic& statistic)
+        -> void
+    {
+        double sum = 0.0;
+        for (uint8_t code = 0; code < 4; ++code)
+        {
+            if (code != kMissingGenotypeCode)
+            {
+                sum += static_cast<double>(locus.counts[code])
+                       * locus.encoded[code];
+            }
+        }
+        statistic.mean = GT == GeneticEffectType::Add
+                             ? statistic.maf * 2.0
+                             : sum / locus.valid_count;
+
+        double square_sum = 0.0;
+        for (uint8_t code = 0; code < 4; ++code)
+        {
+            if (code != kMissingGenotypeCode)
+            {
+                const double diff = locus.encoded[code] - statistic.mean;
+                square_sum
+                    += static_cast<double>(locus.counts[code]) * diff * diff;
+            }
+        }
+        statistic.stddev = std::sqrt(square_sum / (locus.valid_count - 1.0));
+        if (statistic.stddev < MONOMORPHIC_TOL)
+        {
+            statistic.is_monomorphic = true;
+        }
+    }
+
    private:
     static auto center(LocusContext& context, LocusStatistic& statistic) -> void
     {
@@ -85,27 +131,39 @@ struct HWEPolicy
         -> void
     {
         center(context, statistic);
-        stddev(context, statistic);
+        stddev(statistic);
+    }
+
+    static auto summarize(
+        const LocusCounts& /*locus*/,
+        LocusStatistic& statistic) -> void
+    {
+        statistic.mean = mean(statistic.maf);
+        stddev(statistic);
     }
 
    private:
-    static auto center(LocusContext& context, LocusStatistic& statistic) -> void
+    static auto mean(double maf) -> double
     {
         if constexpr (g_type == GeneticEffectType::Add)
         {
-            statistic.mean = statistic.maf * 2.0;
+            return maf * 2.0;
         }
         else
         {
-            statistic.mean = 2 * (1 - statistic.maf) * statistic.maf;
+            return 2 * (1 - maf) * maf;
         }
+    }
+
+    static auto center(LocusContext& context, LocusStatistic& statistic) -> void
+    {
+        statistic.mean = mean(statistic.maf);
         context.locus
             = context.nan_mask.select(statistic.mean, context.locus).array()
               - statistic.mean;
     };
 
-    static auto stddev(LocusContext& /*context*/, LocusStatistic& statistic)
-        -> void
+    static auto stddev(LocusStatistic& statistic) -> void
     {
         if constexpr (g_type == GeneticEffectType::Add)
         {
@@ -134,27 +192,39 @@ struct OrthHWEPolicy
         -> void
     {
         center(context, statistic);
-        stddev(context, statistic);
+        stddev(statistic);
+    }
+
+    static auto summarize(
+        const LocusCounts& /*locus*/,
+        LocusStatistic& statistic) -> void
+    {
+        statistic.mean = mean(statistic.maf);
+        stddev(statistic);
     }
 
    private:
-    static auto center(LocusContext& context, LocusStatistic& statistic) -> void
+    static auto mean(double maf) -> double
     {
         if constexpr (g_type == GeneticEffectType::Add)
         {
-            statistic.mean = statistic.maf * 2.0;
+            return maf * 2.0;
         }
         else
         {
-            statistic.mean = 2.0 * statistic.maf * statistic.maf;
+            return 2.0 * maf * maf;
         }
+    }
+
+    static auto center(LocusContext& context, LocusStatistic& statistic) -> void
+    {
+        statistic.mean = mean(statistic.maf);
         context.locus
             = context.nan_mask.select(statistic.mean, context.locus).array()
               - statistic.mean;
     };
 
-    static auto stddev(LocusContext& /*context*/, LocusStatistic& statistic)
-        -> void
+    static auto stddev(LocusStatistic& statistic) -> void
     {
         double dominance_stddev = 2.0 * statistic.maf * (1.0 - statistic.maf);
 
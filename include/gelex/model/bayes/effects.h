@@ -25,6 +25,7 @@
 
 #include "gelex/data/genotype/genotype_matrix.h"
 #include "gelex/data/genotype/genotype_mmap.h"
+#include "gelex/data/genotype/genotype_view.h"
 #include "gelex/model/bayes/distribution.h"
 #include "gelex/types/fixed_effects.h"
 
@@ -33,7 +34,8 @@ namespace gelex
 namespace bayes
 {
 
-using GenotypeStorage = std::variant<GenotypeMap, GenotypeMatrix>;
+using GenotypeStorage
+    = std::variant<GenotypeMap, GenotypeMatrix, GenotypeView>;
 
 inline Eigen::Ref<const Eigen::MatrixXd> get_matrix_ref(
     const GenotypeStorage& storage)
@@ -142,6 +144,13 @@ struct GeneticEffect
         cols_norm = get_matrix_ref(this->X).colwise().squaredNorm();
     }
 
+    // Shares another effect's genotypes; `cols_norm` must match the rows
+    // that actually enter the likelihood.
+    GeneticEffect(GenotypeView X, Eigen::VectorXd cols_norm)
+        : X(std::move(X)), cols_norm(std::move(cols_norm))
+    {
+    }
+
     GenotypeStorage X;
     Eigen::VectorXd cols_norm;
 
@@ -235,6 +244,10 @@ struct ResidualState
 {
     Eigen::VectorXd y_adj;
     double variance{0.0};
+
+    // Rows excluded from the likelihood (cross-validation). Their y_adj
+    // entries are not kept at zero; every read over the residual skips them.
+    std::vector<Eigen::Index> held_out;
 };
 
 }  // namespace bayes
@@ -18,6 +18,7 @@
 #define GELEX_MODEL_BAYES_MODEL_H_
 
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,11 @@ class BayesModel
    public:
     BayesModel(PhenoPipe& pheno_pipe, GenoPipe& geno_pipe);
 
+    // Cross-validation fold of `full`: genotypes are shared through a
+    // GenotypeView and `held_out` rows are masked out of the likelihood.
+    // `full` must outlive the fold model.
+    BayesModel(const BayesModel& full, std::span<const Eigen::Index> held_out);
+
     const FixedEffect* fixed() const { return &fixed_; }
 
     FixedEffect* fixed() { return &fixed_; }
@@ -70,6 +76,7 @@ class BayesModel
 
     double phenotype_variance() const { return phenotype_var_; }
     Eigen::Index num_individuals() const { return num_individuals_; }
+    const std::vector<Eigen::Index>& held_out() const { return held_out_; }
 
    private:
     void add_additive(GenotypeMap&& matrix);
@@ -86,6 +93,7 @@ class BayesModel
     double phenotype_var_{};
 
     Eigen::VectorXd phenotype_;
+    std::vector<Eigen::Index> held_out_;
 
     FixedEffect fixed_;
     std::vector<bayes::RandomEffect> random_;
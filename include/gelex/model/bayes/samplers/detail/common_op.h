@@ -29,6 +29,7 @@
 #include <Eigen/Core>
 
 #include "gelex/infra/utils/math_utils.h"
+#include "gelex/model/bayes/effects.h"
 
 namespace gelex::detail
 {
@@ -82,7 +83,7 @@ inline void blas_daxpy(
 }
 
 inline auto update_residual_and_gebv(
-    Eigen::Ref<Eigen::VectorXd> y_adj,
+    bayes::ResidualState& residual,
     Eigen::Ref<Eigen::VectorXd> gebv,
     const Eigen::Ref<const Eigen::VectorXd>& col,
     double old_value,
@@ -91,11 +92,26 @@ inline auto update_residual_and_gebv(
     const double diff = old_value - new_value;
     if (fabs(diff) > std::numeric_limits<double>::epsilon())
     {
-        blas_daxpy(diff, col, y_adj);
+        blas_daxpy(diff, col, residual.y_adj);
         blas_daxpy(-diff, col, gebv);
     }
 }
 
+// X'y_adj over the training rows. Held-out rows of y_adj follow the marker
+// updates like any other row and are masked here instead.
+template <typename DerivedX>
+inline auto residual_dot(
+    const Eigen::DenseBase<DerivedX>& col,
+    const bayes::ResidualState& residual) -> double
+{
+    double rhs = blas_ddot(col, residual.y_adj);
+    for (const Eigen::Index row : residual.held_out)
+    {
+        rhs -= col.derived().coeff(row) * residual.y_adj(row);
+    }
+    return rhs;
+}
+
 inline auto compute_likelihood_params(
     double rhs,
     double marker_variance,
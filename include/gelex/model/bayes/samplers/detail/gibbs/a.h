@@ -34,7 +34,6 @@ auto A(
     bayes::ResidualState& residual,
     std::mt19937_64& rng) -> void
 {
-    auto& y_adj = residual.y_adj;
     const double residual_variance = residual.variance;
 
     Eigen::VectorXd& coeffs = state.coeffs;
@@ -59,7 +58,7 @@ auto A(
             = 1 / (cols_norm(i) + residual_variance / sigma(i));
 
         // calculate the posterior mean and standard deviation
-        const double rhs = blas_ddot(col, y_adj) + (cols_norm(i) * old_i);
+        const double rhs = residual_dot(col, residual) + (cols_norm(i) * old_i);
         const double post_mean = rhs * percision_kernel;
         const double post_stddev = sqrt(residual_variance * percision_kernel);
 
@@ -69,7 +68,7 @@ auto A(
 
         chi_squared.compute(new_i * new_i);
         sigma(i) = chi_squared(rng);
-        update_residual_and_gebv(y_adj, u, col, old_i, new_i);
+        update_residual_and_gebv(residual, u, col, old_i, new_i);
     }
     state.variance = detail::var(state.u)(0);
 }
@@ -34,7 +34,6 @@ auto R(
     bayes::ResidualState& residual,
     std::mt19937_64& rng) -> void
 {
-    auto& y_adj = residual.y_adj;
     const double residual_variance = residual.variance;
 
     const Eigen::VectorXd logpi = state.pi.prop.array().log();
@@ -66,7 +65,7 @@ auto R(
         const double old_i = coeffs(i);
         const auto& col = X.col(i);
 
-        double rhs = blas_ddot(col, y_adj);
+        double rhs = residual_dot(col, residual);
         if (old_i != 0.0)
         {
             rhs += cols_norm(i) * old_i;
@@ -105,12 +104,12 @@ auto R(
                 = std::sqrt(residual_variance * params.precision_kernel);
 
             new_i = (normal(rng) * post_stddev) + post_mean;
-            update_residual_and_gebv(y_adj, u, col, old_i, new_i);
+            update_residual_and_gebv(residual, u, col, old_i, new_i);
             sum_square_coeffs += (new_i * new_i) / (*effect.scale)(dist_index);
         }
         else if (old_i != 0.0)
         {
-            update_residual_and_gebv(y_adj, u, col, old_i, 0.0);
+            update_residual_and_gebv(residual, u, col, old_i, 0.0);
         }
         coeffs(i) = new_i;
 
@@ -34,7 +34,6 @@ auto RR(
     bayes::ResidualState& residual,
     std::mt19937_64& rng) -> void
 {
-    auto& y_adj = residual.y_adj;
     const double residual_variance = residual.variance;
 
     Eigen::VectorXd& coeff = state.coeffs;
@@ -60,13 +59,13 @@ auto RR(
         const double v = cols_norm(i) + residual_over_var;
         const double inv_v = 1.0 / v;
 
-        const double rhs = blas_ddot(col, y_adj) + (cols_norm(i) * old_i);
+        const double rhs = residual_dot(col, residual) + (cols_norm(i) * old_i);
         const double post_mean = rhs * inv_v;
         const double post_stddev = sqrt_residual_variance * std::sqrt(inv_v);
 
         const double new_i = (normal(rng) * post_stddev) + post_mean;
         coeff(i) = new_i;
-        update_residual_and_gebv(y_adj, u, col, old_i, new_i);
+        update_residual_and_gebv(residual, u, col, old_i, new_i);
     }
     state.variance = detail::var(state.u)(0);
 
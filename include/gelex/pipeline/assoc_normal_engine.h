@@ -21,6 +21,7 @@
 #include <string>
 
 #include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/infra/logging/assoc_event.h"
 #include "gelex/infra/logging/reml_event.h"
 #include "gelex/types/genetic_effect_type.h"
@@ -46,6 +47,8 @@ class AssocNormalEngine
 
         std::filesystem::path bed_path;
         std::string out_prefix;
+
+        VariantFilter variant_filter;
     };
 
     explicit AssocNormalEngine(Config config);
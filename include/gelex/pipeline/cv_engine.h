@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_PIPELINE_CV_ENGINE_H_
+#define GELEX_PIPELINE_CV_ENGINE_H_
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/infra/logging/cv_event.h"
+#include "gelex/pipeline/fit_engine.h"
+
+namespace gelex
+{
+class PhenoPipe;
+class GenoPipe;
+
+/**
+ * @brief K-fold cross-validation of a BayesAlphabet model.
+ *
+ * Genotypes are decoded once; every fold builds a BayesModel that views the
+ * shared genotype store and masks its test rows out of the likelihood. Folds
+ * run concurrently, each on a single-threaded MCMC chain.
+ */
+class CvEngine
+{
+   public:
+    struct Config
+    {
+        FitEngine::Config fit;
+        int n_folds = 5;
+        int n_jobs = 1;
+    };
+
+    explicit CvEngine(Config config);
+    auto run(
+        PhenoPipe&& pheno,
+        GenoPipe&& geno,
+        const CvObserver& observer = {}) -> void;
+
+    // Random, balanced fold label per sample in [0, n_folds).
+    static auto assign_folds(Eigen::Index n_samples, int n_folds, int seed)
+        -> std::vector<int>;
+
+   private:
+    Config config_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_PIPELINE_CV_ENGINE_H_
@@ -17,6 +17,7 @@
 #ifndef GELEX_PIPELINE_FIT_ENGINE_H_
 #define GELEX_PIPELINE_FIT_ENGINE_H_
 
+#include <filesystem>
 #include <optional>
 #include <string>
 #include <vector>
@@ -29,6 +30,8 @@ namespace gelex
 {
 class PhenoPipe;
 class GenoPipe;
+enum class GenotypeProcessMethod : uint8_t;
+
 class FitEngine
 {
    public:
@@ -46,6 +49,10 @@ class FitEngine
         std::optional<std::vector<double>> dscale;
 
         std::string out_prefix;
+
+        // Target individuals scored inside the chain; empty disables it.
+        std::filesystem::path predict_bed_path;
+        GenotypeProcessMethod genotype_method{};
     };
 
     explicit FitEngine(Config config);
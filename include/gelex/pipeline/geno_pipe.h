@@ -21,12 +21,14 @@
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "gelex/data/genotype/genotype_loader.h"
 #include "gelex/data/genotype/genotype_matrix.h"
 #include "gelex/data/genotype/genotype_mmap.h"
 #include "gelex/data/genotype/genotype_pipe.h"
 #include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/infra/logging/data_pipe_event.h"
 #include "gelex/types/genetic_effect_type.h"
 
@@ -48,6 +50,8 @@ class GenoPipe
         int chunk_size = 10000;
 
         std::string output_prefix;
+
+        VariantFilter variant_filter;
     };
 
     explicit GenoPipe(const Config& config, DataPipeObserver observer = {});
@@ -74,40 +78,49 @@ class GenoPipe
         return dominance_matrix_ != nullptr;
     }
 
+    // Raw indices of the variants kept by the filter; empty when unfiltered.
+    auto selected_variants() const -> const std::vector<Eigen::Index>&
+    {
+        return variants_;
+    }
+
    private:
     using GenotypeMatrixPtr
         = std::unique_ptr<std::variant<GenotypeMap, GenotypeMatrix>>;
 
+    // Returns true when a matching on-disk cache was reused.
     template <GeneticEffectType GT>
     auto load_genotype_impl(
         const std::string& suffix,
         GenotypeProcessMethod method,
-        GenotypeMatrixPtr& target) -> void
+        GenotypeMatrixPtr& target) -> bool
     {
         if (config_.use_mmap)
         {
             std::string file_path = config_.output_prefix + suffix;
             auto pipe = gelex::GenotypePipe(
-                config_.bed_path, sample_manager_, file_path);
+                config_.bed_path, sample_manager_, file_path, variants_);
             target
                 = std::make_unique<std::variant<GenotypeMap, GenotypeMatrix>>(
                     pipe.process<GT>(method, config_.chunk_size));
+            return pipe.reused_cache();
         }
-        else
-        {
-            auto loader
-                = gelex::GenotypeLoader(config_.bed_path, sample_manager_);
-            target
-                = std::make_unique<std::variant<GenotypeMap, GenotypeMatrix>>(
-                    loader.process<GT>(method, config_.chunk_size));
-        }
+
+        auto loader = gelex::GenotypeLoader(
+            config_.bed_path, sample_manager_, variants_);
+        target = std::make_unique<std::variant<GenotypeMap, GenotypeMatrix>>(
+            loader.process<GT>(method, config_.chunk_size));
+        return false;
     }
 
     auto load_additive_matrix() -> void;
     auto load_dominance_matrix() -> void;
 
+    auto resolve_variants() -> void;
+
     Config config_;
     std::shared_ptr<SampleManager> sample_manager_;
+    std::vector<Eigen::Index> variants_;
     GenotypeMatrixPtr additive_matrix_;
     GenotypeMatrixPtr dominance_matrix_;
     DataPipeObserver observer_;
@@ -18,9 +18,12 @@
 #define GELEX_PIPELINE_GRM_GRM_ENGINE_H_
 
 #include <filesystem>
+#include <optional>
 #include <string>
 
 #include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/genotype/variant_filter.h"
+#include "gelex/data/grm/grm.h"
 #include "gelex/infra/logging/grm_event.h"
 #include "gelex/types/freq_effect.h"
 
@@ -40,6 +43,42 @@ class GrmEngine
 
         std::string out_prefix;
         int chunk_size;
+
+        VariantFilter variant_filter;
+        GrmPrecision precision = GrmPrecision::Double;
+        GrmKernel kernel = GrmKernel::Dense;
+
+        // LOCO: write each chromosome's GRM in the background while the
+        // next one accumulates, at the cost of a third n x n buffer
+        bool overlap_writes = true;
+
+        // --add --dom without LOCO: accumulate both GRMs from one decode
+        // of each chunk, at the cost of a second n x n accumulator
+        bool fuse_effects = true;
+
+        // --part i/N: only the i-th (1-based) of N balanced row slices,
+        // written under grm_part_prefix(); 0 parts is the whole matrix
+        int part_index = 0;
+        int num_parts = 0;
+
+        // write <out>.sp.bin (SparseGrmWriter) keeping the pairs whose
+        // value over trace / n is above this, instead of the dense .bin
+        std::optional<double> sparse_cutoff;
+
+        // also write <out>.<type>.eig, the eigendecomposition of each
+        // whole-genome dense GRM (see decompose_grm)
+        bool eigen = false;
+
+        // also write the epistatic kernels <out>.{aa,ad,dd}: Hadamard
+        // products of the scaled A and D GRMs of the run, A x D and D x D
+        // needing both effects
+        bool epistasis = false;
+
+        // grm --update: extend <update_prefix>.<type> with the BED samples
+        // it lacks into <out_prefix>.<type> (see GrmUpdater); variants and
+        // encodings come from its .loci, so method and variant_filter do
+        // not apply
+        std::filesystem::path update_prefix;
     };
 
     explicit GrmEngine(Config config);
@@ -48,6 +87,8 @@ class GrmEngine
 
    private:
     Config config_;
+
+    auto update(const GrmObserver& observer) -> void;
 };
 
 }  // namespace gelex
@@ -17,6 +17,7 @@
 #ifndef GELEX_PIPELINE_GRM_PIPE_H_
 #define GELEX_PIPELINE_GRM_PIPE_H_
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <span>
@@ -49,8 +50,13 @@ class GrmPipe
 
     auto sample_id_sets() const -> std::vector<std::span<const std::string>>;
 
+    // Sparse GRM files are loaded into GeneticEffect::K_sparse.
     auto load(const std::shared_ptr<SampleManager>& sample_manager) -> void;
 
+    // Stored lower-triangle entries over the sparse GRM files; 0 when all
+    // are dense.
+    auto num_sparse_entries() const -> size_t;
+
     auto take_grms() && -> std::vector<freq::GeneticEffect>
     {
         return std::move(grms_);
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_PIPELINE_MEMORY_PLANNER_H_
+#define GELEX_PIPELINE_MEMORY_PLANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/algo/infer/params.h"
+#include "gelex/data/grm/grm_part.h"
+
+namespace gelex
+{
+
+enum class MemoryWorkload : uint8_t
+{
+    Fit,    // fit and cv: genotype matrix plus MCMC draws
+    Grm,    // one n x n accumulator at a time plus decode chunks
+    Assoc,  // loaded GRMs, the REML workspace and test chunks
+    Pca,    // decode chunks plus a few n x (k + oversampling) blocks
+};
+
+// Dimensions and settings a command is about to run with.
+struct MemoryRequest
+{
+    MemoryWorkload workload = MemoryWorkload::Fit;
+    Eigen::Index num_samples = 0;
+    Eigen::Index num_snps = 0;
+
+    Eigen::Index chunk_size = 10000;
+    // false when the user fixed --chunk-size; the planner then keeps it
+    bool auto_chunk_size = true;
+
+    // Fit: additive always, dominance optionally
+    bool dominance = false;
+    bool use_mmap = false;
+    Eigen::Index num_records = 0;
+    // mixture components per marker; 0 for non-mixture priors
+    Eigen::Index num_components = 0;
+    // chains held at once (cv --jobs)
+    int num_chains = 1;
+    // Full only when the per-draw matrices are asked for
+    SampleStorage sample_storage = SampleStorage::Streaming;
+
+    // Grm: matrices per run (2 with --add --dom); Assoc: GRMs loaded (plus
+    // dominance tests)
+    int num_grms = 1;
+    // Grm: whole-genome plus per-chromosome GRMs from one pass
+    bool loco = false;
+    // Grm: float chunks and a float n x n chunk product
+    bool mixed_precision = false;
+    // Grm: chunks held as 2-bit codes (packed kernel); overrides the above
+    bool packed_codes = false;
+    // Grm: the --part slice computed instead of the whole matrix
+    std::optional<GrmPart> part;
+    // Grm: dsyevd workspace for --eigen, the accumulator becoming the
+    // eigenvectors
+    bool eigen = false;
+    // Grm: --epistasis, which without fusion keeps the additive GRM until
+    // the dominance one is done
+    bool epistasis = false;
+    // Assoc: lower-triangle entries stored by sparse GRMs (.sp.bin); when
+    // set, the sparse REML replaces the n x n GRMs and workspace
+    size_t sparse_grm_entries = 0;
+    // Pca: components plus oversampling, the width of the subspace
+    Eigen::Index pca_width = 0;
+
+    std::optional<size_t> limit_bytes;
+};
+
+struct MemoryItem
+{
+    std::string label;
+    size_t bytes = 0;
+};
+
+struct MemoryPlan
+{
+    MemoryWorkload workload = MemoryWorkload::Fit;
+    bool use_mmap = false;
+    Eigen::Index chunk_size = 0;
+    SampleStorage sample_storage = SampleStorage::Streaming;
+    // Grm with loco: write chromosome GRMs while the next one accumulates
+    bool overlap_writes = false;
+    // Grm with two matrices and no loco: accumulate both in one pass
+    bool fuse_effects = false;
+
+    std::vector<MemoryItem> items;
+    size_t peak_bytes = 0;
+    std::optional<size_t> limit_bytes;
+
+    [[nodiscard]] auto fits() const -> bool
+    {
+        return !limit_bytes || peak_bytes <= *limit_bytes;
+    }
+};
+
+/**
+ * @brief Estimates peak memory for a request and, under a limit, picks the
+ * cheapest settings that fit.
+ *
+ * The estimate sums the large buffers of the workload, so it is an upper
+ * bound on what the command allocates rather than a measurement. Without a
+ * limit the requested settings are kept and only estimated. With one, the
+ * planner relaxes them in order of cost to the run: streaming MCMC draw
+ * storage when full draws were requested (same summaries), memory-mapped genotypes, synchronous LOCO GRM
+ * writes, one pass per GRM instead of fused additive and dominance ones,
+ * then smaller chunks (down to kMinChunkSize, and only when the chunk size
+ * is not fixed). If
+ * nothing fits the plan reports the smallest configuration with fits()
+ * false and leaves the decision to the caller.
+ */
+auto plan_memory(const MemoryRequest& request) -> MemoryPlan;
+
+// "512M", "16G", "1.5T" or a plain byte count; binary units.
+auto parse_memory_size(std::string_view text) -> size_t;
+
+// 1536 -> "1.50 KiB"
+auto format_memory_size(size_t bytes) -> std::string;
+
+inline constexpr Eigen::Index kMinChunkSize = 256;
+
+}  // namespace gelex
+
+#endif  // GELEX_PIPELINE_MEMORY_PLANNER_H_
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_PIPELINE_PCA_ENGINE_H_
+#define GELEX_PIPELINE_PCA_ENGINE_H_
+
+#include <filesystem>
+#include <string>
+
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/genotype/variant_filter.h"
+#include "gelex/data/grm/genotype_pca.h"
+#include "gelex/infra/logging/pca_event.h"
+
+namespace gelex
+{
+
+// Writes <out>.eigenvec (FID, IID, PC1..PCk; a --qcovar file) and
+// <out>.eigenval (one eigenvalue of the GRM per line).
+class PcaEngine
+{
+   public:
+    struct Config
+    {
+        std::filesystem::path bed_path;
+        GenotypeProcessMethod method;
+
+        std::string out_prefix;
+        int chunk_size;
+
+        VariantFilter variant_filter;
+        GenotypePca::Options options;
+    };
+
+    explicit PcaEngine(Config config);
+
+    auto compute(const PcaObserver& observer = {}) -> void;
+
+   private:
+    Config config_;
+};
+
+}  // namespace gelex
+
+#endif  // GELEX_PIPELINE_PCA_ENGINE_H_
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "gelex/algo/sim/effect_sampler.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/infra/logging/simulate_event.h"
 
 namespace gelex
@@ -44,6 +45,8 @@ class PhenotypeSimulationEngine
         std::vector<EffectSizeClass> dom_effect_classes;
 
         int seed;
+
+        VariantFilter variant_filter;
     };
 
     explicit PhenotypeSimulationEngine(Config config);
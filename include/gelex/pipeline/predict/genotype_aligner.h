@@ -30,7 +30,9 @@ class GenotypeAligner
         const std::filesystem::path& bed_path,
         const SnpEffects& snp_effects);
 
-    auto align(Eigen::MatrixXd&& raw_genotype) const -> Eigen::MatrixXd;
+    // Model SNPs missing from the target BIM are filled with `unmatched`.
+    auto align(Eigen::MatrixXd&& raw_genotype, double unmatched = 0.0) const
+        -> Eigen::MatrixXd;
 
    private:
     MatchPlan match_plan_;
@@ -18,6 +18,10 @@
 #define GELEX_ESTIMATOR_BAYES_RESULT_WRITER_H_
 
 #include <filesystem>
+#include <span>
+#include <vector>
+
+#include <Eigen/Core>
 
 namespace gelex
 {
@@ -27,15 +31,19 @@ class MCMCResult;
 class MCMCResultWriter
 {
    public:
+    // `variants` are the raw .bim rows the model was fitted on; empty means
+    // every row.
     MCMCResultWriter(
         const MCMCResult& result,
-        const std::filesystem::path& bim_file_path);
+        const std::filesystem::path& bim_file_path,
+        std::span<const Eigen::Index> variants = {});
 
     auto save(const std::filesystem::path& prefix) const -> void;
 
    private:
     const MCMCResult* result_;
     std::filesystem::path bim_file_path_;
+    std::vector<Eigen::Index> variants_;
 };
 
 }  // namespace gelex
@@ -19,6 +19,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 
 #include <Eigen/Core>
@@ -40,7 +41,8 @@ class SnpEffectsWriter
     SnpEffectsWriter(
         const MCMCResult& result,
         const std::filesystem::path& bim_file_path,
-        const std::filesystem::path& output_path);
+        const std::filesystem::path& output_path,
+        std::span<const Eigen::Index> variants = {});
     ~SnpEffectsWriter();
 
     auto write() -> void;
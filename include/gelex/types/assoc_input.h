@@ -17,6 +17,8 @@
 #ifndef GELEX_TYPES_ASSOC_INPUT_H_
 #define GELEX_TYPES_ASSOC_INPUT_H_
 
+#include <functional>
+
 #include <Eigen/Core>
 
 namespace gelex
@@ -35,7 +37,10 @@ struct AssocInput
     {
         Z.resize(n_samples, chunk_size);
         W.resize(n_samples, chunk_size);
-        V_inv.resize(n_samples, n_samples);
+        if (!solve_v)
+        {
+            V_inv.resize(n_samples, n_samples);
+        }
         V_inv_y.resize(n_samples);
     }
 
@@ -43,6 +48,11 @@ struct AssocInput
     Eigen::MatrixXd V_inv;  // Inverse of covariance matrix
     Eigen::VectorXd V_inv_y;
     Eigen::MatrixXd W;  // Intermediate buffer for V^{-1} Z
+
+    // Sparse GRMs: W = V^{-1} Z by solves with the factor of V; V_inv is
+    // then left empty
+    std::function<void(const Eigen::MatrixXd& z, Eigen::MatrixXd& w)>
+        solve_v;
 };
 
 struct AssocOutput
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <fmt/base.h>
 
@@ -51,6 +52,26 @@ struct GeneticEffect
 {
     GrmType type;
     Eigen::MatrixXd K;
+    // set instead of K for a sparse GRM (grm --sparse-cutoff)
+    Eigen::SparseMatrix<double> K_sparse;
+
+    [[nodiscard]] auto is_sparse() const -> bool
+    {
+        return K_sparse.size() > 0;
+    }
+    [[nodiscard]] auto num_samples() const -> Eigen::Index
+    {
+        return is_sparse() ? K_sparse.rows() : K.rows();
+    }
+};
+
+// Spectral decomposition of a GRM as GeneticEffect::K holds it, scaled by
+// trace / n: K = vectors * values.asDiagonal() * vectors', eigenvalues in
+// ascending order (grm --eigen).
+struct GrmEigen
+{
+    Eigen::VectorXd values;
+    Eigen::MatrixXd vectors;
 };
 
 struct FixedState
@@ -1,6 +1,8 @@
 #ifndef GELEX_TYPES_GENETIC_EFFECT_TYPE_H_
 #define GELEX_TYPES_GENETIC_EFFECT_TYPE_H_
+#include <array>
 #include <cstdint>
+#include <limits>
 
 namespace gelex
 {
@@ -25,6 +27,29 @@ struct LocusStatistic
     bool is_monomorphic{false};
 };
 
+// Per-locus counts of the 2-bit PLINK genotype codes, indexed by code:
+// 0b00 homozygous A1, 0b01 missing, 0b10 heterozygous, 0b11 homozygous A2.
+using GenotypeCodeCounts = std::array<int64_t, 4>;
+
+// One output value per 2-bit genotype code, indexed as GenotypeCodeCounts.
+using GenotypeCodeTable = std::array<double, 4>;
+
+inline constexpr uint8_t kMissingGenotypeCode = 0b01;
+
+// A1 dosage of each code; the missing code decodes to NaN.
+inline constexpr GenotypeCodeTable kGenotypeDosages
+    = {2.0, std::numeric_limits<double>::quiet_NaN(), 1.0, 0.0};
+
+// Everything needed to emit one processed locus straight from packed codes:
+// its statistics and the final value written for each code.
+struct LocusPlan
+{
+    LocusStatistic stats;
+    GenotypeCodeTable values{};
+};
+
+using LocusPlanner = LocusPlan (*)(const GenotypeCodeCounts&);
+
 }  // namespace gelex
 
 #endif  // GELEX_TYPES_GENETIC_EFFECT_TYPE_H_
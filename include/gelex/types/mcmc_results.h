@@ -31,7 +31,9 @@ struct PosteriorSummary
 {
     explicit PosteriorSummary(Eigen::Index n_params)
         : mean(Eigen::VectorXd::Zero(n_params)),
-          stddev(Eigen::VectorXd::Zero(n_params))
+          stddev(Eigen::VectorXd::Zero(n_params)),
+          lower(Eigen::VectorXd::Zero(n_params)),
+          upper(Eigen::VectorXd::Zero(n_params))
     {
     }
     PosteriorSummary() = default;
@@ -40,12 +42,15 @@ struct PosteriorSummary
 
     Eigen::VectorXd mean;
     Eigen::VectorXd stddev;
+    // equal-tailed credible interval from the streaming quantile sketches
+    Eigen::VectorXd lower;
+    Eigen::VectorXd upper;
 };
 
 struct FixedSummary
 {
     explicit FixedSummary(const FixedSamples& sample)
-        : coeffs(sample.coeffs.rows())
+        : coeffs(sample.coeffs.size())
     {
     }
 
@@ -55,7 +60,7 @@ struct FixedSummary
 struct RandomSummary
 {
     explicit RandomSummary(const RandomSamples& sample)
-        : coeffs(sample.coeffs.rows()), variance(1)
+        : coeffs(sample.coeffs.size()), variance(1)
     {
     }
 
@@ -66,28 +71,29 @@ struct RandomSummary
 struct BaseMarkerSummary
 {
     explicit BaseMarkerSummary(const BaseMarkerSamples& samples)
-        : coeffs(samples.coeffs.rows()),
+        : coeffs(samples.coeffs.size()),
           variance(1),
           heritability(1),
-          pve(samples.coeffs.rows())
+          pve(samples.coeffs.size())
     {
-        if (samples.tracker.size() > 0)  // mixture model
+        // mixture model
+        if (samples.component_counts.size() > 0)
         {
-            pip = Eigen::VectorXd::Zero(samples.tracker.rows());
+            pip = Eigen::VectorXd::Zero(samples.coeffs.size());
             comp_probs = Eigen::MatrixXd::Zero(
-                samples.tracker.rows(), samples.n_proportions);
+                samples.coeffs.size(), samples.n_proportions);
         }
 
         if (samples.mixture_proportion.size() > 0)
         {
             mixture_proportion
-                = PosteriorSummary(samples.mixture_proportion.rows());
+                = PosteriorSummary(samples.mixture_proportion.size());
         }
 
         if (samples.component_variance.size() > 0)
         {
             component_variance
-                = PosteriorSummary(samples.component_variance.rows());
+                = PosteriorSummary(samples.component_variance.size());
         }
     }
 
@@ -121,20 +127,17 @@ struct DominantSummary : BaseMarkerSummary
 class MCMCResult
 {
    public:
-    explicit MCMCResult(
-        MCMCSamples&& samples,
-        const BayesModel& model,
-        double prob = 0.9);
+    explicit MCMCResult(MCMCSamples&& samples, const BayesModel& model);
 
     /**
      * @brief Compute posterior statistics.
      *
-     * If prob is provided, uses it as the probability threshold for
-     * computation. Otherwise, uses default prob.
-     *
-     * @param prob Optional probability threshold for computation.
+     * Credible intervals come from the quantile sketches updated while
+     * sampling, so their level is fixed by MCMCParams::credible_prob.
      */
-    void compute(std::optional<double> prob = std::nullopt);
+    void compute();
+
+    double prob() const { return prob_; }
 
     const FixedSummary* fixed() const
     {
@@ -28,6 +28,9 @@
 
 #include <Eigen/Core>
 
+#include "gelex/infra/utils/quantile_sketch.h"
+#include "gelex/infra/utils/running_stats.h"
+
 // Forward declaration
 
 namespace gelex::detail
@@ -56,19 +59,61 @@ struct MCMCParams;
 class BayesState;
 class BayesModel;
 
+/**
+ * @brief Equal-tailed credible interval of a parameter block, estimated
+ * from the stream of stored draws without keeping them.
+ */
+struct CredibleSketch
+{
+    CredibleSketch() = default;
+    CredibleSketch(const MCMCParams& params, Eigen::Index n_params);
+
+    void update(const Eigen::Ref<const Eigen::VectorXd>& draw);
+    void update(double draw);
+
+    QuantileSketch lower;
+    QuantileSketch upper;
+};
+
+/**
+ * @brief Stored draws of one parameter block.
+ *
+ * Every draw is folded into running moments (posterior mean and SD) and the
+ * credible sketch, so memory does not grow with the chain length. The draws
+ * themselves are kept, one column per record, only under
+ * SampleStorage::Full.
+ */
+struct ParamDraws
+{
+    ParamDraws() = default;
+    ParamDraws(const MCMCParams& params, Eigen::Index n_params);
+
+    void store(
+        const Eigen::Ref<const Eigen::VectorXd>& draw,
+        Eigen::Index record_idx);
+    void store(double draw, Eigen::Index record_idx);
+
+    Eigen::Index size() const { return n_params; }
+
+    Eigen::Index n_params = 0;
+    RunningStats moments;
+    CredibleSketch interval;
+    Eigen::MatrixXd draws;  // empty unless SampleStorage::Full
+};
+
 struct FixedSamples
 {
     FixedSamples(const MCMCParams& params, const FixedEffect& effect);
 
-    Eigen::MatrixXd coeffs;
+    ParamDraws coeffs;
     explicit operator bool() const { return coeffs.size() > 0; }
 };
 
 struct RandomSamples
 {
     RandomSamples(const MCMCParams& params, const bayes::RandomEffect& effect);
-    Eigen::MatrixXd coeffs;
-    Eigen::RowVectorXd variance;
+    ParamDraws coeffs;
+    ParamDraws variance;
     explicit operator bool() const { return coeffs.size() > 0; }
 
    protected:
@@ -81,13 +126,22 @@ struct BaseMarkerSamples : RandomSamples
         const MCMCParams& params,
         const bayes::GeneticEffect& effect);
 
-    Eigen::MatrixXd mixture_proportion;
-    Eigen::RowVectorXd heritability;
+    ParamDraws mixture_proportion;
+    ParamDraws heritability;
+    ParamDraws component_variance;
+
+    // Per-draw component of each marker, SampleStorage::Full only; the
+    // posterior inclusion probabilities come from `component_counts`.
     Eigen::MatrixXi tracker;
-    Eigen::MatrixXd component_variance;
+    Eigen::MatrixXi component_counts;
+    Eigen::Index n_draws = 0;
 
     Eigen::Index n_proportions
         = 0;  // load the number of prop for no-estimate-pi models.
+
+    void store_components(
+        const Eigen::VectorXi& components,
+        Eigen::Index record_idx);
 };
 
 struct AdditiveSamples : BaseMarkerSamples
@@ -108,7 +162,7 @@ struct ResidualSamples
 {
     explicit ResidualSamples(const MCMCParams& params);
 
-    Eigen::RowVectorXd variance;
+    ParamDraws variance;
     explicit operator bool() const { return variance.size() > 0; }
 };
 
@@ -141,6 +195,7 @@ class MCMCSamples
         return dominant_ ? &dominant_.value() : nullptr;
     }
     const ResidualSamples& residual() const { return residual_; }
+    double credible_prob() const { return credible_prob_; }
 
    private:
     std::optional<FixedSamples> fixed_;
@@ -148,6 +203,7 @@ class MCMCSamples
     std::optional<AdditiveSamples> additive_;
     std::optional<DominantSamples> dominant_;
     ResidualSamples residual_;
+    double credible_prob_;
     std::unique_ptr<detail::BinaryWriter<double>> add_writer_;
     std::unique_ptr<detail::BinaryWriter<double>> dom_writer_;
     std::unique_ptr<detail::BinaryWriter<double>> scalar_writer_;
@@ -25,7 +25,14 @@ namespace gelex::gwas
 void wald_test(AssocInput& input, AssocOutput& output)
 {
     output.zt_v_inv_r = (input.Z.transpose() * input.V_inv_y);
-    input.W = input.V_inv * input.Z;
+    if (input.solve_v)
+    {
+        input.solve_v(input.Z, input.W);
+    }
+    else
+    {
+        input.W = input.V_inv * input.Z;
+    }
     output.zt_v_inv_z = (input.Z.transpose() * input.W).diagonal();
 
     output.beta = (output.zt_v_inv_r.array() / output.zt_v_inv_z.array());
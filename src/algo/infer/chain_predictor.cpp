@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/algo/infer/chain_predictor.h"
+
+#include <format>
+
+#include "gelex/exception.h"
+#include "gelex/model/bayes/model.h"
+
+namespace gelex
+{
+
+ChainPredictor::ChainPredictor(
+    Eigen::MatrixXd&& additive,
+    Eigen::MatrixXd&& dominant)
+    : additive_(std::move(additive)),
+      dominant_(std::move(dominant)),
+      gebv_(Eigen::VectorXd::Zero(additive_.rows()))
+{
+    if (has_dominance() && dominant_.rows() != additive_.rows())
+    {
+        throw InvalidInputException(
+            std::format(
+                "Target genotype row mismatch: additive has {} samples, "
+                "dominant has {}",
+                additive_.rows(),
+                dominant_.rows()));
+    }
+}
+
+auto ChainPredictor::update(const BayesState& state) -> void
+{
+    const auto* add = state.additive();
+    if (add == nullptr || add->coeffs.size() != additive_.cols())
+    {
+        throw InvalidInputException(
+            "Target additive genotypes do not match the fitted SNP effects");
+    }
+    gebv_.noalias() = additive_ * add->coeffs;
+
+    if (has_dominance())
+    {
+        const auto* dom = state.dominant();
+        if (dom == nullptr || dom->coeffs.size() != dominant_.cols())
+        {
+            throw InvalidInputException(
+                "Target dominance genotypes do not match the fitted SNP "
+                "effects");
+        }
+        gebv_.noalias() += dominant_ * dom->coeffs;
+    }
+
+    stats_.update(gebv_);
+}
+
+}  // namespace gelex
@@ -23,10 +23,8 @@ namespace gelex::detail::PosteriorCalculator
 
 PosteriorSummary compute_param_summary(
     const Eigen::Ref<const Eigen::MatrixXd>& samples,
-    double prob)
+    const CredibleSketch& interval)
 {
-    static_cast<void>(prob);
-
     if (samples.cols() == 0 || samples.rows() == 0)
     {
         return PosteriorSummary(0);
@@ -34,6 +32,30 @@ PosteriorSummary compute_param_summary(
 
     PosteriorSummary summary(get_n_params(samples));
     compute_mean_std(summary, samples);
+    if (interval.lower.size() == summary.size())
+    {
+        summary.lower = interval.lower.result();
+        summary.upper = interval.upper.result();
+    }
+    return summary;
+}
+
+PosteriorSummary compute_param_summary(const ParamDraws& draws)
+{
+    const RunningStatsResult stats = draws.moments.result();
+    if (stats.mean.size() == 0)
+    {
+        return PosteriorSummary(0);
+    }
+
+    PosteriorSummary summary(stats.mean.size());
+    summary.mean = stats.mean;
+    summary.stddev = stats.stddev;
+    if (draws.interval.lower.size() == summary.size())
+    {
+        summary.lower = draws.interval.lower.result();
+        summary.upper = draws.interval.upper.result();
+    }
     return summary;
 }
 
@@ -132,6 +154,18 @@ void compute_pve(
     }
 }
 
+void compute_pve_from_mean(
+    PosteriorSummary& summary,
+    const Eigen::Ref<const Eigen::VectorXd>& mean_coeffs,
+    double phenotype_var)
+{
+    if (mean_coeffs.size() == 0 || phenotype_var <= 0.0)
+    {
+        return;
+    }
+    summary.mean = mean_coeffs.array().square() / phenotype_var;
+}
+
 Eigen::Index get_n_params(const Eigen::Ref<const Eigen::MatrixXd>& samples)
 {
     return samples.rows();
@@ -162,4 +196,15 @@ Eigen::MatrixXd compute_component_probs(
     return comp_probs;
 }
 
+Eigen::MatrixXd component_probs_from_counts(
+    const Eigen::Ref<const Eigen::MatrixXi>& counts,
+    Eigen::Index n_draws)
+{
+    if (counts.size() == 0 || n_draws <= 0)
+    {
+        return Eigen::MatrixXd::Zero(0, 0);
+    }
+    return counts.cast<double>() / static_cast<double>(n_draws);
+}
+
 }  // namespace gelex::detail::PosteriorCalculator
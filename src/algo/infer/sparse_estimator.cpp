@@ -0,0 +1,374 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/algo/infer/sparse_estimator.h"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <Eigen/Cholesky>
+#include <Eigen/QR>
+
+#include "gelex/algo/numerics/constrain.h"
+#include "gelex/algo/numerics/optimizer.h"
+#include "gelex/algo/stats/statistics.h"
+#include "gelex/exception.h"
+#include "gelex/infra/logging/notify.h"
+#include "gelex/model/freq/model.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+using SparseMatrix = Eigen::SparseMatrix<double>;
+
+// fixed so that repeated fits of the same data agree
+constexpr uint64_t kProbeSeed = 0x5eed;
+
+// REML quantities at one set of variance components, in the order of
+// collect_variance_components(): residual, then the genetic effects.
+class SparseReml
+{
+   public:
+    SparseReml(const FreqModel& model, Eigen::Index num_probes)
+        : model_(model), factor_(std::make_shared<SparseVFactor>())
+    {
+        const Eigen::Index n = model.num_individuals();
+        identity_.resize(n, n);
+        identity_.setIdentity();
+
+        // Hutchinson: tr(A) = E[z'Az] for Rademacher z; unit vectors make
+        // it exact and are cheaper once n is below the probe count
+        if (n <= num_probes)
+        {
+            probes_ = Eigen::MatrixXd::Identity(n, n);
+            probe_scale_ = 1.0;
+        }
+        else
+        {
+            std::mt19937_64 rng(kProbeSeed);
+            probes_.resize(n, num_probes);
+            for (Eigen::Index j = 0; j < num_probes; ++j)
+            {
+                for (Eigen::Index i = 0; i < n; ++i)
+                {
+                    probes_(i, j) = (rng() & 1U) != 0 ? 1.0 : -1.0;
+                }
+            }
+            probe_scale_ = 1.0 / static_cast<double>(num_probes);
+        }
+        for (const auto& effect : model.genetic())
+        {
+            k_probes_.emplace_back(effect.K_sparse * probes_);
+        }
+    }
+
+    auto evaluate(const Eigen::VectorXd& sigma) -> void
+    {
+        const auto& genetic = model_.genetic();
+        const auto& x = model_.fixed().X;
+        const auto& y = model_.phenotype();
+
+        SparseMatrix v = identity_ * sigma(0);
+        for (size_t i = 0; i < genetic.size(); ++i)
+        {
+            v += genetic[i].K_sparse * sigma(static_cast<Eigen::Index>(i) + 1);
+        }
+        // the pattern is the union of the GRMs', the same every iteration
+        if (!analyzed_)
+        {
+            factor_->analyzePattern(v);
+            analyzed_ = true;
+        }
+        factor_->factorize(v);
+        if (factor_->info() != Eigen::Success
+            || (factor_->vectorD().array() <= 0.0).any())
+        {
+            throw std::runtime_error("V matrix is not positive definite");
+        }
+        const double logdet_v = factor_->vectorD().array().log().sum();
+
+        solve_sparse_v(*factor_, x, vinv_x_);
+        xvx_.compute(x.transpose() * vinv_x_);
+        if (xvx_.info() != Eigen::Success)
+        {
+            throw std::runtime_error("X'V^{-1}X is not positive definite");
+        }
+        const double logdet_xvx
+            = 2.0 * xvx_.matrixLLT().diagonal().array().log().sum();
+
+        Eigen::MatrixXd vinv_y;
+        solve_sparse_v(*factor_, y, vinv_y);
+        proj_y_ = vinv_y.col(0)
+                  - vinv_x_ * xvx_.solve(vinv_x_.transpose() * y);
+        loglike_ = -0.5 * (logdet_v + logdet_xvx + y.dot(proj_y_));
+
+        const Eigen::MatrixXd p_probes = apply_proj(probes_);
+        traces_.resize(static_cast<Eigen::Index>(genetic.size()) + 1);
+        traces_(0) = probe_scale_ * probes_.cwiseProduct(p_probes).sum();
+        for (size_t i = 0; i < genetic.size(); ++i)
+        {
+            traces_(static_cast<Eigen::Index>(i) + 1)
+                = probe_scale_ * k_probes_[i].cwiseProduct(p_probes).sum();
+        }
+    }
+
+    // sigma_new = (sigma^2 * Py'K Py - sigma^2 * tr(PK) + sigma * n) / n
+    auto em_update(const Eigen::VectorXd& sigma) const -> Eigen::VectorXd
+    {
+        const auto n = static_cast<double>(model_.num_individuals());
+        Eigen::VectorXd next(sigma.size());
+        for (Eigen::Index i = 0; i < sigma.size(); ++i)
+        {
+            const double py_k_py = proj_y_.dot(k_times(i, proj_y_));
+            const double sq = sigma(i) * sigma(i);
+            next(i) = (sq * py_k_py - sq * traces_(i) + sigma(i) * n) / n;
+        }
+        return next;
+    }
+
+    // sigma - H^{-1} grad with the average-information H
+    auto ai_update(const Eigen::VectorXd& sigma, Eigen::MatrixXd& hess_inv)
+        const -> Eigen::VectorXd
+    {
+        const Eigen::Index n_comp = sigma.size();
+        Eigen::MatrixXd dvpy(model_.num_individuals(), n_comp);
+        Eigen::VectorXd grad(n_comp);
+        for (Eigen::Index i = 0; i < n_comp; ++i)
+        {
+            dvpy.col(i) = k_times(i, proj_y_);
+            grad(i) = -0.5 * (traces_(i) - proj_y_.dot(dvpy.col(i)));
+        }
+
+        const Eigen::MatrixXd p_dvpy = apply_proj(dvpy);
+        Eigen::MatrixXd hess(n_comp, n_comp);
+        for (Eigen::Index i = 0; i < n_comp; ++i)
+        {
+            for (Eigen::Index j = i; j < n_comp; ++j)
+            {
+                hess(i, j) = -0.5 * dvpy.col(i).dot(p_dvpy.col(j));
+                hess(j, i) = hess(i, j);
+            }
+        }
+        hess_inv = hess.completeOrthogonalDecomposition().pseudoInverse();
+        return sigma - (hess_inv * grad);
+    }
+
+    auto loglike() const -> double { return loglike_; }
+    auto proj_y() const -> const Eigen::VectorXd& { return proj_y_; }
+    auto vinv_x() const -> const Eigen::MatrixXd& { return vinv_x_; }
+    auto xvx() const -> const Eigen::LLT<Eigen::MatrixXd>& { return xvx_; }
+    auto factor() const -> std::shared_ptr<const SparseVFactor>
+    {
+        return factor_;
+    }
+
+   private:
+    const FreqModel& model_;
+    SparseMatrix identity_;
+    std::shared_ptr<SparseVFactor> factor_;
+    bool analyzed_{false};
+
+    Eigen::MatrixXd probes_;
+    double probe_scale_{1.0};
+    std::vector<Eigen::MatrixXd> k_probes_;  // K_i * probes
+
+    Eigen::MatrixXd vinv_x_;
+    Eigen::LLT<Eigen::MatrixXd> xvx_;
+    Eigen::VectorXd proj_y_;
+    double loglike_{};
+    Eigen::VectorXd traces_;  // tr(P), then tr(P K_i)
+
+    // K of component i (the identity for the residual) times u
+    auto k_times(Eigen::Index i, const Eigen::VectorXd& u) const
+        -> Eigen::VectorXd
+    {
+        if (i == 0)
+        {
+            return u;
+        }
+        return model_.genetic()[static_cast<size_t>(i - 1)].K_sparse * u;
+    }
+
+    // P u = V^{-1} u - V^{-1}X (X'V^{-1}X)^{-1} (V^{-1}X)' u
+    auto apply_proj(const Eigen::MatrixXd& u) const -> Eigen::MatrixXd
+    {
+        Eigen::MatrixXd pu;
+        solve_sparse_v(*factor_, u, pu);
+        pu.noalias() -= vinv_x_ * xvx_.solve(vinv_x_.transpose() * u);
+        return pu;
+    }
+};
+
+auto variance_labels(const FreqState& state)
+    -> std::pair<std::vector<std::string>, std::vector<double>>
+{
+    std::vector<std::string> labels;
+    std::vector<double> variances;
+    for (const auto& g : state.genetic())
+    {
+        labels.push_back(fmt::format("V({})", g.type));
+        variances.push_back(g.variance);
+    }
+    labels.emplace_back("V(e)");
+    variances.push_back(state.residual().variance);
+    return {std::move(labels), std::move(variances)};
+}
+
+}  // namespace
+
+auto solve_sparse_v(
+    const SparseVFactor& factor,
+    const Eigen::Ref<const Eigen::MatrixXd>& b,
+    Eigen::MatrixXd& x) -> void
+{
+    x.resize(b.rows(), b.cols());
+#pragma omp parallel for schedule(dynamic)
+    for (Eigen::Index j = 0; j < b.cols(); ++j)
+    {
+        x.col(j) = factor.solve(b.col(j));
+    }
+}
+
+SparseEstimator::SparseEstimator(
+    size_t max_iter,
+    double tol,
+    RemlObserver observer,
+    Eigen::Index num_probes)
+    : convergence_checker_(tol),
+      max_iter_(max_iter),
+      num_probes_(num_probes),
+      observer_(std::move(observer))
+{
+    if (num_probes_ <= 0)
+    {
+        throw ArgumentValidationException(
+            "the number of trace probes must be positive");
+    }
+}
+
+auto SparseEstimator::fit(
+    const FreqModel& model,
+    FreqState& state,
+    bool em_init) -> std::shared_ptr<const SparseVFactor>
+{
+    if (!model.random().empty() || model.genetic().empty())
+    {
+        throw InvalidInputException(
+            "sparse REML needs at least one GRM and no other random effects");
+    }
+    for (const auto& effect : model.genetic())
+    {
+        if (!effect.is_sparse())
+        {
+            throw InvalidInputException(
+                "sparse GRMs (.sp.bin) cannot be combined with dense ones");
+        }
+    }
+
+    SparseReml reml(model, num_probes_);
+    convergence_checker_.clear();
+    converged_ = false;
+
+    Eigen::VectorXd sigma = collect_variance_components(state);
+    Eigen::MatrixXd hess_inv
+        = Eigen::MatrixXd::Zero(sigma.size(), sigma.size());
+    auto step = [&](bool em) -> bool
+    {
+        reml.evaluate(sigma);
+        sigma = em ? reml.em_update(sigma) : reml.ai_update(sigma, hess_inv);
+        constrain(sigma, model.phenotype_variance());
+        distribute_variance_components(state, sigma);
+        return convergence_checker_.is_converged(sigma, reml.loglike());
+    };
+
+    // EM initialization
+    if (em_init)
+    {
+        step(true);
+        auto [labels, init_variances] = variance_labels(state);
+        notify(
+            observer_,
+            RemlEmInitEvent{
+                .loglike = reml.loglike(),
+                .init_variances = std::move(init_variances)});
+    }
+
+    // AI iterations
+    for (size_t iter = 1; iter <= max_iter_; ++iter)
+    {
+        const bool converged = step(false);
+        loglike_ = reml.loglike();
+
+        auto [labels, variances] = variance_labels(state);
+        notify(
+            observer_,
+            RemlIterationEvent{
+                .iter = iter,
+                .loglike = loglike_,
+                .labels = std::move(labels),
+                .variances = std::move(variances)});
+
+        if (converged)
+        {
+            converged_ = true;
+            iter_count_ = iter;
+            break;
+        }
+    }
+
+    if (!converged_)
+    {
+        iter_count_ = max_iter_;
+    }
+
+    // final results, as effect_solver does from the dense V^{-1}
+    const auto& y = model.phenotype();
+    const auto num_fixed = model.fixed().X.cols();
+    state.fixed().coeff = reml.xvx().solve(reml.vinv_x().transpose() * y);
+    const Eigen::MatrixXd xvx_inv
+        = reml.xvx().solve(Eigen::MatrixXd::Identity(num_fixed, num_fixed));
+    state.fixed().se = xvx_inv.diagonal().array().sqrt();
+    for (size_t i = 0; i < model.genetic().size(); ++i)
+    {
+        auto& effect_state = state.genetic()[i];
+        effect_state.ebv.noalias() = model.genetic()[i].K_sparse
+                                     * reml.proj_y() * effect_state.variance;
+    }
+    statistics::compute_variance_se(state, hess_inv);
+    statistics::compute_heritability(state, hess_inv);
+
+    notify(
+        observer_,
+        RemlCompleteEvent{
+            .model = &model,
+            .state = &state,
+            .converged = converged_,
+            .iter_count = iter_count_,
+            .max_iter = max_iter_,
+            .loglike = loglike_});
+
+    return reml.factor();
+}
+
+}  // namespace gelex
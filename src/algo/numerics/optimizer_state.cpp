@@ -16,6 +16,8 @@
 
 #include "gelex/algo/numerics/optimizer_state.h"
 
+#include "gelex/infra/utils/huge_pages.h"
+#include "gelex/infra/utils/numa.h"
 #include "gelex/model/freq/model.h"
 
 namespace gelex
@@ -27,6 +29,11 @@ OptimizerState::OptimizerState(const FreqModel& model)
 {
     v.resize(num_individuals_, num_individuals_);
     proj.resize(num_individuals_, num_individuals_);
+    // n x n and rewritten every iteration; huge pages cut the TLB misses
+    advise_huge_pages(v);
+    advise_huge_pages(proj);
+    numa_first_touch(v);
+    numa_first_touch(proj);
     proj_y.resize(num_individuals_);
     tx_vinv_x.resize(model.fixed().X.cols(), model.fixed().X.cols());
 
@@ -23,6 +23,7 @@
 
 #include <Eigen/Core>
 
+#include "gelex/data/genotype/chunk_prefetcher.h"
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/exception.h"
 #include "gelex/infra/logging/simulate_event.h"
@@ -85,11 +86,16 @@ auto GeneticValueCalculator::calculate(
     }
     notify_progress(observer, static_cast<size_t>(n_snps), 0);
 
-    for (Eigen::Index start = 0; start < n_snps; start += SNP_CHUNK_SIZE)
+    const std::pair<Eigen::Index, Eigen::Index> all{0, n_snps};
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split({&all, 1}, SNP_CHUNK_SIZE),
+        ChunkPrefetcher::decode(bed_pipe_));
+
+    while (const auto* chunk = prefetcher.next())
     {
-        const Eigen::Index end = std::min(start + SNP_CHUNK_SIZE, n_snps);
-        auto [add_chunk, dom_chunk]
-            = encode_chunk(bed_pipe_.load_chunk(start, end));
+        const Eigen::Index start = chunk->start;
+        const Eigen::Index end = chunk->end;
+        auto [add_chunk, dom_chunk] = encode_chunk(chunk->genotype);
         additive_values
             += add_chunk * effects.additive.segment(start, end - start);
         if (has_dominance_)
@@ -46,10 +46,16 @@ auto compute_bic(const FreqModel& model, double loglike) -> double
 
 auto compute_variance_se(FreqState& state, const OptimizerState& opt_state)
     -> void
+{
+    compute_variance_se(state, opt_state.hess_inv);
+}
+
+auto compute_variance_se(FreqState& state, const Eigen::MatrixXd& hess_inv)
+    -> void
 {
     // se(σ) = sqrt(diag(-H⁻¹))
     // variance component order: residual, random[0..], genetic[0..]
-    Eigen::VectorXd se = (-opt_state.hess_inv.diagonal()).array().sqrt();
+    Eigen::VectorXd se = (-hess_inv.diagonal()).array().sqrt();
 
     Eigen::Index idx = 0;
 
@@ -71,6 +77,12 @@ auto compute_variance_se(FreqState& state, const OptimizerState& opt_state)
 
 auto compute_heritability(FreqState& state, const OptimizerState& opt_state)
     -> void
+{
+    compute_heritability(state, opt_state.hess_inv);
+}
+
+auto compute_heritability(FreqState& state, const Eigen::MatrixXd& hess_inv)
+    -> void
 {
     // total phenotypic variance
     double sum_var = state.residual().variance;
@@ -89,7 +101,7 @@ auto compute_heritability(FreqState& state, const OptimizerState& opt_state)
     }
 
     double sum_var_sq = sum_var * sum_var;
-    auto n_comp = opt_state.hess_inv.rows();
+    auto n_comp = hess_inv.rows();
 
     // for each genetic effect, compute heritability and its SE using delta
     // method
@@ -121,7 +133,7 @@ auto compute_heritability(FreqState& state, const OptimizerState& opt_state)
         }
 
         // se(h²) = sqrt(g' * (-H⁻¹) * g)
-        double var_h2 = grad.dot(-opt_state.hess_inv * grad);
+        double var_h2 = grad.dot(-hess_inv * grad);
         g.heritability_se = std::sqrt(std::max(0.0, var_h2));
     }
 }
@@ -0,0 +1,484 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decode_kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#include "data/decode_lut.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define GELEX_DECODE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gelex::detail
+{
+
+namespace
+{
+
+auto decode_one(const uint8_t* src, Eigen::Index sample) -> double
+{
+    return kDecodeLut[src[sample >> 2]][sample & 3];
+}
+
+// --------------------------------------------------------------------------
+// Scalar: one 4-double table row per packed byte
+// --------------------------------------------------------------------------
+
+void dense_scalar_from(
+    const uint8_t* src,
+    Eigen::Index begin,
+    Eigen::Index num_samples,
+    double* dst)
+{
+    Eigen::Index i = begin;
+    for (; i + 4 <= num_samples; i += 4)
+    {
+        std::memcpy(dst + i, kDecodeLut[src[i >> 2]].data(), 4 * sizeof(double));
+    }
+    for (; i < num_samples; ++i)
+    {
+        dst[i] = decode_one(src, i);
+    }
+}
+
+void sparse_scalar_from(
+    const uint8_t* src,
+    Eigen::Index begin,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    double* dst)
+{
+    for (Eigen::Index i = begin; i < num_raw_samples; ++i)
+    {
+        if (const Eigen::Index target = raw_to_target[i]; target != -1)
+        {
+            dst[target] = decode_one(src, i);
+        }
+    }
+}
+
+void dense_scalar(const uint8_t* src, Eigen::Index num_samples, double* dst)
+{
+    dense_scalar_from(src, 0, num_samples, dst);
+}
+
+void sparse_scalar(
+    const uint8_t* src,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    double* dst)
+{
+    sparse_scalar_from(src, 0, num_raw_samples, raw_to_target, dst);
+}
+
+// --------------------------------------------------------------------------
+// Mapped scalar: codes go through a per-locus table, so the 256-entry
+// dosage table cannot be reused. Each nibble is looked up in a 16-row table
+// of value pairs built per call instead.
+// --------------------------------------------------------------------------
+
+// One table serves both precisions: the values are narrowed once, when
+// the nibble rows are built, as a float table would hold them.
+template <typename T>
+using NibbleTable = std::array<std::array<T, 2>, 16>;
+
+template <typename T>
+auto make_nibble_table(const GenotypeCodeTable& table) -> NibbleTable<T>
+{
+    NibbleTable<T> nibbles{};
+    for (size_t nibble = 0; nibble < nibbles.size(); ++nibble)
+    {
+        nibbles[nibble] = {
+            static_cast<T>(table[nibble & 3]),
+            static_cast<T>(table[nibble >> 2])};
+    }
+    return nibbles;
+}
+
+template <typename T>
+auto decode_mapped_one(
+    const uint8_t* src,
+    Eigen::Index sample,
+    const GenotypeCodeTable& table) -> T
+{
+    return static_cast<T>(table[(src[sample >> 2] >> (2 * (sample & 3))) & 3]);
+}
+
+template <typename T>
+void dense_mapped_tail(
+    const uint8_t* src,
+    Eigen::Index begin,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    T* dst)
+{
+    for (Eigen::Index i = begin; i < num_samples; ++i)
+    {
+        dst[i] = decode_mapped_one<T>(src, i, table);
+    }
+}
+
+template <typename T>
+void sparse_mapped_scalar_from(
+    const uint8_t* src,
+    Eigen::Index begin,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    const GenotypeCodeTable& table,
+    T* dst)
+{
+    for (Eigen::Index i = begin; i < num_raw_samples; ++i)
+    {
+        if (const Eigen::Index target = raw_to_target[i]; target != -1)
+        {
+            dst[target] = decode_mapped_one<T>(src, i, table);
+        }
+    }
+}
+
+template <typename T>
+void dense_mapped_scalar(
+    const uint8_t* src,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    T* dst)
+{
+    const NibbleTable<T> nibbles = make_nibble_table<T>(table);
+    Eigen::Index i = 0;
+    for (; i + 4 <= num_samples; i += 4)
+    {
+        const uint8_t byte = src[i >> 2];
+        std::memcpy(dst + i, nibbles[byte & 15].data(), 2 * sizeof(T));
+        std::memcpy(dst + i + 2, nibbles[byte >> 4].data(), 2 * sizeof(T));
+    }
+    dense_mapped_tail(src, i, num_samples, table, dst);
+}
+
+template <typename T>
+void sparse_mapped_scalar(
+    const uint8_t* src,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    const GenotypeCodeTable& table,
+    T* dst)
+{
+    sparse_mapped_scalar_from(
+        src, 0, num_raw_samples, raw_to_target, table, dst);
+}
+
+// --------------------------------------------------------------------------
+// Code counts: the low and high bit of every code are split into two words
+// and combined under the keep mask, so one popcount counts 32 samples.
+// Homozygous A1 (0b00) is whatever is left of the selected samples.
+// --------------------------------------------------------------------------
+
+[[gnu::always_inline]] inline void count_codes(
+    const uint8_t* src,
+    Eigen::Index num_bytes,
+    const uint64_t* keep,
+    GenotypeCodeCounts& counts)
+{
+    constexpr auto kWordBytes = static_cast<Eigen::Index>(sizeof(uint64_t));
+
+    int64_t selected = 0;
+    int64_t missing = 0;
+    int64_t het = 0;
+    int64_t hom_a2 = 0;
+    for (Eigen::Index offset = 0, w = 0; offset < num_bytes;
+         offset += kWordBytes, ++w)
+    {
+        uint64_t word = 0;
+        std::memcpy(
+            &word,
+            src + offset,
+            static_cast<size_t>(std::min(kWordBytes, num_bytes - offset)));
+        const uint64_t lo = word & keep[w];
+        const uint64_t hi = (word >> 1) & keep[w];
+        selected += std::popcount(keep[w]);
+        missing += std::popcount(lo & ~hi);
+        het += std::popcount(hi & ~lo);
+        hom_a2 += std::popcount(lo & hi);
+    }
+    counts[0] += selected - missing - het - hom_a2;
+    counts[1] += missing;
+    counts[2] += het;
+    counts[3] += hom_a2;
+}
+
+void count_scalar(
+    const uint8_t* src,
+    Eigen::Index num_bytes,
+    const uint64_t* keep,
+    GenotypeCodeCounts& counts)
+{
+    count_codes(src, num_bytes, keep, counts);
+}
+
+#ifdef GELEX_DECODE_X86
+
+// Every AVX2 CPU has POPCNT, but the baseline build may not emit it.
+__attribute__((target("popcnt"))) void count_popcnt(
+    const uint8_t* src,
+    Eigen::Index num_bytes,
+    const uint64_t* keep,
+    GenotypeCodeCounts& counts)
+{
+    count_codes(src, num_bytes, keep, counts);
+}
+
+// --------------------------------------------------------------------------
+// AVX2, single precision: two packed bytes are broadcast to eight 32-bit
+// lanes, shifted per lane and used as indices into the code table held
+// twice in a register, so one vpermps yields 8 floats and a 64-bit load
+// feeds 32 codes. The same trick gives only 4 doubles per permute and
+// measured no faster than the byte tables, which are store-bound already,
+// so the double paths stay scalar (see benchmark_decode_kernels.cpp).
+// --------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) auto dense_mapped_f32_avx2_until(
+    const uint8_t* src,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    float* dst) -> Eigen::Index
+{
+    const __m128 codes4 = _mm256_cvtpd_ps(_mm256_loadu_pd(table.data()));
+    const __m256 lanes = _mm256_set_m128(codes4, codes4);
+    const __m256i shifts = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+
+    Eigen::Index i = 0;
+    for (; i + 32 <= num_samples; i += 32)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, src + (i >> 2), sizeof(word));
+        for (int k = 0; k < 4; ++k)
+        {
+            const auto pair = static_cast<int>((word >> (16 * k)) & 0xffffU);
+            const __m256i codes
+                = _mm256_srlv_epi32(_mm256_set1_epi32(pair), shifts);
+            _mm256_storeu_ps(
+                dst + i + (8 * k), _mm256_permutevar8x32_ps(lanes, codes));
+        }
+    }
+    return i;
+}
+
+void dense_mapped_f32_avx2(
+    const uint8_t* src,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    float* dst)
+{
+    const Eigen::Index done
+        = dense_mapped_f32_avx2_until(src, num_samples, table, dst);
+    dense_mapped_tail(src, done, num_samples, table, dst);
+}
+
+// --------------------------------------------------------------------------
+// AVX-512: two packed bytes are broadcast, shifted per lane and used as
+// indices into an in-register code table ({2, NaN, 1, 0} for dosages),
+// yielding 8 doubles per permute. Only the low 3 index bits are used, so the
+// table is repeated instead of masking the codes.
+// --------------------------------------------------------------------------
+
+__attribute__((target("avx512f"))) auto load_table_avx512(
+    const GenotypeCodeTable& table) -> __m512d
+{
+    return _mm512_broadcast_f64x4(_mm256_loadu_pd(table.data()));
+}
+
+__attribute__((target("avx512f"))) auto decode8_avx512(
+    const uint8_t* src,
+    Eigen::Index sample,
+    __m512d table) -> __m512d
+{
+    const __m512i shifts = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+
+    uint16_t pair = 0;
+    std::memcpy(&pair, src + (sample >> 2), sizeof(pair));
+    const __m512i codes = _mm512_srlv_epi64(_mm512_set1_epi64(pair), shifts);
+    return _mm512_permutexvar_pd(codes, table);
+}
+
+__attribute__((target("avx512f"))) auto dense_avx512_until(
+    const uint8_t* src,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    double* dst) -> Eigen::Index
+{
+    const __m512d lanes = load_table_avx512(table);
+    Eigen::Index i = 0;
+    for (; i + 8 <= num_samples; i += 8)
+    {
+        _mm512_storeu_pd(dst + i, decode8_avx512(src, i, lanes));
+    }
+    return i;
+}
+
+// Single precision narrows the 8 decoded doubles to one 256-bit scatter.
+// The dense float path uses the AVX2 permute instead, which yields 8
+// floats per permute without the narrowing and measured faster.
+template <typename T>
+__attribute__((target("avx512f"))) auto sparse_avx512_until(
+    const uint8_t* src,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    const GenotypeCodeTable& table,
+    T* dst) -> Eigen::Index
+{
+    static_assert(sizeof(Eigen::Index) == sizeof(int64_t));
+    const __m512i dropped = _mm512_set1_epi64(-1);
+    const __m512d lanes = load_table_avx512(table);
+
+    Eigen::Index i = 0;
+    for (; i + 8 <= num_raw_samples; i += 8)
+    {
+        const __m512i targets = _mm512_loadu_si512(raw_to_target + i);
+        const __mmask8 keep = _mm512_cmpneq_epi64_mask(targets, dropped);
+        if (keep == 0)
+        {
+            continue;
+        }
+        const __m512d values = decode8_avx512(src, i, lanes);
+        if constexpr (std::is_same_v<T, float>)
+        {
+            _mm512_mask_i64scatter_ps(
+                dst, keep, targets, _mm512_cvtpd_ps(values), sizeof(float));
+        }
+        else
+        {
+            _mm512_mask_i64scatter_pd(
+                dst, keep, targets, values, sizeof(double));
+        }
+    }
+    return i;
+}
+
+void dense_avx512(const uint8_t* src, Eigen::Index num_samples, double* dst)
+{
+    const Eigen::Index done
+        = dense_avx512_until(src, num_samples, kGenotypeDosages, dst);
+    dense_scalar_from(src, done, num_samples, dst);
+}
+
+void sparse_avx512(
+    const uint8_t* src,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    double* dst)
+{
+    const Eigen::Index done = sparse_avx512_until(
+        src, num_raw_samples, raw_to_target, kGenotypeDosages, dst);
+    sparse_scalar_from(src, done, num_raw_samples, raw_to_target, dst);
+}
+
+void dense_mapped_avx512(
+    const uint8_t* src,
+    Eigen::Index num_samples,
+    const GenotypeCodeTable& table,
+    double* dst)
+{
+    const Eigen::Index done = dense_avx512_until(src, num_samples, table, dst);
+    dense_mapped_tail(src, done, num_samples, table, dst);
+}
+
+template <typename T>
+void sparse_mapped_avx512(
+    const uint8_t* src,
+    Eigen::Index num_raw_samples,
+    const Eigen::Index* raw_to_target,
+    const GenotypeCodeTable& table,
+    T* dst)
+{
+    const Eigen::Index done = sparse_avx512_until(
+        src, num_raw_samples, raw_to_target, table, dst);
+    sparse_mapped_scalar_from(
+        src, done, num_raw_samples, raw_to_target, table, dst);
+}
+
+#endif  // GELEX_DECODE_X86
+
+constexpr DecodeKernel kScalarKernel{
+    .name = "scalar",
+    .dense = dense_scalar,
+    .sparse = sparse_scalar,
+    .dense_mapped = dense_mapped_scalar<double>,
+    .sparse_mapped = sparse_mapped_scalar<double>,
+    .dense_mapped_f32 = dense_mapped_scalar<float>,
+    .sparse_mapped_f32 = sparse_mapped_scalar<float>,
+    .count = count_scalar};
+
+#ifdef GELEX_DECODE_X86
+// AVX2 has no scatter, so the sparse paths stay scalar, and so do the
+// double ones (see above); the kernel adds the float permute and POPCNT.
+constexpr DecodeKernel kAvx2Kernel{
+    .name = "avx2",
+    .dense = dense_scalar,
+    .sparse = sparse_scalar,
+    .dense_mapped = dense_mapped_scalar<double>,
+    .sparse_mapped = sparse_mapped_scalar<double>,
+    .dense_mapped_f32 = dense_mapped_f32_avx2,
+    .sparse_mapped_f32 = sparse_mapped_scalar<float>,
+    .count = count_popcnt};
+
+// Each slot takes the fastest implementation the CPU can run, not only the
+// AVX-512 ones: the AVX2 float permute outruns the narrowed AVX-512 decode
+// (4.61 vs 4.31 Gsample/s in benchmark_decode_kernels.cpp), and every
+// AVX-512 CPU also has AVX2.
+constexpr DecodeKernel kAvx512Kernel{
+    .name = "avx512",
+    .dense = dense_avx512,
+    .sparse = sparse_avx512,
+    .dense_mapped = dense_mapped_avx512,
+    .sparse_mapped = sparse_mapped_avx512<double>,
+    .dense_mapped_f32 = dense_mapped_f32_avx2,
+    .sparse_mapped_f32 = sparse_mapped_avx512<float>,
+    .count = count_popcnt};
+#endif
+
+}  // namespace
+
+auto available_decode_kernels() -> std::vector<const DecodeKernel*>
+{
+    std::vector<const DecodeKernel*> kernels{&kScalarKernel};
+#ifdef GELEX_DECODE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels.push_back(&kAvx2Kernel);
+    }
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        kernels.push_back(&kAvx512Kernel);
+    }
+#endif
+    return kernels;
+}
+
+auto decode_kernel() -> const DecodeKernel&
+{
+    static const DecodeKernel& selected = *available_decode_kernels().back();
+    return selected;
+}
+
+}  // namespace gelex::detail
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_BED_PIPE_DECODE_KERNELS_H_
+#define GELEX_DATA_BED_PIPE_DECODE_KERNELS_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/types/genetic_effect_type.h"
+
+namespace gelex::detail
+{
+
+/**
+ * @brief One implementation of the packed 2-bit BED -> double expansion.
+ *
+ * `dense` writes the first `num_samples` genotypes of a variant to `dst`.
+ * `sparse` writes raw sample `i` to `dst[raw_to_target[i]]`, skipping
+ * samples mapped to -1. The `*_mapped` variants write `table[code]` instead
+ * of the dosage, so a locus can be emitted already encoded and scaled;
+ * the `*_mapped_f32` variants write it in single precision, for kernels
+ * that consume floats.
+ *
+ * `count` adds the codes of the samples selected by `keep` to `counts`;
+ * `keep` has the bit pattern 0b01 for every selected sample, packed like
+ * the variant itself and padded with zeros to whole 64-bit words.
+ *
+ * A kernel may fill a slot with a narrower instruction set's
+ * implementation where that one measured faster.
+ */
+struct DecodeKernel
+{
+    std::string_view name;
+    void (*dense)(const uint8_t* src, Eigen::Index num_samples, double* dst);
+    void (*sparse)(
+        const uint8_t* src,
+        Eigen::Index num_raw_samples,
+        const Eigen::Index* raw_to_target,
+        double* dst);
+    void (*dense_mapped)(
+        const uint8_t* src,
+        Eigen::Index num_samples,
+        const GenotypeCodeTable& table,
+        double* dst);
+    void (*sparse_mapped)(
+        const uint8_t* src,
+        Eigen::Index num_raw_samples,
+        const Eigen::Index* raw_to_target,
+        const GenotypeCodeTable& table,
+        double* dst);
+    void (*dense_mapped_f32)(
+        const uint8_t* src,
+        Eigen::Index num_samples,
+        const GenotypeCodeTable& table,
+        float* dst);
+    void (*sparse_mapped_f32)(
+        const uint8_t* src,
+        Eigen::Index num_raw_samples,
+        const Eigen::Index* raw_to_target,
+        const GenotypeCodeTable& table,
+        float* dst);
+    void (*count)(
+        const uint8_t* src,
+        Eigen::Index num_bytes,
+        const uint64_t* keep,
+        GenotypeCodeCounts& counts);
+};
+
+// Fastest kernel the running CPU supports; resolved once on first use.
+auto decode_kernel() -> const DecodeKernel&;
+
+// Every kernel the running CPU supports, scalar first.
+auto available_decode_kernels() -> std::vector<const DecodeKernel*>;
+
+}  // namespace gelex::detail
+
+#endif  // GELEX_DATA_BED_PIPE_DECODE_KERNELS_H_
@@ -16,25 +16,53 @@
 
 #include "metadata.h"
 
+#include <fstream>
+#include <string>
+
 #include "gelex/data/loader/fam_loader.h"
 #include "gelex/io/parser.h"
 
 namespace gelex::detail
 {
 
+namespace
+{
+
+// .pvar files carry "##" meta lines and a "#CHROM" header
+auto count_pvar_variants(const std::filesystem::path& pvar_path) -> size_t
+{
+    auto file = open_file<std::ifstream>(pvar_path, std::ios::in);
+    size_t count = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && !line.starts_with('#'))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
 auto load_bed_metadata(const std::filesystem::path& bed_prefix) -> BedMetadata
 {
     auto bed_path = bed_prefix;
-    bed_path.replace_extension(".bed");
-    auto bim_path = bed_prefix;
-    bim_path.replace_extension(".bim");
-    auto fam_path = bed_prefix;
-    fam_path.replace_extension(".fam");
+    if (genotype_format(bed_path) != GenotypeFormat::Pgen)
+    {
+        bed_path.replace_extension(".bed");
+    }
+    auto bim_path = variant_info_path(bed_path);
+    auto fam_path = sample_info_path(bed_path);
 
     BedMetadata metadata;
     metadata.bed_path = bed_path;
-    metadata.num_raw_snps
-        = static_cast<Eigen::Index>(count_total_lines(bim_path));
+    metadata.format = genotype_format(bed_path);
+    metadata.num_raw_snps = static_cast<Eigen::Index>(
+        metadata.format == GenotypeFormat::Pgen
+            ? count_pvar_variants(bim_path)
+            : count_total_lines(bim_path));
 
     FamLoader fam_loader(fam_path);
     metadata.raw_ids = fam_loader.ids();
@@ -23,12 +23,15 @@
 
 #include <Eigen/Core>
 
+#include "gelex/data/genotype/bed_path.h"
+
 namespace gelex::detail
 {
 
 struct BedMetadata
 {
     std::filesystem::path bed_path;
+    GenotypeFormat format = GenotypeFormat::Bed;
     Eigen::Index num_raw_samples = 0;
     Eigen::Index num_raw_snps = 0;
     Eigen::Index bytes_per_variant = 0;
@@ -0,0 +1,530 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pgen_reader.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <system_error>
+
+#include "gelex/exception.h"
+
+namespace gelex::detail
+{
+
+namespace
+{
+
+constexpr uint8_t kPgenMagic0 = 0x6C;
+constexpr uint8_t kPgenMagic1 = 0x1B;
+constexpr uint8_t kModeBedLayout = 0x01;
+constexpr uint8_t kModeVariableWidth = 0x10;
+
+// magic, mode, variant count, sample count, control byte
+constexpr size_t kBedLayoutHeaderSize = 3;
+constexpr size_t kHeaderSize = 12;
+constexpr size_t kBlockSize = 65536;
+constexpr size_t kDifflistGroupSize = 64;
+
+// low three bits of a variant record type
+constexpr uint8_t kVrtypePlain = 0;
+constexpr uint8_t kVrtypeOneBit = 1;
+constexpr uint8_t kVrtypeLd = 2;
+constexpr uint8_t kVrtypeLdInverted = 3;
+constexpr uint8_t kVrtypeInvalid = 5;
+constexpr uint8_t kVrtypeMultiallelic = 0x08;
+
+// PLINK 2 codes 0/1/2/3 (hom REF, het, hom ALT, missing) to the BED codes
+// 11/10/00/01, four genotypes per byte; `invert` swaps 0 and 2 first.
+consteval auto make_bed_table(bool invert) -> std::array<uint8_t, 256>
+{
+    constexpr std::array<unsigned, 4> to_bed{0b11, 0b10, 0b00, 0b01};
+    std::array<uint8_t, 256> table{};
+    for (unsigned byte = 0; byte < 256; ++byte)
+    {
+        unsigned out = 0;
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            unsigned code = (byte >> (2 * k)) & 3;
+            if (invert && (code == 0 || code == 2))
+            {
+                code = 2 - code;
+            }
+            out |= to_bed[code] << (2 * k);
+        }
+        table[byte] = static_cast<uint8_t>(out);
+    }
+    return table;
+}
+
+constexpr auto kToBed = make_bed_table(false);
+constexpr auto kToBedInverted = make_bed_table(true);
+
+// spreads the 4 bits of a nibble to the low bit of 4 genotype slots
+consteval auto make_spread_table() -> std::array<uint8_t, 16>
+{
+    std::array<uint8_t, 16> table{};
+    for (unsigned nibble = 0; nibble < 16; ++nibble)
+    {
+        unsigned out = 0;
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            out |= ((nibble >> k) & 1U) << (2 * k);
+        }
+        table[nibble] = static_cast<uint8_t>(out);
+    }
+    return table;
+}
+
+constexpr auto kSpread = make_spread_table();
+
+auto load_le(const uint8_t* ptr, size_t num_bytes) -> uint64_t
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < num_bytes; ++i)
+    {
+        value |= static_cast<uint64_t>(ptr[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Bounds-checked walk over one record.
+struct RecordCursor
+{
+    const uint8_t* ptr;
+    const uint8_t* end;
+
+    // nullptr when fewer than `n` bytes are left
+    auto take(size_t n) -> const uint8_t*
+    {
+        if (n > static_cast<size_t>(end - ptr))
+        {
+            return nullptr;
+        }
+        const uint8_t* out = ptr;
+        ptr += n;
+        return out;
+    }
+
+    auto varint(uint32_t& value) -> bool
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 32 && ptr < end; shift += 7)
+        {
+            const uint8_t byte = *ptr++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void set_code(std::span<uint8_t> geno, size_t sample, unsigned code)
+{
+    uint8_t& byte = geno[sample / 4];
+    const unsigned shift = 2 * (sample % 4);
+    byte = static_cast<uint8_t>((byte & ~(3U << shift)) | (code << shift));
+}
+
+// Difflist: a varint length L, then ceil(L / 64) groups given by their first
+// sample id and a skip byte each (except the last), the L packed genotypes
+// and varint deltas between the remaining sample ids of every group.
+auto apply_difflist(
+    RecordCursor& cursor,
+    size_t num_samples,
+    size_t sample_id_bytes,
+    std::span<uint8_t> geno) -> bool
+{
+    uint32_t length = 0;
+    if (!cursor.varint(length))
+    {
+        return false;
+    }
+    if (length == 0)
+    {
+        return true;
+    }
+    const size_t num_groups
+        = (length + kDifflistGroupSize - 1) / kDifflistGroupSize;
+    const uint8_t* group_ids = cursor.take(num_groups * sample_id_bytes);
+    // skip bytes only help random access into the groups
+    const uint8_t* skips = cursor.take(num_groups - 1);
+    const uint8_t* codes = cursor.take((length + 3) / 4);
+    if (group_ids == nullptr || skips == nullptr || codes == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t sample = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (i % kDifflistGroupSize == 0)
+        {
+            sample = load_le(
+                group_ids + ((i / kDifflistGroupSize) * sample_id_bytes),
+                sample_id_bytes);
+        }
+        else
+        {
+            uint32_t delta = 0;
+            if (!cursor.varint(delta) || delta == 0)
+            {
+                return false;
+            }
+            sample += delta;
+        }
+        if (sample >= num_samples)
+        {
+            return false;
+        }
+        set_code(geno, sample, (codes[i / 4] >> (2 * (i % 4))) & 3U);
+    }
+    return true;
+}
+
+void translate(
+    std::span<const uint8_t> geno,
+    uint8_t* dst,
+    const std::array<uint8_t, 256>& table)
+{
+    for (size_t i = 0; i < geno.size(); ++i)
+    {
+        dst[i] = table[geno[i]];
+    }
+}
+
+}  // namespace
+
+PgenReader::PgenReader(
+    const std::filesystem::path& pgen_path,
+    Eigen::Index num_raw_snps,
+    Eigen::Index num_raw_samples)
+    : path_(pgen_path.string()),
+      num_raw_snps_(num_raw_snps),
+      num_raw_samples_(num_raw_samples),
+      bytes_per_variant_((num_raw_samples + 3) / 4)
+{
+    if (num_raw_samples_ <= 0)
+    {
+        throw FileFormatException(
+            std::format("{}: invalid bytes per variant", path_));
+    }
+    // sample ids in difflists take just enough bytes for the sample count
+    sample_id_bytes_
+        = ((std::bit_width(static_cast<uint64_t>(num_raw_samples_)) - 1) / 8)
+          + 1;
+
+    std::error_code ec;
+    mmap_.map(path_, ec);
+    if (ec)
+    {
+        throw FileOpenException(
+            std::format("{}: failed to mmap pgen file", path_));
+    }
+    if (mmap_.size() < kBedLayoutHeaderSize)
+    {
+        throw FileFormatException(
+            std::format("{}: pgen file too short", path_));
+    }
+    data_ = reinterpret_cast<const uint8_t*>(mmap_.data());
+    if (data_[0] != kPgenMagic0 || data_[1] != kPgenMagic1)
+    {
+        throw FileFormatException(
+            std::format("{}: invalid PGEN magic number", path_));
+    }
+
+    parse_index();
+}
+
+void PgenReader::parse_index()
+{
+    const auto num_snps = static_cast<size_t>(num_raw_snps_);
+    const size_t size = mmap_.size();
+    const uint8_t mode = data_[2];
+
+    if (mode == kModeBedLayout)
+    {
+        const size_t expected = kBedLayoutHeaderSize
+                                + (num_snps
+                                   * static_cast<size_t>(bytes_per_variant_));
+        if (size < expected)
+        {
+            throw FileFormatException(
+                std::format(
+                    "{}: pgen file truncated. Expected {} bytes, got {}",
+                    path_,
+                    expected,
+                    size));
+        }
+        bed_layout_ = true;
+        return;
+    }
+    if (mode != kModeVariableWidth)
+    {
+        throw FileFormatException(
+            std::format(
+                "{}: unsupported pgen storage mode 0x{:02x} (expected 0x01 "
+                "or 0x10; a separate .pgi index is not supported)",
+                path_,
+                mode));
+    }
+
+    if (size < kHeaderSize)
+    {
+        throw FileFormatException(
+            std::format("{}: pgen header truncated", path_));
+    }
+    size_t pos = kHeaderSize;
+    auto take = [&](size_t n) -> const uint8_t*
+    {
+        if (n > size - pos)
+        {
+            throw FileFormatException(
+                std::format("{}: pgen header truncated", path_));
+        }
+        const uint8_t* out = data_ + pos;
+        pos += n;
+        return out;
+    };
+
+    const uint64_t header_snps = load_le(data_ + 3, 4);
+    const uint64_t header_samples = load_le(data_ + 7, 4);
+    if (header_snps != num_snps
+        || header_samples != static_cast<uint64_t>(num_raw_samples_))
+    {
+        throw FileFormatException(
+            std::format(
+                "{}: header declares {} variants and {} samples, "
+                ".pvar/.psam list {} and {}",
+                path_,
+                header_snps,
+                header_samples,
+                num_snps,
+                num_raw_samples_));
+    }
+
+    const uint8_t control = data_[11];
+    const unsigned storage = control & 15U;
+    if (storage >= 8)
+    {
+        throw FileFormatException(
+            std::format(
+                "{}: unsupported pgen record layout {}", path_, storage));
+    }
+    // 4-bit record types when no phase/dosage track is present
+    const bool wide_vrtypes = storage >= 4;
+    const size_t length_bytes = (storage & 3U) + 1;
+    const size_t allele_count_bytes = (control >> 4) & 3U;
+    const bool has_nonref_flags = (control >> 6) == 3;
+
+    const size_t num_blocks = (num_snps + kBlockSize - 1) / kBlockSize;
+    const uint8_t* block_offsets = take(num_blocks * 8);
+
+    vrtypes_.resize(num_snps);
+    offsets_.assign(num_snps + 1, 0);
+    for (size_t block = 0; block < num_blocks; ++block)
+    {
+        const size_t first = block * kBlockSize;
+        const size_t count = std::min(kBlockSize, num_snps - first);
+        const uint8_t* types = take(wide_vrtypes ? count : (count + 1) / 2);
+        const uint8_t* lengths = take(count * length_bytes);
+        take(count * allele_count_bytes);
+        if (has_nonref_flags)
+        {
+            take((count + 7) / 8);
+        }
+
+        uint64_t offset = load_le(block_offsets + (block * 8), 8);
+        if (block > 0 && offset != offsets_[first])
+        {
+            throw FileFormatException(
+                std::format("{}: variant blocks are not contiguous", path_));
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t vrtype
+                = wide_vrtypes ? types[i]
+                               : static_cast<uint8_t>(
+                                     (types[i / 2] >> (4 * (i % 2))) & 15U);
+            if ((vrtype & kVrtypeMultiallelic) != 0)
+            {
+                throw FileFormatException(
+                    std::format(
+                        "{}: variant {} has multiallelic hardcalls, which "
+                        "are not supported",
+                        path_,
+                        first + i));
+            }
+            vrtypes_[first + i] = vrtype;
+            offsets_[first + i] = offset;
+            offset += load_le(lengths + (i * length_bytes), length_bytes);
+        }
+        offsets_[first + count] = offset;
+    }
+
+    if (offsets_.back() > size)
+    {
+        throw FileFormatException(
+            std::format(
+                "{}: pgen file truncated. Expected {} bytes, got {}",
+                path_,
+                offsets_.back(),
+                size));
+    }
+    if (num_snps > 0 && is_ld(0))
+    {
+        corrupt(0);
+    }
+}
+
+auto PgenReader::is_ld(Eigen::Index variant) const -> bool
+{
+    const unsigned vrtype = vrtypes_[static_cast<size_t>(variant)] & 7U;
+    return vrtype == kVrtypeLd || vrtype == kVrtypeLdInverted;
+}
+
+auto PgenReader::record(Eigen::Index variant) const -> std::span<const uint8_t>
+{
+    const auto j = static_cast<size_t>(variant);
+    return {data_ + offsets_[j], data_ + offsets_[j + 1]};
+}
+
+void PgenReader::decode_base(
+    Eigen::Index variant,
+    std::span<uint8_t> geno) const
+{
+    const unsigned vrtype = vrtypes_[static_cast<size_t>(variant)] & 7U;
+    const auto rec = record(variant);
+    RecordCursor cursor{rec.data(), rec.data() + rec.size()};
+
+    if (vrtype == kVrtypePlain)
+    {
+        const uint8_t* src = cursor.take(geno.size());
+        if (src == nullptr)
+        {
+            corrupt(variant);
+        }
+        std::memcpy(geno.data(), src, geno.size());
+        return;
+    }
+
+    if (vrtype == kVrtypeOneBit)
+    {
+        // the set bits take `low + delta`, the others `low`; a difflist
+        // patches the remaining genotypes
+        const uint8_t* head = cursor.take(1);
+        const uint8_t* bits
+            = cursor.take(static_cast<size_t>((num_raw_samples_ + 7) / 8));
+        if (head == nullptr || bits == nullptr || (*head / 4) + (*head & 3) > 3)
+        {
+            corrupt(variant);
+        }
+        const unsigned low = *head / 4U;
+        const unsigned delta = *head & 3U;
+        for (size_t i = 0; i < geno.size(); ++i)
+        {
+            const unsigned nibble = (bits[i / 2] >> (4 * (i % 2))) & 15U;
+            geno[i] = static_cast<uint8_t>(
+                (low * 0x55U) + (delta * kSpread[nibble]));
+        }
+    }
+    else if (vrtype == kVrtypeInvalid || vrtype == kVrtypeLd
+             || vrtype == kVrtypeLdInverted)
+    {
+        corrupt(variant);
+    }
+    else
+    {
+        // 4/6/7: everything but the difflist is genotype `vrtype & 3`
+        std::ranges::fill(geno, static_cast<uint8_t>((vrtype & 3U) * 0x55U));
+    }
+
+    if (!apply_difflist(
+            cursor,
+            static_cast<size_t>(num_raw_samples_),
+            sample_id_bytes_,
+            geno))
+    {
+        corrupt(variant);
+    }
+}
+
+void PgenReader::read(Eigen::Index start, Eigen::Index end, uint8_t* dst)
+    const
+{
+    const auto bytes = static_cast<size_t>(bytes_per_variant_);
+    if (bed_layout_)
+    {
+        std::memcpy(
+            dst,
+            data_ + kBedLayoutHeaderSize + (static_cast<size_t>(start) * bytes),
+            static_cast<size_t>(end - start) * bytes);
+        return;
+    }
+
+    // `base` holds the last variant that is not LD-compressed
+    std::vector<uint8_t> base(bytes);
+    std::vector<uint8_t> geno(bytes);
+    if (start < end && is_ld(start))
+    {
+        Eigen::Index base_variant = start;
+        while (is_ld(base_variant))
+        {
+            --base_variant;
+        }
+        decode_base(base_variant, base);
+    }
+
+    for (Eigen::Index j = start; j < end; ++j)
+    {
+        uint8_t* out = dst + (static_cast<size_t>(j - start) * bytes);
+        if (!is_ld(j))
+        {
+            decode_base(j, base);
+            translate(base, out, kToBed);
+            continue;
+        }
+
+        std::ranges::copy(base, geno.begin());
+        const auto rec = record(j);
+        RecordCursor cursor{rec.data(), rec.data() + rec.size()};
+        if (!apply_difflist(
+                cursor,
+                static_cast<size_t>(num_raw_samples_),
+                sample_id_bytes_,
+                geno))
+        {
+            corrupt(j);
+        }
+        const bool inverted
+            = (vrtypes_[static_cast<size_t>(j)] & 7U) == kVrtypeLdInverted;
+        translate(geno, out, inverted ? kToBedInverted : kToBed);
+    }
+}
+
+void PgenReader::corrupt(Eigen::Index variant) const
+{
+    throw FileFormatException(
+        std::format("{}: malformed record for variant {}", path_, variant));
+}
+
+}  // namespace gelex::detail
@@ -53,6 +53,31 @@ SampleProjection::SampleProjection(
     is_dense_mapping_ = sequential && (mapped_count == num_raw_samples)
                         && (static_cast<size_t>(num_raw_samples)
                             == sample_manager->num_common_samples());
+    // target ids are unique, so distinct raw samples never share a row
+    covers_targets_ = static_cast<size_t>(mapped_count)
+                      == sample_manager->num_common_samples();
+
+    target_to_raw_.assign(sample_manager->num_common_samples(), -1);
+    for (Eigen::Index i = 0; i < num_raw_samples; ++i)
+    {
+        const Eigen::Index target = raw_to_target_sample_idx_[i];
+        if (target == -1)
+        {
+            continue;
+        }
+        target_to_raw_[static_cast<size_t>(target)] = i;
+        if (!runs_.empty())
+        {
+            auto& last = runs_.back();
+            if (last.raw_begin + last.length == i
+                && last.target_begin + last.length == target)
+            {
+                ++last.length;
+                continue;
+            }
+        }
+        runs_.push_back({.raw_begin = i, .target_begin = target, .length = 1});
+    }
 }
 
 auto SampleProjection::mapping() const -> const std::vector<Eigen::Index>&
@@ -65,4 +90,20 @@ auto SampleProjection::is_dense() const -> bool
     return is_dense_mapping_;
 }
 
+auto SampleProjection::runs() const -> const std::vector<GatherRun>&
+{
+    return runs_;
+}
+
+auto SampleProjection::target_to_raw() const
+    -> const std::vector<Eigen::Index>&
+{
+    return target_to_raw_;
+}
+
+auto SampleProjection::covers_targets() const -> bool
+{
+    return covers_targets_;
+}
+
 }  // namespace gelex::detail
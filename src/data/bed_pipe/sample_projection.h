@@ -28,6 +28,14 @@
 namespace gelex::detail
 {
 
+// Consecutive raw samples that land on consecutive target rows.
+struct GatherRun
+{
+    Eigen::Index raw_begin;
+    Eigen::Index target_begin;
+    Eigen::Index length;
+};
+
 class SampleProjection
 {
    public:
@@ -39,9 +47,25 @@ class SampleProjection
 
     [[nodiscard]] auto is_dense() const -> bool;
 
+    // Gather plan: the kept raw samples as maximal runs, in raw order.
+    // A subset that keeps FAM order is a handful of long runs; dropped
+    // samples only split them.
+    [[nodiscard]] auto runs() const -> const std::vector<GatherRun>&;
+
+    // Raw sample feeding each target row, -1 for rows no sample feeds.
+    [[nodiscard]] auto target_to_raw() const
+        -> const std::vector<Eigen::Index>&;
+
+    // Whether every target row is fed by some raw sample; rows that are
+    // not are left to the caller (BedPipe fills them with NaN).
+    [[nodiscard]] auto covers_targets() const -> bool;
+
    private:
     std::vector<Eigen::Index> raw_to_target_sample_idx_;
+    std::vector<Eigen::Index> target_to_raw_;
+    std::vector<GatherRun> runs_;
     bool is_dense_mapping_ = false;
+    bool covers_targets_ = false;
 };
 
 }  // namespace gelex::detail
@@ -16,113 +16,187 @@
 
 #include "variant_decoder.h"
 
-#include <cstring>
-
-#include "data/decode_lut.h"
+#include <type_traits>
 
 namespace gelex::detail
 {
 
-BedVariantDecoder::BedVariantDecoder(
-    Eigen::Index num_raw_samples,
-    Eigen::Index bytes_per_variant,
-    const std::vector<Eigen::Index>& raw_to_target_sample_idx,
-    bool is_dense_mapping)
-    : num_raw_samples_(num_raw_samples),
-      bytes_per_variant_(bytes_per_variant),
-      raw_to_target_sample_idx_(raw_to_target_sample_idx),
-      is_dense_mapping_(is_dense_mapping)
+namespace
 {
-}
 
-void BedVariantDecoder::decode(
+// Runs shorter than this on average cost more in per-run setup than a
+// per-row gather spends on them.
+constexpr Eigen::Index kMinMeanRunLength = 8;
+
+auto decode_sample(
     const uint8_t* data_ptr,
-    std::span<double> target_buf) const
+    Eigen::Index sample,
+    const GenotypeCodeTable& table) -> double
 {
-    if (is_dense_mapping_)
+    return table[(data_ptr[sample >> 2] >> (2 * (sample & 3))) & 3];
+}
+
+}  // namespace
+
+BedVariantDecoder::BedVariantDecoder(
+    Eigen::Index num_raw_samples,
+    const SampleProjection& projection,
+    const DecodeKernel& kernel)
+    : num_raw_samples_(num_raw_samples),
+      raw_to_target_sample_idx_(projection.mapping()),
+      target_to_raw_(projection.target_to_raw()),
+      runs_(projection.runs()),
+      kernel_(&kernel),
+      bytes_per_variant_((num_raw_samples + 3) / 4),
+      keep_mask_(static_cast<size_t>((bytes_per_variant_ + 7) / 8), 0)
+{
+    Eigen::Index num_kept = 0;
+    for (const auto& run : runs_)
     {
-        decode_dense(data_ptr, target_buf);
-        return;
+        num_kept += run.length;
+        for (Eigen::Index i = run.raw_begin; i < run.raw_begin + run.length;
+             ++i)
+        {
+            keep_mask_[i / 32] |= uint64_t{1} << (2 * (i % 32));
+        }
     }
 
-    decode_sparse(data_ptr, target_buf);
+    if (projection.is_dense())
+    {
+        layout_ = Layout::Dense;
+    }
+    else if (!projection.covers_targets())
+    {
+        layout_ = Layout::Scattered;
+    }
+    else if (
+        num_kept >= kMinMeanRunLength * static_cast<Eigen::Index>(runs_.size()))
+    {
+        layout_ = Layout::Runs;
+    }
+    else
+    {
+        layout_ = Layout::Permuted;
+    }
 }
 
-void BedVariantDecoder::decode_dense(
+template <typename T>
+void BedVariantDecoder::expand(
     const uint8_t* data_ptr,
-    std::span<double> target_buf) const
+    const GenotypeCodeTable& table,
+    T* target) const
 {
-    const auto& lut = kDecodeLut;
-    const Eigen::Index num_bytes = bytes_per_variant_;
-    const Eigen::Index total_samples = num_raw_samples_;
-
-    for (Eigen::Index i = 0; i < num_bytes; ++i)
+    constexpr bool kSingle = std::is_same_v<T, float>;
+    const auto dense_mapped = [this, &table](
+                                  const uint8_t* src,
+                                  Eigen::Index num_samples,
+                                  T* dst)
     {
-        const uint8_t byte = data_ptr[i];
-        const auto& vals = lut[byte];
-
-        const Eigen::Index base_idx = i * 4;
-        if (base_idx + 4 <= total_samples)
+        if constexpr (kSingle)
         {
-            std::memcpy(&target_buf[base_idx], vals.data(), 4 * sizeof(double));
+            kernel_->dense_mapped_f32(src, num_samples, table, dst);
         }
         else
         {
-            for (int k = 0; k < 4 && (base_idx + k) < total_samples; ++k)
+            kernel_->dense_mapped(src, num_samples, table, dst);
+        }
+    };
+
+    switch (layout_)
+    {
+        case Layout::Dense:
+            dense_mapped(data_ptr, num_raw_samples_, target);
+            break;
+        case Layout::Runs:
+            for (const auto& run : runs_)
             {
-                target_buf[base_idx + k] = vals[k];
+                Eigen::Index raw = run.raw_begin;
+                const Eigen::Index raw_end = raw + run.length;
+                T* dst = target + run.target_begin;
+
+                // samples before the first whole byte of the run
+                for (; raw < raw_end && (raw & 3) != 0; ++raw)
+                {
+                    *dst++
+                        = static_cast<T>(decode_sample(data_ptr, raw, table));
+                }
+                dense_mapped(data_ptr + (raw >> 2), raw_end - raw, dst);
             }
-        }
+            break;
+        case Layout::Permuted:
+            for (size_t t = 0; t < target_to_raw_.size(); ++t)
+            {
+                target[t] = static_cast<T>(
+                    decode_sample(data_ptr, target_to_raw_[t], table));
+            }
+            break;
+        case Layout::Scattered:
+            if constexpr (kSingle)
+            {
+                kernel_->sparse_mapped_f32(
+                    data_ptr,
+                    num_raw_samples_,
+                    raw_to_target_sample_idx_.data(),
+                    table,
+                    target);
+            }
+            else
+            {
+                kernel_->sparse_mapped(
+                    data_ptr,
+                    num_raw_samples_,
+                    raw_to_target_sample_idx_.data(),
+                    table,
+                    target);
+            }
+            break;
     }
 }
 
-void BedVariantDecoder::decode_sparse(
+void BedVariantDecoder::decode(
     const uint8_t* data_ptr,
     std::span<double> target_buf) const
 {
-    const auto& lut = kDecodeLut;
-    const Eigen::Index num_bytes = bytes_per_variant_;
-
-    for (Eigen::Index i = 0; i < num_bytes; ++i)
+    // the plain dosage kernels have their own fast paths for these two
+    if (layout_ == Layout::Dense)
     {
-        const uint8_t byte = data_ptr[i];
-        const auto& vals = lut[byte];
-
-        const Eigen::Index base_raw_idx = i * 4;
-
-        if (Eigen::Index tidx = raw_to_target_sample_idx_[base_raw_idx];
-            tidx != -1)
-        {
-            target_buf[tidx] = vals[0];
-        }
+        kernel_->dense(data_ptr, num_raw_samples_, target_buf.data());
+        return;
+    }
+    if (layout_ == Layout::Scattered)
+    {
+        kernel_->sparse(
+            data_ptr,
+            num_raw_samples_,
+            raw_to_target_sample_idx_.data(),
+            target_buf.data());
+        return;
+    }
+    expand(data_ptr, kGenotypeDosages, target_buf.data());
+}
 
-        if (base_raw_idx + 1 < num_raw_samples_) [[likely]]
-        {
-            if (Eigen::Index tidx = raw_to_target_sample_idx_[base_raw_idx + 1];
-                tidx != -1)
-            {
-                target_buf[tidx] = vals[1];
-            }
-        }
+void BedVariantDecoder::decode(
+    const uint8_t* data_ptr,
+    std::span<double> target_buf,
+    const GenotypeCodeTable& values) const
+{
+    expand(data_ptr, values, target_buf.data());
+}
 
-        if (base_raw_idx + 2 < num_raw_samples_) [[likely]]
-        {
-            if (Eigen::Index tidx = raw_to_target_sample_idx_[base_raw_idx + 2];
-                tidx != -1)
-            {
-                target_buf[tidx] = vals[2];
-            }
-        }
+void BedVariantDecoder::decode(
+    const uint8_t* data_ptr,
+    std::span<float> target_buf,
+    const GenotypeCodeTable& values) const
+{
+    expand(data_ptr, values, target_buf.data());
+}
 
-        if (base_raw_idx + 3 < num_raw_samples_) [[likely]]
-        {
-            if (Eigen::Index tidx = raw_to_target_sample_idx_[base_raw_idx + 3];
-                tidx != -1)
-            {
-                target_buf[tidx] = vals[3];
-            }
-        }
-    }
+auto BedVariantDecoder::count(const uint8_t* data_ptr) const
+    -> GenotypeCodeCounts
+{
+    GenotypeCodeCounts counts{};
+    kernel_->count(data_ptr, bytes_per_variant_, keep_mask_.data(), counts);
+    return counts;
 }
 
 }  // namespace gelex::detail
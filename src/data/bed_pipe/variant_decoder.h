@@ -22,31 +22,67 @@
 
 #include <Eigen/Core>
 
+#include "decode_kernels.h"
+#include "sample_projection.h"
+
 namespace gelex::detail
 {
 
 class BedVariantDecoder
 {
    public:
+    // How kept raw samples reach their target rows, chosen once from the
+    // projection.
+    enum class Layout : uint8_t
+    {
+        Dense,      // identity mapping
+        Runs,       // long order-preserving runs, expanded byte-wise
+        Permuted,   // reordered: one sequential write per target row
+        Scattered,  // some target rows have no sample: scatter kernels
+    };
+
     BedVariantDecoder(
         Eigen::Index num_raw_samples,
-        Eigen::Index bytes_per_variant,
-        const std::vector<Eigen::Index>& raw_to_target_sample_idx,
-        bool is_dense_mapping);
+        const SampleProjection& projection,
+        const DecodeKernel& kernel = decode_kernel());
 
     void decode(const uint8_t* data_ptr, std::span<double> target_buf) const;
 
-   private:
-    void decode_dense(const uint8_t* data_ptr, std::span<double> target_buf)
-        const;
+    // Expands the variant with the given per-code output values, e.g.
+    // those a planner derives from count().
+    void decode(
+        const uint8_t* data_ptr,
+        std::span<double> target_buf,
+        const GenotypeCodeTable& values) const;
+
+    // As above, in single precision.
+    void decode(
+        const uint8_t* data_ptr,
+        std::span<float> target_buf,
+        const GenotypeCodeTable& values) const;
+
+    // Codes of the selected samples, without decoding.
+    [[nodiscard]] auto count(const uint8_t* data_ptr) const
+        -> GenotypeCodeCounts;
 
-    void decode_sparse(const uint8_t* data_ptr, std::span<double> target_buf)
-        const;
+    [[nodiscard]] auto layout() const -> Layout { return layout_; }
+
+   private:
+    template <typename T>
+    void expand(
+        const uint8_t* data_ptr,
+        const GenotypeCodeTable& table,
+        T* target) const;
 
     Eigen::Index num_raw_samples_ = 0;
-    Eigen::Index bytes_per_variant_ = 0;
     const std::vector<Eigen::Index>& raw_to_target_sample_idx_;
-    bool is_dense_mapping_ = false;
+    const std::vector<Eigen::Index>& target_to_raw_;
+    const std::vector<GatherRun>& runs_;
+    Layout layout_ = Layout::Dense;
+    const DecodeKernel* kernel_;
+    Eigen::Index bytes_per_variant_ = 0;
+    // 0b01 per selected raw sample, in the packed BED layout
+    std::vector<uint64_t> keep_mask_;
 };
 
 }  // namespace gelex::detail
@@ -26,9 +26,15 @@ namespace gelex
 auto format_bed_path(std::string_view bed_path) -> std::filesystem::path
 {
     std::filesystem::path bed(bed_path);
-    if (bed.extension() != ".bed")
+    if (bed.extension() != ".bed" && bed.extension() != ".pgen")
     {
+        auto pgen = bed;
+        pgen += ".pgen";
         bed += ".bed";
+        if (!std::filesystem::exists(bed) && std::filesystem::exists(pgen))
+        {
+            return pgen;
+        }
     }
 
     if (!std::filesystem::exists(bed))
@@ -39,4 +45,26 @@ auto format_bed_path(std::string_view bed_path) -> std::filesystem::path
     return bed;
 }
 
+auto genotype_format(const std::filesystem::path& bed_path) -> GenotypeFormat
+{
+    return bed_path.extension() == ".pgen" ? GenotypeFormat::Pgen
+                                           : GenotypeFormat::Bed;
+}
+
+auto variant_info_path(const std::filesystem::path& bed_path)
+    -> std::filesystem::path
+{
+    auto path = bed_path;
+    return path.replace_extension(
+        genotype_format(bed_path) == GenotypeFormat::Pgen ? ".pvar" : ".bim");
+}
+
+auto sample_info_path(const std::filesystem::path& bed_path)
+    -> std::filesystem::path
+{
+    auto path = bed_path;
+    return path.replace_extension(
+        genotype_format(bed_path) == GenotypeFormat::Pgen ? ".psam" : ".fam");
+}
+
 }  // namespace gelex
@@ -16,15 +16,20 @@
 
 #include "gelex/data/genotype/bed_pipe.h"
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
 #include <format>
 #include <limits>
 #include <memory>
 #include <span>
+#include <utility>
 
 #include <omp.h>
 
 #include "data/bed_pipe/metadata.h"
 #include "data/bed_pipe/mmap_reader.h"
+#include "data/bed_pipe/pgen_reader.h"
 #include "data/bed_pipe/sample_projection.h"
 #include "data/bed_pipe/variant_decoder.h"
 #include "gelex/exception.h"
@@ -51,8 +56,9 @@ auto validate_chunk_range(
     }
 }
 
+template <typename Buffer>
 auto validate_target_buffer_shape(
-    const Eigen::Ref<Eigen::MatrixXd>& target_buf,
+    const Buffer& target_buf,
     Eigen::Index expected_rows,
     Eigen::Index expected_cols) -> void
 {
@@ -81,16 +87,26 @@ BedPipe::BedPipe(
     projection_ = std::make_unique<detail::SampleProjection>(
         metadata.raw_ids, sample_manager_);
 
-    bed_reader_ = std::make_unique<detail::BedMmapReader>(
-        metadata.bed_path, metadata.num_raw_snps, metadata.bytes_per_variant);
+    if (metadata.format == GenotypeFormat::Pgen)
+    {
+        pgen_reader_ = std::make_unique<detail::PgenReader>(
+            metadata.bed_path,
+            metadata.num_raw_snps,
+            metadata.num_raw_samples);
+    }
+    else
+    {
+        bed_reader_ = std::make_unique<detail::BedMmapReader>(
+            metadata.bed_path,
+            metadata.num_raw_snps,
+            metadata.bytes_per_variant);
+    }
 
     decoder_ = std::make_unique<detail::BedVariantDecoder>(
-        metadata.num_raw_samples,
-        metadata.bytes_per_variant,
-        projection_->mapping(),
-        projection_->is_dense());
+        metadata.num_raw_samples, *projection_);
 
     num_raw_snps_ = metadata.num_raw_snps;
+    bytes_per_variant_ = metadata.bytes_per_variant;
 }
 
 BedPipe::BedPipe(BedPipe&&) noexcept = default;
@@ -118,10 +134,12 @@ auto BedPipe::load_chunk(Eigen::Index start_col, Eigen::Index end_col) const
     return result;
 }
 
-void BedPipe::load_chunk(
-    Eigen::Ref<Eigen::MatrixXd> target_buf,
+template <typename Scalar>
+auto BedPipe::prepare_chunk(
+    DecodeBuffer<Scalar> target_buf,
     Eigen::Index start_col,
-    Eigen::Index end_col) const
+    Eigen::Index end_col,
+    std::vector<uint8_t>& staging) const -> const uint8_t*
 {
     const Eigen::Index max_cols = num_snps();
     validate_chunk_range(start_col, end_col, max_cols);
@@ -130,20 +148,111 @@ void BedPipe::load_chunk(
     const Eigen::Index num_output_cols = end_col - start_col;
     validate_target_buffer_shape(target_buf, num_output_rows, num_output_cols);
 
-    if (!projection_->is_dense())
+    if (!projection_->covers_targets())
     {
-        target_buf.setConstant(std::numeric_limits<double>::quiet_NaN());
+        target_buf.setConstant(std::numeric_limits<Scalar>::quiet_NaN());
     }
+    return packed_rows(start_col, end_col, staging);
+}
 
-    const uint8_t* chunk_ptr
-        = bed_reader_->chunk_ptr(start_col, num_output_cols);
-    if (chunk_ptr == nullptr)
+auto BedPipe::raw_variant(Eigen::Index col) const -> Eigen::Index
+{
+    return variants_.empty() ? col : variants_[static_cast<size_t>(col)];
+}
+
+auto BedPipe::packed_rows(
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    std::vector<uint8_t>& staging) const -> const uint8_t*
+{
+    const Eigen::Index num_cols = end_col - start_col;
+    const Eigen::Index first = raw_variant(start_col);
+    const bool contiguous = raw_variant(end_col - 1) - first == num_cols - 1;
+
+    if (!pgen_reader_ && contiguous)
+    {
+        const uint8_t* chunk_ptr = bed_reader_->chunk_ptr(first, num_cols);
+        if (chunk_ptr == nullptr)
+        {
+            throw FileFormatException(
+                "BedPipe::load_chunk: mapped BED payload is truncated");
+        }
+        return chunk_ptr;
+    }
+
+    // Gather the rows into `staging`, one run of consecutive raw variants
+    // at a time; .pgen runs are decoded, BED runs copied.
+    staging.resize(static_cast<size_t>(num_cols * bytes_per_variant_));
+    auto copy_run
+        = [&](Eigen::Index raw_begin, Eigen::Index count, uint8_t* dst)
     {
-        throw FileFormatException(
-            "BedPipe::load_chunk: mapped BED payload is truncated");
+        if (pgen_reader_)
+        {
+            pgen_reader_->read(raw_begin, raw_begin + count, dst);
+            return;
+        }
+        const uint8_t* src = bed_reader_->chunk_ptr(raw_begin, count);
+        if (src == nullptr)
+        {
+            throw FileFormatException(
+                "BedPipe::load_chunk: mapped BED payload is truncated");
+        }
+        std::memcpy(dst, src, static_cast<size_t>(count * bytes_per_variant_));
+    };
+
+    // each thread fills a contiguous slice; exceptions must not escape the
+    // parallel region
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+        const Eigen::Index num_threads = omp_get_num_threads();
+        const Eigen::Index thread = omp_get_thread_num();
+        const Eigen::Index begin = num_cols * thread / num_threads;
+        const Eigen::Index end = num_cols * (thread + 1) / num_threads;
+        try
+        {
+            for (Eigen::Index j = begin; j < end;)
+            {
+                const Eigen::Index raw_begin = raw_variant(start_col + j);
+                Eigen::Index run = 1;
+                while (j + run < end
+                       && raw_variant(start_col + j + run) == raw_begin + run)
+                {
+                    ++run;
+                }
+                copy_run(
+                    raw_begin,
+                    run,
+                    staging.data()
+                        + static_cast<size_t>(j * bytes_per_variant_));
+                j += run;
+            }
+        }
+        catch (...)
+        {
+#pragma omp critical
+            error = std::current_exception();
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
     }
+    return staging.data();
+}
 
-    const Eigen::Index bytes_per_variant = bed_reader_->bytes_per_variant();
+void BedPipe::load_chunk(
+    Eigen::Ref<Eigen::MatrixXd> target_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col) const
+{
+    std::vector<uint8_t> staging;
+    const uint8_t* chunk_ptr
+        = prepare_chunk(target_buf, start_col, end_col, staging);
+
+    const Eigen::Index num_output_rows = target_buf.rows();
+    const Eigen::Index num_output_cols = target_buf.cols();
+    const Eigen::Index bytes_per_variant = bytes_per_variant_;
 
 #pragma omp parallel for schedule(static)
     for (Eigen::Index j = 0; j < num_output_cols; ++j)
@@ -157,6 +266,284 @@ void BedPipe::load_chunk(
     }
 }
 
+template <typename Scalar>
+void BedPipe::load_planned(
+    DecodeBuffer<Scalar> target_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner planner,
+    std::span<LocusStatistic> stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    if (std::cmp_not_equal(stats.size(), end_col - start_col)
+        || (!counts.empty()
+            && std::cmp_not_equal(counts.size(), end_col - start_col)))
+    {
+        throw ArgumentValidationException(
+            "BedPipe::load_chunk: stats or counts size does not match chunk "
+            "range");
+    }
+    std::vector<uint8_t> staging;
+    const uint8_t* chunk_ptr
+        = prepare_chunk(target_buf, start_col, end_col, staging);
+
+    const Eigen::Index num_output_rows = target_buf.rows();
+    const Eigen::Index num_output_cols = target_buf.cols();
+    const Eigen::Index bytes_per_variant = bytes_per_variant_;
+
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index j = 0; j < num_output_cols; ++j)
+    {
+        const uint8_t* src_ptr
+            = chunk_ptr + static_cast<size_t>(j * bytes_per_variant);
+
+        const auto index = static_cast<size_t>(j);
+        const GenotypeCodeCounts variant_counts = decoder_->count(src_ptr);
+        const LocusPlan plan = planner(variant_counts);
+        decoder_->decode(
+            src_ptr,
+            std::span<Scalar>(target_buf.col(j).data(), num_output_rows),
+            plan.values);
+        stats[index] = plan.stats;
+        if (!counts.empty())
+        {
+            counts[index] = variant_counts;
+        }
+    }
+}
+
+void BedPipe::load_chunk(
+    Eigen::Ref<Eigen::MatrixXd> target_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner planner,
+    std::span<LocusStatistic> stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    load_planned<double>(
+        target_buf, start_col, end_col, planner, stats, counts);
+}
+
+void BedPipe::load_chunk(
+    Eigen::Ref<Eigen::MatrixXf> target_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner planner,
+    std::span<LocusStatistic> stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    load_planned<float>(
+        target_buf, start_col, end_col, planner, stats, counts);
+}
+
+template <typename Scalar>
+void BedPipe::load_planned(
+    DecodeBuffer<Scalar> first_buf,
+    DecodeBuffer<Scalar> second_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner first_planner,
+    LocusPlanner second_planner,
+    std::span<LocusStatistic> first_stats,
+    std::span<LocusStatistic> second_stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    if (std::cmp_not_equal(first_stats.size(), end_col - start_col)
+        || std::cmp_not_equal(second_stats.size(), end_col - start_col)
+        || (!counts.empty()
+            && std::cmp_not_equal(counts.size(), end_col - start_col)))
+    {
+        throw ArgumentValidationException(
+            "BedPipe::load_chunk: stats or counts size does not match chunk "
+            "range");
+    }
+    std::vector<uint8_t> staging;
+    const uint8_t* chunk_ptr
+        = prepare_chunk(first_buf, start_col, end_col, staging);
+    validate_target_buffer_shape(
+        second_buf, num_samples(), end_col - start_col);
+    if (!projection_->covers_targets())
+    {
+        second_buf.setConstant(std::numeric_limits<Scalar>::quiet_NaN());
+    }
+
+    const Eigen::Index num_output_rows = first_buf.rows();
+    const Eigen::Index num_output_cols = first_buf.cols();
+    const Eigen::Index bytes_per_variant = bytes_per_variant_;
+
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index j = 0; j < num_output_cols; ++j)
+    {
+        const uint8_t* src_ptr
+            = chunk_ptr + static_cast<size_t>(j * bytes_per_variant);
+        const auto index = static_cast<size_t>(j);
+        // one count feeds both plans
+        const GenotypeCodeCounts variant_counts = decoder_->count(src_ptr);
+        const LocusPlan first = first_planner(variant_counts);
+        const LocusPlan second = second_planner(variant_counts);
+        decoder_->decode(
+            src_ptr,
+            std::span<Scalar>(first_buf.col(j).data(), num_output_rows),
+            first.values);
+        decoder_->decode(
+            src_ptr,
+            std::span<Scalar>(second_buf.col(j).data(), num_output_rows),
+            second.values);
+        first_stats[index] = first.stats;
+        second_stats[index] = second.stats;
+        if (!counts.empty())
+        {
+            counts[index] = variant_counts;
+        }
+    }
+}
+
+void BedPipe::load_chunk(
+    Eigen::Ref<Eigen::MatrixXd> first_buf,
+    Eigen::Ref<Eigen::MatrixXd> second_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner first_planner,
+    LocusPlanner second_planner,
+    std::span<LocusStatistic> first_stats,
+    std::span<LocusStatistic> second_stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    load_planned<double>(
+        first_buf,
+        second_buf,
+        start_col,
+        end_col,
+        first_planner,
+        second_planner,
+        first_stats,
+        second_stats,
+        counts);
+}
+
+void BedPipe::load_chunk(
+    Eigen::Ref<Eigen::MatrixXf> first_buf,
+    Eigen::Ref<Eigen::MatrixXf> second_buf,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    LocusPlanner first_planner,
+    LocusPlanner second_planner,
+    std::span<LocusStatistic> first_stats,
+    std::span<LocusStatistic> second_stats,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    load_planned<float>(
+        first_buf,
+        second_buf,
+        start_col,
+        end_col,
+        first_planner,
+        second_planner,
+        first_stats,
+        second_stats,
+        counts);
+}
+
+void BedPipe::count_codes(
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    validate_chunk_range(start_col, end_col, num_snps());
+    if (std::cmp_not_equal(counts.size(), end_col - start_col))
+    {
+        throw ArgumentValidationException(
+            "BedPipe::count_codes: counts size does not match chunk range");
+    }
+    std::vector<uint8_t> staging;
+    const uint8_t* chunk_ptr = packed_rows(start_col, end_col, staging);
+
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index j = 0; j < end_col - start_col; ++j)
+    {
+        counts[static_cast<size_t>(j)] = decoder_->count(
+            chunk_ptr + static_cast<size_t>(j * bytes_per_variant_));
+    }
+}
+
+void BedPipe::load_codes(
+    Eigen::Ref<PackedCodes> codes,
+    Eigen::Index start_col,
+    Eigen::Index end_col,
+    std::span<GenotypeCodeCounts> counts) const
+{
+    validate_chunk_range(start_col, end_col, num_snps());
+    const Eigen::Index num_cols = end_col - start_col;
+    if (std::cmp_not_equal(counts.size(), num_cols))
+    {
+        throw ArgumentValidationException(
+            "BedPipe::load_codes: counts size does not match chunk range");
+    }
+    if (codes.rows() != num_samples() || codes.cols() != (num_cols + 3) / 4)
+    {
+        throw ArgumentValidationException(
+            "BedPipe::load_codes: codes dimension mismatch");
+    }
+    std::vector<uint8_t> staging;
+    const uint8_t* chunk_ptr = packed_rows(start_col, end_col, staging);
+
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index j = 0; j < num_cols; ++j)
+    {
+        counts[static_cast<size_t>(j)] = decoder_->count(
+            chunk_ptr + static_cast<size_t>(j * bytes_per_variant_));
+    }
+
+    // Blocks of target rows read neighbouring raw bytes, so each variant's
+    // row is walked in cache-sized pieces.
+    constexpr Eigen::Index kRowBlock = 512;
+    const auto& target_to_raw = projection_->target_to_raw();
+    const Eigen::Index num_rows = codes.rows();
+    codes.setZero();
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index row_begin = 0; row_begin < num_rows;
+         row_begin += kRowBlock)
+    {
+        const Eigen::Index row_end = std::min(row_begin + kRowBlock, num_rows);
+        for (Eigen::Index j = 0; j < num_cols; ++j)
+        {
+            const uint8_t* src
+                = chunk_ptr + static_cast<size_t>(j * bytes_per_variant_);
+            const Eigen::Index byte = j / 4;
+            const int shift = static_cast<int>(2 * (j % 4));
+            for (Eigen::Index t = row_begin; t < row_end; ++t)
+            {
+                const Eigen::Index raw = target_to_raw[static_cast<size_t>(t)];
+                const unsigned code
+                    = raw < 0 ? kMissingGenotypeCode
+                              : (src[raw >> 2] >> (2 * (raw & 3))) & 0b11U;
+                codes(t, byte) = static_cast<uint8_t>(
+                    codes(t, byte) | (code << shift));
+            }
+        }
+    }
+}
+
+void BedPipe::select_variants(std::vector<Eigen::Index> variants)
+{
+    if (variants.empty())
+    {
+        throw ArgumentValidationException(
+            "BedPipe::select_variants: no variants selected");
+    }
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        if (variants[i] < 0 || variants[i] >= num_raw_snps_
+            || (i > 0 && variants[i] <= variants[i - 1]))
+        {
+            throw ArgumentValidationException(
+                "BedPipe::select_variants: variant indices must be unique, "
+                "ascending and within the file");
+        }
+    }
+    variants_ = std::move(variants);
+}
+
 auto BedPipe::num_samples() const -> Eigen::Index
 {
     return static_cast<Eigen::Index>(sample_manager_->num_common_samples());
@@ -164,7 +551,8 @@ auto BedPipe::num_samples() const -> Eigen::Index
 
 auto BedPipe::num_snps() const -> Eigen::Index
 {
-    return num_raw_snps_;
+    return variants_.empty() ? num_raw_snps_
+                             : static_cast<Eigen::Index>(variants_.size());
 }
 
 }  // namespace gelex
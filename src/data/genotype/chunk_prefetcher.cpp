@@ -0,0 +1,263 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/genotype/chunk_prefetcher.h"
+
+#include <algorithm>
+
+#include <omp.h>
+
+#include "gelex/exception.h"
+
+namespace gelex
+{
+
+ChunkPrefetcher::ChunkPrefetcher(
+    std::vector<Range> ranges,
+    Producer producer,
+    size_t depth)
+    : ranges_(std::move(ranges)),
+      producer_(std::move(producer)),
+      thread_budget_(omp_get_max_threads())
+{
+    if (depth == 0)
+    {
+        throw ArgumentValidationException(
+            "ChunkPrefetcher: depth must be at least 1");
+    }
+    slots_.resize(depth);
+    const auto [producer_threads, consumer_threads]
+        = split_threads(thread_budget_);
+    producer_threads_ = producer_threads;
+    omp_set_num_threads(consumer_threads);
+    worker_ = std::jthread([this](const std::stop_token& stop) { run(stop); });
+}
+
+ChunkPrefetcher::~ChunkPrefetcher()
+{
+    worker_.request_stop();
+    ready_.notify_all();
+    omp_set_num_threads(thread_budget_);
+}
+
+auto ChunkPrefetcher::split_threads(int budget) -> std::pair<int, int>
+{
+    const int producer = std::max(budget / 4, 1);
+    return {producer, std::max(budget - producer, 1)};
+}
+
+void ChunkPrefetcher::run(const std::stop_token& stop)
+{
+    // a new thread starts from the default budget, not the caller's
+    omp_set_num_threads(producer_threads_);
+    for (size_t i = 0; i < ranges_.size(); ++i)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            // slot i is free once the caller is done with chunk i - depth
+            if (!ready_.wait(
+                    lock, stop, [&] { return i < released_ + slots_.size(); }))
+            {
+                return;
+            }
+        }
+
+        Chunk& chunk = slots_[i % slots_.size()];
+        chunk.start = ranges_[i].start;
+        chunk.end = ranges_[i].end;
+        try
+        {
+            producer_(chunk);
+        }
+        catch (...)
+        {
+            std::lock_guard lock(mutex_);
+            error_ = std::current_exception();
+            ready_.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            ++produced_;
+        }
+        ready_.notify_all();
+    }
+}
+
+auto ChunkPrefetcher::next() -> Chunk*
+{
+    std::unique_lock lock(mutex_);
+    // the chunk handed out last time is no longer needed
+    released_ = handed_out_;
+    ready_.notify_all();
+
+    if (handed_out_ == ranges_.size())
+    {
+        return nullptr;
+    }
+    ready_.wait(lock, [&] { return produced_ > handed_out_ || error_; });
+    if (produced_ <= handed_out_)
+    {
+        std::rethrow_exception(error_);
+    }
+    return &slots_[handed_out_++ % slots_.size()];
+}
+
+auto ChunkPrefetcher::split(
+    std::span<const std::pair<Eigen::Index, Eigen::Index>> ranges,
+    Eigen::Index chunk_size) -> std::vector<Range>
+{
+    if (chunk_size <= 0)
+    {
+        throw ArgumentValidationException(
+            "ChunkPrefetcher: chunk size must be positive");
+    }
+    std::vector<Range> chunks;
+    for (const auto& [range_start, range_end] : ranges)
+    {
+        for (Eigen::Index start = range_start; start < range_end;
+             start += chunk_size)
+        {
+            chunks.push_back({start, std::min(start + chunk_size, range_end)});
+        }
+    }
+    return chunks;
+}
+
+auto ChunkPrefetcher::decode(const BedPipe& bed) -> Producer
+{
+    return [&bed](Chunk& chunk)
+    {
+        chunk.genotype.resize(bed.num_samples(), chunk.end - chunk.start);
+        bed.load_chunk(chunk.genotype, chunk.start, chunk.end);
+    };
+}
+
+auto ChunkPrefetcher::decode(const BedPipe& bed, LocusPlanner planner)
+    -> Producer
+{
+    return [&bed, planner](Chunk& chunk)
+    {
+        chunk.genotype.resize(bed.num_samples(), chunk.end - chunk.start);
+        chunk.stats.resize(static_cast<size_t>(chunk.end - chunk.start));
+        chunk.counts.resize(chunk.stats.size());
+        bed.load_chunk(
+            chunk.genotype,
+            chunk.start,
+            chunk.end,
+            planner,
+            chunk.stats,
+            chunk.counts);
+    };
+}
+
+auto ChunkPrefetcher::decode_f32(const BedPipe& bed, LocusPlanner planner)
+    -> Producer
+{
+    return [&bed, planner](Chunk& chunk)
+    {
+        chunk.genotype_f32.resize(bed.num_samples(), chunk.end - chunk.start);
+        chunk.stats.resize(static_cast<size_t>(chunk.end - chunk.start));
+        chunk.counts.resize(chunk.stats.size());
+        bed.load_chunk(
+            chunk.genotype_f32,
+            chunk.start,
+            chunk.end,
+            planner,
+            chunk.stats,
+            chunk.counts);
+    };
+}
+
+auto ChunkPrefetcher::decode(
+    const BedPipe& bed,
+    LocusPlanner planner,
+    LocusPlanner dominance_planner) -> Producer
+{
+    return [&bed, planner, dominance_planner](Chunk& chunk)
+    {
+        const Eigen::Index num_cols = chunk.end - chunk.start;
+        chunk.genotype.resize(bed.num_samples(), num_cols);
+        chunk.dominance.resize(bed.num_samples(), num_cols);
+        chunk.stats.resize(static_cast<size_t>(num_cols));
+        chunk.dominance_stats.resize(static_cast<size_t>(num_cols));
+        chunk.counts.resize(static_cast<size_t>(num_cols));
+        bed.load_chunk(
+            chunk.genotype,
+            chunk.dominance,
+            chunk.start,
+            chunk.end,
+            planner,
+            dominance_planner,
+            chunk.stats,
+            chunk.dominance_stats,
+            chunk.counts);
+    };
+}
+
+auto ChunkPrefetcher::decode_f32(
+    const BedPipe& bed,
+    LocusPlanner planner,
+    LocusPlanner dominance_planner) -> Producer
+{
+    return [&bed, planner, dominance_planner](Chunk& chunk)
+    {
+        const Eigen::Index num_cols = chunk.end - chunk.start;
+        chunk.genotype_f32.resize(bed.num_samples(), num_cols);
+        chunk.dominance_f32.resize(bed.num_samples(), num_cols);
+        chunk.stats.resize(static_cast<size_t>(num_cols));
+        chunk.dominance_stats.resize(static_cast<size_t>(num_cols));
+        chunk.counts.resize(static_cast<size_t>(num_cols));
+        bed.load_chunk(
+            chunk.genotype_f32,
+            chunk.dominance_f32,
+            chunk.start,
+            chunk.end,
+            planner,
+            dominance_planner,
+            chunk.stats,
+            chunk.dominance_stats,
+            chunk.counts);
+    };
+}
+
+auto ChunkPrefetcher::pack(
+    const BedPipe& bed,
+    LocusPlanner planner,
+    LocusPlanner dominance_planner) -> Producer
+{
+    return [&bed, planner, dominance_planner](Chunk& chunk)
+    {
+        const Eigen::Index num_cols = chunk.end - chunk.start;
+        chunk.counts.resize(static_cast<size_t>(num_cols));
+        chunk.codes.resize(bed.num_samples(), (num_cols + 3) / 4);
+        bed.load_codes(chunk.codes, chunk.start, chunk.end, chunk.counts);
+
+        auto plan = [&chunk](LocusPlanner by, std::vector<LocusPlan>& plans)
+        {
+            plans.resize(chunk.counts.size());
+            std::ranges::transform(chunk.counts, plans.begin(), by);
+        };
+        plan(planner, chunk.plans);
+        if (dominance_planner != nullptr)
+        {
+            plan(dominance_planner, chunk.dominance_plans);
+        }
+    };
+}
+
+}  // namespace gelex
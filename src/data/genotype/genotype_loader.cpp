@@ -25,15 +25,20 @@ namespace gelex
 
 GenotypeLoader::GenotypeLoader(
     const std::filesystem::path& bed_path,
-    std::shared_ptr<SampleManager> sample_manager)
+    std::shared_ptr<SampleManager> sample_manager,
+    std::vector<Eigen::Index> variants)
     : bed_pipe_(bed_path, std::move(sample_manager))
 {
+    if (!variants.empty())
+    {
+        bed_pipe_.select_variants(std::move(variants));
+    }
     num_variants_ = bed_pipe_.num_snps();    // NOLINT
     sample_size_ = bed_pipe_.num_samples();  // NOLINT
 
     try
     {
-        data_matrix_.resize(sample_size_, num_variants_);
+        data_matrix_ = HugePageMatrix(sample_size_, num_variants_);
     }
     catch (const std::bad_alloc&)
     {
@@ -48,34 +53,21 @@ GenotypeLoader::GenotypeLoader(
     }
 }
 
-void GenotypeLoader::process_chunk(
-    Eigen::MatrixXd& chunk,
-    Eigen::Index global_start,
-    LocusStatistic (*fn)(Eigen::Ref<Eigen::VectorXd>))
+void GenotypeLoader::record_stats(
+    std::span<const LocusStatistic> stats,
+    Eigen::Index global_start)
 {
-    const Eigen::Index num_variants_in_chunk = chunk.cols();
-
-#pragma omp parallel for schedule(static)
-    for (Eigen::Index i = 0; i < num_variants_in_chunk; ++i)
+    for (size_t i = 0; i < stats.size(); ++i)
     {
-        auto variant = chunk.col(i);
-        LocusStatistic stats = fn(variant);
+        const auto global_idx = global_start + static_cast<Eigen::Index>(i);
+        means_[global_idx] = stats[i].mean;
+        stddevs_[global_idx] = stats[i].stddev;
 
-        Eigen::Index global_idx = global_start + i;
-        means_[global_idx] = stats.mean;
-        stddevs_[global_idx] = stats.stddev;
-
-        if (stats.is_monomorphic)
+        if (stats[i].is_monomorphic)
         {
-#pragma omp critical(genotype_loader_mono)
-            {
-                monomorphic_indices_.push_back(
-                    static_cast<int64_t>(global_idx));
-            }
+            monomorphic_indices_.push_back(static_cast<int64_t>(global_idx));
         }
     }
-
-    data_matrix_.middleCols(global_start, num_variants_in_chunk) = chunk;
 }
 
 GenotypeMatrix GenotypeLoader::finalize()
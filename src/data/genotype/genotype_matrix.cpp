@@ -20,7 +20,7 @@ namespace gelex
 {
 
 GenotypeMatrix::GenotypeMatrix(
-    Eigen::MatrixXd&& data,
+    HugePageMatrix&& data,
     std::vector<int64_t>&& mono_indices,
     Eigen::VectorXd&& mean,
     Eigen::VectorXd&& stddev)
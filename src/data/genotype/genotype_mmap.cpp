@@ -20,6 +20,7 @@
 #include <format>
 
 #include "gelex/exception.h"
+#include "gelex/infra/utils/huge_pages.h"
 
 namespace gelex
 {
@@ -55,6 +56,9 @@ GenotypeMap::GenotypeMap(const std::filesystem::path& bin_file)
     const auto* data_ptr = reinterpret_cast<const double*>(mmap_.data());
 
     validate_alignment(data_ptr);
+    // honoured for page-cache backed files only where the kernel supports
+    // file THP; a no-op otherwise
+    advise_huge_pages(data_ptr, mmap_.size());
 
     new (&mat_) MapType(data_ptr, rows_, cols_);
 }
@@ -16,32 +16,98 @@
 
 #include "gelex/data/genotype/genotype_pipe.h"
 
+#include <cstdint>
 #include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
 #include <utility>
 
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/exception.h"
-#include "gelex/infra/logger.h"
 
 namespace gelex
 {
 
-void GenotypePipe::process_chunk(
-    Eigen::MatrixXd& chunk,
-    size_t global_start,
-    LocusStatistic (*fn)(Eigen::Ref<Eigen::VectorXd>))
+namespace
 {
-    const int64_t num_variants_in_chunk = chunk.cols();
 
-    for (int64_t i = 0; i < num_variants_in_chunk; ++i)
+constexpr std::string_view kCacheVersion = "gelex-genotype-cache 1";
+
+auto file_fingerprint(std::string_view tag, const std::filesystem::path& path)
+    -> std::string
+{
+    if (!std::filesystem::exists(path))
+    {
+        throw FileNotFoundException(
+            std::format("{}: file not found", path.string()));
+    }
+    return std::format(
+        "{} {} {} {}\n",
+        tag,
+        path.filename().string(),
+        std::filesystem::file_size(path),
+        std::filesystem::last_write_time(path).time_since_epoch().count());
+}
+
+// FNV-1a over the ordered ids; order matters because it fixes the row layout
+auto hash_sample_ids(std::span<const std::string> ids) -> uint64_t
+{
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](unsigned char byte)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (const auto& id : ids)
+    {
+        for (const char c : id)
+        {
+            mix(static_cast<unsigned char>(c));
+        }
+        mix(0);
+    }
+    return hash;
+}
+
+auto hash_variants(std::span<const Eigen::Index> variants) -> uint64_t
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const Eigen::Index variant : variants)
     {
-        auto variant = chunk.col(i);
-        LocusStatistic stats = fn(variant);
+        auto value = static_cast<uint64_t>(variant);
+        for (int i = 0; i < 8; ++i)
+        {
+            hash ^= value & 0xFFU;
+            hash *= 1099511628211ULL;
+            value >>= 8;
+        }
+    }
+    return hash;
+}
+
+auto temporary_path(const std::filesystem::path& path) -> std::filesystem::path
+{
+    auto tmp = path;
+    tmp += ".tmp";
+    return tmp;
+}
+
+}  // namespace
 
+void GenotypePipe::record_stats(
+    std::span<const LocusStatistic> stats,
+    size_t global_start)
+{
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
         size_t global_idx = global_start + i;
-        means_[global_idx] = stats.mean;
-        variances_[global_idx] = stats.stddev;
+        means_[global_idx] = stats[i].mean;
+        variances_[global_idx] = stats[i].stddev;
 
-        if (stats.is_monomorphic)
+        if (stats[i].is_monomorphic)
         {
             monomorphic_indices_.push_back(static_cast<int64_t>(global_idx));
         }
@@ -51,42 +117,127 @@ void GenotypePipe::process_chunk(
 GenotypePipe::GenotypePipe(
     const std::filesystem::path& bed_path,
     std::shared_ptr<SampleManager> sample_manager,
-    const std::filesystem::path& output_prefix)
-    : bed_pipe_(bed_path, std::move(sample_manager))
+    const std::filesystem::path& output_prefix,
+    std::vector<Eigen::Index> variants)
+    : bed_pipe_(bed_path, sample_manager)
 {
-    auto logger = logging::get();
+    matrix_path_ = output_prefix;
+    matrix_path_ += ".bmat";
+    stats_path_ = output_prefix;
+    stats_path_ += ".snpstats";
+    key_path_ = output_prefix;
+    key_path_ += ".cache";
+
+    // a variant subset changes the columns, so it joins the key
+    std::string selection;
+    if (!variants.empty())
+    {
+        selection = std::format(
+            "variants {} {:016x}\n", variants.size(), hash_variants(variants));
+        bed_pipe_.select_variants(std::move(variants));
+    }
 
-    auto matrix_path = output_prefix;
-    matrix_path += ".bmat";
-    auto stats_path = output_prefix;
-    stats_path += ".snpstats";
+    num_variants_ = bed_pipe_.num_snps();
+    sample_size_ = bed_pipe_.num_samples();
+
+    const auto bed = format_bed_path(bed_path.string());
+    const auto bim = variant_info_path(bed);
+    const auto fam = sample_info_path(bed);
+
+    source_fingerprint_ = std::format(
+        "{}{}{}samples {} {:016x}\n{}",
+        file_fingerprint("bed", bed),
+        file_fingerprint("bim", bim),
+        file_fingerprint("fam", fam),
+        sample_manager->num_common_samples(),
+        hash_sample_ids(sample_manager->common_ids()),
+        selection);
+}
 
-    bool exists = std::filesystem::exists(matrix_path)
-                  || std::filesystem::exists(stats_path);
+auto GenotypePipe::cache_key(
+    GeneticEffectType type,
+    GenotypeProcessMethod method) const -> std::string
+{
+    return std::format(
+        "{}\n{}method {}\neffect {}\n",
+        kCacheVersion,
+        source_fingerprint_,
+        static_cast<int>(method),
+        type == GeneticEffectType::Add ? "add" : "dom");
+}
+
+auto GenotypePipe::load_cached(const std::string& key)
+    -> std::optional<GenotypeMap>
+{
+    reused_cache_ = false;
 
-    if (exists)
+    std::ifstream key_stream(key_path_, std::ios::binary);
+    if (!key_stream)
     {
-        logger->error(
-            "Output files already exist: [{}] or [{}]",
-            matrix_path.string(),
-            stats_path.string());
-        throw FileExistsException(
-            std::format("{}: existing files", output_prefix.string()));
+        return std::nullopt;
     }
+    const std::string stored{
+        std::istreambuf_iterator<char>(key_stream),
+        std::istreambuf_iterator<char>()};
 
-    matrix_writer_ = std::make_unique<detail::BinaryMatrixWriter>(matrix_path);
-    stats_writer_ = std::make_unique<detail::SnpStatsWriter>(stats_path);
+    if (stored != key || !std::filesystem::exists(matrix_path_)
+        || !std::filesystem::exists(stats_path_))
+    {
+        return std::nullopt;
+    }
 
-    num_variants_ = bed_pipe_.num_snps();
-    sample_size_ = bed_pipe_.num_samples();
+    try
+    {
+        GenotypeMap cached(matrix_path_);
+        if (cached.rows() != sample_size_ || cached.cols() != num_variants_)
+        {
+            return std::nullopt;
+        }
+        reused_cache_ = true;
+        return cached;
+    }
+    catch (const GelexException&)
+    {
+        // unreadable leftovers are regenerated like any stale cache
+        return std::nullopt;
+    }
 }
 
-GenotypeMap GenotypePipe::finalize()
+void GenotypePipe::open_writers()
+{
+    matrix_writer_ = std::make_unique<detail::BinaryMatrixWriter>(
+        temporary_path(matrix_path_));
+    stats_writer_
+        = std::make_unique<detail::SnpStatsWriter>(temporary_path(stats_path_));
+}
+
+GenotypeMap GenotypePipe::finalize(const std::string& key)
 {
     stats_writer_->write(
         sample_size_, monomorphic_indices_, means_, variances_);
 
-    return GenotypeMap(matrix_writer_->path());
+    // Close both temporaries before publishing them. The old key goes first
+    // so an interrupted swap is never mistaken for a valid cache.
+    matrix_writer_.reset();
+    stats_writer_.reset();
+
+    std::filesystem::remove(key_path_);
+    std::filesystem::rename(temporary_path(matrix_path_), matrix_path_);
+    std::filesystem::rename(temporary_path(stats_path_), stats_path_);
+
+    const auto key_tmp = temporary_path(key_path_);
+    {
+        std::ofstream key_stream(key_tmp, std::ios::binary | std::ios::trunc);
+        key_stream << key;
+        if (!key_stream.flush())
+        {
+            throw FileWriteException(
+                std::format("{}: failed to write cache key", key_tmp.string()));
+        }
+    }
+    std::filesystem::rename(key_tmp, key_path_);
+
+    return GenotypeMap(matrix_path_);
 }
 
 }  // namespace gelex
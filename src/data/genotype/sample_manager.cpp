@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/loader/fam_loader.h"
 
 namespace gelex
@@ -77,8 +78,7 @@ void SampleManager::finalize()
 auto SampleManager::create_finalized(const std::filesystem::path& bed_path)
     -> std::shared_ptr<SampleManager>
 {
-    auto fam_path = std::filesystem::path(bed_path).replace_extension(".fam");
-    auto manager = std::make_shared<SampleManager>(fam_path);
+    auto manager = std::make_shared<SampleManager>(sample_info_path(bed_path));
     manager->finalize();
     return manager;
 }
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/genotype/variant_filter.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "gelex/exception.h"
+#include "gelex/io/parser.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+// counts are summed in chunks so a .pgen never stages the whole file
+constexpr Eigen::Index kCountChunkSize = 8192;
+constexpr double kHweTolerance = 1e-8;
+
+auto read_id_list(const std::filesystem::path& path)
+    -> std::unordered_set<std::string>
+{
+    auto file = detail::open_file<std::ifstream>(path, std::ios::in);
+    std::unordered_set<std::string> ids;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const auto begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos)
+        {
+            continue;
+        }
+        const auto end = line.find_first_of(" \t\r", begin);
+        ids.emplace(line.substr(begin, end - begin));
+    }
+    return ids;
+}
+
+auto passes_metadata(
+    const VariantFilter& filter,
+    const SnpMeta& meta,
+    const std::unordered_set<std::string>& extract,
+    const std::unordered_set<std::string>& exclude) -> bool
+{
+    if (!filter.extract_path.empty() && !extract.contains(meta.id))
+    {
+        return false;
+    }
+    if (exclude.contains(meta.id))
+    {
+        return false;
+    }
+    if (!filter.chromosomes.empty()
+        && std::ranges::find(filter.chromosomes, meta.chrom)
+               == filter.chromosomes.end())
+    {
+        return false;
+    }
+    if (filter.from_bp && meta.pos < *filter.from_bp)
+    {
+        return false;
+    }
+    return !(filter.to_bp && meta.pos > *filter.to_bp);
+}
+
+auto passes_genotypes(
+    const VariantFilter& filter,
+    const GenotypeCodeCounts& counts) -> bool
+{
+    // BED codes: 00 hom A1, 01 missing, 10 het, 11 hom A2
+    const int64_t hom1 = counts[0b00];
+    const int64_t het = counts[0b10];
+    const int64_t hom2 = counts[0b11];
+    const int64_t called = hom1 + het + hom2;
+    const int64_t total = called + counts[kMissingGenotypeCode];
+
+    if (total > 0
+        && static_cast<double>(counts[kMissingGenotypeCode])
+               > filter.max_missing_rate * static_cast<double>(total))
+    {
+        return false;
+    }
+    if (filter.min_maf > 0.0)
+    {
+        if (called == 0)
+        {
+            return false;
+        }
+        const double p = static_cast<double>((2 * hom1) + het)
+                         / (2.0 * static_cast<double>(called));
+        if (std::min(p, 1.0 - p) < filter.min_maf)
+        {
+            return false;
+        }
+    }
+    return filter.min_hwe_pvalue <= 0.0
+           || hwe_exact_pvalue(het, hom1, hom2) >= filter.min_hwe_pvalue;
+}
+
+}  // namespace
+
+auto VariantFilter::empty() const -> bool
+{
+    return extract_path.empty() && exclude_path.empty()
+           && chromosomes.empty() && !from_bp && !to_bp && !uses_genotypes();
+}
+
+auto VariantFilter::uses_genotypes() const -> bool
+{
+    return min_maf > 0.0 || max_missing_rate < 1.0 || min_hwe_pvalue > 0.0;
+}
+
+auto apply_variant_filter(
+    const VariantFilter& filter,
+    BedPipe& bed,
+    SnpEffects& snps) -> std::vector<Eigen::Index>
+{
+    if (std::cmp_not_equal(snps.size(), bed.num_snps()))
+    {
+        throw InvalidInputException(
+            std::format(
+                "variant metadata lists {} variants, the genotype file {}",
+                snps.size(),
+                bed.num_snps()));
+    }
+
+    const auto extract = filter.extract_path.empty()
+                             ? std::unordered_set<std::string>{}
+                             : read_id_list(filter.extract_path);
+    const auto exclude = filter.exclude_path.empty()
+                             ? std::unordered_set<std::string>{}
+                             : read_id_list(filter.exclude_path);
+
+    std::vector<Eigen::Index> kept;
+    kept.reserve(snps.size());
+    for (size_t j = 0; j < snps.size(); ++j)
+    {
+        if (passes_metadata(filter, snps[j], extract, exclude))
+        {
+            kept.push_back(static_cast<Eigen::Index>(j));
+        }
+    }
+
+    if (filter.uses_genotypes() && !kept.empty())
+    {
+        bed.select_variants(kept);
+        std::vector<GenotypeCodeCounts> counts(kept.size());
+        const auto num_kept = static_cast<Eigen::Index>(kept.size());
+        for (Eigen::Index start = 0; start < num_kept; start += kCountChunkSize)
+        {
+            const Eigen::Index end
+                = std::min(start + kCountChunkSize, num_kept);
+            bed.count_codes(
+                start,
+                end,
+                std::span(counts).subspan(
+                    static_cast<size_t>(start),
+                    static_cast<size_t>(end - start)));
+        }
+
+        size_t out = 0;
+        for (size_t j = 0; j < kept.size(); ++j)
+        {
+            if (passes_genotypes(filter, counts[j]))
+            {
+                kept[out++] = kept[j];
+            }
+        }
+        kept.resize(out);
+    }
+
+    if (kept.empty())
+    {
+        throw InvalidInputException("no variants pass the variant filters");
+    }
+    bed.select_variants(kept);
+    snps = select_snps(snps, kept);
+    return kept;
+}
+
+auto select_snps(const SnpEffects& snps, std::span<const Eigen::Index> variants)
+    -> SnpEffects
+{
+    SnpEffects selected(variants.size());
+    for (Eigen::Index variant : variants)
+    {
+        selected.emplace_meta(snps[static_cast<size_t>(variant)]);
+    }
+    return selected;
+}
+
+auto hwe_exact_pvalue(int64_t hets, int64_t hom1, int64_t hom2) -> double
+{
+    const int64_t hom_rare = std::min(hom1, hom2);
+    const int64_t hom_common = std::max(hom1, hom2);
+    const int64_t genotypes = hets + hom_rare + hom_common;
+    if (genotypes == 0)
+    {
+        return 1.0;
+    }
+    const int64_t rare_copies = (2 * hom_rare) + hets;
+
+    // heterozygote counts share the parity of the rare allele count; start
+    // from the most likely one and walk outwards with the recurrence
+    std::vector<double> probs(static_cast<size_t>(rare_copies + 1), 0.0);
+    int64_t mid = rare_copies * ((2 * genotypes) - rare_copies)
+                  / (2 * genotypes);
+    if ((mid % 2) != (rare_copies % 2))
+    {
+        ++mid;
+    }
+
+    probs[static_cast<size_t>(mid)] = 1.0;
+    double sum = 1.0;
+
+    int64_t curr_rare = (rare_copies - mid) / 2;
+    int64_t curr_common = genotypes - mid - curr_rare;
+    for (int64_t curr_hets = mid; curr_hets > 1; curr_hets -= 2)
+    {
+        const auto i = static_cast<size_t>(curr_hets);
+        probs[i - 2] = probs[i] * static_cast<double>(curr_hets)
+                       * static_cast<double>(curr_hets - 1)
+                       / (4.0 * static_cast<double>(curr_rare + 1)
+                          * static_cast<double>(curr_common + 1));
+        sum += probs[i - 2];
+        ++curr_rare;
+        ++curr_common;
+    }
+
+    curr_rare = (rare_copies - mid) / 2;
+    curr_common = genotypes - mid - curr_rare;
+    for (int64_t curr_hets = mid; curr_hets <= rare_copies - 2; curr_hets += 2)
+    {
+        const auto i = static_cast<size_t>(curr_hets);
+        probs[i + 2] = probs[i] * 4.0 * static_cast<double>(curr_rare)
+                       * static_cast<double>(curr_common)
+                       / (static_cast<double>(curr_hets + 2)
+                          * static_cast<double>(curr_hets + 1));
+        sum += probs[i + 2];
+        --curr_rare;
+        --curr_common;
+    }
+
+    // tables as likely as the observed one count despite rounding
+    const double observed
+        = probs[static_cast<size_t>(hets)] * (1.0 + kHweTolerance);
+    double pvalue = 0.0;
+    for (double prob : probs)
+    {
+        if (prob <= observed)
+        {
+            pvalue += prob;
+        }
+    }
+    return std::min(1.0, pvalue / sum);
+}
+
+}  // namespace gelex
@@ -0,0 +1,581 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_cross_product.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(_M_X64)) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define GELEX_CROSS_PRODUCT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gelex::detail
+{
+
+using Eigen::Index;
+
+namespace
+{
+
+// Loci per block of bit planes: 16 words per plane, so a sample's planes
+// take 256 bytes and those of a few thousand samples stay in L2.
+constexpr size_t kBlockLoci = 1024;
+
+// The level of a locus follows from differences of its processed values,
+// which carry the rounding of `encoded - mean`.
+constexpr double kLevelTolerance = 1e-9;
+
+// --------------------------------------------------------------------------
+// Dot products of bit planes. With x = [t >= 1] and y = [t == 2], y is a
+// subset of x and
+//   t_k t_i = |xk & xi| + |xk & yi| + |yk & xi| + |yk & yi|
+//           = |xk & xi| + |(xk & yi) | (yk & xi)| + 2 |yk & yi|,
+// three popcounts per word pair.
+// --------------------------------------------------------------------------
+
+[[gnu::always_inline]] inline void add_column_words(
+    const uint64_t* planes,
+    Index words,
+    Index k,
+    Index i_begin,
+    Index i_end,
+    double* out)
+{
+    const Index stride = 2 * words;
+    const uint64_t* xk = planes + (k * stride);
+    const uint64_t* yk = xk + words;
+    for (Index i = i_begin; i < i_end; ++i)
+    {
+        const uint64_t* xi = planes + (i * stride);
+        const uint64_t* yi = xi + words;
+        int64_t dot = 0;
+        for (Index w = 0; w < words; ++w)
+        {
+            dot += std::popcount(xk[w] & xi[w])
+                   + std::popcount((xk[w] & yi[w]) | (yk[w] & xi[w]))
+                   + (2 * std::popcount(yk[w] & yi[w]));
+        }
+        out[i - i_begin] += static_cast<double>(dot);
+    }
+}
+
+void add_column_portable(
+    const uint64_t* planes,
+    Index words,
+    Index k,
+    Index i_begin,
+    Index i_end,
+    double* out)
+{
+    add_column_words(planes, words, k, i_begin, i_end, out);
+}
+
+#ifdef GELEX_CROSS_PRODUCT_X86
+
+__attribute__((target("popcnt"))) void add_column_popcnt(
+    const uint64_t* planes,
+    Index words,
+    Index k,
+    Index i_begin,
+    Index i_end,
+    double* out)
+{
+    add_column_words(planes, words, k, i_begin, i_end, out);
+}
+
+// --------------------------------------------------------------------------
+// AVX-512: 512 loci per popcount of a plane pair, with u = xk & xi,
+// v = (xk & yi) | (yk & xi) and w = yk & yi. Eight column entries are
+// computed at a time, so k's planes are loaded once per eight products and
+// the eight sums are reduced together.
+// --------------------------------------------------------------------------
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) [[gnu::always_inline]]
+inline void add_word_pair(
+    __m512i xk,
+    __m512i yk,
+    const uint64_t* xi,
+    Index words,
+    __m512i& ones,
+    __m512i& twos)
+{
+    const __m512i x = _mm512_loadu_si512(xi);
+    const __m512i y = _mm512_loadu_si512(xi + words);
+    // ternary logic 0xEA: (xk & y) | (yk & x)
+    const __m512i v
+        = _mm512_ternarylogic_epi64(xk, y, _mm512_and_si512(yk, x), 0xEA);
+    ones = _mm512_add_epi64(
+        ones, _mm512_popcnt_epi64(_mm512_and_si512(xk, x)));
+    ones = _mm512_add_epi64(ones, _mm512_popcnt_epi64(v));
+    twos = _mm512_add_epi64(
+        twos, _mm512_popcnt_epi64(_mm512_and_si512(yk, y)));
+}
+
+// Adds the 128-bit lanes of a and b in pairs: a's first two, then b's.
+__attribute__((target("avx512f"))) [[gnu::always_inline]] inline auto
+fold_lanes(__m512i a, __m512i b) -> __m512i
+{
+    return _mm512_add_epi64(
+        _mm512_shuffle_i64x2(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+        _mm512_shuffle_i64x2(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+__attribute__((target("avx512f,avx512dq,avx512vpopcntdq"))) void
+add_column_avx512(
+    const uint64_t* planes,
+    Index words,
+    Index k,
+    Index i_begin,
+    Index i_end,
+    double* out)
+{
+    const Index stride = 2 * words;
+    const uint64_t* xk = planes + (k * stride);
+    const uint64_t* yk = xk + words;
+    Index i = i_begin;
+    for (; i + 8 <= i_end; i += 8)
+    {
+        __m512i ones[8];  // NOLINT(*-avoid-c-arrays)
+        __m512i twos[8];  // NOLINT(*-avoid-c-arrays)
+        for (int r = 0; r < 8; ++r)
+        {
+            ones[r] = _mm512_setzero_si512();
+            twos[r] = _mm512_setzero_si512();
+        }
+        for (Index w = 0; w < words; w += 8)
+        {
+            const __m512i x = _mm512_loadu_si512(xk + w);
+            const __m512i y = _mm512_loadu_si512(yk + w);
+            for (int r = 0; r < 8; ++r)
+            {
+                add_word_pair(
+                    x,
+                    y,
+                    planes + ((i + r) * stride) + w,
+                    words,
+                    ones[r],
+                    twos[r]);
+            }
+        }
+        // lane r of the sums holds entry i + r: pairs interleaved within
+        // 128-bit lanes, then the lanes folded twice
+        __m512i pairs[4];  // NOLINT(*-avoid-c-arrays)
+        for (int r = 0; r < 4; ++r)
+        {
+            const __m512i a = _mm512_add_epi64(
+                ones[2 * r], _mm512_slli_epi64(twos[2 * r], 1));
+            const __m512i b = _mm512_add_epi64(
+                ones[(2 * r) + 1], _mm512_slli_epi64(twos[(2 * r) + 1], 1));
+            pairs[r] = _mm512_add_epi64(
+                _mm512_unpacklo_epi64(a, b), _mm512_unpackhi_epi64(a, b));
+        }
+        const __m512i sums = fold_lanes(
+            fold_lanes(pairs[0], pairs[1]), fold_lanes(pairs[2], pairs[3]));
+        double* dst = out + (i - i_begin);
+        _mm512_storeu_pd(
+            dst,
+            _mm512_add_pd(_mm512_loadu_pd(dst), _mm512_cvtepi64_pd(sums)));
+    }
+    for (; i < i_end; ++i)
+    {
+        __m512i ones = _mm512_setzero_si512();
+        __m512i twos = _mm512_setzero_si512();
+        for (Index w = 0; w < words; w += 8)
+        {
+            add_word_pair(
+                _mm512_loadu_si512(xk + w),
+                _mm512_loadu_si512(yk + w),
+                planes + (i * stride) + w,
+                words,
+                ones,
+                twos);
+        }
+        const __m512i dot
+            = _mm512_add_epi64(ones, _mm512_slli_epi64(twos, 1));
+        out[i - i_begin] += static_cast<double>(_mm512_reduce_add_epi64(dot));
+    }
+}
+
+#endif  // GELEX_CROSS_PRODUCT_X86
+
+constexpr CrossProductKernel kPortableKernel{
+    .name = "portable",
+    .add_column = add_column_portable};
+
+#ifdef GELEX_CROSS_PRODUCT_X86
+constexpr CrossProductKernel kPopcntKernel{
+    .name = "popcnt",
+    .add_column = add_column_popcnt};
+
+constexpr CrossProductKernel kAvx512Kernel{
+    .name = "avx512",
+    .add_column = add_column_avx512};
+#endif
+
+// Missing calls of a block in compressed rows, one row per sample (loci
+// within the block) or per locus (samples): row r holds entries
+// [offsets[r], offsets[r + 1]), in ascending order.
+struct MissingCalls
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> entries;
+
+    [[nodiscard]] auto row(size_t r) const -> std::span<const uint32_t>
+    {
+        return {entries.data() + offsets[r], entries.data() + offsets[r + 1]};
+    }
+
+    [[nodiscard]] auto empty() const -> bool { return entries.empty(); }
+};
+
+auto compress(const std::vector<std::vector<uint32_t>>& rows) -> MissingCalls
+{
+    MissingCalls calls;
+    calls.offsets.reserve(rows.size() + 1);
+    calls.offsets.push_back(0);
+    for (const auto& row : rows)
+    {
+        calls.entries.insert(calls.entries.end(), row.begin(), row.end());
+        calls.offsets.push_back(static_cast<uint32_t>(calls.entries.size()));
+    }
+    return calls;
+}
+
+// The same calls with rows and entries swapped; `num_rows` rows.
+auto transpose(const MissingCalls& calls, size_t num_rows) -> MissingCalls
+{
+    MissingCalls result;
+    result.offsets.assign(num_rows + 1, 0);
+    for (const uint32_t entry : calls.entries)
+    {
+        ++result.offsets[entry + 1];
+    }
+    for (size_t r = 0; r < num_rows; ++r)
+    {
+        result.offsets[r + 1] += result.offsets[r];
+    }
+    result.entries.resize(calls.entries.size());
+    std::vector<uint32_t> next(
+        result.offsets.begin(), result.offsets.end() - 1);
+    for (size_t r = 0; r + 1 < calls.offsets.size(); ++r)
+    {
+        for (const uint32_t entry : calls.row(r))
+        {
+            result.entries[next[entry]++] = static_cast<uint32_t>(r);
+        }
+    }
+    return result;
+}
+
+auto level_of(const uint64_t* planes, Index words, Index i, size_t j)
+    -> uint8_t
+{
+    const uint64_t* x = planes + (i * 2 * words);
+    const auto word = static_cast<Index>(j / 64);
+    const auto bit = j % 64;
+    return static_cast<uint8_t>(
+        ((x[word] >> bit) & 1U) + ((x[words + word] >> bit) & 1U));
+}
+
+// Fills the bit planes of a block, adds offset * t of every sample to
+// `offset_sums` and lists each sample's missing calls. A word of each
+// plane is assembled in registers before it is stored.
+auto build_planes(
+    const PackedCodes& codes,
+    std::span<const IntegerLocus> block,
+    Index words,
+    std::vector<uint64_t>& planes,
+    Eigen::VectorXd& offset_sums,
+    std::vector<std::vector<uint32_t>>& missing_of_sample) -> void
+{
+    const auto cols = static_cast<Index>(missing_of_sample.size());
+    planes.assign(static_cast<size_t>(cols * 2 * words), 0);
+
+#pragma omp parallel for schedule(static) default(none) \
+    shared(codes, block, planes, words, cols, offset_sums, missing_of_sample)
+    for (Index k = 0; k < cols; ++k)
+    {
+        uint64_t* x = planes.data() + (k * 2 * words);
+        uint64_t* y = x + words;
+        const uint8_t* row = &codes(k, 0);
+        auto& sample_missing = missing_of_sample[static_cast<size_t>(k)];
+        sample_missing.clear();
+        double offset_sum = 0.0;
+        for (size_t first = 0; first < block.size(); first += 64)
+        {
+            const size_t last = std::min(first + 64, block.size());
+            uint64_t x_word = 0;
+            uint64_t y_word = 0;
+            for (size_t j = first; j < last; ++j)
+            {
+                const IntegerLocus& locus = block[j];
+                const auto index = static_cast<size_t>(locus.index);
+                const unsigned code
+                    = (row[index / 4] >> (2 * (index % 4))) & 0b11U;
+                if (code == kMissingGenotypeCode)
+                {
+                    sample_missing.push_back(static_cast<uint32_t>(j));
+                    continue;
+                }
+                const uint8_t level = locus.levels[code];
+                x_word |= uint64_t{level >= 1} << (j - first);
+                y_word |= uint64_t{level == 2} << (j - first);
+                offset_sum += locus.offset * level;
+            }
+            x[first / 64] = x_word;
+            y[first / 64] = y_word;
+        }
+        offset_sums(k) += offset_sum;
+    }
+}
+
+// Missing-call terms of one block. With A = t - offset, t = 0 at a missing
+// call, and B = offset at the missing calls only, Z = A + B and
+// ZZ' = AA' + AB' + BA' + BB'; the bit planes and the centering give AA'.
+// Entry (i, k) of the rest adds offset * A(i, v) over the loci where k is
+// missing and offset * A(k, v) over those where only i is; where both are,
+// that term would be -offset^2 and cancel BB'. Each thread owns whole
+// columns.
+auto add_missing_terms(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    std::span<const IntegerLocus> block,
+    const std::vector<uint64_t>& planes,
+    Index words,
+    const MissingCalls& missing_of_sample,
+    const MissingCalls& missing_of_locus) -> void
+{
+    const Index cols = grm.cols();
+    const Index begin = cols - grm.rows();
+
+    // the levels of every sample at the loci with a missing call
+    std::vector<std::vector<uint8_t>> levels(block.size());
+#pragma omp parallel for schedule(dynamic) default(none) \
+    shared(missing_of_locus, levels, planes, words, cols)
+    for (size_t j = 0; j < levels.size(); ++j)
+    {
+        if (missing_of_locus.row(j).empty())
+        {
+            continue;
+        }
+        levels[j].resize(static_cast<size_t>(cols));
+        for (Index i = 0; i < cols; ++i)
+        {
+            levels[j][static_cast<size_t>(i)]
+                = level_of(planes.data(), words, i, j);
+        }
+    }
+    // the sample of every missing call, in the order they are listed
+    std::vector<uint32_t> samples(missing_of_sample.entries.size());
+    for (Index i = 0; i < cols; ++i)
+    {
+        const auto row = static_cast<size_t>(i);
+        std::fill(
+            samples.begin() + missing_of_sample.offsets[row],
+            samples.begin() + missing_of_sample.offsets[row + 1],
+            static_cast<uint32_t>(i));
+    }
+
+#pragma omp parallel default(none) shared( \
+        grm,                               \
+        block,                             \
+        planes,                            \
+        words,                             \
+        missing_of_sample,                 \
+        samples,                           \
+        levels,                            \
+        cols,                              \
+        begin)
+    {
+        std::vector<double> weights(block.size());
+#pragma omp for schedule(dynamic, 16)
+        for (Index k = 0; k < cols; ++k)
+        {
+            const Index i_begin = std::max(k, begin);
+            const Index length = cols - i_begin;
+            double* column = &grm(i_begin - begin, k);
+
+            for (size_t j = 0; j < block.size(); ++j)
+            {
+                const double offset = block[j].offset;
+                weights[j] = offset
+                             * (static_cast<double>(
+                                    level_of(planes.data(), words, k, j))
+                                - offset);
+            }
+
+            // AB', one pass per missing call of k; BA' skips these loci
+            const auto own = missing_of_sample.row(static_cast<size_t>(k));
+            for (const uint32_t j : own)
+            {
+                const double offset = block[j].offset;
+                const double square = offset * offset;
+                const uint8_t* level = levels[j].data() + i_begin;
+                for (Index r = 0; r < length; ++r)
+                {
+                    column[r] += (offset * level[r]) - square;
+                }
+                weights[j] = 0.0;
+            }
+
+            // BA', over the missing calls of the samples from i_begin on
+            const auto first = missing_of_sample.offsets[
+                static_cast<size_t>(i_begin)];
+            const auto last
+                = missing_of_sample.offsets[static_cast<size_t>(cols)];
+            for (auto e = first; e < last; ++e)
+            {
+                column[samples[e] - i_begin]
+                    += weights[missing_of_sample.entries[e]];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+auto as_integer_locus(Index index, const GenotypeCodeTable& table)
+    -> std::optional<IntegerLocus>
+{
+    if (table[kMissingGenotypeCode] != 0.0)
+    {
+        return std::nullopt;
+    }
+    constexpr std::array<uint8_t, 3> kCalledCodes{0b00, 0b10, 0b11};
+    double lowest = std::numeric_limits<double>::infinity();
+    for (const uint8_t code : kCalledCodes)
+    {
+        if (!std::isfinite(table[code]))
+        {
+            return std::nullopt;
+        }
+        lowest = std::min(lowest, table[code]);
+    }
+
+    IntegerLocus locus{.index = index, .levels = {}, .offset = -lowest};
+    for (const uint8_t code : kCalledCodes)
+    {
+        const double level = table[code] - lowest;
+        const double rounded = std::round(level);
+        if (rounded > 2.0 || std::abs(level - rounded) > kLevelTolerance)
+        {
+            return std::nullopt;
+        }
+        locus.levels[code] = static_cast<uint8_t>(rounded);
+    }
+    return locus;
+}
+
+auto available_cross_product_kernels()
+    -> std::vector<const CrossProductKernel*>
+{
+    std::vector<const CrossProductKernel*> kernels{&kPortableKernel};
+#ifdef GELEX_CROSS_PRODUCT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt"))
+    {
+        kernels.push_back(&kPopcntKernel);
+    }
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512dq")
+        && __builtin_cpu_supports("avx512vpopcntdq"))
+    {
+        kernels.push_back(&kAvx512Kernel);
+    }
+#endif
+    return kernels;
+}
+
+auto cross_product_kernel() -> const CrossProductKernel&
+{
+    static const CrossProductKernel& selected
+        = *available_cross_product_kernels().back();
+    return selected;
+}
+
+auto add_integer_cross_products(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    const PackedCodes& codes,
+    std::span<const IntegerLocus> loci,
+    const CrossProductKernel& kernel) -> void
+{
+    const Index cols = grm.cols();
+    const Index begin = cols - grm.rows();
+
+    Eigen::VectorXd offset_sums = Eigen::VectorXd::Zero(cols);
+    double offset_squares = 0.0;
+    std::vector<uint64_t> planes;
+    std::vector<std::vector<uint32_t>> missing_of_sample(
+        static_cast<size_t>(cols));
+
+    for (size_t first = 0; first < loci.size(); first += kBlockLoci)
+    {
+        const auto block
+            = loci.subspan(first, std::min(kBlockLoci, loci.size() - first));
+        const auto words
+            = static_cast<Index>((block.size() + 511) / 512 * 8);
+        build_planes(
+            codes, block, words, planes, offset_sums, missing_of_sample);
+        for (const IntegerLocus& locus : block)
+        {
+            offset_squares += locus.offset * locus.offset;
+        }
+
+        // integer products t_i t_k, one thread per column
+#pragma omp parallel for schedule(dynamic, 8) default(none) \
+    shared(grm, kernel, planes, words, cols, begin)
+        for (Index k = 0; k < cols; ++k)
+        {
+            const Index i_begin = std::max(k, begin);
+            kernel.add_column(
+                planes.data(),
+                words,
+                k,
+                i_begin,
+                cols,
+                &grm(i_begin - begin, k));
+        }
+
+        const MissingCalls by_sample = compress(missing_of_sample);
+        if (!by_sample.empty())
+        {
+            add_missing_terms(
+                grm,
+                block,
+                planes,
+                words,
+                by_sample,
+                transpose(by_sample, block.size()));
+        }
+    }
+
+    // centering: - r_i - r_k + s over the lower triangle
+#pragma omp parallel for schedule(static) default(none) \
+    shared(grm, offset_sums, offset_squares, cols, begin)
+    for (Index k = 0; k < cols; ++k)
+    {
+        const Index i_begin = std::max(k, begin);
+        grm.col(k).segment(i_begin - begin, cols - i_begin).array()
+            += (offset_squares - offset_sums(k))
+               - offset_sums.segment(i_begin, cols - i_begin).array();
+    }
+}
+
+}  // namespace gelex::detail
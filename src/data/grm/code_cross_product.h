@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_DATA_GRM_CODE_CROSS_PRODUCT_H_
+#define GELEX_DATA_GRM_CODE_CROSS_PRODUCT_H_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/types/genetic_effect_type.h"
+
+namespace gelex::detail
+{
+
+/**
+ * @brief A locus whose processed values are small integers less one
+ * offset: `table[code] == levels[code] - offset` for the called codes,
+ * with levels in {0, 1, 2}, and 0 for the missing code.
+ *
+ * Every center-family GenotypeProcessMethod plans additive loci like this,
+ * and so do the non-orthogonal ones for dominance (a heterozygote
+ * indicator); scaling by a per-locus SD does not fit.
+ */
+struct IntegerLocus
+{
+    Eigen::Index index;
+    std::array<uint8_t, 4> levels;
+    double offset;
+};
+
+// `index` is the locus' column in the chunk; nullopt when `table` is not
+// of the form above.
+auto as_integer_locus(Eigen::Index index, const GenotypeCodeTable& table)
+    -> std::optional<IntegerLocus>;
+
+/**
+ * @brief One implementation of the bit-plane dot products.
+ *
+ * `planes` holds, per sample, `words` 64-bit words of its level >= 1 bits
+ * followed by `words` words of its level == 2 bits; `words` is a multiple
+ * of 8. `add_column` adds sum_v level(k, v) * level(i, v) to
+ * `out[i - i_begin]` for every i in [i_begin, i_end).
+ */
+struct CrossProductKernel
+{
+    std::string_view name;
+    void (*add_column)(
+        const uint64_t* planes,
+        Eigen::Index words,
+        Eigen::Index k,
+        Eigen::Index i_begin,
+        Eigen::Index i_end,
+        double* out);
+};
+
+// Fastest kernel the running CPU supports; resolved once on first use.
+auto cross_product_kernel() -> const CrossProductKernel&;
+
+// Every kernel the running CPU supports, portable first.
+auto available_cross_product_kernels()
+    -> std::vector<const CrossProductKernel*>;
+
+/**
+ * @brief Adds sum_v z_iv z_kv over `loci` to the lower triangle of `grm`
+ * straight from the 2-bit codes.
+ *
+ * `grm` has the layout GRM::update_grm fills (rows [cols - rows, cols) of
+ * an n x n GRM, columns [0, cols)) and `codes` holds at least `cols`
+ * samples. With z = t - offset for called genotypes, t the integer level,
+ * and z = 0 for missing ones, the sum splits into
+ *
+ *   sum t_i t_k - r_i - r_k + s + (missing-call terms),
+ *
+ * r_i = sum offset * t_i and s = sum offset^2. The integer products come
+ * from AND and popcount of per-sample bit planes; the rest is added
+ * afterwards, the missing-call terms walking each missing call once, so
+ * the cost grows with the missing calls rather than with n^2.
+ */
+auto add_integer_cross_products(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    const PackedCodes& codes,
+    std::span<const IntegerLocus> loci,
+    const CrossProductKernel& kernel = cross_product_kernel()) -> void;
+
+}  // namespace gelex::detail
+
+#endif  // GELEX_DATA_GRM_CODE_CROSS_PRODUCT_H_
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/genotype_pca.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+
+#include "gelex/data/genotype/chunk_prefetcher.h"
+#include "gelex/exception.h"
+#include "gelex/infra/logging/notify.h"
+
+namespace gelex
+{
+using Eigen::Index;
+
+namespace
+{
+
+// Replaces the columns of `block` by an orthonormal basis of their span.
+auto orthonormalize(Eigen::MatrixXd& block) -> void
+{
+    const Eigen::HouseholderQR<Eigen::MatrixXd> qr(block);
+    block = qr.householderQ()
+            * Eigen::MatrixXd::Identity(block.rows(), block.cols());
+}
+
+auto fix_signs(Eigen::MatrixXd& vectors) -> void
+{
+    for (Index j = 0; j < vectors.cols(); ++j)
+    {
+        Index largest = 0;
+        vectors.col(j).cwiseAbs().maxCoeff(&largest);
+        if (vectors(largest, j) < 0.0)
+        {
+            vectors.col(j) *= -1.0;
+        }
+    }
+}
+
+}  // namespace
+
+GenotypePca::GenotypePca(const std::filesystem::path& bed_path)
+    : sample_manager_(SampleManager::create_finalized(bed_path)),
+      bed_(bed_path, sample_manager_)
+{
+}
+
+auto GenotypePca::compute(
+    GenotypeProcessMethod method,
+    const Options& options,
+    Index chunk_size,
+    const PcaObserver& observer) -> PcaResult
+{
+    const Index n = bed_.num_samples();
+    const Index m = bed_.num_snps();
+    const Index k = options.num_components;
+    if (k < 1 || k > std::min(n, m))
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "number of principal components must be between 1 and {} "
+                "(the smaller of {} samples and {} variants), got {}",
+                std::min(n, m),
+                n,
+                m,
+                k));
+    }
+    if (options.oversampling < 0 || options.max_iter == 0)
+    {
+        throw ArgumentValidationException(
+            "PCA oversampling must be non-negative and max_iter positive");
+    }
+    const Index l = std::min(k + options.oversampling, n);
+
+    // drawn sequentially so the start block only depends on the seed
+    std::mt19937_64 rng(options.seed);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd basis(n, l);
+    for (double& value : basis.reshaped())
+    {
+        value = normal(rng);
+    }
+    orthonormalize(basis);
+
+    const std::vector<std::pair<Index, Index>> ranges{{0, m}};
+    const auto chunks = ChunkPrefetcher::split(ranges, chunk_size);
+    const auto planner = get_genotype_planner<GeneticEffectType::Add>(method);
+
+    PcaResult result;
+    Eigen::MatrixXd product(n, l);
+    Eigen::MatrixXd projected;
+    for (size_t iter = 1; iter <= options.max_iter; ++iter)
+    {
+        product.setZero();
+        double sum_squares = 0.0;
+        ChunkPrefetcher prefetcher(
+            chunks, ChunkPrefetcher::decode(bed_, planner));
+        while (auto* chunk = prefetcher.next())
+        {
+            const auto& genotype = chunk->genotype;
+            projected.noalias() = genotype.transpose() * basis;
+            product.noalias() += genotype * projected;
+            sum_squares += genotype.squaredNorm();
+        }
+
+        // Rayleigh-Ritz on span(basis); the solver sorts ascending
+        const Eigen::MatrixXd reduced = basis.transpose() * product;
+        const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen(reduced);
+        const Eigen::VectorXd values = eigen.eigenvalues().tail(k).reverse();
+        const Eigen::MatrixXd rotation
+            = eigen.eigenvectors().rightCols(k).rowwise().reverse();
+
+        // Z Z' u - lambda u for u = basis * v, using product = Z Z' basis
+        const Eigen::MatrixXd vectors = basis * rotation;
+        const Eigen::MatrixXd residuals
+            = (product * rotation) - (vectors * values.asDiagonal());
+        double residual = 0.0;
+        for (Index j = 0; j < k; ++j)
+        {
+            residual = std::max(
+                residual,
+                residuals.col(j).norm()
+                    / std::max(
+                        std::abs(values(j)),
+                        std::numeric_limits<double>::min()));
+        }
+        notify(observer, PcaIterationEvent{iter, residual});
+
+        result.iterations = iter;
+        result.converged = residual < options.tol;
+        if (result.converged || iter == options.max_iter)
+        {
+            result.eigenvectors = vectors;
+            result.eigenvalues
+                = values / (sum_squares / static_cast<double>(n));
+            break;
+        }
+        basis = product;
+        orthonormalize(basis);
+    }
+    fix_signs(result.eigenvectors);
+
+    notify(
+        observer,
+        PcaCompleteEvent{
+            .eigenvalues = std::vector<double>(
+                result.eigenvalues.begin(), result.eigenvalues.end()),
+            .iterations = result.iterations,
+            .converged = result.converged,
+        });
+    return result;
+}
+
+}  // namespace gelex
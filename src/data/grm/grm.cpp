@@ -16,7 +16,11 @@
 
 #include "gelex/data/grm/grm.h"
 
+#include <algorithm>
+#include <format>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include <Eigen/Core>
 #ifdef USE_MKL
@@ -26,6 +30,7 @@
 #include <cblas.h>
 #endif
 
+#include "data/grm/code_cross_product.h"
 #include "gelex/data/genotype/bed_pipe.h"
 #include "gelex/data/genotype/sample_manager.h"
 
@@ -39,12 +44,65 @@ GRM::GRM(const std::filesystem::path& bed_path)
 {
 }
 
+auto GRM::set_part(GrmPart part) -> void
+{
+    if (part.row_begin < 0 || part.row_begin >= part.row_end
+        || part.row_end > bed_.num_samples())
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "GRM part rows [{}, {}) are not within {} samples",
+                part.row_begin,
+                part.row_end,
+                bed_.num_samples()));
+    }
+    part_ = part;
+}
+
+auto GRM::make_accumulator() const -> Eigen::MatrixXd
+{
+    const GrmPart rows = part();
+    Eigen::MatrixXd grm(rows.num_rows(), rows.row_end);
+    advise_huge_pages(grm);
+    numa_first_touch(grm);
+    return grm;
+}
+
+auto GRM::denominator(const Eigen::MatrixXd& grm) const -> double
+{
+    return grm.rightCols(grm.rows()).trace()
+           / static_cast<double>(bed_.num_samples());
+}
+
 auto GRM::update_grm(
     Eigen::Ref<Eigen::MatrixXd> grm,
     const Eigen::Ref<const Eigen::MatrixXd>& genotype) -> void
 {
     const auto n = static_cast<int>(genotype.rows());
     const auto m = static_cast<int>(genotype.cols());
+    const auto rows = static_cast<int>(grm.rows());
+    const auto begin = static_cast<int>(grm.cols() - grm.rows());
+    const auto ldc = static_cast<int>(grm.outerStride());
+
+    // columns left of the slice's diagonal block: a full rectangle
+    if (begin > 0)
+    {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasTrans,
+            rows,
+            begin,
+            m,
+            1.0,
+            genotype.data() + begin,
+            n,
+            genotype.data(),
+            n,
+            1.0,
+            grm.data(),
+            ldc);
+    }
 
     // dsyrk: C := alpha * A * A^T + beta * C
     // CblasLower: only updates lower triangle
@@ -52,13 +110,230 @@ auto GRM::update_grm(
         CblasColMajor,
         CblasLower,
         CblasNoTrans,
-        n,
+        rows,
         m,
         1.0,
-        genotype.data(),
+        genotype.data() + begin,
         n,
         1.0,
-        grm.data(),
-        n);
+        grm.data() + (static_cast<Index>(begin) * ldc),
+        ldc);
+}
+
+auto GRM::compute_add_dom(
+    GenotypeProcessMethod method,
+    const std::vector<std::pair<Index, Index>>& ranges,
+    Index chunk_size,
+    const GrmObserver& observer) -> std::pair<GrmResult, GrmResult>
+{
+    Eigen::MatrixXd additive = make_accumulator();
+    Eigen::MatrixXd dominance = make_accumulator();
+
+    Index total_snps_to_process = 0;
+    for (const auto& [start, end] : ranges)
+    {
+        total_snps_to_process += (end - start);
+    }
+
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, chunk_size), add_dom_producer(method));
+
+    // progress counts both GRMs, as if they were computed one after another
+    std::vector<GenotypeCodeCounts> counts;
+    Index processed_snps = 0;
+    while (auto* chunk = prefetcher.next())
+    {
+        accumulate(additive, *chunk);
+        accumulate(dominance, *chunk, true);
+        collect_counts(counts, *chunk);
+
+        processed_snps += chunk->end - chunk->start;
+        notify(
+            observer,
+            GrmProgressEvent{
+                static_cast<size_t>(2 * processed_snps),
+                static_cast<size_t>(2 * total_snps_to_process),
+                false});
+    }
+
+    chunk_product_.resize(0, 0);
+    const double additive_denominator = denominator(additive);
+    const double dominance_denominator = denominator(dominance);
+    return {
+        GrmResult{std::move(additive), additive_denominator, std::move(counts)},
+        GrmResult{std::move(dominance), dominance_denominator, {}}};
+}
+
+auto GRM::add_dom_producer(GenotypeProcessMethod method) const
+    -> ChunkPrefetcher::Producer
+{
+    auto additive = get_genotype_planner<GeneticEffectType::Add>(method);
+    auto dominance = get_genotype_planner<GeneticEffectType::Dom>(method);
+    if (kernel_ == GrmKernel::Packed)
+    {
+        return ChunkPrefetcher::pack(bed_, additive, dominance);
+    }
+    return precision_ == GrmPrecision::Mixed
+               ? ChunkPrefetcher::decode_f32(bed_, additive, dominance)
+               : ChunkPrefetcher::decode(bed_, additive, dominance);
+}
+
+auto GRM::accumulate(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    const ChunkPrefetcher::Chunk& chunk,
+    bool dominance) -> void
+{
+    if (kernel_ == GrmKernel::Packed)
+    {
+        const Index bitwise = update_grm_packed(
+            grm,
+            chunk.codes,
+            dominance ? chunk.dominance_plans : chunk.plans,
+            chunk.counts);
+        packed_usage_.bitwise += bitwise;
+        packed_usage_.expanded += (chunk.end - chunk.start) - bitwise;
+        return;
+    }
+    if (precision_ == GrmPrecision::Mixed)
+    {
+        update_grm_mixed(
+            grm,
+            chunk_product_,
+            dominance ? chunk.dominance_f32 : chunk.genotype_f32);
+        return;
+    }
+    update_grm(grm, dominance ? chunk.dominance : chunk.genotype);
+}
+
+auto GRM::update_grm_mixed(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    Eigen::MatrixXf& product,
+    const Eigen::Ref<const Eigen::MatrixXf>& genotype) -> void
+{
+    const auto n = static_cast<int>(genotype.rows());
+    const auto m = static_cast<int>(genotype.cols());
+    const Index rows = grm.rows();
+    const Index cols = grm.cols();
+    const Index begin = cols - rows;
+    if (product.rows() != rows || product.cols() != cols)
+    {
+        product.resize(rows, cols);
+        advise_huge_pages(product);
+    }
+
+    // P := A * A^T over the slice, overwritten per chunk: sgemm left of
+    // the diagonal block, ssyrk (lower triangle) on it
+    if (begin > 0)
+    {
+        cblas_sgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasTrans,
+            static_cast<int>(rows),
+            static_cast<int>(begin),
+            m,
+            1.0F,
+            genotype.data() + begin,
+            n,
+            genotype.data(),
+            n,
+            0.0F,
+            product.data(),
+            static_cast<int>(rows));
+    }
+    cblas_ssyrk(
+        CblasColMajor,
+        CblasLower,
+        CblasNoTrans,
+        static_cast<int>(rows),
+        m,
+        1.0F,
+        genotype.data() + begin,
+        n,
+        0.0F,
+        product.data() + (begin * rows),
+        static_cast<int>(rows));
+
+#pragma omp parallel for schedule(static) default(none) \
+    shared(grm, product, rows, cols, begin)
+    for (Index j = 0; j < cols; ++j)
+    {
+        const Index first = std::max<Index>(j - begin, 0);
+        grm.col(j).tail(rows - first)
+            += product.col(j).tail(rows - first).cast<double>();
+    }
+}
+
+namespace
+{
+
+// Packed kernel: variants outside the popcount path expanded per panel,
+// each panel one dgemm/dsyrk update, so the decoded working set stays at
+// n x kPanelVariants doubles whatever the chunk size.
+constexpr Index kPanelVariants = 256;
+
+// A missing call costs the popcount path O(n) scalar updates; at about one
+// in 100 samples that catches up with the variant's share of a dsyrk.
+constexpr int64_t kMissingCallsPerSample = 128;
+
+}  // namespace
+
+auto GRM::update_grm_packed(
+    Eigen::Ref<Eigen::MatrixXd> grm,
+    const PackedCodes& codes,
+    std::span<const LocusPlan> plans,
+    std::span<const GenotypeCodeCounts> counts) -> Index
+{
+    std::vector<detail::IntegerLocus> integer_loci;
+    std::vector<Index> expanded;
+    for (size_t v = 0; v < plans.size(); ++v)
+    {
+        const auto index = static_cast<Index>(v);
+        const bool few_missing
+            = counts[v][kMissingGenotypeCode] * kMissingCallsPerSample
+              <= codes.rows();
+        auto locus = few_missing
+                         ? detail::as_integer_locus(index, plans[v].values)
+                         : std::nullopt;
+        if (locus)
+        {
+            integer_loci.push_back(*locus);
+        }
+        else
+        {
+            expanded.push_back(index);
+        }
+    }
+    if (!integer_loci.empty())
+    {
+        detail::add_integer_cross_products(grm, codes, integer_loci);
+    }
+
+    // Only the samples up to the slice's last row enter its products.
+    const Index cols = grm.cols();
+    const auto num_expanded = static_cast<Index>(expanded.size());
+    Eigen::MatrixXd panel(
+        cols, std::min(num_expanded, Index{kPanelVariants}));
+
+    for (Index first = 0; first < num_expanded; first += kPanelVariants)
+    {
+        const Index width
+            = std::min(num_expanded - first, Index{kPanelVariants});
+        // consecutive samples fill the same cache lines of every column
+#pragma omp parallel for schedule(static) default(none) \
+    shared(panel, codes, plans, expanded, cols, first, width)
+        for (Index k = 0; k < cols; ++k)
+        {
+            const uint8_t* row = &codes(k, 0);
+            for (Index j = 0; j < width; ++j)
+            {
+                const Index v = expanded[static_cast<size_t>(first + j)];
+                const uint8_t code = (row[v / 4] >> (2 * (v % 4))) & 0b11U;
+                panel(k, j) = plans[static_cast<size_t>(v)].values[code];
+            }
+        }
+        update_grm(grm, panel.leftCols(width));
+    }
+    return static_cast<Index>(integer_loci.size());
 }
 }  // namespace gelex
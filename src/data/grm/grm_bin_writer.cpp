@@ -16,7 +16,9 @@
 
 #include "gelex/data/grm/grm_bin_writer.h"
 
+#include <algorithm>
 #include <format>
+#include <vector>
 
 #include "gelex/exception.h"
 #include "gelex/io/parser.h"
@@ -24,11 +26,72 @@
 namespace gelex
 {
 
-GrmBinWriter::GrmBinWriter(const std::filesystem::path& file_path)
+GrmBinWriter::GrmBinWriter(
+    const std::filesystem::path& file_path,
+    bool append)
     : path_(file_path), io_buffer_(kDefaultBufferSize)
 {
     file_ = detail::open_file<std::ofstream>(
-        path_, std::ios::binary | std::ios::trunc, io_buffer_);
+        path_,
+        std::ios::binary | (append ? std::ios::app : std::ios::trunc),
+        io_buffer_);
+}
+
+template <typename Value>
+auto GrmBinWriter::write_lower(
+    Eigen::Index num_rows,
+    Eigen::Index begin,
+    const Value& value) -> void
+{
+    // Lower triangle (including diagonal) as float32, row by row:
+    // (0,0), (1,0), (1,1), (2,0), (2,1), (2,2), ...
+    // Rows are converted into a float stage in parallel and each stage goes
+    // out in one write; the tiles read short contiguous runs of a column.
+    const auto triangle = [](Eigen::Index i) -> size_t
+    { return static_cast<size_t>(i) * static_cast<size_t>(i + 1) / 2; };
+    std::vector<float> stage;
+    Eigen::Index first = 0;
+    while (first < num_rows)
+    {
+        Eigen::Index last = first + 1;
+        while (last < num_rows
+               && triangle(begin + last + 1) - triangle(begin + first)
+                      <= kStageFloats)
+        {
+            ++last;
+        }
+        const size_t base = triangle(begin + first);
+        stage.resize(triangle(begin + last) - base);
+
+        const Eigen::Index num_tiles
+            = (last - first + kTileRows - 1) / kTileRows;
+#pragma omp parallel for schedule(dynamic)
+        for (Eigen::Index tile = 0; tile < num_tiles; ++tile)
+        {
+            const Eigen::Index r0 = first + (tile * kTileRows);
+            const Eigen::Index r1 = std::min(r0 + kTileRows, last);
+            for (Eigen::Index j = 0; j < begin + r1; ++j)
+            {
+                for (Eigen::Index r = std::max(r0, j - begin); r < r1; ++r)
+                {
+                    stage[triangle(begin + r) - base + j]
+                        = static_cast<float>(value(r, j));
+                }
+            }
+        }
+
+        file_.write(
+            reinterpret_cast<const char*>(stage.data()),
+            static_cast<std::streamsize>(stage.size() * sizeof(float)));
+        first = last;
+    }
+
+    if (!file_.good())
+    {
+        throw FileWriteException(
+            std::format(
+                "{}: failed to write GRM data to binary file", path_.string()));
+    }
 }
 
 auto GrmBinWriter::write(const Eigen::Ref<const Eigen::MatrixXd>& grm) -> void
@@ -49,23 +112,52 @@ auto GrmBinWriter::write(const Eigen::Ref<const Eigen::MatrixXd>& grm) -> void
                 grm.cols()));
     }
 
-    // Write lower triangle (including diagonal) as float32
-    // Order: (0,0), (1,0), (1,1), (2,0), (2,1), (2,2), ...
-    for (Eigen::Index i = 0; i < n; ++i)
+    write_rows(grm);
+}
+
+auto GrmBinWriter::write_rows(const Eigen::Ref<const Eigen::MatrixXd>& rows)
+    -> void
+{
+    const Eigen::Index begin = rows.cols() - rows.rows();
+    if (begin < 0)
     {
-        for (Eigen::Index j = 0; j <= i; ++j)
-        {
-            auto value = static_cast<float>(grm(i, j));
-            file_.write(reinterpret_cast<const char*>(&value), sizeof(float));
-        }
+        throw InvalidInputException(
+            std::format(
+                "{}: GRM rows must span at least as many columns, got {}x{}",
+                path_.string(),
+                rows.rows(),
+                rows.cols()));
     }
 
-    if (!file_.good())
+    write_lower(
+        rows.rows(),
+        begin,
+        [&rows](Eigen::Index r, Eigen::Index j) { return rows(r, j); });
+}
+
+auto GrmBinWriter::write_hadamard(
+    const Eigen::Ref<const Eigen::MatrixXd>& left,
+    const Eigen::Ref<const Eigen::MatrixXd>& right,
+    double scale) -> void
+{
+    if (left.rows() != left.cols() || right.rows() != left.rows()
+        || right.cols() != left.cols())
     {
-        throw FileWriteException(
+        throw InvalidInputException(
             std::format(
-                "{}: failed to write GRM data to binary file", path_.string()));
+                "{}: Hadamard product needs two square GRMs of one size, got "
+                "{}x{} and {}x{}",
+                path_.string(),
+                left.rows(),
+                left.cols(),
+                right.rows(),
+                right.cols()));
     }
+    write_lower(
+        left.rows(),
+        0,
+        [&](Eigen::Index r, Eigen::Index j)
+        { return scale * left(r, j) * right(r, j); });
 }
 
 }  // namespace gelex
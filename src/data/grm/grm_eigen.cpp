@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/grm_eigen.h"
+
+#include <format>
+#include <utility>
+
+#include <Eigen/src/misc/lapacke.h>
+
+#include "gelex/data/io/binary_writer.h"
+#include "gelex/exception.h"
+
+namespace gelex
+{
+
+auto decompose_grm(Eigen::MatrixXd grm) -> freq::GrmEigen
+{
+    const Eigen::Index n = grm.rows();
+    if (n == 0 || grm.cols() != n)
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "GRM to decompose must be square and non-empty, got {}x{}",
+                n,
+                grm.cols()));
+    }
+    const double scale = grm.trace() / static_cast<double>(n);
+    if (!(scale > 0.0))
+    {
+        throw InvalidInputException(
+            "GRM to decompose has a non-positive trace");
+    }
+    grm.triangularView<Eigen::Lower>() /= scale;
+
+    Eigen::VectorXd values(n);
+    const auto size = static_cast<lapack_int>(n);
+    const lapack_int info = LAPACKE_dsyevd(
+        LAPACK_COL_MAJOR, 'V', 'L', size, grm.data(), size, values.data());
+    if (info != 0)
+    {
+        throw InvalidOperationException(
+            std::format("dsyevd failed to converge (info = {})", info));
+    }
+    return {.values = std::move(values), .vectors = std::move(grm)};
+}
+
+auto write_grm_eigen(
+    const freq::GrmEigen& eigen,
+    const std::filesystem::path& path) -> void
+{
+    if (eigen.vectors.rows() != eigen.values.size()
+        || eigen.vectors.cols() != eigen.values.size())
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "{}: {} eigenvalues but {}x{} eigenvectors",
+                path.string(),
+                eigen.values.size(),
+                eigen.vectors.rows(),
+                eigen.vectors.cols()));
+    }
+    detail::BinaryWriter<double> writer(path.string());
+    writer.write(eigen.values);
+    for (Eigen::Index j = 0; j < eigen.vectors.cols(); ++j)
+    {
+        writer.write(eigen.vectors.col(j));
+    }
+    writer.finish();
+}
+
+namespace detail
+{
+
+GrmEigenLoader::GrmEigenLoader(const std::filesystem::path& prefix)
+    : path_(prefix.string() + ".eig"),
+      grm_(prefix),
+      matrix_(path_.string())
+{
+    const auto& matrix = matrix_.matrix();
+    if (matrix.rows() != num_samples() || matrix.cols() != num_samples() + 1)
+    {
+        throw FileFormatException(
+            std::format(
+                "{}: {}x{} matrix, expected {}x{} for the {} samples of the "
+                "GRM",
+                path_.string(),
+                matrix.rows(),
+                matrix.cols(),
+                num_samples(),
+                num_samples() + 1,
+                num_samples()));
+    }
+}
+
+auto GrmEigenLoader::load(
+    const std::unordered_map<std::string, Eigen::Index>& id_map) const
+    -> freq::GrmEigen
+{
+    const auto permutation = grm_.permutation(id_map);
+    if (permutation.target_size != num_samples()
+        || std::cmp_not_equal(permutation.sources.size(), num_samples()))
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: decomposes {} samples but {} are analysed; a subset "
+                "needs its own decomposition",
+                path_.string(),
+                num_samples(),
+                id_map.size()));
+    }
+
+    const auto vectors = eigenvectors();
+    freq::GrmEigen eigen{
+        .values = eigenvalues(),
+        .vectors = Eigen::MatrixXd(num_samples(), num_samples())};
+#pragma omp parallel for schedule(static)
+    for (Eigen::Index j = 0; j < num_samples(); ++j)
+    {
+        for (size_t i = 0; i < permutation.sources.size(); ++i)
+        {
+            eigen.vectors(permutation.targets[i], j)
+                = vectors(permutation.sources[i], j);
+        }
+    }
+    return eigen;
+}
+
+}  // namespace detail
+
+}  // namespace gelex
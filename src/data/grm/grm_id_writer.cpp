@@ -25,11 +25,13 @@
 namespace gelex
 {
 
-GrmIdWriter::GrmIdWriter(const std::filesystem::path& file_path)
+GrmIdWriter::GrmIdWriter(
+    const std::filesystem::path& file_path,
+    bool append)
     : path_(file_path)
 {
     file_ = detail::open_file<std::ofstream>(
-        path_, std::ios::out | std::ios::trunc);
+        path_, std::ios::out | (append ? std::ios::app : std::ios::trunc));
 }
 
 auto GrmIdWriter::split_id(std::string_view id)
@@ -19,11 +19,16 @@
 #include <algorithm>
 #include <format>
 #include <fstream>
+#include <numeric>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <unordered_set>
+#include <utility>
 
 #include "gelex/data/frame/dataframe_policy.h"
 #include "gelex/exception.h"
+#include "gelex/infra/utils/numa.h"
 #include "gelex/io/parser.h"
 #include "gelex/types/freq_effect.h"
 
@@ -31,6 +36,19 @@ namespace
 {
 auto get_type(std::string_view grm_path_stem) -> gelex::freq::GrmType
 {
+    // the products of grm --epistasis, named by their last extension
+    if (grm_path_stem.ends_with(".aa"))
+    {
+        return gelex::freq::GrmType::AA;
+    }
+    if (grm_path_stem.ends_with(".ad"))
+    {
+        return gelex::freq::GrmType::AD;
+    }
+    if (grm_path_stem.ends_with(".dd"))
+    {
+        return gelex::freq::GrmType::DD;
+    }
     if (grm_path_stem.contains("add"))
     {
         return gelex::freq::GrmType::A;
@@ -50,6 +68,13 @@ GrmLoader::GrmLoader(const std::filesystem::path& prefix)
       id_path_(prefix.string() + ".id"),
       type_(get_type(prefix.string()))
 {
+    const std::filesystem::path sparse_path = prefix.string() + ".sp.bin";
+    if (!std::filesystem::exists(bin_path_)
+        && std::filesystem::exists(sparse_path))
+    {
+        bin_path_ = sparse_path;
+        sparse_ = true;
+    }
     load_sample_ids();
     init_mmap();
 }
@@ -103,6 +128,20 @@ auto GrmLoader::init_mmap() -> void
             std::format("{}: failed to mmap file", bin_path_.string()));
     }
 
+    if (sparse_)
+    {
+        if (mmap_.size() % sizeof(SparseGrmEntry) != 0)
+        {
+            throw FileFormatException(
+                std::format(
+                    "{}: file size {} is not a whole number of sparse GRM "
+                    "entries",
+                    bin_path_.string(),
+                    mmap_.size()));
+        }
+        return;
+    }
+
     // GRM binary format: [float32 lower triangle]
     // Expected size = n * (n + 1) / 2 * sizeof(float)
     size_t expected_elements = static_cast<size_t>(num_samples_)
@@ -132,22 +171,14 @@ auto GrmLoader::load() const -> Eigen::MatrixXd
 
 auto GrmLoader::load_unnormalized() const -> Eigen::MatrixXd
 {
-    Eigen::MatrixXd grm(num_samples_, num_samples_);
-
-    const auto* data = reinterpret_cast<const float*>(mmap_.data());
-
-    // Fill lower triangle and mirror to upper triangle
-    for (Eigen::Index i = 0; i < num_samples_; ++i)
-    {
-        for (Eigen::Index j = 0; j <= i; ++j)
-        {
-            size_t idx = lower_triangle_index(i, j);
-            auto value = static_cast<double>(data[idx]);
-            grm(i, j) = value;
-            grm(j, i) = value;
-        }
-    }
+    GrmPermutation identity{
+        .target_size = num_samples_, .num_file_samples = num_samples_};
+    identity.sources.resize(static_cast<size_t>(num_samples_));
+    std::iota(identity.sources.begin(), identity.sources.end(), 0);
+    identity.targets = identity.sources;
 
+    Eigen::MatrixXd grm;
+    load_unnormalized(identity, grm);
     return grm;
 }
 
@@ -173,64 +204,324 @@ auto GrmLoader::load_unnormalized(
         target.resize(0, 0);
         return;
     }
+    load_unnormalized(permutation(id_map), target);
+}
+
+auto GrmLoader::permutation(
+    const std::unordered_map<std::string, Eigen::Index>& id_map) const
+    -> GrmPermutation
+{
+    GrmPermutation result{.num_file_samples = num_samples_};
+    result.sources.reserve(id_map.size());
+    result.targets.reserve(id_map.size());
 
-    // Build file_id -> file_index mapping
-    std::unordered_map<std::string, Eigen::Index> file_id_to_idx;
-    file_id_to_idx.reserve(sample_ids_.size());
+    // walking the file keeps the sources ascending and needs no second map
+    Eigen::Index max_target_idx = -1;
     for (Eigen::Index i = 0; i < num_samples_; ++i)
     {
-        file_id_to_idx[sample_ids_[i]] = i;
+        auto it = id_map.find(sample_ids_[static_cast<size_t>(i)]);
+        if (it != id_map.end())
+        {
+            result.sources.push_back(i);
+            result.targets.push_back(it->second);
+            max_target_idx = std::max(max_target_idx, it->second);
+        }
+    }
+
+    if (result.sources.size() < id_map.size())
+    {
+        const std::unordered_set<std::string_view> file_ids(
+            sample_ids_.begin(), sample_ids_.end());
+        for (const auto& [id, target_idx] : id_map)
+        {
+            if (!file_ids.contains(id))
+            {
+                throw InvalidInputException(
+                    std::format(
+                        "{}: sample ID '{}' not found in GRM file",
+                        bin_path_.string(),
+                        id));
+            }
+        }
     }
 
-    // Build source_idx -> target_idx mapping
-    // and find max target index to determine output matrix size
-    Eigen::Index max_target_idx = 0;
-    std::vector<std::pair<Eigen::Index, Eigen::Index>> idx_mapping;
-    idx_mapping.reserve(id_map.size());
+    result.target_size = max_target_idx + 1;
+    return result;
+}
+
+template <typename Apply>
+auto GrmLoader::expand_dense(
+    const GrmPermutation& permutation,
+    Eigen::MatrixXd& target,
+    Apply&& apply) const -> void
+{
+    const Eigen::Index n = permutation.target_size;
+    const auto& sources = permutation.sources;
+    const auto& targets = permutation.targets;
+    const auto count = static_cast<Eigen::Index>(sources.size());
+    const auto* data = reinterpret_cast<const float*>(mmap_.data());
+
+    // rank of each target index in file order; -1 where nothing lands
+    std::vector<Eigen::Index> rank(static_cast<size_t>(n), -1);
+    bool identity = n == num_samples_ && count == n;
+    bool ordered = true;
+    for (Eigen::Index k = 0; k < count; ++k)
+    {
+        const auto kk = static_cast<size_t>(k);
+        rank[static_cast<size_t>(targets[kk])] = k;
+        identity = identity && sources[kk] == k && targets[kk] == k;
+        ordered = ordered && (k == 0 || targets[kk] > targets[kk - 1]);
+    }
 
-    for (const auto& [id, target_idx] : id_map)
+    // packed row s_k holds (s_k, s_l) for l <= k: column t_k of the target
+    // takes them in one pass, each column owned by one thread
+#pragma omp parallel for schedule(dynamic, 16)
+    for (Eigen::Index k = 0; k < count; ++k)
     {
-        auto it = file_id_to_idx.find(id);
-        if (it == file_id_to_idx.end())
+        const auto kk = static_cast<size_t>(k);
+        const float* row = data + lower_triangle_index(sources[kk], 0);
+        auto column = target.col(targets[kk]);
+        if (identity)
         {
-            throw InvalidInputException(
-                std::format(
-                    "{}: sample ID '{}' not found in GRM file",
-                    bin_path_.string(),
-                    id));
+            apply(
+                column.head(k + 1),
+                Eigen::Map<const Eigen::VectorXf>(row, k + 1)
+                    .cast<double>());
+            continue;
+        }
+        for (Eigen::Index l = 0; l <= k; ++l)
+        {
+            const auto ll = static_cast<size_t>(l);
+            apply(
+                column(targets[ll]), static_cast<double>(row[sources[ll]]));
         }
+    }
 
-        idx_mapping.emplace_back(it->second, target_idx);
-        max_target_idx = std::max(max_target_idx, target_idx);
+    // mirror (r, c) from (c, r) wherever c comes first in file order; with
+    // an order-preserving map that is the strictly lower triangle, so tiles
+    // above the diagonal are skipped
+    constexpr Eigen::Index kTile = 64;
+    const Eigen::Index num_tiles = (n + kTile - 1) / kTile;
+#pragma omp parallel for collapse(2) schedule(dynamic)
+    for (Eigen::Index tc = 0; tc < num_tiles; ++tc)
+    {
+        for (Eigen::Index tr = 0; tr < num_tiles; ++tr)
+        {
+            if (ordered && tr < tc)
+            {
+                continue;
+            }
+            const Eigen::Index c1 = std::min((tc + 1) * kTile, n);
+            const Eigen::Index r1 = std::min((tr + 1) * kTile, n);
+            for (Eigen::Index c = tc * kTile; c < c1; ++c)
+            {
+                const Eigen::Index rank_c = rank[static_cast<size_t>(c)];
+                if (rank_c < 0)
+                {
+                    continue;
+                }
+                for (Eigen::Index r = tr * kTile; r < r1; ++r)
+                {
+                    if (rank[static_cast<size_t>(r)] > rank_c)
+                    {
+                        target(r, c) = target(c, r);
+                    }
+                }
+            }
+        }
     }
+}
 
-    // Allocate output matrix
-    Eigen::Index out_size = max_target_idx + 1;
-    target.setZero(out_size, out_size);
+auto GrmLoader::load_unnormalized(
+    const GrmPermutation& permutation,
+    Eigen::MatrixXd& target) const -> void
+{
+    if (permutation.num_file_samples != num_samples_)
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: permutation built for {} samples, file has {}",
+                bin_path_.string(),
+                permutation.num_file_samples,
+                num_samples_));
+    }
+
+    const Eigen::Index n = permutation.target_size;
+    target.resize(n, n);
+    numa_first_touch(target);
+
+    if (sparse_)
+    {
+        for_each_sparse_entry(
+            permutation,
+            [&](Eigen::Index r, Eigen::Index c, double value)
+            {
+                target(r, c) = value;
+                target(c, r) = value;
+            });
+        return;
+    }
+
+    expand_dense(
+        permutation,
+        target,
+        [](auto&& entry, const auto& value) { entry = value; });
+}
+
+auto GrmLoader::subtract_scaled(
+    const GrmPermutation& permutation,
+    double scale,
+    Eigen::MatrixXd& target) const -> void
+{
+    if (sparse_)
+    {
+        throw InvalidOperationException(
+            std::format(
+                "{}: subtracting needs a dense GRM (.bin)",
+                bin_path_.string()));
+    }
+    const Eigen::Index n = permutation.target_size;
+    if (permutation.num_file_samples != num_samples_
+        || std::cmp_not_equal(permutation.sources.size(), n)
+        || target.rows() != n || target.cols() != n)
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: permutation of {} samples onto {} does not cover the "
+                "{}x{} target",
+                bin_path_.string(),
+                permutation.sources.size(),
+                n,
+                target.rows(),
+                target.cols()));
+    }
+
+    expand_dense(
+        permutation,
+        target,
+        [scale](auto&& entry, const auto& value)
+        { entry = (entry - value) * scale; });
+}
 
+auto GrmLoader::trace(const GrmPermutation& permutation) const -> double
+{
+    if (permutation.num_file_samples != num_samples_)
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: permutation built for {} samples, file has {}",
+                bin_path_.string(),
+                permutation.num_file_samples,
+                num_samples_));
+    }
+    double sum = 0.0;
+    if (sparse_)
+    {
+        for_each_sparse_entry(
+            permutation,
+            [&](Eigen::Index r, Eigen::Index c, double value)
+            {
+                if (r == c)
+                {
+                    sum += value;
+                }
+            });
+        return sum;
+    }
     const auto* data = reinterpret_cast<const float*>(mmap_.data());
+    for (const Eigen::Index source : permutation.sources)
+    {
+        sum += static_cast<double>(
+            data[lower_triangle_index(source, source)]);
+    }
+    return sum;
+}
 
-    // Fill the matrix using index mapping
-    for (size_t ii = 0; ii < idx_mapping.size(); ++ii)
+template <typename Visit>
+auto GrmLoader::for_each_sparse_entry(
+    const GrmPermutation& permutation,
+    Visit&& visit) const -> void
+{
+    std::vector<Eigen::Index> target_of(static_cast<size_t>(num_samples_), -1);
+    for (size_t k = 0; k < permutation.sources.size(); ++k)
     {
-        auto [src_i, tgt_i] = idx_mapping[ii];
+        target_of[static_cast<size_t>(permutation.sources[k])]
+            = permutation.targets[k];
+    }
 
-        for (size_t jj = 0; jj < idx_mapping.size(); ++jj)
+    for (const auto& entry : sparse_entries())
+    {
+        if (entry.row >= num_samples_ || entry.col > entry.row)
+        {
+            throw FileFormatException(
+                std::format(
+                    "{}: entry ({}, {}) is outside the lower triangle of {} "
+                    "samples",
+                    bin_path_.string(),
+                    entry.row,
+                    entry.col,
+                    num_samples_));
+        }
+        const Eigen::Index r = target_of[entry.row];
+        const Eigen::Index c = target_of[entry.col];
+        if (r >= 0 && c >= 0)
         {
-            auto [src_j, tgt_j] = idx_mapping[jj];
+            visit(r, c, static_cast<double>(entry.value));
+        }
+    }
+}
 
-            // Read from lower triangle (ensure src_i >= src_j)
-            Eigen::Index file_i = src_i;
-            Eigen::Index file_j = src_j;
-            if (file_i < file_j)
+auto GrmLoader::load_sparse_unnormalized(
+    const GrmPermutation& permutation) const -> Eigen::SparseMatrix<double>
+{
+    if (!sparse_)
+    {
+        throw InvalidOperationException(
+            std::format(
+                "{}: sparse loading needs a sparse GRM (.sp.bin)",
+                bin_path_.string()));
+    }
+    if (permutation.num_file_samples != num_samples_)
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: permutation built for {} samples, file has {}",
+                bin_path_.string(),
+                permutation.num_file_samples,
+                num_samples_));
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(2 * num_sparse_entries());
+    for_each_sparse_entry(
+        permutation,
+        [&](Eigen::Index r, Eigen::Index c, double value)
+        {
+            triplets.emplace_back(r, c, value);
+            if (r != c)
             {
-                std::swap(file_i, file_j);
+                triplets.emplace_back(c, r, value);
             }
+        });
 
-            size_t idx = lower_triangle_index(file_i, file_j);
-            target(tgt_i, tgt_j) = static_cast<double>(data[idx]);
-        }
+    const Eigen::Index n = permutation.target_size;
+    Eigen::SparseMatrix<double> grm(n, n);
+    grm.setFromTriplets(triplets.begin(), triplets.end());
+    return grm;
+}
+
+auto GrmLoader::load_sparse(
+    const std::unordered_map<std::string, Eigen::Index>& id_map) const
+    -> Eigen::SparseMatrix<double>
+{
+    Eigen::SparseMatrix<double> grm
+        = load_sparse_unnormalized(permutation(id_map));
+    if (grm.rows() > 0)
+    {
+        const double trace = grm.diagonal().sum();
+        grm /= trace / static_cast<double>(grm.rows());
     }
+    return grm;
 }
 
 auto GrmLoader::load_unnormalized(
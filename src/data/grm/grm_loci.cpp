@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/grm_loci.h"
+
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gelex/exception.h"
+#include "gelex/io/parser.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+constexpr std::string_view kHeader = "SNP\tA1\tA2\tHOM1\tMISS\tHET\tHOM2";
+constexpr size_t kColumns = 7;
+
+}  // namespace
+
+GrmLociWriter::GrmLociWriter(const std::filesystem::path& file_path)
+    : path_(file_path)
+{
+    file_ = detail::open_file<std::ofstream>(
+        path_, std::ios::out | std::ios::trunc);
+}
+
+auto GrmLociWriter::write(
+    std::span<const SnpMeta> snps,
+    std::span<const LocusPlan> plans) -> void
+{
+    if (snps.size() != plans.size())
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "{}: {} variants but {} encodings",
+                path_.string(),
+                snps.size(),
+                plans.size()));
+    }
+
+    file_ << kHeader << '\n';
+    for (size_t i = 0; i < snps.size(); ++i)
+    {
+        const auto& values = plans[i].values;
+        file_ << std::format(
+            "{}\t{}\t{}\t{:.17g}\t{:.17g}\t{:.17g}\t{:.17g}\n",
+            snps[i].id,
+            snps[i].A1,
+            snps[i].A2,
+            values[0],
+            values[1],
+            values[2],
+            values[3]);
+    }
+
+    if (!file_.good())
+    {
+        throw FileWriteException(
+            std::format(
+                "{}: failed to write variant encodings", path_.string()));
+    }
+}
+
+auto load_grm_loci(const std::filesystem::path& path) -> std::vector<GrmLocus>
+{
+    auto file = detail::open_file<std::ifstream>(path, std::ios::in);
+    std::string line;
+    if (!std::getline(file, line) || line != kHeader)
+    {
+        throw FileFormatException(
+            std::format("{}: not a GRM variant encoding file", path.string()));
+    }
+
+    std::vector<GrmLocus> loci;
+    std::vector<std::string_view> columns;
+    int n_line = 1;
+    while (std::getline(file, line))
+    {
+        ++n_line;
+        if (line.empty())
+        {
+            continue;
+        }
+        GrmLocus locus;
+        try
+        {
+            detail::parse_string(line, columns);
+            if (columns.size() != kColumns || columns[1].size() != 1
+                || columns[2].size() != 1)
+            {
+                throw DataParseException(
+                    "expected SNP, A1, A2 and four code values");
+            }
+            locus.id = std::string(columns[0]);
+            locus.A1 = columns[1][0];
+            locus.A2 = columns[2][0];
+            for (size_t code = 0; code < locus.values.size(); ++code)
+            {
+                locus.values[code] = detail::parse_number(columns[3 + code]);
+            }
+        }
+        catch (const GelexException& e)
+        {
+            throw FileFormatException(
+                std::format("{}:{}: {}", path.string(), n_line, e.what()));
+        }
+        loci.push_back(std::move(locus));
+    }
+    if (loci.empty())
+    {
+        throw FileFormatException(
+            std::format("{}: lists no variants", path.string()));
+    }
+    return loci;
+}
+
+}  // namespace gelex
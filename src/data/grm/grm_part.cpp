@@ -0,0 +1,225 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/grm_part.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <string>
+
+#include "gelex/exception.h"
+#include "gelex/io/parser.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+// lower-triangle entries in rows [0, rows)
+auto triangle_entries(int64_t rows) -> int64_t
+{
+    return rows * (rows + 1) / 2;
+}
+
+// smallest row count whose triangle holds at least `entries`
+auto rows_for_entries(int64_t entries, int64_t num_samples) -> int64_t
+{
+    auto rows = static_cast<int64_t>(std::ceil(
+        (std::sqrt((8.0 * static_cast<double>(entries)) + 1.0) - 1.0) / 2.0));
+    while (rows > 0 && triangle_entries(rows - 1) >= entries)
+    {
+        --rows;
+    }
+    while (triangle_entries(rows) < entries)
+    {
+        ++rows;
+    }
+    return std::min(rows, num_samples);
+}
+
+auto count_ids(const std::filesystem::path& path) -> int64_t
+{
+    auto file = detail::open_file<std::ifstream>(path, std::ios::in);
+    int64_t count = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+auto balanced_grm_part(Eigen::Index num_samples, int index, int num_parts)
+    -> GrmPart
+{
+    if (num_parts < 1 || index < 1 || index > num_parts)
+    {
+        throw ArgumentValidationException(
+            std::format("invalid GRM part {}/{}", index, num_parts));
+    }
+    if (num_parts > num_samples)
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "cannot split {} samples into {} GRM parts",
+                num_samples,
+                num_parts));
+    }
+
+    // boundary k leaves about k / num_parts of the entries above it; the
+    // first rows hold so few that boundaries are nudged apart to keep
+    // every part non-empty
+    const int64_t total = triangle_entries(num_samples);
+    int64_t begin = 0;
+    int64_t end = 0;
+    for (int part = 1; part <= index; ++part)
+    {
+        const int64_t entries = ((part * total) + num_parts - 1) / num_parts;
+        begin = end;
+        end = std::clamp(
+            rows_for_entries(entries, num_samples),
+            begin + 1,
+            num_samples - (num_parts - part));
+    }
+    return {begin, end};
+}
+
+auto parse_grm_part(std::string_view text) -> std::pair<int, int>
+{
+    const auto invalid = [&]
+    {
+        return ArgumentValidationException(
+            std::format("invalid GRM part '{}', expected e.g. 3/10", text));
+    };
+
+    const auto slash = text.find('/');
+    if (slash == std::string_view::npos)
+    {
+        throw invalid();
+    }
+    auto parse = [&](std::string_view field)
+    {
+        int value = 0;
+        const auto* last = field.data() + field.size();
+        auto [ptr, ec] = std::from_chars(field.data(), last, value);
+        if (ec != std::errc{} || ptr != last || field.empty())
+        {
+            throw invalid();
+        }
+        return value;
+    };
+    const int index = parse(text.substr(0, slash));
+    const int num_parts = parse(text.substr(slash + 1));
+    if (num_parts < 1 || index < 1 || index > num_parts)
+    {
+        throw invalid();
+    }
+    return {index, num_parts};
+}
+
+auto grm_part_prefix(std::string_view out_prefix, int index, int num_parts)
+    -> std::string
+{
+    return std::format("{}.part_{}_{}", out_prefix, num_parts, index);
+}
+
+auto merge_grm_parts(
+    const std::vector<std::filesystem::path>& part_prefixes,
+    const std::filesystem::path& out_prefix) -> void
+{
+    if (part_prefixes.empty())
+    {
+        throw ArgumentValidationException("no GRM parts to merge");
+    }
+
+    auto with_extension = [](std::filesystem::path prefix, const char* ext)
+    {
+        prefix += ext;
+        return prefix;
+    };
+
+    // rows of each part, checked against the bytes its rows must occupy
+    int64_t rows_before = 0;
+    for (const auto& prefix : part_prefixes)
+    {
+        const auto bin_path = with_extension(prefix, ".bin");
+        const int64_t rows = count_ids(with_extension(prefix, ".id"));
+        if (!std::filesystem::exists(bin_path))
+        {
+            throw FileNotFoundException(
+                std::format("{}: GRM part not found", bin_path.string()));
+        }
+        const int64_t expected
+            = (triangle_entries(rows_before + rows)
+               - triangle_entries(rows_before))
+              * static_cast<int64_t>(sizeof(float));
+        const auto actual
+            = static_cast<int64_t>(std::filesystem::file_size(bin_path));
+        if (actual != expected)
+        {
+            throw FileFormatException(
+                std::format(
+                    "{}: {} bytes, expected {} for rows [{}, {}); parts "
+                    "must be complete and listed in order",
+                    bin_path.string(),
+                    actual,
+                    expected,
+                    rows_before,
+                    rows_before + rows));
+        }
+        rows_before += rows;
+    }
+
+    std::vector<char> io_buffer(static_cast<size_t>(64 * 1024));
+    const auto out_bin = with_extension(out_prefix, ".bin");
+    auto bin = detail::open_file<std::ofstream>(
+        out_bin, std::ios::binary | std::ios::trunc, io_buffer);
+    auto ids = detail::open_file<std::ofstream>(
+        with_extension(out_prefix, ".id"), std::ios::out | std::ios::trunc);
+    for (const auto& prefix : part_prefixes)
+    {
+        auto part_bin = detail::open_file<std::ifstream>(
+            with_extension(prefix, ".bin"), std::ios::binary);
+        bin << part_bin.rdbuf();
+        auto part_ids = detail::open_file<std::ifstream>(
+            with_extension(prefix, ".id"), std::ios::in);
+        std::string line;
+        while (std::getline(part_ids, line))
+        {
+            if (!line.empty())
+            {
+                ids << line << '\n';
+            }
+        }
+    }
+    if (!bin.good() || !ids.good())
+    {
+        throw FileWriteException(
+            std::format("{}: failed to write merged GRM", out_bin.string()));
+    }
+}
+
+}  // namespace gelex
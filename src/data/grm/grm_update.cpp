@@ -0,0 +1,211 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/grm_update.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/grm/grm_loader.h"
+#include "gelex/data/grm/grm_loci.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/exception.h"
+#include "gelex/infra/logging/notify.h"
+
+namespace gelex
+{
+using Eigen::Index;
+
+GrmUpdater::GrmUpdater(
+    const std::filesystem::path& bed_path,
+    const std::filesystem::path& grm_prefix)
+    : sample_manager_(SampleManager::create_finalized(bed_path)),
+      bed_(bed_path, sample_manager_)
+{
+    const detail::GrmLoader grm(grm_prefix);
+    if (grm.is_sparse())
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: a sparse GRM cannot be updated", grm_prefix.string()));
+    }
+
+    // variants of the GRM, located in the .bim and read in file order
+    auto loci_path = grm_prefix;
+    loci_path += ".loci";
+    auto loci = load_grm_loci(loci_path);
+    const auto snps
+        = detail::BimLoader(variant_info_path(bed_path)).take_info();
+    std::unordered_map<std::string_view, Index> snp_index;
+    snp_index.reserve(snps.size());
+    for (Index j = 0; j < static_cast<Index>(snps.size()); ++j)
+    {
+        snp_index.emplace(snps[j].id, j);
+    }
+    std::vector<std::pair<Index, GenotypeCodeTable>> selected;
+    selected.reserve(loci.size());
+    for (auto& locus : loci)
+    {
+        const auto it = snp_index.find(locus.id);
+        if (it == snp_index.end())
+        {
+            throw InvalidInputException(
+                std::format(
+                    "{}: variant {} is not in the BED file",
+                    loci_path.string(),
+                    locus.id));
+        }
+        const auto& snp = snps[it->second];
+        if (snp.A1 == locus.A2 && snp.A2 == locus.A1)
+        {
+            std::swap(locus.values[0], locus.values[3]);
+        }
+        else if (snp.A1 != locus.A1 || snp.A2 != locus.A2)
+        {
+            throw InvalidInputException(
+                std::format(
+                    "{}: alleles of {} differ from the BED file's",
+                    loci_path.string(),
+                    locus.id));
+        }
+        selected.emplace_back(it->second, locus.values);
+    }
+    std::ranges::sort(
+        selected, {}, &std::pair<Index, GenotypeCodeTable>::first);
+    std::vector<Index> indices;
+    indices.reserve(selected.size());
+    tables_.reserve(selected.size());
+    for (const auto& [index, table] : selected)
+    {
+        if (!indices.empty() && indices.back() == index)
+        {
+            throw InvalidInputException(
+                std::format(
+                    "{}: variant {} is listed twice",
+                    loci_path.string(),
+                    snps[index].id));
+        }
+        indices.push_back(index);
+        tables_.push_back(table);
+    }
+    bed_.select_variants(indices);
+
+    // the GRM's samples keep their order; the rest of the BED follows
+    const auto& bed_ids = sample_manager_->common_ids();
+    const auto& bed_rows = sample_manager_->common_id_map();
+    const auto& old_ids = grm.sample_ids();
+    num_old_ = static_cast<Index>(old_ids.size());
+    rows_.reserve(bed_ids.size());
+    for (const auto& id : old_ids)
+    {
+        const auto it = bed_rows.find(id);
+        if (it == bed_rows.end())
+        {
+            throw InvalidInputException(
+                std::format(
+                    "{}: sample {} of the GRM is not in the BED file",
+                    grm_prefix.string(),
+                    id));
+        }
+        rows_.push_back(it->second);
+    }
+    const std::unordered_set<std::string_view> known(
+        old_ids.begin(), old_ids.end());
+    for (Index i = 0; i < static_cast<Index>(bed_ids.size()); ++i)
+    {
+        if (!known.contains(bed_ids[i]))
+        {
+            rows_.push_back(i);
+            new_ids_.push_back(bed_ids[i]);
+        }
+    }
+    if (new_ids_.empty())
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: the BED file has no samples the GRM lacks",
+                grm_prefix.string()));
+    }
+}
+
+auto GrmUpdater::encode(
+    const ChunkPrefetcher::Chunk& chunk,
+    Eigen::MatrixXd& encoded) const -> void
+{
+    const Index num_cols = chunk.end - chunk.start;
+    const auto n = static_cast<Index>(rows_.size());
+    encoded.resize(n, num_cols);
+#pragma omp parallel for schedule(static)
+    for (Index j = 0; j < num_cols; ++j)
+    {
+        const auto& values = tables_[static_cast<size_t>(chunk.start + j)];
+        const Index byte = j / 4;
+        const int shift = static_cast<int>(2 * (j % 4));
+        for (Index r = 0; r < n; ++r)
+        {
+            const auto code
+                = (chunk.codes(rows_[static_cast<size_t>(r)], byte) >> shift)
+                  & 0b11;
+            encoded(r, j) = values[code];
+        }
+    }
+}
+
+auto GrmUpdater::compute(Index chunk_size, const GrmObserver& observer)
+    -> Eigen::MatrixXd
+{
+    const auto n = static_cast<Index>(rows_.size());
+    const Index total_snps = bed_.num_snps();
+    Eigen::MatrixXd rows = Eigen::MatrixXd::Zero(num_new(), n);
+
+    const std::vector<std::pair<Index, Index>> ranges{{0, total_snps}};
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, chunk_size),
+        [this](ChunkPrefetcher::Chunk& chunk)
+        {
+            const Index num_cols = chunk.end - chunk.start;
+            std::vector<GenotypeCodeCounts> counts(
+                static_cast<size_t>(num_cols));
+            chunk.codes.resize(bed_.num_samples(), (num_cols + 3) / 4);
+            bed_.load_codes(chunk.codes, chunk.start, chunk.end, counts);
+        });
+
+    Eigen::MatrixXd encoded;
+    Index processed_snps = 0;
+    while (auto* chunk = prefetcher.next())
+    {
+        encode(*chunk, encoded);
+        rows.noalias() += encoded.bottomRows(num_new()) * encoded.transpose();
+
+        processed_snps += chunk->end - chunk->start;
+        notify(
+            observer,
+            GrmProgressEvent{
+                static_cast<size_t>(processed_snps),
+                static_cast<size_t>(total_snps),
+                false});
+    }
+    return rows;
+}
+
+}  // namespace gelex
@@ -24,17 +24,39 @@
 namespace gelex
 {
 
+namespace
+{
+
+auto open_chr_loader(const std::filesystem::path& chr_grm_prefix)
+    -> detail::GrmLoader
+{
+    std::filesystem::path bin_path = chr_grm_prefix.string() + ".bin";
+    if (!std::filesystem::exists(bin_path))
+    {
+        throw InvalidInputException(
+            std::format(
+                "LOCO error: GRM file not found: {}", bin_path.string()));
+    }
+    return detail::GrmLoader(chr_grm_prefix);
+}
+
+}  // namespace
+
 LocoGRMLoader::LocoGRMLoader(
     const std::filesystem::path& whole_grm_prefix,
     const std::unordered_map<std::string, Eigen::Index>& id_map)
+    : whole_(whole_grm_prefix),
+      permutation_(whole_.permutation(id_map)),
+      trace_whole_(whole_.trace(permutation_)),
+      id_map_(id_map)
 {
-    detail::GrmLoader whole_loader(whole_grm_prefix);
-    // Load and filter the whole GRM once during construction.
-    // load_unnormalized(id_map) returns (X_w * X_w') filtered and reordered.
-    g_whole_ = whole_loader.load_unnormalized(id_map);
-    // Compute trace after loading and save for LOCO calculation
-    trace_whole_ = g_whole_.trace();
-    k_whole_ = trace_whole_ / static_cast<double>(g_whole_.rows());
+    if (whole_.is_sparse())
+    {
+        throw InvalidInputException(
+            std::format(
+                "LOCO error: whole-genome GRM must be dense: {}",
+                whole_grm_prefix.string()));
+    }
 }
 
 LocoGRMLoader::~LocoGRMLoader() = default;
@@ -44,24 +66,38 @@ auto LocoGRMLoader::load_loco_grm(
     const std::unordered_map<std::string, Eigen::Index>& id_map,
     Eigen::MatrixXd& target) const -> void
 {
-    std::filesystem::path bin_path = chr_grm_prefix.string() + ".bin";
-    if (!std::filesystem::exists(bin_path))
-    {
-        throw InvalidInputException(
-            std::format(
-                "LOCO error: GRM file not found: {}", bin_path.string()));
-    }
+    auto chr_loader = open_chr_loader(chr_grm_prefix);
 
-    detail::GrmLoader chr_loader(chr_grm_prefix);
+    // Map the chromosome GRM with the SAME id_map to ensure alignment.
+    assemble(chr_loader, chr_loader.permutation(id_map), target);
+}
 
-    // Load chromosome GRM filtered by the SAME id_map to ensure alignment.
-    // Use the mutable buffer to avoid reallocations.
-    chr_loader.load_unnormalized(id_map, g_chr_buffer_);
+auto LocoGRMLoader::load_loco_grm(
+    const std::filesystem::path& chr_grm_prefix,
+    Eigen::MatrixXd& target) const -> void
+{
+    auto chr_loader = open_chr_loader(chr_grm_prefix);
+    if (chr_loader.sample_ids() == whole_.sample_ids())
+    {
+        assemble(chr_loader, permutation_, target);
+    }
+    else
+    {
+        assemble(chr_loader, chr_loader.permutation(id_map_), target);
+    }
+}
 
-    // Compute k_i from the loaded chromosome GRM trace
-    double trace_i = g_chr_buffer_.trace();
-    double k_i = trace_i / static_cast<double>(g_chr_buffer_.rows());
-    double k_loco = k_whole_ - k_i;
+auto LocoGRMLoader::assemble(
+    const detail::GrmLoader& chr_loader,
+    const detail::GrmPermutation& chr_permutation,
+    Eigen::MatrixXd& target) const -> void
+{
+    // Both traces come from the diagonals of the unnormalized (X*X') files,
+    // so the denominator is known before any n x n work.
+    const auto n = static_cast<double>(num_samples());
+    const double k_whole = trace_whole_ / n;
+    const double k_i = chr_loader.trace(chr_permutation) / n;
+    const double k_loco = k_whole - k_i;
     if (k_loco <= 0)
     {
         throw InvalidInputException(
@@ -69,11 +105,11 @@ auto LocoGRMLoader::load_loco_grm(
                 "LOCO error: Chromosome GRM denominator ({}) is greater than "
                 "or equal to Whole GRM denominator ({})",
                 k_i,
-                k_whole_));
+                k_whole));
     }
 
-    // Both g_whole_ and g_chr_buffer_ are now unnormalized (X*X') and filtered.
-    target = (g_whole_ - g_chr_buffer_) / k_loco;
+    whole_.load_unnormalized(permutation_, target);
+    chr_loader.subtract_scaled(chr_permutation, 1.0 / k_loco, target);
 }
 
 auto LocoGRMLoader::load_loco_grm(
@@ -88,7 +124,7 @@ auto LocoGRMLoader::load_loco_grm(
 
 auto LocoGRMLoader::num_samples() const noexcept -> Eigen::Index
 {
-    return g_whole_.rows();
+    return permutation_.target_size;
 }
 
 }  // namespace gelex
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/data/grm/sparse_grm_writer.h"
+
+#include <format>
+#include <limits>
+
+#include "gelex/exception.h"
+#include "gelex/io/parser.h"
+
+namespace gelex
+{
+
+SparseGrmWriter::SparseGrmWriter(const std::filesystem::path& file_path)
+    : path_(file_path), io_buffer_(kDefaultBufferSize)
+{
+    file_ = detail::open_file<std::ofstream>(
+        path_, std::ios::binary | std::ios::trunc, io_buffer_);
+}
+
+auto SparseGrmWriter::write(
+    const Eigen::Ref<const Eigen::MatrixXd>& grm,
+    double cutoff) -> size_t
+{
+    const Eigen::Index n = grm.rows();
+    if (grm.rows() != grm.cols())
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: GRM must be square, got {}x{}",
+                path_.string(),
+                n,
+                grm.cols()));
+    }
+    if (n == 0)
+    {
+        return 0;
+    }
+    if (n > std::numeric_limits<uint32_t>::max())
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: {} samples exceed the sparse GRM format",
+                path_.string(),
+                n));
+    }
+    const double denominator = grm.trace() / static_cast<double>(n);
+    if (!(denominator > 0.0))
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: GRM trace must be positive to apply a sparse cutoff",
+                path_.string()));
+    }
+
+    // columns are scanned in parallel down their contiguous lower part
+    const double threshold = cutoff * denominator;
+    std::vector<std::vector<SparseGrmEntry>> columns(static_cast<size_t>(n));
+#pragma omp parallel for schedule(dynamic, 64)
+    for (Eigen::Index j = 0; j < n; ++j)
+    {
+        auto& column = columns[static_cast<size_t>(j)];
+        const auto col = static_cast<uint32_t>(j);
+        column.push_back({col, col, static_cast<float>(grm(j, j))});
+        for (Eigen::Index i = j + 1; i < n; ++i)
+        {
+            if (grm(i, j) > threshold)
+            {
+                column.push_back(
+                    {static_cast<uint32_t>(i),
+                     col,
+                     static_cast<float>(grm(i, j))});
+            }
+        }
+    }
+
+    size_t num_pairs = 0;
+    for (const auto& column : columns)
+    {
+        file_.write(
+            reinterpret_cast<const char*>(column.data()),
+            static_cast<std::streamsize>(
+                column.size() * sizeof(SparseGrmEntry)));
+        num_pairs += column.size() - 1;
+    }
+
+    if (!file_.good())
+    {
+        throw FileWriteException(
+            std::format(
+                "{}: failed to write sparse GRM data", path_.string()));
+    }
+    return num_pairs;
+}
+
+}  // namespace gelex
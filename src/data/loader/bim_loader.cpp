@@ -18,8 +18,11 @@
 
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+#include <array>
 #include <ranges>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/ranges.h>
@@ -34,10 +37,69 @@
 namespace gelex::detail
 {
 
+namespace
+{
+
+// Column positions of the fields BimLoader reads; defaults are the .bim
+// layout, a .pvar header overrides them.
+struct VariantColumns
+{
+    static constexpr size_t kMaxColumns = 9;
+
+    size_t chrom = 0;
+    size_t id = 1;
+    size_t pos = 3;
+    size_t a1 = 4;
+    size_t a2 = 5;
+    size_t count = 6;
+};
+
+// "#CHROM POS ID REF ALT ..." header of a .pvar. ALT becomes A1, the
+// counted allele, matching the .bim PLINK 2 exports.
+auto parse_pvar_header(std::string_view line) -> VariantColumns
+{
+    std::array<std::string_view, 5> names{"#CHROM", "ID", "POS", "ALT", "REF"};
+    std::array<size_t, 5> positions{};
+    positions.fill(VariantColumns::kMaxColumns);
+
+    size_t index = 0;
+    for (auto&& rng : line | std::views::split('\t'))
+    {
+        auto it = std::ranges::find(names, std::string_view(rng));
+        if (it != names.end())
+        {
+            positions[static_cast<size_t>(it - names.begin())] = index;
+        }
+        ++index;
+    }
+
+    for (auto&& [name, position] : std::views::zip(names, positions))
+    {
+        if (position >= VariantColumns::kMaxColumns)
+        {
+            throw FileFormatException(
+                std::format("1: .pvar header lacks the {} column", name));
+        }
+    }
+    VariantColumns columns{
+        .chrom = positions[0],
+        .id = positions[1],
+        .pos = positions[2],
+        .a1 = positions[3],
+        .a2 = positions[4]};
+    columns.count = std::ranges::max(positions) + 1;
+    return columns;
+}
+
+}  // namespace
+
 BimLoader::BimLoader(const std::filesystem::path& path)
 {
     auto file = detail::open_file<std::ifstream>(path, std::ios::in);
-    char delimiter = detect_file_delimiter(file);
+    // .pvar files are tab-delimited and may open with "##" lines
+    char delimiter = path.extension() == ".pvar"
+                         ? '\t'
+                         : detect_file_delimiter(file);
     try
     {
         set_snp_info(delimiter, file);
@@ -54,34 +116,48 @@ void BimLoader::set_snp_info(char delimiter, std::ifstream& file)
     snp_effects_.clear();
     std::string line;
     int n_line = 0;
-    std::array<std::string_view, 6> cols;
+    // a .pvar without a #CHROM header keeps the .bim column order
+    VariantColumns columns;
+    std::array<std::string_view, VariantColumns::kMaxColumns> cols;
 
     while (std::getline(file, line))
     {
         n_line++;
+        if (line.starts_with('#'))
+        {
+            if (line.starts_with("#CHROM"))
+            {
+                columns = parse_pvar_header(line);
+            }
+            continue;
+        }
         auto tokens = line | std::views::split(delimiter)
                       | std::views::transform([](auto&& rng)
                                               { return std::string_view(rng); })
                       | std::views::filter([](std::string_view sv)
                                            { return !sv.empty(); })
-                      | std::views::take(6);
+                      | std::views::take(columns.count);
 
         auto [in, out] = std::ranges::copy(tokens, cols.begin());
 
-        if (out != cols.end())
+        const auto count = std::distance(cols.begin(), out);
+        if (std::cmp_not_equal(count, columns.count))
         {
-            const auto count = std::distance(cols.begin(), out);
             throw InconsistentColumnCountException(
-                std::format("{}: has {} columns, expected 6", n_line, count));
+                std::format(
+                    "{}: has {} columns, expected {}",
+                    n_line,
+                    count,
+                    columns.count));
         }
         try
         {
             snp_effects_.emplace_meta(
-                {.chrom = std::string(cols[0]),
-                 .id = std::string(cols[1]),
-                 .pos = detail::parse_number<int>(cols[3]),
-                 .A1 = cols[4][0],
-                 .A2 = cols[5][0]});
+                {.chrom = std::string(cols[columns.chrom]),
+                 .id = std::string(cols[columns.id]),
+                 .pos = detail::parse_number<int>(cols[columns.pos]),
+                 .A1 = cols[columns.a1][0],
+                 .A2 = cols[columns.a2][0]});
         }
         catch (const gelex::GelexException& err)
         {
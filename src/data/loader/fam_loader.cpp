@@ -19,6 +19,8 @@
 #include <filesystem>
 #include <fstream>
 #include <ranges>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <Eigen/Core>
@@ -26,10 +28,28 @@
 #include <fmt/ranges.h>
 #include "gelex/exception.h"
 #include "gelex/io/parser.h"
+#include "gelex/types/sample_id.h"
 
 namespace gelex::detail
 {
 
+namespace
+{
+
+// .psam files without a FID column get FID 0, as PLINK 2 writes them when
+// exporting a .fam
+auto parse_iid(std::string_view line, char delimiter) -> std::string
+{
+    auto parts = line | std::views::split(delimiter);
+    if (parts.begin() == parts.end())
+    {
+        throw FileFormatException("failed to parse IID (empty line)");
+    }
+    return make_sample_id("0", std::string_view(*parts.begin()));
+}
+
+}  // namespace
+
 FamLoader::FamLoader(const std::filesystem::path& path)
 {
     try
@@ -53,6 +73,7 @@ void FamLoader::set_ids(const std::filesystem::path& path)
     ids_.reserve(1024);  // Start small
     std::string line;
     int n_line = 0;
+    bool has_fid = true;
 
     while (std::getline(file, line))
     {
@@ -61,9 +82,22 @@ void FamLoader::set_ids(const std::filesystem::path& path)
         {
             continue;
         }
+        // .psam header line: "#FID IID ..." or "#IID ..."
+        if (n_line == 1 && line.starts_with('#'))
+        {
+            has_fid = line.starts_with("#FID");
+            if (!has_fid && !line.starts_with("#IID"))
+            {
+                throw FileFormatException(
+                    "1: .psam header must start with #FID or #IID");
+            }
+            continue;
+        }
         try
         {
-            ids_.emplace_back(parse_id(line, delimiter));
+            ids_.emplace_back(
+                has_fid ? parse_id(line, delimiter)
+                        : parse_iid(line, delimiter));
         }
         catch (const GelexException& e)
         {
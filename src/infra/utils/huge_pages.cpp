@@ -0,0 +1,185 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/infra/utils/huge_pages.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "gelex/infra/utils/numa.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+constexpr std::align_val_t kFallbackAlignment{64};
+
+auto round_up(size_t value, size_t multiple) -> size_t
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+auto advise_huge_pages(const void* data, size_t bytes) -> HugePageMode
+{
+#ifdef __linux__
+    const auto begin = reinterpret_cast<std::uintptr_t>(data);
+    const auto first = round_up(begin, kHugePageSize);
+    const auto last = (begin + bytes) / kHugePageSize * kHugePageSize;
+    if (data == nullptr || last <= first)
+    {
+        return HugePageMode::None;
+    }
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    auto* region = reinterpret_cast<void*>(first);
+    return madvise(region, last - first, MADV_HUGEPAGE) == 0
+               ? HugePageMode::Transparent
+               : HugePageMode::None;
+#else
+    static_cast<void>(data);
+    static_cast<void>(bytes);
+    return HugePageMode::None;
+#endif
+}
+
+HugePageBuffer::HugePageBuffer(size_t bytes) : bytes_(bytes)
+{
+    if (bytes == 0)
+    {
+        return;
+    }
+
+#ifdef __linux__
+    if (bytes >= kHugePageSize)
+    {
+        const size_t length = round_up(bytes, kHugePageSize);
+
+        // Without MAP_NORESERVE the pool reservation is checked here, so an
+        // empty or exhausted pool fails now instead of faulting later.
+        void* ptr = mmap(
+            nullptr,
+            length,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0);
+        if (ptr != MAP_FAILED)
+        {
+            data_ = ptr;
+            mapped_ = length;
+            mode_ = HugePageMode::HugeTlb;
+            return;
+        }
+
+        // over-map by one huge page and trim both ends to align the start
+        const size_t padded = length + kHugePageSize;
+        ptr = mmap(
+            nullptr,
+            padded,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        auto* raw = static_cast<char*>(ptr);
+        const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+        const size_t head = round_up(addr, kHugePageSize) - addr;
+        if (head > 0)
+        {
+            munmap(raw, head);
+        }
+        if (padded - head - length > 0)
+        {
+            munmap(raw + head + length, padded - head - length);
+        }
+        data_ = raw + head;
+        mapped_ = length;
+        mode_ = advise_huge_pages(data_, length);
+        return;
+    }
+#endif
+
+    data_ = ::operator new(bytes, kFallbackAlignment);
+    std::fill_n(static_cast<char*>(data_), bytes, char{0});
+}
+
+HugePageBuffer::HugePageBuffer(HugePageBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)),
+      mapped_(std::exchange(other.mapped_, 0)),
+      mode_(std::exchange(other.mode_, HugePageMode::None))
+{
+}
+
+HugePageBuffer& HugePageBuffer::operator=(HugePageBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        bytes_ = std::exchange(other.bytes_, 0);
+        mapped_ = std::exchange(other.mapped_, 0);
+        mode_ = std::exchange(other.mode_, HugePageMode::None);
+    }
+    return *this;
+}
+
+HugePageBuffer::~HugePageBuffer()
+{
+    release();
+}
+
+auto HugePageBuffer::release() noexcept -> void
+{
+    if (data_ == nullptr)
+    {
+        return;
+    }
+#ifdef __linux__
+    if (mapped_ > 0)
+    {
+        munmap(data_, mapped_);
+        data_ = nullptr;
+        return;
+    }
+#endif
+    ::operator delete(data_, kFallbackAlignment);
+    data_ = nullptr;
+}
+
+HugePageMatrix::HugePageMatrix(Eigen::Index rows, Eigen::Index cols)
+    : buffer_(
+          static_cast<size_t>(rows) * static_cast<size_t>(cols)
+          * sizeof(double)),
+      rows_(rows),
+      cols_(cols)
+{
+    numa_first_touch(static_cast<double*>(buffer_.data()), rows_, cols_);
+}
+
+}  // namespace gelex
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/infra/utils/numa.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "gelex/exception.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+std::atomic<NumaPolicy> g_policy{NumaPolicy::None};
+
+// "0-1,4" -> {0, 1, 4}
+auto parse_node_list(std::string_view text) -> std::vector<int>
+{
+    std::vector<int> nodes;
+    while (!text.empty())
+    {
+        const auto comma = text.find(',');
+        auto item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{}
+                                               : text.substr(comma + 1);
+        if (item.empty())
+        {
+            continue;
+        }
+        const auto dash = item.find('-');
+        const int first = std::stoi(std::string(item.substr(0, dash)));
+        const int last = dash == std::string_view::npos
+                             ? first
+                             : std::stoi(std::string(item.substr(dash + 1)));
+        for (int node = first; node <= last; ++node)
+        {
+            nodes.push_back(node);
+        }
+    }
+    return nodes;
+}
+
+auto detect_nodes() -> std::vector<int>
+{
+    std::vector<int> nodes;
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string line;
+    if (online && std::getline(online, line))
+    {
+        try
+        {
+            nodes = parse_node_list(line);
+        }
+        catch (const std::exception&)
+        {
+            nodes.clear();
+        }
+    }
+    if (nodes.empty())
+    {
+        nodes.push_back(0);
+    }
+    return nodes;
+}
+
+#ifdef __linux__
+// The mask holds one unsigned long, so nodes beyond 63 are left alone.
+constexpr int kMaxNode = 64;
+
+auto page_size() -> std::uintptr_t
+{
+    static const auto size
+        = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// Applies `mode` over the whole pages inside [begin, end); best effort.
+auto bind_range(
+    std::uintptr_t begin,
+    std::uintptr_t end,
+    int mode,
+    unsigned long mask) -> void
+{
+    const auto page = page_size();
+    begin = (begin + page - 1) / page * page;
+    end = end / page * page;
+    if (end <= begin || mask == 0)
+    {
+        return;
+    }
+    // failures (e.g. seccomp, no NUMA support) just keep the default policy
+    static_cast<void>(syscall(
+        SYS_mbind,
+        begin,
+        end - begin,
+        mode,
+        &mask,
+        static_cast<unsigned long>(kMaxNode + 1),
+        0U));
+}
+
+auto node_mask(int node) -> unsigned long
+{
+    return node < kMaxNode ? 1UL << node : 0UL;
+}
+
+auto place(double* data, Eigen::Index rows, Eigen::Index cols) -> void
+{
+    const auto& nodes = numa_nodes();
+    const auto policy = numa_policy();
+    if (nodes.size() < 2 || policy == NumaPolicy::None)
+    {
+        return;
+    }
+
+    const auto begin = reinterpret_cast<std::uintptr_t>(data);
+    const auto column_bytes
+        = static_cast<std::uintptr_t>(rows) * sizeof(double);
+    if (policy == NumaPolicy::Interleave)
+    {
+        unsigned long mask = 0;
+        for (const int node : nodes)
+        {
+            mask |= node_mask(node);
+        }
+        bind_range(
+            begin,
+            begin + (column_bytes * static_cast<std::uintptr_t>(cols)),
+            MPOL_INTERLEAVE,
+            mask);
+        return;
+    }
+
+    const auto n_nodes = static_cast<Eigen::Index>(nodes.size());
+    for (Eigen::Index k = 0; k < n_nodes; ++k)
+    {
+        const Eigen::Index first = cols * k / n_nodes;
+        const Eigen::Index last = cols * (k + 1) / n_nodes;
+        bind_range(
+            begin + (column_bytes * static_cast<std::uintptr_t>(first)),
+            begin + (column_bytes * static_cast<std::uintptr_t>(last)),
+            MPOL_PREFERRED,
+            node_mask(nodes[static_cast<size_t>(k)]));
+    }
+}
+#endif
+
+}  // namespace
+
+auto parse_numa_policy(std::string_view text) -> NumaPolicy
+{
+    std::string lower(text);
+    std::ranges::transform(
+        lower,
+        lower.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "none")
+    {
+        return NumaPolicy::None;
+    }
+    if (lower == "interleave")
+    {
+        return NumaPolicy::Interleave;
+    }
+    if (lower == "partition")
+    {
+        return NumaPolicy::Partition;
+    }
+    throw ArgumentValidationException(
+        std::format(
+            "invalid NUMA policy '{}', expected none, interleave or "
+            "partition",
+            text));
+}
+
+auto set_numa_policy(NumaPolicy policy) -> void
+{
+    g_policy.store(policy, std::memory_order_relaxed);
+}
+
+auto numa_policy() -> NumaPolicy
+{
+    return g_policy.load(std::memory_order_relaxed);
+}
+
+auto numa_nodes() -> const std::vector<int>&
+{
+    static const std::vector<int> nodes = detect_nodes();
+    return nodes;
+}
+
+auto numa_first_touch(double* data, Eigen::Index rows, Eigen::Index cols)
+    -> void
+{
+    if (data == nullptr || rows <= 0 || cols <= 0)
+    {
+        return;
+    }
+#ifdef __linux__
+    place(data, rows, cols);
+#endif
+
+    const auto column_bytes = static_cast<size_t>(rows) * sizeof(double);
+#pragma omp parallel for schedule(static) default(none) \
+    shared(data, rows, cols, column_bytes)
+    for (Eigen::Index j = 0; j < cols; ++j)
+    {
+        std::memset(data + (j * rows), 0, column_bytes);
+    }
+}
+
+}  // namespace gelex
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/infra/utils/quantile_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+#include "gelex/exception.h"
+
+namespace gelex
+{
+
+using Eigen::Index;
+
+QuantileSketch::QuantileSketch(Index n_params, double prob)
+    : prob_(prob),
+      increments_{0.0, prob / 2.0, prob, (1.0 + prob) / 2.0, 1.0},
+      heights_(Markers::Zero(kMarkers, n_params)),
+      positions_(Markers::Zero(kMarkers, n_params))
+{
+    if (!(prob > 0.0 && prob < 1.0))
+    {
+        throw ArgumentValidationException(
+            std::format("quantile prob must be in (0, 1), got {}", prob));
+    }
+}
+
+auto QuantileSketch::update(const Eigen::Ref<const Eigen::VectorXd>& draw)
+    -> void
+{
+    if (draw.size() != size())
+    {
+        throw InvalidInputException(
+            "Size mismatch in QuantileSketch::update");
+    }
+
+    ++count_;
+    if (count_ <= kMarkers)
+    {
+        // warm-up: markers hold the raw draws until five are seen
+        heights_.row(static_cast<Index>(count_ - 1)) = draw.transpose();
+        if (count_ == kMarkers)
+        {
+            for (Index j = 0; j < size(); ++j)
+            {
+                auto col = heights_.col(j);
+                std::sort(col.data(), col.data() + kMarkers);
+                positions_.col(j) << 1.0, 2.0, 3.0, 4.0, 5.0;
+            }
+        }
+        return;
+    }
+
+    // desired marker positions depend only on the number of draws
+    std::array<double, kMarkers> desired{};
+    for (int i = 0; i < kMarkers; ++i)
+    {
+        desired[i]
+            = 1.0 + (static_cast<double>(count_) - 1.0) * increments_[i];
+    }
+
+    for (Index j = 0; j < size(); ++j)
+    {
+        auto q = heights_.col(j);
+        auto n = positions_.col(j);
+        const double x = draw(j);
+
+        int cell = 0;
+        if (x < q(0))
+        {
+            q(0) = x;
+        }
+        else if (x >= q(kMarkers - 1))
+        {
+            q(kMarkers - 1) = x;
+            cell = kMarkers - 2;
+        }
+        else
+        {
+            while (x >= q(cell + 1))
+            {
+                ++cell;
+            }
+        }
+
+        for (int i = cell + 1; i < kMarkers; ++i)
+        {
+            n(i) += 1.0;
+        }
+        adjust(j, desired);
+    }
+}
+
+auto QuantileSketch::adjust(
+    Index param,
+    const std::array<double, kMarkers>& desired) -> void
+{
+    auto q = heights_.col(param);
+    auto n = positions_.col(param);
+
+    for (int i = 1; i < kMarkers - 1; ++i)
+    {
+        const double d = desired[i] - n(i);
+        if ((d >= 1.0 && n(i + 1) - n(i) > 1.0)
+            || (d <= -1.0 && n(i - 1) - n(i) < -1.0))
+        {
+            const int s = d >= 0.0 ? 1 : -1;
+            const double sd = s;
+
+            // piecewise-parabolic prediction, falling back to linear when it
+            // would break the ordering of the markers
+            const double parabolic
+                = q(i)
+                  + sd / (n(i + 1) - n(i - 1))
+                        * ((n(i) - n(i - 1) + sd) * (q(i + 1) - q(i))
+                               / (n(i + 1) - n(i))
+                           + (n(i + 1) - n(i) - sd) * (q(i) - q(i - 1))
+                                 / (n(i) - n(i - 1)));
+
+            if (q(i - 1) < parabolic && parabolic < q(i + 1))
+            {
+                q(i) = parabolic;
+            }
+            else
+            {
+                q(i) += sd * (q(i + s) - q(i)) / (n(i + s) - n(i));
+            }
+            n(i) += sd;
+        }
+    }
+}
+
+auto QuantileSketch::result() const -> Eigen::VectorXd
+{
+    if (count_ >= kMarkers)
+    {
+        return heights_.row(2).transpose();
+    }
+
+    Eigen::VectorXd output = Eigen::VectorXd::Zero(size());
+    if (count_ == 0)
+    {
+        return output;
+    }
+
+    // exact interpolated quantile over the buffered draws
+    const auto n_draws = static_cast<Index>(count_);
+    const double h = prob_ * static_cast<double>(n_draws - 1);
+    const auto lo = static_cast<Index>(std::floor(h));
+    const Index hi = std::min(lo + 1, n_draws - 1);
+    const double frac = h - static_cast<double>(lo);
+
+    std::array<double, kMarkers> buffer{};
+    for (Index j = 0; j < size(); ++j)
+    {
+        for (Index i = 0; i < n_draws; ++i)
+        {
+            buffer[static_cast<size_t>(i)] = heights_(i, j);
+        }
+        std::sort(buffer.begin(), buffer.begin() + n_draws);
+        output(j) = buffer[static_cast<size_t>(lo)]
+                    + frac
+                          * (buffer[static_cast<size_t>(hi)]
+                             - buffer[static_cast<size_t>(lo)]);
+    }
+    return output;
+}
+
+}  // namespace gelex
@@ -16,6 +16,8 @@
 
 #include "gelex/model/bayes/model.h"
 
+#include <algorithm>
+#include <format>
 #include <optional>
 #include <string>
 
@@ -24,6 +26,8 @@
 #include <Eigen/Core>
 
 #include "gelex/data/genotype/genotype_mmap.h"
+#include "gelex/data/genotype/genotype_view.h"
+#include "gelex/exception.h"
 #include "gelex/infra/utils/math_utils.h"
 #include "gelex/model/bayes/effects.h"
 #include "gelex/pipeline/geno_pipe.h"
@@ -36,6 +40,36 @@ using Eigen::Index;
 using Eigen::MatrixXd;
 using Eigen::VectorXd;
 
+namespace
+{
+
+template <typename Effect>
+auto make_fold_effect(const Effect& full, std::span<const Index> held_out)
+    -> Effect
+{
+    auto view = std::visit(
+        [](const auto& storage) { return GenotypeView(storage); }, full.X);
+
+    // Subtract the held-out rows instead of recomputing the norms over a
+    // row-masked copy of the genotypes.
+    const auto& X = view.matrix();
+    VectorXd cols_norm = full.cols_norm;
+#pragma omp parallel for default(none) shared(X, cols_norm, held_out)
+    for (Index j = 0; j < X.cols(); ++j)
+    {
+        double removed = 0.0;
+        for (const Index row : held_out)
+        {
+            removed += X(row, j) * X(row, j);
+        }
+        cols_norm(j) = std::max(cols_norm(j) - removed, 0.0);
+    }
+
+    return Effect(std::move(view), std::move(cols_norm));
+}
+
+}  // namespace
+
 BayesModel::BayesModel(PhenoPipe& pheno_pipe, GenoPipe& geno_pipe)
     : phenotype_(std::move(pheno_pipe).take_phenotype())
 {
@@ -57,6 +91,69 @@ BayesModel::BayesModel(PhenoPipe& pheno_pipe, GenoPipe& geno_pipe)
     }
 }
 
+BayesModel::BayesModel(const BayesModel& full, std::span<const Index> held_out)
+    : phenotype_(full.phenotype_),
+      held_out_(held_out.begin(), held_out.end()),
+      fixed_(full.fixed_),
+      random_(full.random_),
+      residual_(full.residual_)
+{
+    std::ranges::sort(held_out_);
+    const auto [first, last] = std::ranges::unique(held_out_);
+    held_out_.erase(first, last);
+
+    const Index n = full.num_individuals_;
+    if (!held_out_.empty() && (held_out_.front() < 0 || held_out_.back() >= n))
+    {
+        throw InvalidInputException(
+            std::format("held-out row index out of range [0, {})", n));
+    }
+    num_individuals_ = n - static_cast<Index>(held_out_.size());
+    if (num_individuals_ < 2)
+    {
+        throw InvalidInputException(
+            "cross-validation fold leaves fewer than 2 training samples");
+    }
+
+    // Zeroed rows drop out of every X'y and column norm of the small design
+    // matrices, so only the genetic effects need explicit masking.
+    for (const Index row : held_out_)
+    {
+        phenotype_(row) = 0.0;
+        fixed_.X.row(row).setZero();
+        for (auto& effect : random_)
+        {
+            effect.X.row(row).setZero();
+        }
+    }
+    fixed_.cols_norm = fixed_.X.colwise().squaredNorm();
+    for (auto& effect : random_)
+    {
+        effect.cols_norm = effect.X.colwise().squaredNorm();
+    }
+
+    const double mean
+        = phenotype_.sum() / static_cast<double>(num_individuals_);
+    double ss = 0.0;
+    for (Index i = 0; i < n; ++i)
+    {
+        if (!std::ranges::binary_search(held_out_, i))
+        {
+            ss += (phenotype_(i) - mean) * (phenotype_(i) - mean);
+        }
+    }
+    phenotype_var_ = ss / static_cast<double>(num_individuals_ - 1);
+
+    if (full.additive_)
+    {
+        additive_.emplace(make_fold_effect(*full.additive_, held_out_));
+    }
+    if (full.dominant_)
+    {
+        dominant_.emplace(make_fold_effect(*full.dominant_, held_out_));
+    }
+}
+
 void BayesModel::add_fixed_effect(FixedEffect&& effect)
 {
     fixed_ = std::move(effect);
@@ -116,6 +213,7 @@ BayesState::BayesState(const BayesModel& model)
     }
     residual_.y_adj = model.phenotype().array();
     residual_.variance = model.residual().init_variance;
+    residual_.held_out = model.held_out();
 }
 
 void BayesState::compute_heritability()
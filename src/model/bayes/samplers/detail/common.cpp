@@ -150,7 +150,12 @@ auto Residual::operator()(
 {
     auto& residual = states.residual();
     detail::ScaledInvChiSq chi_squared{model.residual().prior};
-    chi_squared.compute(residual.y_adj.squaredNorm(), model.num_individuals());
+    double sse = residual.y_adj.squaredNorm();
+    for (const Eigen::Index row : residual.held_out)
+    {
+        sse -= residual.y_adj(row) * residual.y_adj(row);
+    }
+    chi_squared.compute(sse, model.num_individuals());
     residual.variance = chi_squared(rng);
 }
 }  // namespace gelex::detail::CommonSampler
@@ -17,6 +17,7 @@
 #include "assoc_detail.h"
 
 #include "gelex/algo/gwas/association_test.h"
+#include "gelex/data/genotype/chunk_prefetcher.h"
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/exception.h"
 #include "gelex/infra/logging/notify.h"
@@ -25,11 +26,8 @@
 namespace gelex::detail
 {
 
-auto dispatch_assoc_chunk_by_method(
-    GenotypeProcessMethod method,
-    ModelType model_type,
-    Eigen::Ref<Eigen::MatrixXd> genotype,
-    Eigen::VectorXd* freqs) -> void
+auto assoc_planner(GenotypeProcessMethod method, ModelType model_type)
+    -> LocusPlanner
 {
     if (!is_center_family_method(method))
     {
@@ -39,12 +37,9 @@ auto dispatch_assoc_chunk_by_method(
     }
     if (model_type == ModelType::A)
     {
-        process_matrix<GeneticEffectType::Add>(method, genotype, freqs);
-    }
-    else
-    {
-        process_matrix<GeneticEffectType::Dom>(method, genotype, freqs);
+        return get_genotype_planner<GeneticEffectType::Add>(method);
     }
+    return get_genotype_planner<GeneticEffectType::Dom>(method);
 }
 
 auto update_assoc_input(
@@ -53,63 +48,73 @@ auto update_assoc_input(
     const FreqState& state,
     Eigen::MatrixXd&& v_inv) -> void
 {
+    input.solve_v = nullptr;
     input.V_inv = std::move(v_inv);
     input.V_inv_y
         = input.V_inv
           * (model.phenotype() - model.fixed().X * state.fixed().coeff);
 }
 
+auto update_assoc_input(
+    AssocInput& input,
+    const FreqModel& model,
+    const FreqState& state,
+    std::shared_ptr<const SparseVFactor> v_factor) -> void
+{
+    input.V_inv.resize(0, 0);
+    input.V_inv_y = v_factor->solve(
+        model.phenotype() - model.fixed().X * state.fixed().coeff);
+    input.solve_v
+        = [factor = std::move(v_factor)](
+              const Eigen::MatrixXd& z, Eigen::MatrixXd& w)
+    { solve_sparse_v(*factor, z, w); };
+}
+
 ChrScanner::ChrScanner(Config config, BedPipe& bed, AssocObserver observer)
     : config_(config), bed_(bed), observer_(std::move(observer))
 {
-    const auto cs = static_cast<Eigen::Index>(config_.chunk_size);
-    output_.resize(cs);
-    freqs_.resize(cs);
+    output_.resize(config_.chunk_size);
 }
 
 auto ChrScanner::scan(
     const ChrGroup& group,
-    const GenoProcessor& processor,
+    LocusPlanner planner,
     const ResultWriter& writer) -> void
 {
-    const auto n_samples = input_.V_inv.rows();
-    const auto cs = static_cast<size_t>(config_.chunk_size);
-
-    for (const auto& [range_start, range_end] : group.ranges)
-    {
-        for (auto start = range_start; start < range_end;
-             start += static_cast<Eigen::Index>(cs))
-        {
-            const auto end
-                = std::min(start + static_cast<Eigen::Index>(cs), range_end);
-            const auto current_chunk_size = end - start;
+    const auto n_samples = input_.V_inv_y.size();
 
-            input_.resize(n_samples, current_chunk_size);
-            output_.resize(current_chunk_size);
-            freqs_.resize(current_chunk_size);
+    // the next chunk is decoded while the Wald test runs on this one
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(group.ranges, config_.chunk_size),
+        ChunkPrefetcher::decode(bed_, planner));
 
-            bed_.load_chunk(input_.Z, start, end);
+    while (auto* chunk = prefetcher.next())
+    {
+        const auto current_chunk_size = chunk->end - chunk->start;
 
-            processor(input_.Z, &freqs_);
-            gwas::wald_test(input_, output_);
+        input_.resize(n_samples, current_chunk_size);
+        output_.resize(current_chunk_size);
+        // hand the decoded buffer over instead of copying it; the old Z
+        // goes back to the prefetcher to be refilled
+        input_.Z.swap(chunk->genotype);
+        gwas::wald_test(input_, output_);
 
-            for (Eigen::Index i = 0; i < current_chunk_size; ++i)
-            {
-                writer(
-                    static_cast<size_t>(start + i),
-                    {.freq = freqs_(i),
-                     .beta = output_.beta(i),
-                     .se = output_.se(i),
-                     .p_value = output_.p_value(i)});
-            }
+        for (Eigen::Index i = 0; i < current_chunk_size; ++i)
+        {
+            writer(
+                static_cast<size_t>(chunk->start + i),
+                {.freq = chunk->stats[static_cast<size_t>(i)].maf,
+                 .beta = output_.beta(i),
+                 .se = output_.se(i),
+                 .p_value = output_.p_value(i)});
+        }
 
-            progress_counter_ += static_cast<size_t>(current_chunk_size);
+        progress_counter_ += static_cast<size_t>(current_chunk_size);
 
-            notify(
-                observer_,
-                AssocScanProgressEvent{
-                    .current = progress_counter_, .total = config_.total_snps});
-        }
+        notify(
+            observer_,
+            AssocScanProgressEvent{
+                .current = progress_counter_, .total = config_.total_snps});
     }
 }
 
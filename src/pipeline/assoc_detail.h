@@ -19,13 +19,16 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 
 #include <Eigen/Core>
 
+#include "gelex/algo/infer/sparse_estimator.h"
 #include "gelex/data/genotype/bed_pipe.h"
 #include "gelex/infra/logging/assoc_event.h"
 #include "gelex/types/assoc_input.h"
 #include "gelex/types/chr_group.h"
+#include "gelex/types/genetic_effect_type.h"
 
 namespace gelex
 {
@@ -37,11 +40,8 @@ enum class ModelType : uint8_t;
 namespace detail
 {
 
-auto dispatch_assoc_chunk_by_method(
-    GenotypeProcessMethod method,
-    ModelType model_type,
-    Eigen::Ref<Eigen::MatrixXd> genotype,
-    Eigen::VectorXd* freqs) -> void;
+auto assoc_planner(GenotypeProcessMethod method, ModelType model_type)
+    -> LocusPlanner;
 
 auto update_assoc_input(
     AssocInput& input,
@@ -49,6 +49,13 @@ auto update_assoc_input(
     const FreqState& state,
     Eigen::MatrixXd&& v_inv) -> void;
 
+// Sparse GRMs: the scan solves with the factor of V instead of V^{-1}.
+auto update_assoc_input(
+    AssocInput& input,
+    const FreqModel& model,
+    const FreqState& state,
+    std::shared_ptr<const SparseVFactor> v_factor) -> void;
+
 class ChrScanner
 {
    public:
@@ -66,8 +73,6 @@ class ChrScanner
         double p_value;
     };
 
-    using GenoProcessor
-        = std::function<void(Eigen::Ref<Eigen::MatrixXd>, Eigen::VectorXd*)>;
     using ResultWriter
         = std::function<void(size_t snp_index, const SnpResult&)>;
 
@@ -78,7 +83,7 @@ class ChrScanner
 
     auto scan(
         const ChrGroup& group,
-        const GenoProcessor& processor,
+        LocusPlanner planner,
         const ResultWriter& writer) -> void;
 
     auto assoc_input() -> AssocInput& { return input_; }
@@ -90,7 +95,6 @@ class ChrScanner
 
     AssocInput input_;
     AssocOutput output_;
-    Eigen::VectorXd freqs_;
     size_t progress_counter_ = 0;
 };
 
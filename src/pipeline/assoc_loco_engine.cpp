@@ -16,11 +16,15 @@
 
 #include "gelex/pipeline/assoc_loco_engine.h"
 
+#include <algorithm>
+
 #include <Eigen/Core>
 
 #include "assoc_detail.h"
 #include "gelex/algo/infer/estimator.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/data/grm/loco_grm_loader.h"
 #include "gelex/data/loader/bim_loader.h"
 #include "gelex/exception.h"
@@ -43,13 +47,23 @@ auto AssocLocoEngine::run(
     const RemlObserver& /*reml_observer*/) -> void
 {
     BedPipe bed_pipe(config_.bed_path, pheno.sample_manager());
-    auto bim_path = config_.bed_path;
     auto snp_effects
-        = std::move(detail::BimLoader(bim_path.replace_extension(".bim")))
+        = std::move(detail::BimLoader(variant_info_path(config_.bed_path)))
               .take_info();
+    if (!config_.variant_filter.empty())
+    {
+        apply_variant_filter(config_.variant_filter, bed_pipe, snp_effects);
+    }
 
     FreqModel model(pheno, grm);
     FreqState state(model);
+    if (std::ranges::any_of(
+            model.genetic(), [](const auto& g) { return g.is_sparse(); }))
+    {
+        throw InvalidInputException(
+            "--loco needs dense GRMs; sparse GRMs (.sp.bin) are whole-genome "
+            "only");
+    }
 
     const auto& grm_paths = grm.grm_paths();
 
@@ -83,11 +97,8 @@ auto AssocLocoEngine::run(
     detail::ChrScanner scanner(
         {config_.chunk_size, snp_effects.size()}, bed_pipe, observer);
 
-    auto processor = [&](Eigen::Ref<Eigen::MatrixXd> geno, Eigen::VectorXd* f)
-    {
-        detail::dispatch_assoc_chunk_by_method(
-            config_.method, config_.model_type, geno, f);
-    };
+    const auto planner
+        = detail::assoc_planner(config_.method, config_.model_type);
     auto result_writer = [&](size_t idx, const detail::ChrScanner::SnpResult& r)
     {
         writer.write_result(
@@ -104,7 +115,7 @@ auto AssocLocoEngine::run(
             const auto chr_grm_prefix
                 = grm_paths[i].string() + ".chr" + group.name;
             loco_loaders[i].load_loco_grm(
-                chr_grm_prefix, id_map, model.genetic()[i].K);
+                chr_grm_prefix, model.genetic()[i].K);
         }
 
         notify(
@@ -134,7 +145,7 @@ auto AssocLocoEngine::run(
             observer,
             AssocLocoPhaseEvent{.chr_name = group.name, .phase = "SCAN"});
 
-        scanner.scan(group, processor, result_writer);
+        scanner.scan(group, planner, result_writer);
     }
 
     writer.finalize();
@@ -16,11 +16,17 @@
 
 #include "gelex/pipeline/assoc_normal_engine.h"
 
+#include <algorithm>
+#include <memory>
+
 #include <Eigen/Core>
 
 #include "assoc_detail.h"
 #include "gelex/algo/infer/estimator.h"
+#include "gelex/algo/infer/sparse_estimator.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/data/loader/bim_loader.h"
 #include "gelex/infra/logging/notify.h"
 #include "gelex/model/freq/model.h"
@@ -43,18 +49,34 @@ auto AssocNormalEngine::run(
     const RemlObserver& reml_observer) -> void
 {
     BedPipe bed_pipe(config_.bed_path, pheno.sample_manager());
-    auto bim_path = config_.bed_path;
     auto snp_effects
-        = std::move(detail::BimLoader(bim_path.replace_extension(".bim")))
+        = std::move(detail::BimLoader(variant_info_path(config_.bed_path)))
               .take_info();
+    if (!config_.variant_filter.empty())
+    {
+        apply_variant_filter(config_.variant_filter, bed_pipe, snp_effects);
+    }
 
     FreqModel model(pheno, grm);
     FreqState state(model);
-    Estimator estimator(config_.max_iter, config_.tol, reml_observer);
 
     notify(observer, AssocRemlStartedEvent{.chr_name = ""});
 
-    auto v_inv = estimator.fit(model, state);
+    // sparse GRMs keep V sparse: REML and the scan solve with its factor
+    Eigen::MatrixXd v_inv;
+    std::shared_ptr<const SparseVFactor> v_factor;
+    if (std::ranges::any_of(
+            model.genetic(), [](const auto& g) { return g.is_sparse(); }))
+    {
+        SparseEstimator estimator(
+            config_.max_iter, config_.tol, reml_observer);
+        v_factor = estimator.fit(model, state);
+    }
+    else
+    {
+        Estimator estimator(config_.max_iter, config_.tol, reml_observer);
+        v_inv = estimator.fit(model, state);
+    }
     auto chr_groups = build_chr_groups(false, snp_effects);
 
     notify(
@@ -69,14 +91,19 @@ auto AssocNormalEngine::run(
 
     detail::ChrScanner scanner(
         {config_.chunk_size, snp_effects.size()}, bed_pipe, observer);
-    detail::update_assoc_input(
-        scanner.assoc_input(), model, state, std::move(v_inv));
-
-    auto processor = [&](Eigen::Ref<Eigen::MatrixXd> geno, Eigen::VectorXd* f)
+    if (v_factor)
     {
-        detail::dispatch_assoc_chunk_by_method(
-            config_.method, config_.model_type, geno, f);
-    };
+        detail::update_assoc_input(
+            scanner.assoc_input(), model, state, std::move(v_factor));
+    }
+    else
+    {
+        detail::update_assoc_input(
+            scanner.assoc_input(), model, state, std::move(v_inv));
+    }
+
+    const auto planner
+        = detail::assoc_planner(config_.method, config_.model_type);
     auto result_writer = [&](size_t idx, const detail::ChrScanner::SnpResult& r)
     {
         writer.write_result(
@@ -85,7 +112,7 @@ auto AssocNormalEngine::run(
     };
     for (const auto& group : chr_groups)
     {
-        scanner.scan(group, processor, result_writer);
+        scanner.scan(group, planner, result_writer);
     }
 
     writer.finalize();
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/pipeline/cv_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <format>
+#include <numeric>
+#include <random>
+
+#include <omp.h>
+
+#include "fit_detail.h"
+#include "gelex/algo/infer/mcmc.h"
+#include "gelex/algo/infer/posterior_calculator.h"
+#include "gelex/exception.h"
+#include "gelex/infra/logging/notify.h"
+#include "gelex/io/text_writer.h"
+#include "gelex/model/bayes/model.h"
+#include "gelex/pipeline/geno_pipe.h"
+#include "gelex/pipeline/pheno_pipe.h"
+#include "gelex/types/sample_id.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+using Eigen::Index;
+
+struct FoldMetrics
+{
+    double accuracy{std::nan("")};
+    double bias{std::nan("")};
+};
+
+// Pearson correlation of observed on predicted values and the regression
+// slope of observed on predicted (1 means unbiased).
+auto evaluate(
+    const Eigen::Ref<const Eigen::VectorXd>& observed,
+    const Eigen::Ref<const Eigen::VectorXd>& predicted) -> FoldMetrics
+{
+    if (observed.size() < 2)
+    {
+        return {};
+    }
+    const Eigen::ArrayXd y = observed.array() - observed.mean();
+    const Eigen::ArrayXd g = predicted.array() - predicted.mean();
+    const double syg = (y * g).sum();
+    const double syy = y.square().sum();
+    const double sgg = g.square().sum();
+
+    FoldMetrics metrics;
+    if (syy > 0.0 && sgg > 0.0)
+    {
+        metrics.accuracy = syg / std::sqrt(syy * sgg);
+    }
+    if (sgg > 0.0)
+    {
+        metrics.bias = syg / sgg;
+    }
+    return metrics;
+}
+
+auto add_held_out_gebv(
+    const bayes::GeneticEffect* effect,
+    const BaseMarkerSummary* summary,
+    std::span<const Index> rows,
+    Eigen::Ref<Eigen::VectorXd> gebv) -> void
+{
+    if (effect == nullptr || summary == nullptr)
+    {
+        return;
+    }
+    // The posterior mean of X_test * beta equals X_test * E[beta]; rows are
+    // read in place from the shared genotype store.
+    const auto X = bayes::get_matrix_ref(effect->X);
+    const auto& beta = summary->coeffs.mean;
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        gebv(static_cast<Index>(i)) += X.row(rows[i]).dot(beta);
+    }
+}
+
+}  // namespace
+
+CvEngine::CvEngine(Config config) : config_(std::move(config))
+{
+    if (config_.n_folds < 2)
+    {
+        throw ArgumentValidationException(
+            std::format(
+                "number of folds must be at least 2, got {}",
+                config_.n_folds));
+    }
+    config_.n_jobs = std::clamp(config_.n_jobs, 1, config_.n_folds);
+}
+
+auto CvEngine::assign_folds(Index n_samples, int n_folds, int seed)
+    -> std::vector<int>
+{
+    std::vector<Index> order(static_cast<size_t>(n_samples));
+    std::iota(order.begin(), order.end(), Index{0});
+    std::mt19937_64 rng(static_cast<std::mt19937_64::result_type>(seed));
+    std::ranges::shuffle(order, rng);
+
+    std::vector<int> folds(static_cast<size_t>(n_samples));
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        folds[static_cast<size_t>(order[i])] = static_cast<int>(i % n_folds);
+    }
+    return folds;
+}
+
+auto CvEngine::run(
+    PhenoPipe&& pheno,
+    GenoPipe&& geno,
+    const CvObserver& observer) -> void
+{
+    auto pheno_pipe = std::move(pheno);
+    auto geno_pipe = std::move(geno);
+    const std::vector<std::string> sample_ids
+        = pheno_pipe.sample_manager()->common_ids();
+    const BayesModel full(pheno_pipe, geno_pipe);
+
+    const Index n = full.num_individuals();
+    const int k = config_.n_folds;
+    if (n < 2 * k)
+    {
+        throw InvalidInputException(
+            std::format("{} samples are too few for {}-fold CV", n, k));
+    }
+
+    const auto labels = assign_folds(n, k, config_.fit.seed);
+    std::vector<std::vector<Index>> test_rows(static_cast<size_t>(k));
+    for (Index i = 0; i < n; ++i)
+    {
+        test_rows[static_cast<size_t>(labels[static_cast<size_t>(i)])]
+            .push_back(i);
+    }
+
+    Eigen::VectorXd gebv = Eigen::VectorXd::Zero(n);
+    std::vector<FoldMetrics> metrics(static_cast<size_t>(k));
+    std::exception_ptr error;
+
+    // Every chain pins Eigen to one thread; pin it once here so the nested
+    // guards never race on a different value.
+    const detail::EigenThreadGuard guard;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(config_.n_jobs) \
+    default(none) shared(full, test_rows, gebv, metrics, error, observer, k)
+    for (int fold = 0; fold < k; ++fold)
+    {
+        try
+        {
+            const auto& rows = test_rows[static_cast<size_t>(fold)];
+            BayesModel model(full, rows);
+            detail::configure_model_priors(model, config_.fit);
+
+            Eigen::VectorXd fold_gebv
+                = Eigen::VectorXd::Zero(static_cast<Index>(rows.size()));
+            detail::visit_trait_model(
+                config_.fit.method,
+                [&](auto trait_model)
+                {
+                    MCMC mcmc(config_.fit.mcmc_params, trait_model);
+                    MCMCResult result
+                        = mcmc.run(model, config_.fit.seed + fold);
+                    add_held_out_gebv(
+                        full.additive(), result.additive(), rows, fold_gebv);
+                    add_held_out_gebv(
+                        full.dominant(), result.dominant(), rows, fold_gebv);
+                });
+
+            Eigen::VectorXd observed(static_cast<Index>(rows.size()));
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                const auto idx = static_cast<Index>(i);
+                observed(idx) = full.phenotype()(rows[i]);
+                gebv(rows[i]) = fold_gebv(idx);
+            }
+            const auto fold_metrics = evaluate(observed, fold_gebv);
+            metrics[static_cast<size_t>(fold)] = fold_metrics;
+
+#pragma omp critical(gelex_cv_notify)
+            notify(
+                observer,
+                CvFoldCompleteEvent{
+                    .fold = fold + 1,
+                    .n_train = model.num_individuals(),
+                    .n_test = static_cast<std::ptrdiff_t>(rows.size()),
+                    .accuracy = fold_metrics.accuracy,
+                    .bias = fold_metrics.bias});
+        }
+        catch (...)
+        {
+#pragma omp critical(gelex_cv_error)
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    detail::TextWriter writer(config_.fit.out_prefix + ".cv");
+    writer.write("FID\tIID\tfold\tphenotype\tgebv");
+    for (Index i = 0; i < n; ++i)
+    {
+        auto [fid, iid] = split_sample_id(sample_ids[static_cast<size_t>(i)]);
+        writer.write(
+            std::format(
+                "{}\t{}\t{}\t{:.6f}\t{:.6f}",
+                fid,
+                iid,
+                labels[static_cast<size_t>(i)] + 1,
+                full.phenotype()(i),
+                gebv(i)));
+    }
+
+    double sum_accuracy = 0.0;
+    double sum_bias = 0.0;
+    for (const auto& m : metrics)
+    {
+        sum_accuracy += m.accuracy;
+        sum_bias += m.bias;
+    }
+    const auto pooled = evaluate(full.phenotype(), gebv);
+
+    notify(
+        observer,
+        CvCompleteEvent{
+            .mean_accuracy = sum_accuracy / k,
+            .mean_bias = sum_bias / k,
+            .pooled_accuracy = pooled.accuracy,
+            .out_prefix = config_.fit.out_prefix});
+}
+
+}  // namespace gelex
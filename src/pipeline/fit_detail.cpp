@@ -0,0 +1,298 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fit_detail.h"
+
+#include <cmath>
+#include <format>
+#include <limits>
+#include <memory>
+
+#include <fmt/format.h>
+
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/genotype/sample_manager.h"
+#include "gelex/data/genotype/variant_filter.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/exception.h"
+#include "gelex/infra/utils/math_utils.h"
+#include "gelex/io/text_writer.h"
+#include "gelex/model/bayes/model.h"
+#include "gelex/model/bayes/prior_strategies.h"
+#include "gelex/pipeline/predict/genotype_aligner.h"
+#include "gelex/types/sample_id.h"
+
+namespace gelex::detail
+{
+
+namespace
+{
+
+auto get_default_pi(BayesAlphabet type) -> Eigen::VectorXd
+{
+    switch (type)
+    {
+        case BayesAlphabet::B:
+        case BayesAlphabet::Bpi:
+        case BayesAlphabet::Bd:
+        case BayesAlphabet::Bdpi:
+        case BayesAlphabet::C:
+        case BayesAlphabet::Cpi:
+        case BayesAlphabet::Cd:
+        case BayesAlphabet::Cdpi:
+            return Eigen::VectorXd{{0.99, 0.01}};
+        case BayesAlphabet::R:
+        case BayesAlphabet::Rd:
+            return Eigen::VectorXd{{0.99, 0.005, 0.001, 0.001, 0.001}};
+        case BayesAlphabet::A:
+        case BayesAlphabet::RR:
+        case BayesAlphabet::Ad:
+        case BayesAlphabet::RRd:
+            return Eigen::VectorXd{{0.0, 1.0}};
+        default:
+            return Eigen::VectorXd{};
+    }
+}
+
+auto get_default_scale(BayesAlphabet type) -> Eigen::VectorXd
+{
+    switch (type)
+    {
+        case BayesAlphabet::R:
+        case BayesAlphabet::Rd:
+            return Eigen::VectorXd{{0.0, 0.001, 0.01, 0.1, 1.0}};
+        default:
+            return Eigen::VectorXd{};
+    }
+}
+
+auto to_eigen(
+    const std::optional<std::vector<double>>& opt_vec,
+    BayesAlphabet type,
+    Eigen::VectorXd (*default_func)(BayesAlphabet)) -> Eigen::VectorXd
+{
+    if (opt_vec)
+    {
+        return Eigen::Map<const Eigen::VectorXd>(
+            opt_vec->data(), static_cast<Eigen::Index>(opt_vec->size()));
+    }
+    return default_func(type);
+}
+
+auto is_orth_family_method(GenotypeProcessMethod method) -> bool
+{
+    switch (method)
+    {
+        case GenotypeProcessMethod::OrthStandardizeHWE:
+        case GenotypeProcessMethod::OrthCenterHWE:
+        case GenotypeProcessMethod::OrthStandardize:
+        case GenotypeProcessMethod::OrthCenter:
+            return true;
+        default:
+            return false;
+    }
+}
+
+auto encode_dominance(double genotype, double freq, bool orth) -> double
+{
+    if (orth)
+    {
+        if (genotype == 2.0)
+        {
+            return (4.0 * freq) - 2.0;
+        }
+        if (genotype == 1.0)
+        {
+            return 2.0 * freq;
+        }
+        return genotype;
+    }
+    return genotype == 2.0 ? 0.0 : genotype;
+}
+
+// Mirrors GenotypeProcessorStrategy, but with the training statistics: the
+// target sample must not shift the centering or the scale of any SNP.
+auto standardize_to_training(
+    Eigen::Ref<Eigen::MatrixXd> genotype,
+    const bayes::GenotypeStorage& reference,
+    const Eigen::VectorXd& freqs,
+    bool is_dominance,
+    GenotypeProcessMethod method) -> void
+{
+    const auto& mean = bayes::get_means(reference);
+    const auto& stddev = bayes::get_stddev(reference);
+    const bool scale = !is_center_family_method(method);
+    const bool orth = is_orth_family_method(method);
+
+#pragma omp parallel for default(none) \
+    shared(genotype, reference, freqs, mean, stddev, scale, orth, is_dominance)
+    for (Eigen::Index j = 0; j < genotype.cols(); ++j)
+    {
+        auto col = genotype.col(j);
+        if (bayes::is_monomorphic_variant(reference, j))
+        {
+            col.setZero();
+            continue;
+        }
+        const double inv_sd = scale ? 1.0 / stddev(j) : 1.0;
+        for (Eigen::Index i = 0; i < col.size(); ++i)
+        {
+            double value = col(i);
+            if (std::isnan(value))
+            {
+                col(i) = 0.0;
+                continue;
+            }
+            if (is_dominance)
+            {
+                value = encode_dominance(value, freqs(j), orth);
+            }
+            col(i) = (value - mean(j)) * inv_sd;
+        }
+    }
+}
+
+}  // namespace
+
+auto configure_model_priors(BayesModel& model, const FitEngine::Config& config)
+    -> void
+{
+    auto prior_strategy = create_prior_strategy(config.method);
+    if (!prior_strategy)
+    {
+        throw GelexException(
+            fmt::format(
+                "Failed to create prior strategy for model type: {}",
+                config.method));
+    }
+
+    PriorConfig prior_config;
+    prior_config.phenotype_variance = model.phenotype_variance();
+    prior_config.additive.mixture_proportions
+        = to_eigen(config.pi, config.method, get_default_pi);
+    prior_config.dominant.mixture_proportions
+        = to_eigen(config.dpi, config.method, get_default_pi);
+    prior_config.additive.mixture_scales
+        = to_eigen(config.scale, config.method, get_default_scale);
+    prior_config.dominant.mixture_scales
+        = to_eigen(config.dscale, config.method, get_default_scale);
+
+    (*prior_strategy)(model, prior_config);
+}
+
+auto load_target_genotypes(
+    const std::filesystem::path& target_bed_path,
+    const std::filesystem::path& train_bim_path,
+    std::span<const Eigen::Index> train_variants,
+    const BayesModel& model,
+    GenotypeProcessMethod method) -> TargetGenotypes
+{
+    const auto* additive = model.additive();
+    if (additive == nullptr)
+    {
+        throw InvalidOperationException(
+            "in-chain prediction requires an additive genetic effect");
+    }
+
+    SnpEffects train_snps = BimLoader(train_bim_path).take_info();
+    if (!train_variants.empty())
+    {
+        train_snps = select_snps(train_snps, train_variants);
+    }
+    if (static_cast<Eigen::Index>(train_snps.size())
+        != bayes::get_cols(additive->X))
+    {
+        throw InvalidInputException(
+            std::format(
+                "{}: expected {} SNPs to match the fitted model, got {}",
+                train_bim_path.string(),
+                bayes::get_cols(additive->X),
+                train_snps.size()));
+    }
+
+    auto sample_manager
+        = std::make_shared<SampleManager>(sample_info_path(target_bed_path));
+    sample_manager->finalize();
+
+    TargetGenotypes target;
+    target.sample_ids = sample_manager->common_ids();
+
+    BedPipe bed_pipe(target_bed_path, sample_manager);
+    GenotypeAligner aligner(target_bed_path, train_snps);
+    Eigen::MatrixXd raw = aligner.align(
+        bed_pipe.load(), std::numeric_limits<double>::quiet_NaN());
+
+    // p is recovered from the additive mean, which is 2p for every method.
+    const Eigen::VectorXd freqs = bayes::get_means(additive->X) / 2.0;
+
+    if (const auto* dominant = model.dominant(); dominant != nullptr)
+    {
+        target.dominant = raw;
+        standardize_to_training(
+            target.dominant, dominant->X, freqs, true, method);
+    }
+    standardize_to_training(raw, additive->X, freqs, false, method);
+    target.additive = std::move(raw);
+
+    return target;
+}
+
+auto write_chain_gebv(
+    const std::filesystem::path& path,
+    std::span<const std::string> sample_ids,
+    const RunningStatsResult& gebv,
+    double prob) -> void
+{
+    if (sample_ids.size() != static_cast<size_t>(gebv.mean.size()))
+    {
+        throw InvalidInputException(
+            std::format(
+                "Dimension mismatch: {} target samples but {} GEBVs",
+                sample_ids.size(),
+                gebv.mean.size()));
+    }
+
+    // Normal approximation of the central credible interval; the chain keeps
+    // only the first two moments per target individual.
+    const double z = inverse_of_normal_cdf((1.0 + prob) / 2.0, 0.0, 1.0);
+    const auto percent = static_cast<int>(std::lround(prob * 100.0));
+
+    TextWriter writer(path);
+    writer.write(
+        std::format("FID\tIID\tgebv\tsd\tlower{0}\tupper{0}", percent));
+
+    std::string row;
+    for (size_t i = 0; i < sample_ids.size(); ++i)
+    {
+        const auto idx = static_cast<Eigen::Index>(i);
+        const double mean = gebv.mean(idx);
+        const double sd = gebv.stddev(idx);
+        auto [fid, iid] = split_sample_id(sample_ids[i]);
+        row = std::format(
+            "{}\t{}\t{:.6f}\t{:.6f}\t{:.6f}\t{:.6f}",
+            fid,
+            iid,
+            mean,
+            sd,
+            mean - (z * sd),
+            mean + (z * sd));
+        writer.write(row);
+    }
+}
+
+}  // namespace gelex::detail
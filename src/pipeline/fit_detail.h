@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GELEX_PIPELINE_FIT_DETAIL_H_
+#define GELEX_PIPELINE_FIT_DETAIL_H_
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "gelex/infra/utils/running_stats.h"
+#include "gelex/model/bayes/trait_model.h"
+#include "gelex/pipeline/fit_engine.h"
+
+namespace gelex
+{
+enum class GenotypeProcessMethod : uint8_t;
+
+namespace detail
+{
+
+auto configure_model_priors(BayesModel& model, const FitEngine::Config& config)
+    -> void;
+
+// Calls `fn` with the trait sampler matching `method`.
+template <typename Fn>
+auto visit_trait_model(BayesAlphabet method, Fn&& fn) -> void
+{
+    switch (method)
+    {
+        case BayesAlphabet::A:
+            fn(BayesA{});
+            break;
+        case BayesAlphabet::Ad:
+            fn(BayesAd{});
+            break;
+        case BayesAlphabet::B:
+            fn(BayesB{});
+            break;
+        case BayesAlphabet::Bpi:
+            fn(BayesBpi{});
+            break;
+        case BayesAlphabet::Bd:
+            fn(BayesBd{});
+            break;
+        case BayesAlphabet::Bdpi:
+            fn(BayesBdpi{});
+            break;
+        case BayesAlphabet::C:
+            fn(BayesC{});
+            break;
+        case BayesAlphabet::Cpi:
+            fn(BayesCpi{});
+            break;
+        case BayesAlphabet::Cd:
+            fn(BayesCd{});
+            break;
+        case BayesAlphabet::Cdpi:
+            fn(BayesCdpi{});
+            break;
+        case BayesAlphabet::R:
+            fn(BayesR{});
+            break;
+        case BayesAlphabet::Rd:
+            fn(BayesRd{});
+            break;
+        case BayesAlphabet::RR:
+            fn(BayesRR{});
+            break;
+        case BayesAlphabet::RRd:
+            fn(BayesRRd{});
+            break;
+        default:
+            break;
+    }
+}
+
+struct TargetGenotypes
+{
+    std::vector<std::string> sample_ids;
+    Eigen::MatrixXd additive;
+    Eigen::MatrixXd dominant;
+};
+
+// Loads target genotypes, aligns them to the training SNP order and
+// standardizes them with the training allele frequencies, means and
+// standard deviations so they live on the same scale as the fitted effects.
+// SNPs absent from the target set contribute zero. `train_variants` are the
+// raw .bim rows kept by the variant filter; empty means every row.
+auto load_target_genotypes(
+    const std::filesystem::path& target_bed_path,
+    const std::filesystem::path& train_bim_path,
+    std::span<const Eigen::Index> train_variants,
+    const BayesModel& model,
+    GenotypeProcessMethod method) -> TargetGenotypes;
+
+auto write_chain_gebv(
+    const std::filesystem::path& path,
+    std::span<const std::string> sample_ids,
+    const RunningStatsResult& gebv,
+    double prob) -> void;
+
+}  // namespace detail
+}  // namespace gelex
+
+#endif  // GELEX_PIPELINE_FIT_DETAIL_H_
@@ -16,16 +16,15 @@
 
 #include "gelex/pipeline/fit_engine.h"
 
-#include <Eigen/Core>
-
-#include <fmt/format.h>
+#include <span>
+#include <vector>
 
+#include "fit_detail.h"
+#include "gelex/algo/infer/chain_predictor.h"
 #include "gelex/algo/infer/mcmc.h"
-#include "gelex/exception.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/infra/logging/notify.h"
 #include "gelex/model/bayes/model.h"
-#include "gelex/model/bayes/prior_strategies.h"
-#include "gelex/model/bayes/trait_model.h"
 #include "gelex/pipeline/geno_pipe.h"
 #include "gelex/pipeline/pheno_pipe.h"
 #include "gelex/pipeline/report/result_writer.h"
@@ -36,145 +35,26 @@ namespace gelex
 namespace
 {
 
-auto get_default_pi(BayesAlphabet type) -> Eigen::VectorXd
-{
-    switch (type)
-    {
-        case BayesAlphabet::B:
-        case BayesAlphabet::Bpi:
-        case BayesAlphabet::Bd:
-        case BayesAlphabet::Bdpi:
-        case BayesAlphabet::C:
-        case BayesAlphabet::Cpi:
-        case BayesAlphabet::Cd:
-        case BayesAlphabet::Cdpi:
-            return Eigen::VectorXd{{0.99, 0.01}};
-        case BayesAlphabet::R:
-        case BayesAlphabet::Rd:
-            return Eigen::VectorXd{{0.99, 0.005, 0.001, 0.001, 0.001}};
-        case BayesAlphabet::A:
-        case BayesAlphabet::RR:
-        case BayesAlphabet::Ad:
-        case BayesAlphabet::RRd:
-            return Eigen::VectorXd{{0.0, 1.0}};
-        default:
-            return Eigen::VectorXd{};
-    }
-}
-
-auto get_default_scale(BayesAlphabet type) -> Eigen::VectorXd
-{
-    switch (type)
-    {
-        case BayesAlphabet::R:
-        case BayesAlphabet::Rd:
-            return Eigen::VectorXd{{0.0, 0.001, 0.01, 0.1, 1.0}};
-        default:
-            return Eigen::VectorXd{};
-    }
-}
-
-auto to_eigen(
-    const std::optional<std::vector<double>>& opt_vec,
-    BayesAlphabet type,
-    Eigen::VectorXd (*default_func)(BayesAlphabet)) -> Eigen::VectorXd
-{
-    if (opt_vec)
-    {
-        return Eigen::Map<const Eigen::VectorXd>(
-            opt_vec->data(), static_cast<Eigen::Index>(opt_vec->size()));
-    }
-    return default_func(type);
-}
-
-auto configure_model_priors(BayesModel& model, const FitEngine::Config& config)
-    -> void
-{
-    auto prior_strategy = create_prior_strategy(config.method);
-    if (!prior_strategy)
-    {
-        throw GelexException(
-            fmt::format(
-                "Failed to create prior strategy for model type: {}",
-                config.method));
-    }
-
-    PriorConfig prior_config;
-    prior_config.phenotype_variance = model.phenotype_variance();
-    prior_config.additive.mixture_proportions
-        = to_eigen(config.pi, config.method, get_default_pi);
-    prior_config.dominant.mixture_proportions
-        = to_eigen(config.dpi, config.method, get_default_pi);
-    prior_config.additive.mixture_scales
-        = to_eigen(config.scale, config.method, get_default_scale);
-    prior_config.dominant.mixture_scales
-        = to_eigen(config.dscale, config.method, get_default_scale);
-
-    (*prior_strategy)(model, prior_config);
-}
-
 auto run_mcmc_analysis(
     BayesModel& model,
     const FitEngine::Config& config,
+    std::span<const Eigen::Index> variants,
+    ChainPredictor* predictor,
     const FitObserver& observer) -> void
 {
     auto run_and_write = [&](auto trait_model)
     {
         MCMC mcmc(config.mcmc_params, trait_model);
+        mcmc.set_predictor(predictor);
         MCMCResult result
             = mcmc.run(model, config.seed, config.out_prefix, observer);
-        auto bim_path = config.bfile_prefix + ".bim";
-        MCMCResultWriter writer(result, bim_path);
+        auto bim_path
+            = variant_info_path(format_bed_path(config.bfile_prefix));
+        MCMCResultWriter writer(result, bim_path, variants);
         writer.save(config.out_prefix);
     };
 
-    switch (config.method)
-    {
-        case BayesAlphabet::A:
-            run_and_write(BayesA{});
-            break;
-        case BayesAlphabet::Ad:
-            run_and_write(BayesAd{});
-            break;
-        case BayesAlphabet::B:
-            run_and_write(BayesB{});
-            break;
-        case BayesAlphabet::Bpi:
-            run_and_write(BayesBpi{});
-            break;
-        case BayesAlphabet::Bd:
-            run_and_write(BayesBd{});
-            break;
-        case BayesAlphabet::Bdpi:
-            run_and_write(BayesBdpi{});
-            break;
-        case BayesAlphabet::C:
-            run_and_write(BayesC{});
-            break;
-        case BayesAlphabet::Cpi:
-            run_and_write(BayesCpi{});
-            break;
-        case BayesAlphabet::Cd:
-            run_and_write(BayesCd{});
-            break;
-        case BayesAlphabet::Cdpi:
-            run_and_write(BayesCdpi{});
-            break;
-        case BayesAlphabet::R:
-            run_and_write(BayesR{});
-            break;
-        case BayesAlphabet::Rd:
-            run_and_write(BayesRd{});
-            break;
-        case BayesAlphabet::RR:
-            run_and_write(BayesRR{});
-            break;
-        case BayesAlphabet::RRd:
-            run_and_write(BayesRRd{});
-            break;
-        default:
-            break;
-    }
+    detail::visit_trait_model(config.method, run_and_write);
 }
 
 }  // namespace
@@ -188,12 +68,40 @@ auto FitEngine::run(
 {
     auto pheno_pipe = std::move(pheno);
     auto geno_pipe = std::move(geno);
+    const std::vector<Eigen::Index> variants = geno_pipe.selected_variants();
     BayesModel model(pheno_pipe, geno_pipe);
-    configure_model_priors(model, config_);
+    detail::configure_model_priors(model, config_);
 
-    run_mcmc_analysis(model, config_, observer);
+    std::ptrdiff_t num_predicted = 0;
+    if (config_.predict_bed_path.empty())
+    {
+        run_mcmc_analysis(model, config_, variants, nullptr, observer);
+    }
+    else
+    {
+        auto target = detail::load_target_genotypes(
+            config_.predict_bed_path,
+            variant_info_path(format_bed_path(config_.bfile_prefix)),
+            variants,
+            model,
+            config_.genotype_method);
+        ChainPredictor predictor(
+            std::move(target.additive), std::move(target.dominant));
+
+        run_mcmc_analysis(model, config_, variants, &predictor, observer);
+
+        detail::write_chain_gebv(
+            config_.out_prefix + ".gebv",
+            target.sample_ids,
+            predictor.result(),
+            config_.mcmc_params.credible_prob);
+        num_predicted = predictor.num_samples();
+    }
 
-    notify(observer, FitResultsSavedEvent{.out_prefix = config_.out_prefix});
+    notify(
+        observer,
+        FitResultsSavedEvent{
+            .out_prefix = config_.out_prefix, .num_predicted = num_predicted});
 }
 
 }  // namespace gelex
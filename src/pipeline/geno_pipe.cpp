@@ -19,6 +19,9 @@
 #include <memory>
 #include <utility>
 
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/loader/bim_loader.h"
 #include "gelex/infra/logging/data_pipe_event.h"
 #include "gelex/infra/logging/notify.h"
 
@@ -33,6 +36,7 @@ GenoPipe::GenoPipe(const Config& config, DataPipeObserver observer)
 auto GenoPipe::load(std::shared_ptr<SampleManager> sample_manager) -> void
 {
     sample_manager_ = std::move(sample_manager);
+    resolve_variants();
 
     if (config_.model_type == ModelType::A)
     {
@@ -49,9 +53,23 @@ auto GenoPipe::load(std::shared_ptr<SampleManager> sample_manager) -> void
     }
 }
 
+auto GenoPipe::resolve_variants() -> void
+{
+    variants_.clear();
+    if (config_.variant_filter.empty())
+    {
+        return;
+    }
+    BedPipe bed_pipe(config_.bed_path, sample_manager_);
+    auto snp_effects
+        = detail::BimLoader(variant_info_path(config_.bed_path)).take_info();
+    variants_ = apply_variant_filter(
+        config_.variant_filter, bed_pipe, snp_effects);
+}
+
 auto GenoPipe::load_additive_matrix() -> void
 {
-    load_genotype_impl<GeneticEffectType::Add>(
+    const bool from_cache = load_genotype_impl<GeneticEffectType::Add>(
         ".add", config_.genotype_method, additive_matrix_);
     int64_t mono = 0;
     int64_t total = 0;
@@ -67,12 +85,13 @@ auto GenoPipe::load_additive_matrix() -> void
         GenotypeLoadedEvent{
             .is_dominance = false,
             .num_snps = total,
-            .monomorphic_snps = mono});
+            .monomorphic_snps = mono,
+            .from_cache = from_cache});
 }
 
 auto GenoPipe::load_dominance_matrix() -> void
 {
-    load_genotype_impl<GeneticEffectType::Dom>(
+    const bool from_cache = load_genotype_impl<GeneticEffectType::Dom>(
         ".dom", config_.genotype_method, dominance_matrix_);
     int64_t mono = 0;
     int64_t total = 0;
@@ -86,7 +105,10 @@ auto GenoPipe::load_dominance_matrix() -> void
     notify(
         observer_,
         GenotypeLoadedEvent{
-            .is_dominance = true, .num_snps = total, .monomorphic_snps = mono});
+            .is_dominance = true,
+            .num_snps = total,
+            .monomorphic_snps = mono,
+            .from_cache = from_cache});
 }
 
 }  // namespace gelex
@@ -16,18 +16,30 @@
 
 #include "gelex/pipeline/grm_engine.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <future>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/grm/grm.h"
 #include "gelex/data/grm/grm_bin_writer.h"
+#include "gelex/data/grm/grm_eigen.h"
 #include "gelex/data/grm/grm_id_writer.h"
+#include "gelex/data/grm/grm_loci.h"
+#include "gelex/data/grm/grm_part.h"
+#include "gelex/data/grm/grm_update.h"
+#include "gelex/data/grm/sparse_grm_writer.h"
+#include "gelex/data/loader/bim_loader.h"
 #include "gelex/infra/logging/grm_event.h"
 #include "gelex/infra/logging/notify.h"
-#include "gelex/infra/utils/utils.h"
 #include "pipeline/grm_work_plan.h"
 
 namespace gelex
@@ -36,12 +48,25 @@ namespace gelex
 namespace
 {
 
+auto temporary_path(const std::string& path) -> std::filesystem::path
+{
+    return path + ".tmp";
+}
+
 auto write_grm_files(
-    const GrmResult& result,
+    const Eigen::Ref<const Eigen::MatrixXd>& grm,
     const std::vector<std::string>& sample_ids,
-    const std::string& out_prefix) -> void
+    const std::string& out_prefix,
+    std::optional<double> sparse_cutoff = std::nullopt) -> void
 {
-    GrmBinWriter(out_prefix + ".bin").write(result.grm);
+    if (sparse_cutoff)
+    {
+        SparseGrmWriter(out_prefix + ".sp.bin").write(grm, *sparse_cutoff);
+    }
+    else
+    {
+        GrmBinWriter(out_prefix + ".bin").write_rows(grm);
+    }
     GrmIdWriter(out_prefix + ".id").write(sample_ids);
 }
 
@@ -51,13 +76,43 @@ GrmEngine::GrmEngine(Config config) : config_(std::move(config)) {}
 
 auto GrmEngine::compute(const GrmObserver& observer) -> void
 {
+    if (!config_.update_prefix.empty())
+    {
+        update(observer);
+        return;
+    }
+
     GRM grm(config_.bed_path);
-    const auto& sample_ids = grm.sample_ids();
+    grm.set_precision(config_.precision);
+    grm.set_kernel(config_.kernel);
+    std::vector<std::string> sample_ids = grm.sample_ids();
+    std::string out_prefix = config_.out_prefix;
+    if (config_.num_parts > 0)
+    {
+        const auto part = balanced_grm_part(
+            static_cast<Eigen::Index>(sample_ids.size()),
+            config_.part_index,
+            config_.num_parts);
+        grm.set_part(part);
+        // a part's .id lists its rows only
+        sample_ids.erase(sample_ids.begin() + part.row_end, sample_ids.end());
+        sample_ids.erase(
+            sample_ids.begin(), sample_ids.begin() + part.row_begin);
+        out_prefix = grm_part_prefix(
+            config_.out_prefix, config_.part_index, config_.num_parts);
+    }
+
+    auto snp_effects
+        = detail::BimLoader(variant_info_path(config_.bed_path)).take_info();
+    if (!config_.variant_filter.empty())
+    {
+        grm.select_variants(config_.variant_filter, snp_effects);
+    }
 
     notify(
         observer,
         GrmDataLoadedEvent{
-            .num_samples = sample_ids.size(),
+            .num_samples = grm.sample_ids().size(),
             .num_snps = static_cast<size_t>(grm.num_snps()),
         });
 
@@ -72,24 +127,218 @@ auto GrmEngine::compute(const GrmObserver& observer) -> void
             config_.method, ranges, config_.chunk_size, observer);
     };
 
-    auto bim_path = config_.bed_path;
-    bim_path.replace_extension(".bim");
+    auto dispatch_groups = [&](const GrmLocoTask& task,
+                               const GRM::GroupSink& sink) -> GrmResult
+    {
+        std::vector<std::vector<std::pair<Eigen::Index, Eigen::Index>>>
+            groups;
+        groups.reserve(task.chromosomes.size());
+        for (const auto& chromosome : task.chromosomes)
+        {
+            groups.push_back(chromosome.ranges);
+        }
+        if (task.is_additive)
+        {
+            return grm.compute_groups<GeneticEffectType::Add>(
+                config_.method, groups, config_.chunk_size, sink, observer);
+        }
+        return grm.compute_groups<GeneticEffectType::Dom>(
+            config_.method, groups, config_.chunk_size, sink, observer);
+    };
+
+    auto output_path = [&](const std::string& name)
+    { return fmt::format("{}.{}", out_prefix, name); };
 
-    auto run_plan = [&](auto& plan)
+    // the encodings `grm --update` applies to new samples, from the code
+    // counts the compute pass reads; parts and sparse GRMs cannot be
+    // updated, so they go without
+    const bool record_loci
+        = config_.num_parts == 0 && !config_.sparse_cutoff;
+    grm.set_record_counts(record_loci);
+    auto write_loci = [&](const GrmWorkItem& item,
+                          std::span<const GenotypeCodeCounts> code_counts)
     {
-        const auto total_snps = static_cast<size_t>(plan.total_work());
-        notify(observer, GrmComputeStartedEvent{.total_snps = total_snps});
+        if (!record_loci)
+        {
+            return;
+        }
+        const auto planner
+            = item.is_additive
+                  ? get_genotype_planner<GeneticEffectType::Add>(
+                        config_.method)
+                  : get_genotype_planner<GeneticEffectType::Dom>(
+                        config_.method);
+        std::vector<LocusPlan> plans(code_counts.size());
+        std::ranges::transform(code_counts, plans.begin(), planner);
+        std::vector<SnpMeta> snps;
+        snps.reserve(plans.size());
+        for (const auto& [start, end] : item.ranges)
+        {
+            for (Eigen::Index j = start; j < end; ++j)
+            {
+                snps.push_back(snp_effects[j]);
+            }
+        }
+        GrmLociWriter(output_path(item.output_name) + ".loci")
+            .write(snps, plans);
+    };
 
-        SmoothEtaCalculator eta(total_snps);
+    // Hadamard products of the GRMs scaled by trace / n, streamed from the
+    // accumulators into the .bin; null for an effect the run lacks
+    auto write_epistasis
+        = [&](const Eigen::MatrixXd* additive, const Eigen::MatrixXd* dominance)
+    {
+        if (!config_.epistasis)
+        {
+            return;
+        }
+        const auto n = static_cast<double>(sample_ids.size());
+        auto write_product = [&](const Eigen::MatrixXd& left,
+                                 const Eigen::MatrixXd& right,
+                                 const std::string& name)
+        {
+            const auto path = output_path(name);
+            GrmBinWriter(path + ".bin")
+                .write_hadamard(
+                    left, right, n * n / (left.trace() * right.trace()));
+            GrmIdWriter(path + ".id").write(sample_ids);
+        };
+        if (additive != nullptr)
+        {
+            write_product(*additive, *additive, "aa");
+        }
+        if (additive != nullptr && dominance != nullptr)
+        {
+            write_product(*additive, *dominance, "ad");
+        }
+        if (dominance != nullptr)
+        {
+            write_product(*dominance, *dominance, "dd");
+        }
+    };
+
+    // the numerator is consumed: it becomes the eigenvectors
+    auto write_eigen
+        = [&](Eigen::MatrixXd&& numerator, const GrmWorkItem& item)
+    {
+        if (config_.eigen)
+        {
+            write_grm_eigen(
+                decompose_grm(std::move(numerator)),
+                output_path(item.output_name) + ".eig");
+        }
+    };
 
-        for (const auto& item : plan.items())
+    auto run_items = [&](const GrmNormalPlan& plan)
+    {
+        const auto& items = plan.items();
+        // --add --dom: the additive and then the dominance item, over the
+        // same variants, accumulated from one decode of each chunk
+        if (config_.fuse_effects && items.size() == 2)
+        {
+            auto [additive, dominance] = grm.compute_add_dom(
+                config_.method,
+                items[0].ranges,
+                config_.chunk_size,
+                observer);
+            write_grm_files(
+                additive.grm,
+                sample_ids,
+                output_path(items[0].output_name),
+                config_.sparse_cutoff);
+            write_grm_files(
+                dominance.grm,
+                sample_ids,
+                output_path(items[1].output_name),
+                config_.sparse_cutoff);
+            // the additive result holds the counts of both
+            write_loci(items[0], additive.code_counts);
+            write_loci(items[1], additive.code_counts);
+            write_epistasis(&additive.grm, &dominance.grm);
+            write_eigen(std::move(additive.grm), items[0]);
+            write_eigen(std::move(dominance.grm), items[1]);
+            return;
+        }
+        // --epistasis with both effects: the additive accumulator waits for
+        // the dominance one
+        Eigen::MatrixXd additive;
+        for (const auto& item : items)
         {
             auto result = dispatch_grm(item.ranges, item.is_additive);
+            write_grm_files(
+                result.grm,
+                sample_ids,
+                output_path(item.output_name),
+                config_.sparse_cutoff);
+            write_loci(item, result.code_counts);
+            if (config_.epistasis && item.is_additive && items.size() == 2)
+            {
+                // --eigen still consumes the accumulator below
+                additive = config_.eigen ? Eigen::MatrixXd(result.grm)
+                                         : std::move(result.grm);
+            }
+            else if (item.is_additive)
+            {
+                write_epistasis(&result.grm, nullptr);
+            }
+            else
+            {
+                write_epistasis(
+                    additive.size() > 0 ? &additive : nullptr, &result.grm);
+            }
+            write_eigen(std::move(result.grm), item);
+        }
+    };
+
+    // One pass per effect type: chromosome GRMs are written as they finish
+    // and the whole-genome GRM, their sum, at the end.
+    auto run_loco = [&](const GrmLocoPlan& plan)
+    {
+        for (const auto& task : plan.tasks())
+        {
+            Eigen::MatrixXd pending;
+            std::future<void> writing;
+            auto sink = [&](size_t group, Eigen::MatrixXd& numerator)
+            {
+                const auto path
+                    = output_path(task.chromosomes[group].output_name);
+                if (!config_.overlap_writes)
+                {
+                    write_grm_files(numerator, sample_ids, path);
+                    return;
+                }
+                if (writing.valid())
+                {
+                    writing.get();
+                }
+                // hand the finished buffer to the writer and take back the
+                // one it has released
+                pending.swap(numerator);
+                writing = std::async(
+                    std::launch::async,
+                    [&pending, &sample_ids, path]
+                    { write_grm_files(pending, sample_ids, path); });
+            };
 
-            auto path
-                = fmt::format("{}.{}", config_.out_prefix, item.output_name);
-            write_grm_files(result, sample_ids, path);
+            auto result = dispatch_groups(task, sink);
+            if (writing.valid())
+            {
+                writing.get();
+            }
+            write_grm_files(
+                result.grm, sample_ids, output_path(task.output_name));
         }
+    };
+
+    auto run_plan = [&](auto& plan,
+                        auto&& run,
+                        size_t num_files,
+                        const std::string& pattern)
+    {
+        const auto total_snps = static_cast<size_t>(plan.total_work());
+        notify(observer, GrmComputeStartedEvent{.total_snps = total_snps});
+
+        run(plan);
 
         notify(
             observer,
@@ -99,28 +348,149 @@ auto GrmEngine::compute(const GrmObserver& observer) -> void
                 .done = true,
             });
 
+        if (config_.kernel == GrmKernel::Packed)
+        {
+            const PackedKernelUsage usage = grm.packed_usage();
+            notify(
+                observer,
+                GrmPackedKernelEvent{
+                    .bitwise = static_cast<size_t>(usage.bitwise),
+                    .expanded = static_cast<size_t>(usage.expanded),
+                });
+        }
+
         notify(
             observer,
             GrmFilesWrittenEvent{
-                .num_files = plan.items().size() * 2,
+                .num_files = num_files,
                 .output_dir = std::filesystem::absolute(
-                                  std::filesystem::path(config_.out_prefix))
+                                  std::filesystem::path(out_prefix))
                                   .parent_path()
                                   .string(),
-                .file_pattern = plan.output_pattern(config_.out_prefix),
+                .file_pattern = config_.sparse_cutoff
+                                    ? fmt::format(
+                                          "{} (sparse .sp.bin)", pattern)
+                                    : pattern,
             });
     };
 
     if (config_.do_loco)
     {
-        GrmLocoPlan plan(bim_path, config_.mode);
-        run_plan(plan);
+        GrmLocoPlan plan(snp_effects, config_.mode);
+        run_plan(
+            plan, run_loco, plan.num_files(), plan.output_pattern(out_prefix));
     }
     else
     {
-        GrmNormalPlan plan(bim_path, config_.mode);
-        run_plan(plan);
+        GrmNormalPlan plan(snp_effects, config_.mode);
+        auto pattern = plan.output_pattern(
+            out_prefix,
+            fmt::format(
+                "bin|id{}{}",
+                record_loci ? "|loci" : "",
+                config_.eigen ? "|eig" : ""));
+        // A x A, D x D, or all three products with both effects
+        const size_t num_products
+            = plan.items().size() == 2 ? 3 : plan.items().size();
+        if (config_.epistasis)
+        {
+            const std::string_view products
+                = num_products == 3                  ? "{aa|ad|dd}"
+                  : config_.mode == freq::GrmType::D ? "dd"
+                                                     : "aa";
+            pattern += fmt::format(
+                ", {}.{}.{{bin|id}}", out_prefix, products);
+        }
+        run_plan(
+            plan,
+            run_items,
+            (plan.items().size()
+             * ((record_loci ? 3 : 2) + (config_.eigen ? 1 : 0)))
+                + (config_.epistasis ? 2 * num_products : 0),
+            pattern);
+    }
+}
+
+auto GrmEngine::update(const GrmObserver& observer) -> void
+{
+    std::vector<std::string> types;
+    if (config_.mode != freq::GrmType::D)
+    {
+        types.emplace_back("add");
+    }
+    if (config_.mode != freq::GrmType::A)
+    {
+        types.emplace_back("dom");
     }
+
+    for (const auto& type : types)
+    {
+        const auto source
+            = fmt::format("{}.{}", config_.update_prefix.string(), type);
+        const auto target = fmt::format("{}.{}", config_.out_prefix, type);
+
+        GrmUpdater updater(config_.bed_path, source);
+        notify(
+            observer,
+            GrmDataLoadedEvent{
+                .num_samples = static_cast<size_t>(
+                    updater.num_old() + updater.num_new()),
+                .num_snps = static_cast<size_t>(updater.num_snps()),
+            });
+        const auto total_snps = static_cast<size_t>(updater.num_snps());
+        notify(observer, GrmComputeStartedEvent{.total_snps = total_snps});
+
+        const Eigen::MatrixXd rows
+            = updater.compute(config_.chunk_size, observer);
+        notify(
+            observer,
+            GrmProgressEvent{
+                .current = total_snps,
+                .total = total_snps,
+                .done = true,
+            });
+
+        // the rows are appended to copies of the GRM that then replace the
+        // target, so an interrupted update leaves it as it was, also when
+        // it is extended in place
+        const bool in_place
+            = std::filesystem::exists(target + ".bin")
+              && std::filesystem::equivalent(source + ".bin", target + ".bin");
+        std::vector<std::string> extensions{".bin", ".id"};
+        if (!in_place)
+        {
+            extensions.emplace_back(".loci");
+        }
+        for (const auto& extension : extensions)
+        {
+            std::filesystem::copy_file(
+                source + extension,
+                temporary_path(target + extension),
+                std::filesystem::copy_options::overwrite_existing);
+        }
+        GrmBinWriter(temporary_path(target + ".bin"), true).write_rows(rows);
+        GrmIdWriter(temporary_path(target + ".id"), true)
+            .write(updater.new_sample_ids());
+        for (const auto& extension : extensions)
+        {
+            std::filesystem::rename(
+                temporary_path(target + extension), target + extension);
+        }
+    }
+
+    notify(
+        observer,
+        GrmFilesWrittenEvent{
+            .num_files = types.size() * 3,
+            .output_dir = std::filesystem::absolute(
+                              std::filesystem::path(config_.out_prefix))
+                              .parent_path()
+                              .string(),
+            .file_pattern = fmt::format(
+                "{}.{}.{{bin|id|loci}}",
+                config_.out_prefix,
+                types.size() == 1 ? types[0] : "{add|dom}"),
+        });
 }
 
 }  // namespace gelex
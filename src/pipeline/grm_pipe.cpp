@@ -69,8 +69,27 @@ auto GrmPipe::load(const std::shared_ptr<SampleManager>& sample_manager) -> void
     grms_.reserve(grm_loaders_.size());
     for (auto& loader : grm_loaders_)
     {
-        grms_.emplace_back(loader.type(), loader.load(id_map));
+        if (loader.is_sparse())
+        {
+            grms_.push_back(
+                {.type = loader.type(),
+                 .K_sparse = loader.load_sparse(id_map)});
+        }
+        else
+        {
+            grms_.push_back({.type = loader.type(), .K = loader.load(id_map)});
+        }
     }
 }
 
+auto GrmPipe::num_sparse_entries() const -> size_t
+{
+    size_t entries = 0;
+    for (const auto& loader : grm_loaders_)
+    {
+        entries += loader.num_sparse_entries();
+    }
+    return entries;
+}
+
 }  // namespace gelex
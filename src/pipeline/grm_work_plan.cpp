@@ -17,12 +17,11 @@
 #include "pipeline/grm_work_plan.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 
-#include "gelex/data/loader/bim_loader.h"
-
 namespace gelex
 {
 
@@ -80,12 +79,9 @@ auto GrmLocoPlan::build_loco_ranges(const SnpEffects& snp_effects)
     return groups;
 }
 
-GrmNormalPlan::GrmNormalPlan(
-    const std::filesystem::path& bim_path,
-    freq::GrmType mode)
+GrmNormalPlan::GrmNormalPlan(const SnpEffects& snp_effects, freq::GrmType mode)
 {
-    detail::BimLoader bim_loader(bim_path);
-    auto num_snps = static_cast<Eigen::Index>(bim_loader.info().size());
+    auto num_snps = static_cast<Eigen::Index>(snp_effects.size());
     auto tasks = build_tasks(mode);
 
     task_pattern_
@@ -113,42 +109,54 @@ auto GrmNormalPlan::total_work() const -> Eigen::Index
     return total_work_;
 }
 
-auto GrmNormalPlan::output_pattern(std::string_view out_prefix) const
-    -> std::string
+auto GrmNormalPlan::output_pattern(
+    std::string_view out_prefix,
+    std::string_view extensions) const -> std::string
 {
-    return fmt::format("{}.{}.{{bin|id}}", out_prefix, task_pattern_);
+    return fmt::format(
+        "{}.{}.{{{}}}", out_prefix, task_pattern_, extensions);
 }
 
-GrmLocoPlan::GrmLocoPlan(
-    const std::filesystem::path& bim_path,
-    freq::GrmType mode)
+GrmLocoPlan::GrmLocoPlan(const SnpEffects& snp_effects, freq::GrmType mode)
 {
-    detail::BimLoader bim_loader(bim_path);
-    auto groups = build_loco_ranges(bim_loader.info());
+    auto groups = build_loco_ranges(snp_effects);
     auto tasks = build_tasks(mode);
 
     num_groups_ = groups.size();
     task_pattern_
         = tasks.size() == 1 ? tasks[0].name : std::string("{add|dom}");
 
-    items_.reserve(groups.size() * tasks.size());
-    for (const auto& group : groups)
+    tasks_.reserve(tasks.size());
+    for (const auto& task : tasks)
     {
-        for (const auto& task : tasks)
+        GrmLocoTask loco_task{
+            .is_additive = task.is_additive,
+            .output_name = task.name,
+            .chromosomes = {},
+        };
+        loco_task.chromosomes.reserve(groups.size());
+        for (const auto& group : groups)
         {
-            items_.push_back({
+            loco_task.chromosomes.push_back({
                 .ranges = group.ranges,
                 .is_additive = task.is_additive,
                 .output_name = fmt::format("{}.chr{}", task.name, group.name),
             });
             total_work_ += group.total_snps;
         }
+        tasks_.push_back(std::move(loco_task));
     }
 }
 
-auto GrmLocoPlan::items() const -> const std::vector<GrmWorkItem>&
+auto GrmLocoPlan::tasks() const -> const std::vector<GrmLocoTask>&
 {
-    return items_;
+    return tasks_;
+}
+
+auto GrmLocoPlan::num_files() const -> size_t
+{
+    // .bin and .id per chromosome plus the whole genome
+    return tasks_.size() * (num_groups_ + 1) * 2;
 }
 
 auto GrmLocoPlan::total_work() const -> Eigen::Index
@@ -160,7 +168,7 @@ auto GrmLocoPlan::output_pattern(std::string_view out_prefix) const
     -> std::string
 {
     return fmt::format(
-        "{}.{}.chr{{1..{}}}.{{bin|id}}",
+        "{}.{}[.chr{{1..{}}}].{{bin|id}}",
         out_prefix,
         task_pattern_,
         num_groups_);
@@ -17,7 +17,6 @@
 #ifndef GELEX_PIPELINE_GRM_WORK_PLAN_H_
 #define GELEX_PIPELINE_GRM_WORK_PLAN_H_
 
-#include <filesystem>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -41,11 +40,14 @@ struct GrmWorkItem
 class GrmNormalPlan
 {
    public:
-    GrmNormalPlan(const std::filesystem::path& bim_path, freq::GrmType mode);
+    GrmNormalPlan(const SnpEffects& snp_effects, freq::GrmType mode);
 
     auto items() const -> const std::vector<GrmWorkItem>&;
     auto total_work() const -> Eigen::Index;
-    auto output_pattern(std::string_view out_prefix) const -> std::string;
+    // `extensions` as in "bin|id"
+    auto output_pattern(
+        std::string_view out_prefix,
+        std::string_view extensions = "bin|id") const -> std::string;
 
    private:
     std::vector<GrmWorkItem> items_;
@@ -53,12 +55,22 @@ class GrmNormalPlan
     std::string task_pattern_;
 };
 
+// One effect type under LOCO: a single pass yields the per-chromosome
+// GRMs and, as their sum, the whole-genome GRM.
+struct GrmLocoTask
+{
+    bool is_additive;
+    std::string output_name;
+    std::vector<GrmWorkItem> chromosomes;
+};
+
 class GrmLocoPlan
 {
    public:
-    GrmLocoPlan(const std::filesystem::path& bim_path, freq::GrmType mode);
+    GrmLocoPlan(const SnpEffects& snp_effects, freq::GrmType mode);
 
-    auto items() const -> const std::vector<GrmWorkItem>&;
+    auto tasks() const -> const std::vector<GrmLocoTask>&;
+    auto num_files() const -> size_t;
     auto total_work() const -> Eigen::Index;
     auto output_pattern(std::string_view out_prefix) const -> std::string;
 
@@ -73,7 +85,7 @@ class GrmLocoPlan
     static auto build_loco_ranges(const SnpEffects& snp_effects)
         -> std::vector<ChrRange>;
 
-    std::vector<GrmWorkItem> items_;
+    std::vector<GrmLocoTask> tasks_;
     Eigen::Index total_work_ = 0;
     size_t num_groups_ = 0;
     std::string task_pattern_;
@@ -0,0 +1,420 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/pipeline/memory_planner.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <limits>
+
+#include "gelex/algo/infer/sparse_estimator.h"
+#include "gelex/exception.h"
+
+namespace gelex
+{
+
+namespace
+{
+
+constexpr size_t kDouble = sizeof(double);
+constexpr size_t kFloat = sizeof(float);
+constexpr size_t kInt = sizeof(int);
+
+// decode chunks alive at once: the prefetcher ring plus the one consumed
+constexpr size_t kChunkBuffers = 3;
+// per-marker vectors of a genetic effect (coeffs, means, sds, norms, ...)
+constexpr size_t kMarkerVectors = 8;
+// per-sample vectors of the sampler (y, residual, predictions, ...)
+constexpr size_t kSampleVectors = 6;
+// variants per decoded panel of the packed GRM kernel
+constexpr size_t kPackedPanelVariants = 256;
+// variants per block of its popcount bit planes, two bits each, padded to
+// 512-bit words
+constexpr size_t kPackedPlaneVariants = 1024;
+// n x n buffers of one REML iteration: V, the projection and its factor
+constexpr size_t kRemlMatrices = 3;
+// sparse REML: V and its LDL' factor, the factor taken as twice V since
+// the fill-in is unknown before ordering
+constexpr size_t kSparseRemlCopies = 3;
+// n x probes blocks of the sparse REML: probes, K * probes, P * probes
+constexpr size_t kProbeBlocks = 3;
+// n x width blocks of the PCA: basis, product, Ritz vectors and residuals
+constexpr size_t kPcaBlocks = 4;
+
+auto to_size(Eigen::Index value) -> size_t
+{
+    return static_cast<size_t>(std::max<Eigen::Index>(value, 0));
+}
+
+struct Settings
+{
+    bool use_mmap;
+    Eigen::Index chunk_size;
+    SampleStorage storage;
+    bool overlap_writes;
+    bool fuse_effects;
+};
+
+auto estimate_fit(const MemoryRequest& request, const Settings& settings)
+    -> std::vector<MemoryItem>
+{
+    const size_t n = to_size(request.num_samples);
+    const size_t m = to_size(request.num_snps);
+    const size_t effects = request.dominance ? 2 : 1;
+    const size_t chains = to_size(std::max(request.num_chains, 1));
+    const size_t records = to_size(request.num_records);
+    const size_t components = to_size(request.num_components);
+
+    std::vector<MemoryItem> items;
+    items.push_back(
+        {settings.use_mmap ? "genotype matrix (mapped)" : "genotype matrix",
+         settings.use_mmap ? 0 : n * m * kDouble * effects});
+    items.push_back(
+        {"genotype chunks",
+         kChunkBuffers * n * to_size(settings.chunk_size) * kDouble});
+    items.push_back(
+        {"sampler state",
+         chains * ((m * kMarkerVectors * kDouble * effects)
+                   + (n * kSampleVectors * kDouble))});
+
+    size_t draws = 0;
+    if (settings.storage == SampleStorage::Full)
+    {
+        draws = m * records * kDouble;
+        if (components > 0)
+        {
+            draws += m * records * kInt;
+        }
+    }
+    else
+    {
+        // running mean and M2, plus per-component counts
+        draws = (2 * m * kDouble) + (m * components * kInt);
+    }
+    items.push_back(
+        {settings.storage == SampleStorage::Full ? "MCMC draws"
+                                                 : "MCMC draws (streaming)",
+         chains * effects * draws});
+    return items;
+}
+
+auto estimate_grm(const MemoryRequest& request, const Settings& settings)
+    -> std::vector<MemoryItem>
+{
+    const size_t n = to_size(request.num_samples);
+    const size_t chunk = to_size(settings.chunk_size);
+    // fused passes accumulate, and for dense chunks decode, both effects
+    const size_t grms = settings.fuse_effects ? 2 : 1;
+    const size_t encodings = request.packed_codes ? 1 : grms;
+    // a part holds its rows over the columns up to its last row
+    const size_t entries
+        = request.part ? to_size(request.part->num_rows())
+                             * to_size(request.part->row_end)
+                       : n * n;
+    std::vector<MemoryItem> items{
+        {grms > 1 ? "GRM accumulators" : "GRM accumulator",
+         grms * entries * kDouble}};
+    if (request.packed_codes)
+    {
+        // four codes per byte, rows padded to whole bytes
+        items.push_back(
+            {"packed genotype chunks", kChunkBuffers * n * ((chunk + 3) / 4)});
+        items.push_back(
+            {"packed decode panel",
+             n * std::min(chunk, kPackedPanelVariants) * kDouble});
+        items.push_back(
+            {"packed bit planes",
+             n * 2 * ((std::min(chunk, kPackedPlaneVariants) + 511) / 512)
+                 * 64});
+    }
+    else if (request.mixed_precision)
+    {
+        // decoded straight to float, without a double copy
+        items.push_back(
+            {"float genotype chunks",
+             kChunkBuffers * encodings * n * chunk * kFloat});
+        items.push_back({"float chunk product", entries * kFloat});
+    }
+    else
+    {
+        items.push_back(
+            {"genotype chunks",
+             kChunkBuffers * encodings * n * chunk * kDouble});
+    }
+    if (request.epistasis && request.num_grms > 1 && !settings.fuse_effects)
+    {
+        items.push_back({"additive GRM for epistasis", entries * kDouble});
+    }
+    if (request.eigen)
+    {
+        // dsyevd: 1 + 6n + 2n^2 doubles and 3 + 5n integers, plus the
+        // eigenvalues
+        items.push_back(
+            {"eigendecomposition workspace",
+             ((1 + (7 * n) + (2 * n * n)) * kDouble) + ((3 + (5 * n)) * kInt)});
+    }
+    if (request.loco)
+    {
+        items.push_back({"chromosome accumulator", n * n * kDouble});
+        if (settings.overlap_writes)
+        {
+            items.push_back({"chromosome being written", n * n * kDouble});
+        }
+    }
+    return items;
+}
+
+auto estimate_assoc(const MemoryRequest& request, const Settings& settings)
+    -> std::vector<MemoryItem>
+{
+    const size_t n = to_size(request.num_samples);
+    const size_t grms = to_size(std::max(request.num_grms, 1));
+    const size_t effects = request.dominance ? 2 : 1;
+    if (request.sparse_grm_entries > 0)
+    {
+        // both triangles, a value and a row index per entry
+        const size_t stored
+            = 2 * request.sparse_grm_entries * (kDouble + kInt);
+        const size_t probes = to_size(
+            std::min(request.num_samples, SparseEstimator::kDefaultProbes));
+        return {
+            {"sparse GRMs", stored},
+            {"sparse REML workspace",
+             (kSparseRemlCopies * stored)
+                 + (kProbeBlocks * grms * n * probes * kDouble)},
+            {"genotype chunks",
+             kChunkBuffers * effects * n * to_size(settings.chunk_size)
+                 * kDouble},
+        };
+    }
+    return {
+        {"GRMs", grms * n * n * kDouble},
+        {"REML workspace", kRemlMatrices * n * n * kDouble},
+        {"genotype chunks",
+         kChunkBuffers * effects * n * to_size(settings.chunk_size)
+             * kDouble},
+    };
+}
+
+auto estimate_pca(const MemoryRequest& request, const Settings& settings)
+    -> std::vector<MemoryItem>
+{
+    const size_t n = to_size(request.num_samples);
+    const size_t width = to_size(request.pca_width);
+    return {
+        {"genotype chunks",
+         kChunkBuffers * n * to_size(settings.chunk_size) * kDouble},
+        {"PCA subspace", kPcaBlocks * n * width * kDouble},
+    };
+}
+
+auto estimate(const MemoryRequest& request, const Settings& settings)
+    -> MemoryPlan
+{
+    MemoryPlan plan{
+        .workload = request.workload,
+        .use_mmap = settings.use_mmap,
+        .chunk_size = settings.chunk_size,
+        .sample_storage = settings.storage,
+        .overlap_writes = settings.overlap_writes,
+        .fuse_effects = settings.fuse_effects,
+        .limit_bytes = request.limit_bytes,
+    };
+    switch (request.workload)
+    {
+        case MemoryWorkload::Fit:
+            plan.items = estimate_fit(request, settings);
+            break;
+        case MemoryWorkload::Grm:
+            plan.items = estimate_grm(request, settings);
+            break;
+        case MemoryWorkload::Assoc:
+            plan.items = estimate_assoc(request, settings);
+            break;
+        case MemoryWorkload::Pca:
+            plan.items = estimate_pca(request, settings);
+            break;
+    }
+    for (const auto& item : plan.items)
+    {
+        plan.peak_bytes += item.bytes;
+    }
+    return plan;
+}
+
+}  // namespace
+
+auto plan_memory(const MemoryRequest& request) -> MemoryPlan
+{
+    if (request.chunk_size <= 0)
+    {
+        throw ArgumentValidationException("chunk size must be positive");
+    }
+
+    Settings settings{
+        .use_mmap = request.use_mmap,
+        .chunk_size = request.chunk_size,
+        .storage = request.sample_storage,
+        .overlap_writes
+        = request.workload == MemoryWorkload::Grm && request.loco,
+        .fuse_effects = request.workload == MemoryWorkload::Grm
+                        && request.num_grms > 1 && !request.loco,
+    };
+    MemoryPlan plan = estimate(request, settings);
+    if (plan.fits())
+    {
+        return plan;
+    }
+
+    if (request.workload == MemoryWorkload::Fit)
+    {
+        if (settings.storage == SampleStorage::Full)
+        {
+            settings.storage = SampleStorage::Streaming;
+            plan = estimate(request, settings);
+            if (plan.fits())
+            {
+                return plan;
+            }
+        }
+        settings.use_mmap = true;
+        plan = estimate(request, settings);
+        if (plan.fits())
+        {
+            return plan;
+        }
+    }
+
+    if (settings.overlap_writes)
+    {
+        settings.overlap_writes = false;
+        plan = estimate(request, settings);
+        if (plan.fits())
+        {
+            return plan;
+        }
+    }
+
+    if (settings.fuse_effects)
+    {
+        settings.fuse_effects = false;
+        plan = estimate(request, settings);
+        if (plan.fits())
+        {
+            return plan;
+        }
+    }
+
+    if (!request.auto_chunk_size)
+    {
+        return plan;
+    }
+    while (!plan.fits() && settings.chunk_size > kMinChunkSize)
+    {
+        settings.chunk_size
+            = std::max(settings.chunk_size / 2, kMinChunkSize);
+        plan = estimate(request, settings);
+    }
+    return plan;
+}
+
+auto parse_memory_size(std::string_view text) -> size_t
+{
+    const auto invalid = [&]
+    {
+        return ArgumentValidationException(
+            std::format(
+                "invalid memory size '{}', expected e.g. 512M, 16G or 1.5T",
+                text));
+    };
+
+    double value = 0.0;
+    const auto* first = text.data();
+    const auto* last = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{} || ptr == first || !(value > 0.0))
+    {
+        throw invalid();
+    }
+
+    std::string_view unit(ptr, static_cast<size_t>(last - ptr));
+    if (unit.ends_with("iB") || unit.ends_with("ib"))
+    {
+        unit.remove_suffix(2);
+    }
+    else if (unit.size() == 2 && (unit[1] == 'B' || unit[1] == 'b'))
+    {
+        unit.remove_suffix(1);
+    }
+
+    double scale = 1.0;
+    if (!unit.empty())
+    {
+        if (unit.size() != 1)
+        {
+            throw invalid();
+        }
+        switch (std::toupper(static_cast<unsigned char>(unit[0])))
+        {
+            case 'B':
+                break;
+            case 'K':
+                scale = 0x1p10;
+                break;
+            case 'M':
+                scale = 0x1p20;
+                break;
+            case 'G':
+                scale = 0x1p30;
+                break;
+            case 'T':
+                scale = 0x1p40;
+                break;
+            default:
+                throw invalid();
+        }
+    }
+
+    const double bytes = value * scale;
+    if (bytes >= static_cast<double>(std::numeric_limits<size_t>::max()))
+    {
+        throw invalid();
+    }
+    return static_cast<size_t>(bytes);
+}
+
+auto format_memory_size(size_t bytes) -> std::string
+{
+    static constexpr std::array<std::string_view, 5> kUnits{
+        "B", "KiB", "MiB", "GiB", "TiB"};
+    auto value = static_cast<double>(bytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < kUnits.size())
+    {
+        value /= 1024.0;
+        ++unit;
+    }
+    if (unit == 0)
+    {
+        return std::format("{} B", bytes);
+    }
+    return std::format("{:.2f} {}", value, kUnits[unit]);
+}
+
+}  // namespace gelex
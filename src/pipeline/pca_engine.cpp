@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gelex/pipeline/pca_engine.h"
+
+#include <format>
+#include <string>
+#include <utility>
+
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/infra/logging/notify.h"
+#include "gelex/io/text_writer.h"
+#include "gelex/types/sample_id.h"
+
+namespace gelex
+{
+
+PcaEngine::PcaEngine(Config config) : config_(std::move(config)) {}
+
+auto PcaEngine::compute(const PcaObserver& observer) -> void
+{
+    GenotypePca pca(config_.bed_path);
+    if (!config_.variant_filter.empty())
+    {
+        auto snps = detail::BimLoader(variant_info_path(config_.bed_path))
+                        .take_info();
+        pca.select_variants(config_.variant_filter, snps);
+    }
+
+    notify(
+        observer,
+        PcaDataLoadedEvent{
+            .num_samples = pca.sample_ids().size(),
+            .num_snps = static_cast<size_t>(pca.num_snps()),
+        });
+
+    const auto result = pca.compute(
+        config_.method, config_.options, config_.chunk_size, observer);
+    const Eigen::Index k = result.eigenvalues.size();
+
+    const std::string eigenvec_path = config_.out_prefix + ".eigenvec";
+    {
+        detail::TextWriter writer(eigenvec_path);
+        std::string line = "FID\tIID";
+        for (Eigen::Index j = 0; j < k; ++j)
+        {
+            line += std::format("\tPC{}", j + 1);
+        }
+        writer.write(line);
+
+        const auto& sample_ids = pca.sample_ids();
+        for (size_t i = 0; i < sample_ids.size(); ++i)
+        {
+            auto [fid, iid] = split_sample_id(sample_ids[i]);
+            line = std::format("{}\t{}", fid, iid);
+            for (Eigen::Index j = 0; j < k; ++j)
+            {
+                line += std::format(
+                    "\t{:.6g}",
+                    result.eigenvectors(static_cast<Eigen::Index>(i), j));
+            }
+            writer.write(line);
+        }
+    }
+
+    const std::string eigenval_path = config_.out_prefix + ".eigenval";
+    {
+        detail::TextWriter writer(eigenval_path);
+        for (const double value : result.eigenvalues)
+        {
+            writer.write(std::format("{:.6g}", value));
+        }
+    }
+
+    notify(
+        observer,
+        PcaFilesWrittenEvent{
+            .eigenvec_path = eigenvec_path,
+            .eigenval_path = eigenval_path,
+        });
+}
+
+}  // namespace gelex
@@ -26,6 +26,7 @@
 #include <Eigen/Core>
 
 #include "gelex/data/frame/dummy_encode.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/genotype/sample_manager.h"
 #include "gelex/exception.h"
 #include "gelex/infra/logger.h"
@@ -41,9 +42,8 @@ namespace gelex
 PhenoPipe::PhenoPipe(const Config& config, DataPipeObserver observer)
     : config_(config), observer_(std::move(observer))
 {
-    auto fam_path = config.bed_path;
     sample_manager_
-        = std::make_shared<SampleManager>(fam_path.replace_extension(".fam"));
+        = std::make_shared<SampleManager>(sample_info_path(config.bed_path));
     num_genotype_samples_ = sample_manager_->num_common_samples();
 
     notify(observer_, DataPipeSectionEvent{});
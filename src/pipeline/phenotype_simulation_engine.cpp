@@ -17,6 +17,7 @@
 #include "gelex/pipeline/phenotype_simulation_engine.h"
 
 #include <random>
+#include <string>
 #include <vector>
 
 #include <Eigen/Core>
@@ -24,6 +25,7 @@
 #include "gelex/algo/sim/effect_sampler.h"
 #include "gelex/algo/sim/genetic_value_calculator.h"
 #include "gelex/algo/sim/phenotype_generator.h"
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/loader/bim_loader.h"
 #include "gelex/infra/logging/notify.h"
 #include "gelex/io/sim/simulation_writer.h"
@@ -72,21 +74,29 @@ auto PhenotypeSimulationEngine::run(const SimulateObserver& observer) -> void
 {
     std::mt19937_64 rng(config_.seed);
 
-    auto bim_path = config_.bed_path;
-    bim_path.replace_extension(".bim");
-    detail::BimLoader bim_loader(bim_path);
-    auto snp_ids = bim_loader.get_ids();
-
     const auto dominance = make_dominance_spec(config_);
 
+    GeneticValueCalculator calculator(
+        config_.bed_path, dominance.has_dominance);
+    auto snp_effects
+        = detail::BimLoader(variant_info_path(config_.bed_path)).take_info();
+    if (!config_.variant_filter.empty())
+    {
+        calculator.select_variants(config_.variant_filter, snp_effects);
+    }
+    std::vector<std::string> snp_ids;
+    snp_ids.reserve(snp_effects.size());
+    for (const auto& snp : snp_effects)
+    {
+        snp_ids.push_back(snp.id);
+    }
+
     EffectSampler effect_sampler(
         config_.add_effect_classes, dominance.effect_classes, rng);
 
     auto causal_effects
         = effect_sampler.sample(static_cast<Eigen::Index>(snp_ids.size()));
 
-    GeneticValueCalculator calculator(
-        config_.bed_path, dominance.has_dominance);
     auto genetic_values = calculator.calculate(causal_effects, observer);
 
     // Generate phenotypes
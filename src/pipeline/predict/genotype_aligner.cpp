@@ -32,14 +32,14 @@ GenotypeAligner::GenotypeAligner(
     match_plan_ = matcher.match(bed_path);
 }
 
-auto GenotypeAligner::align(Eigen::MatrixXd&& raw_genotype) const
-    -> Eigen::MatrixXd
+auto GenotypeAligner::align(Eigen::MatrixXd&& raw_genotype, double unmatched)
+    const -> Eigen::MatrixXd
 {
     Eigen::MatrixXd genotype = std::move(raw_genotype);
     const Eigen::Index num_samples = genotype.rows();
 
-    Eigen::MatrixXd result(num_samples, num_snp_effects_);
-    result.setZero();
+    Eigen::MatrixXd result
+        = Eigen::MatrixXd::Constant(num_samples, num_snp_effects_, unmatched);
 
 #pragma omp parallel for schedule(guided) default(none) shared(result, genotype)
     for (Eigen::Index i = 0; i < static_cast<Eigen::Index>(match_plan_.size());
@@ -23,6 +23,7 @@
 
 #include <Eigen/Core>
 
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/data/genotype/bed_pipe.h"
 #include "gelex/data/genotype/sample_manager.h"
 
@@ -31,9 +32,8 @@ namespace gelex
 
 PredictDataPipe::PredictDataPipe(const Config& config)
 {
-    auto fam_path = config.bed_path;
-    fam_path.replace_extension(".fam");
-    sample_manager_ = std::make_shared<SampleManager>(fam_path);
+    sample_manager_
+        = std::make_shared<SampleManager>(sample_info_path(config.bed_path));
 
     if (!config.qcovar_path.empty())
     {
@@ -19,6 +19,7 @@
 #include <Eigen/Core>
 #include <ranges>
 
+#include "gelex/data/genotype/bed_path.h"
 #include "gelex/exception.h"
 
 #include "gelex/data/loader/bim_loader.h"
@@ -31,8 +32,7 @@ SnpMatcher::SnpMatcher(const SnpEffects& effects) : effects_(&effects) {}
 
 MatchPlan SnpMatcher::match(const std::filesystem::path& predict_bed_path) const
 {
-    auto bim_path = predict_bed_path;
-    bim_path.replace_extension(".bim");
+    const auto bim_path = variant_info_path(predict_bed_path);
 
     if (!std::filesystem::exists(bim_path))
     {
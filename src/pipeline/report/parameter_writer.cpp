@@ -41,7 +41,13 @@ auto ParameterWriter::write() -> void
     const auto* additive = result_->additive();
     const auto* dominant = result_->dominant();
 
-    writer_->write_header({"term", "mean", "stddev"});
+    const double prob = result_->prob();
+    writer_->write_header(
+        {"term",
+         "mean",
+         "stddev",
+         std::format("{:g}%", (1.0 - prob) * 50.0),
+         std::format("{:g}%", (1.0 + prob) * 50.0)});
 
     write_fixed_effects();
     write_random_effects();
@@ -128,7 +134,12 @@ auto ParameterWriter::write_summary_statistics(
     {
         writer_->write(
             std::format(
-                "{}\t{}\t{}", terms[i], stats.mean(i), stats.stddev(i)));
+                "{}\t{}\t{}\t{}\t{}",
+                terms[i],
+                stats.mean(i),
+                stats.stddev(i),
+                stats.lower(i),
+                stats.upper(i)));
     }
 }
 
@@ -27,8 +27,11 @@ namespace gelex
 
 MCMCResultWriter::MCMCResultWriter(
     const MCMCResult& result,
-    const std::filesystem::path& bim_file_path)
-    : result_(&result), bim_file_path_(bim_file_path)
+    const std::filesystem::path& bim_file_path,
+    std::span<const Eigen::Index> variants)
+    : result_(&result),
+      bim_file_path_(bim_file_path),
+      variants_(variants.begin(), variants.end())
 {
 }
 
@@ -43,7 +46,8 @@ auto MCMCResultWriter::save(const std::filesystem::path& prefix) const -> void
     {
         auto snp_path = prefix;
         snp_path.replace_extension(".snp.eff");
-        SnpEffectsWriter snp_effects_writer(*result_, bim_file_path_, snp_path);
+        SnpEffectsWriter snp_effects_writer(
+            *result_, bim_file_path_, snp_path, variants_);
         snp_effects_writer.write();
     }
 }
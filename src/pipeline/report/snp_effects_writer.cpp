@@ -19,6 +19,7 @@
 #include <format>
 #include <memory>
 
+#include "gelex/data/genotype/variant_filter.h"
 #include "gelex/io/text_writer.h"
 
 namespace gelex
@@ -29,11 +30,16 @@ using Eigen::Index;
 SnpEffectsWriter::SnpEffectsWriter(
     const MCMCResult& result,
     const std::filesystem::path& bim_file_path,
-    const std::filesystem::path& output_path)
+    const std::filesystem::path& output_path,
+    std::span<const Eigen::Index> variants)
     : result_(&result),
       bim_loader_(bim_file_path),
       writer_(std::make_unique<detail::TextWriter>(output_path))
 {
+    if (!variants.empty())
+    {
+        bim_loader_.info() = select_snps(bim_loader_.info(), variants);
+    }
 }
 
 SnpEffectsWriter::~SnpEffectsWriter() = default;
@@ -74,7 +80,7 @@ auto SnpEffectsWriter::write_header() -> void
 
     std::string h
         = "Index\tID\tChrom\tPosition\tA1\tA2\tA1Freq"
-          "\tAdd\tAddSE\tAddPVE";
+          "\tAdd\tAddSE\tAddLower\tAddUpper\tAddPVE";
 
     if (n_add_components > 2)
     {
@@ -87,7 +93,7 @@ auto SnpEffectsWriter::write_header() -> void
 
     if (dominant != nullptr)
     {
-        h += "\tDom\tDomSE\tDomPVE";
+        h += "\tDom\tDomSE\tDomLower\tDomUpper\tDomPVE";
         if (n_dom_components > 2)
         {
             for (Index comp = 0; comp < n_dom_components; ++comp)
@@ -155,9 +161,11 @@ auto SnpEffectsWriter::write_effects(
     }
 
     row_buf_ += std::format(
-        "\t{:.6f}\t{:.6f}",
+        "\t{:.6f}\t{:.6f}\t{:.6f}\t{:.6f}",
         effect->coeffs.mean(snp_index),
-        effect->coeffs.stddev(snp_index));
+        effect->coeffs.stddev(snp_index),
+        effect->coeffs.lower(snp_index),
+        effect->coeffs.upper(snp_index));
 
     if (effect->pve.size() > snp_index)
     {
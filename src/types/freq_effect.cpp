@@ -36,7 +36,7 @@ RandomState::RandomState(const RandomEffect& effect)
 }
 
 GeneticState::GeneticState(const GeneticEffect& effect)
-    : type(effect.type), ebv(Eigen::VectorXd::Zero(effect.K.rows()))
+    : type(effect.type), ebv(Eigen::VectorXd::Zero(effect.num_samples()))
 {
 }
 }  // namespace gelex::freq
@@ -16,7 +16,6 @@
 
 #include "gelex/types/mcmc_results.h"
 
-#include <optional>
 #include <ranges>
 
 #include <Eigen/Core>
@@ -30,13 +29,10 @@ namespace gelex
 using Eigen::Index;
 using Eigen::VectorXd;
 
-MCMCResult::MCMCResult(
-    MCMCSamples&& samples,
-    const BayesModel& model,
-    double prob)
+MCMCResult::MCMCResult(MCMCSamples&& samples, const BayesModel& model)
     : samples_(std::move(samples)),
       residual_(1),
-      prob_(prob),
+      prob_(samples_.credible_prob()),
       phenotype_var_(model.phenotype_variance())
 {
     if (const auto* effect = model.additive(); effect)
@@ -65,62 +61,49 @@ MCMCResult::MCMCResult(
     }
 }
 
-void MCMCResult::compute(std::optional<double> prob)
+void MCMCResult::compute()
 {
-    if (prob)
-    {
-        prob_ = prob.value();
-    }
+    using detail::PosteriorCalculator::compute_param_summary;
 
-    // Use PosteriorCalculator for all computations
     if (const auto* sample = samples_.fixed(); fixed_ && sample != nullptr)
     {
-        fixed_->coeffs = detail::PosteriorCalculator::compute_param_summary(
-            samples_.fixed()->coeffs, prob_);
+        fixed_->coeffs = compute_param_summary(sample->coeffs);
     }
 
     for (auto&& [result, sample] : std::views::zip(random_, samples_.random()))
     {
-        result.coeffs = detail::PosteriorCalculator::compute_param_summary(
-            sample.coeffs, prob_);
-        result.variance = detail::PosteriorCalculator::compute_param_summary(
-            sample.variance, prob_);
+        result.coeffs = compute_param_summary(sample.coeffs);
+        result.variance = compute_param_summary(sample.variance);
     }
 
     auto compute_summary = [&](auto& effect, const auto* sample)
     {
-        effect->coeffs = detail::PosteriorCalculator::compute_param_summary(
-            sample->coeffs, prob_);
-        effect->variance = detail::PosteriorCalculator::compute_param_summary(
-            sample->variance, prob_);
-        effect->heritability
-            = detail::PosteriorCalculator::compute_param_summary(
-                sample->heritability, prob_);
+        effect->coeffs = compute_param_summary(sample->coeffs);
+        effect->variance = compute_param_summary(sample->variance);
+        effect->heritability = compute_param_summary(sample->heritability);
 
         if (effect->mixture_proportion.size() > 0)
         {
             effect->mixture_proportion
-                = detail::PosteriorCalculator::compute_param_summary(
-                    sample->mixture_proportion, prob_);
+                = compute_param_summary(sample->mixture_proportion);
         }
         if (effect->component_variance.size() > 0)
         {
             effect->component_variance
-                = detail::PosteriorCalculator::compute_param_summary(
-                    sample->component_variance, prob_);
+                = compute_param_summary(sample->component_variance);
         }
         if (effect->pip.size() > 0)
         {
             const auto n_comp = effect->comp_probs.cols();
             effect->comp_probs
-                = detail::PosteriorCalculator::compute_component_probs(
-                    sample->tracker, n_comp);
+                = detail::PosteriorCalculator::component_probs_from_counts(
+                    sample->component_counts, sample->n_draws);
             effect->pip
                 = effect->comp_probs.rightCols(n_comp - 1).rowwise().sum();
         }
 
-        detail::PosteriorCalculator::compute_pve(
-            effect->pve, sample->coeffs, phenotype_var_);
+        detail::PosteriorCalculator::compute_pve_from_mean(
+            effect->pve, effect->coeffs.mean, phenotype_var_);
     };
 
     if (const auto* sample = samples_.additive();
@@ -138,7 +121,6 @@ void MCMCResult::compute(std::optional<double> prob)
     // pi and snp_tracker functionality is now handled within AdditiveSummary
     // and DominantSummary
 
-    residual_ = detail::PosteriorCalculator::compute_param_summary(
-        samples_.residual().variance, prob_);
+    residual_ = compute_param_summary(samples_.residual().variance);
 }
 }  // namespace gelex
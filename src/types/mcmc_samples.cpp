@@ -34,9 +34,52 @@ MCMCSamples::~MCMCSamples() = default;
 MCMCSamples::MCMCSamples(MCMCSamples&&) noexcept = default;
 auto MCMCSamples::operator=(MCMCSamples&&) noexcept -> MCMCSamples& = default;
 
+CredibleSketch::CredibleSketch(const MCMCParams& params, Eigen::Index n_params)
+    : lower(n_params, (1.0 - params.credible_prob) / 2.0),
+      upper(n_params, (1.0 + params.credible_prob) / 2.0)
+{
+}
+
+void CredibleSketch::update(const Eigen::Ref<const Eigen::VectorXd>& draw)
+{
+    lower.update(draw);
+    upper.update(draw);
+}
+
+void CredibleSketch::update(double draw)
+{
+    update(Eigen::Map<const Eigen::VectorXd>(&draw, 1));
+}
+
+ParamDraws::ParamDraws(const MCMCParams& params, Eigen::Index n_params)
+    : n_params(n_params), interval(params, n_params)
+{
+    if (params.sample_storage == SampleStorage::Full)
+    {
+        draws.resize(n_params, params.n_records);
+    }
+}
+
+void ParamDraws::store(
+    const Eigen::Ref<const Eigen::VectorXd>& draw,
+    Eigen::Index record_idx)
+{
+    moments.update(draw);
+    interval.update(draw);
+    if (draws.size() > 0)
+    {
+        draws.col(record_idx) = draw;
+    }
+}
+
+void ParamDraws::store(double draw, Eigen::Index record_idx)
+{
+    store(Eigen::Map<const Eigen::VectorXd>(&draw, 1), record_idx);
+}
+
 FixedSamples::FixedSamples(const MCMCParams& params, const FixedEffect& effect)
+    : coeffs(params, effect.X.cols())
 {
-    coeffs.resize(effect.X.cols(), params.n_records);
 }
 RandomSamples::RandomSamples(
     const MCMCParams& params,
@@ -44,33 +87,53 @@ RandomSamples::RandomSamples(
     : RandomSamples(params, effect.X.cols()) {};
 
 RandomSamples::RandomSamples(const MCMCParams& params, Eigen::Index n_coeffs)
+    : coeffs(params, n_coeffs), variance(params, 1)
 {
-    coeffs.resize(n_coeffs, params.n_records);
-    variance.resize(params.n_records);
 }
 
 BaseMarkerSamples::BaseMarkerSamples(
     const MCMCParams& params,
     const bayes::GeneticEffect& effect)
-    : RandomSamples(params, bayes::get_cols(effect.X))
+    : RandomSamples(params, bayes::get_cols(effect.X)),
+      heritability(params, 1)
 {
-    heritability.resize(params.n_records);
-
     if (effect.init_pi)  // mixture model
     {
         const Eigen::Index num_snp = bayes::get_cols(effect.X);
         n_proportions = effect.init_pi->size();
-        tracker.resize(num_snp, params.n_records);
+        component_counts.setZero(num_snp, n_proportions);
+        if (params.sample_storage == SampleStorage::Full)
+        {
+            tracker.resize(num_snp, params.n_records);
+        }
 
         if (n_proportions > 2)
         {
-            component_variance.resize(n_proportions - 1, params.n_records);
+            component_variance = ParamDraws(params, n_proportions - 1);
         }
     }
     if (effect.estimate_pi)
     {
-        const Eigen::Index n_props = effect.init_pi->size();
-        mixture_proportion.resize(n_props, params.n_records);
+        mixture_proportion = ParamDraws(params, effect.init_pi->size());
+    }
+}
+
+void BaseMarkerSamples::store_components(
+    const Eigen::VectorXi& components,
+    Eigen::Index record_idx)
+{
+    ++n_draws;
+    if (component_counts.size() == 0 || components.size() == 0)
+    {
+        return;
+    }
+    for (Index i = 0; i < components.size(); ++i)
+    {
+        ++component_counts(i, components(i));
+    }
+    if (tracker.size() > 0)
+    {
+        tracker.col(record_idx) = components;
     }
 }
 
@@ -89,15 +152,15 @@ DominantSamples::DominantSamples(
 }
 
 ResidualSamples::ResidualSamples(const MCMCParams& params)
+    : variance(params, 1)
 {
-    variance.resize(params.n_records);
 }
 
 MCMCSamples::MCMCSamples(
     const MCMCParams& params,
     const BayesModel& model,
     std::string_view sample_prefix)
-    : residual_(params)
+    : residual_(params), credible_prob_(params.credible_prob)
 {
     if (const auto* effect = model.fixed(); effect)
     {
@@ -142,69 +205,53 @@ void MCMCSamples::store(const BayesState& states, Eigen::Index record_idx)
 {
     if (const auto* state = states.fixed(); fixed_ && state != nullptr)
     {
-        fixed_->coeffs.col(record_idx) = state->coeffs;
+        fixed_->coeffs.store(state->coeffs, record_idx);
     }
 
     for (auto&& [sample, state] : std::views::zip(random_, states.random()))
     {
-        sample.coeffs.col(record_idx) = state.coeffs;
-        sample.variance(record_idx) = state.variance;
+        sample.coeffs.store(state.coeffs, record_idx);
+        sample.variance.store(state.variance, record_idx);
     }
 
-    if (const auto* state = states.additive(); additive_ && state != nullptr)
+    auto store_marker
+        = [record_idx](BaseMarkerSamples& sample, const auto& state)
     {
-        additive_->coeffs.col(record_idx) = state->coeffs;
-        if (add_writer_)
-        {
-            add_writer_->write(state->coeffs);
-        }
-        additive_->variance(record_idx) = state->variance;
-        additive_->heritability(record_idx) = state->heritability;
+        sample.coeffs.store(state.coeffs, record_idx);
+        sample.store_components(state.tracker, record_idx);
+        sample.variance.store(state.variance, record_idx);
+        sample.heritability.store(state.heritability, record_idx);
 
-        if (additive_->mixture_proportion.size() > 0)
+        if (sample.mixture_proportion.size() > 0 && state.pi.prop.size() != 0)
         {
-            additive_->mixture_proportion.col(record_idx) = state->pi.prop;
+            sample.mixture_proportion.store(state.pi.prop, record_idx);
         }
-        if (additive_->tracker.size() > 0)
+        if (sample.component_variance.size() > 0)
         {
-            additive_->tracker.col(record_idx) = state->tracker;
+            sample.component_variance.store(
+                state.component_variance, record_idx);
         }
+    };
 
-        if (additive_->component_variance.size() > 0)
+    if (const auto* state = states.additive(); additive_ && state != nullptr)
+    {
+        store_marker(*additive_, *state);
+        if (add_writer_)
         {
-            additive_->component_variance.col(record_idx)
-                = state->component_variance;
+            add_writer_->write(state->coeffs);
         }
     }
 
     if (const auto* state = states.dominant(); dominant_ && state != nullptr)
     {
-        dominant_->coeffs.col(record_idx) = state->coeffs;
+        store_marker(*dominant_, *state);
         if (dom_writer_)
         {
             dom_writer_->write(state->coeffs);
         }
-        dominant_->variance(record_idx) = state->variance;
-        dominant_->heritability(record_idx) = state->heritability;
-
-        if (dominant_->mixture_proportion.size() > 0
-            && state->pi.prop.size() != 0)
-        {
-            dominant_->mixture_proportion.col(record_idx) = state->pi.prop;
-        }
-        if (dominant_->tracker.size() > 0 && state->tracker.size() != 0)
-        {
-            dominant_->tracker.col(record_idx) = state->tracker;
-        }
-
-        if (dominant_->component_variance.size() > 0)
-        {
-            dominant_->component_variance.col(record_idx)
-                = state->component_variance;
-        }
     }
 
-    residual_.variance(record_idx) = states.residual().variance;
+    residual_.variance.store(states.residual().variance, record_idx);
 
     if (scalar_writer_)
     {
@@ -359,6 +359,40 @@ TEST_CASE("BedPipe - load() method", "[data][bed_pipe]")
         REQUIRE(loaded.cols() == num_snps);
         REQUIRE(are_matrices_equal(loaded, expected, 1e-8));
     }
+
+    SECTION("Happy path - large subset with a few samples dropped")
+    {
+        const Eigen::Index num_raw_samples = 203;
+        const Eigen::Index num_snps = 12;
+        auto [bed_prefix, genotypes]
+            = fixture.create_bed_files(num_raw_samples, num_snps, 0.1);
+
+        auto fam_path = bed_prefix;
+        fam_path.replace_extension(".fam");
+        auto sample_manager = std::make_shared<SampleManager>(fam_path);
+
+        auto raw_ids = read_fam_ids(fam_path);
+        std::vector<std::string> intersect_ids;
+        for (size_t i = 0; i < raw_ids.size(); ++i)
+        {
+            if (i % 37 != 5)
+            {
+                intersect_ids.push_back(raw_ids[i]);
+            }
+        }
+        sample_manager->intersect(intersect_ids);
+        sample_manager->finalize();
+
+        BedPipe pipe(bed_prefix, sample_manager);
+
+        auto expected = align_rows_to_id_map(
+            genotypes, raw_ids, sample_manager->common_id_map());
+
+        Eigen::MatrixXd loaded = pipe.load();
+        REQUIRE(
+            loaded.rows() == static_cast<Eigen::Index>(intersect_ids.size()));
+        REQUIRE(are_matrices_equal(loaded, expected, 1e-8));
+    }
 }
 
 TEST_CASE("BedPipe - load_chunk() method", "[data][bed_pipe]")
@@ -547,6 +581,61 @@ TEST_CASE("BedPipe - sample mapping tests", "[data][bed_pipe]")
     }
 }
 
+TEST_CASE("BedPipe - load_codes() transposes packed codes", "[data][bed_pipe]")
+{
+    BedFixture fixture;
+    const Eigen::Index num_snps = 11;
+    auto [bed_prefix, genotypes] = fixture.create_bed_files(13, num_snps, 0.1);
+
+    auto fam_path = bed_prefix;
+    fam_path.replace_extension(".fam");
+    auto sample_manager = std::make_shared<SampleManager>(fam_path);
+    auto raw_ids = read_fam_ids(fam_path);
+    const std::vector<std::string> kept_ids{
+        raw_ids[9], raw_ids[1], raw_ids[4], raw_ids[12], raw_ids[6]};
+    sample_manager->intersect(kept_ids);
+    sample_manager->finalize();
+
+    BedPipe pipe(bed_prefix, sample_manager);
+    const Eigen::MatrixXd expected = pipe.load_chunk(2, num_snps);
+
+    const Eigen::Index cols = num_snps - 2;
+    PackedCodes codes(pipe.num_samples(), (cols + 3) / 4);
+    std::vector<GenotypeCodeCounts> counts(static_cast<size_t>(cols));
+    pipe.load_codes(codes, 2, num_snps, counts);
+
+    for (Eigen::Index j = 0; j < cols; ++j)
+    {
+        Eigen::Index missing = 0;
+        for (Eigen::Index i = 0; i < codes.rows(); ++i)
+        {
+            const auto code = (codes(i, j / 4) >> (2 * (j % 4))) & 0b11;
+            const double dosage = kGenotypeDosages[code];
+            if (std::isnan(expected(i, j)))
+            {
+                REQUIRE(std::isnan(dosage));
+                ++missing;
+            }
+            else
+            {
+                REQUIRE(dosage == expected(i, j));
+            }
+        }
+        const auto& variant_counts = counts[static_cast<size_t>(j)];
+        REQUIRE(variant_counts[kMissingGenotypeCode] == missing);
+    }
+    // bits past the last variant stay zero
+    for (Eigen::Index i = 0; i < codes.rows(); ++i)
+    {
+        REQUIRE((codes(i, codes.cols() - 1) >> 2) == 0);
+    }
+
+    PackedCodes wrong(pipe.num_samples(), 1);
+    REQUIRE_THROWS_AS(
+        pipe.load_codes(wrong, 2, num_snps, counts),
+        ArgumentValidationException);
+}
+
 // TEST_CASE("BedPipe - read plan tests (MatchPlan)", "[data][bed_pipe]")
 // {
 //     BedFixture fixture;
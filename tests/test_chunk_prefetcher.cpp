@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <omp.h>
+
+#include "gelex/data/genotype/chunk_prefetcher.h"
+#include "gelex/exception.h"
+
+using gelex::ChunkPrefetcher;
+
+namespace
+{
+
+// Fills column j with start + j and tracks how many chunks are alive; the
+// consumer decrements `alive` once it is done with a chunk.
+auto counting_producer(std::atomic<int>& alive, std::atomic<int>& peak)
+    -> ChunkPrefetcher::Producer
+{
+    return [&alive, &peak](ChunkPrefetcher::Chunk& chunk)
+    {
+        const int now = ++alive;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now))
+        {
+        }
+        chunk.genotype.resize(3, chunk.end - chunk.start);
+        for (Eigen::Index j = 0; j < chunk.genotype.cols(); ++j)
+        {
+            chunk.genotype.col(j).setConstant(
+                static_cast<double>(chunk.start + j));
+        }
+    };
+}
+
+}  // namespace
+
+TEST_CASE("ChunkPrefetcher::split cuts ranges into chunks", "[data][prefetch]")
+{
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{
+        {0, 5}, {10, 12}, {20, 20}};
+
+    const auto chunks = ChunkPrefetcher::split(ranges, 2);
+
+    REQUIRE(chunks.size() == 4);
+    REQUIRE(chunks[0].start == 0);
+    REQUIRE(chunks[0].end == 2);
+    REQUIRE(chunks[2].start == 4);
+    REQUIRE(chunks[2].end == 5);
+    REQUIRE(chunks[3].start == 10);
+    REQUIRE(chunks[3].end == 12);
+
+    REQUIRE_THROWS_AS(
+        ChunkPrefetcher::split(ranges, 0), gelex::ArgumentValidationException);
+}
+
+TEST_CASE("ChunkPrefetcher hands out chunks in order", "[data][prefetch]")
+{
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{
+        {0, 7}, {9, 13}};
+    std::atomic<int> alive{0};
+    std::atomic<int> peak{0};
+    const size_t depth = GENERATE(1, 2, 3);
+
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, 3),
+        counting_producer(alive, peak),
+        depth);
+
+    std::vector<Eigen::Index> seen;
+    while (auto* chunk = prefetcher.next())
+    {
+        for (Eigen::Index j = 0; j < chunk->genotype.cols(); ++j)
+        {
+            REQUIRE(chunk->genotype(0, j) == chunk->start + j);
+            seen.push_back(chunk->start + j);
+        }
+        // swapping the buffer out must not disturb later chunks
+        Eigen::MatrixXd taken;
+        taken.swap(chunk->genotype);
+        --alive;
+    }
+    REQUIRE(prefetcher.next() == nullptr);
+
+    const std::vector<Eigen::Index> expected{
+        0, 1, 2, 3, 4, 5, 6, 9, 10, 11, 12};
+    REQUIRE(seen == expected);
+    // at most `depth` chunks exist at once, counting the one being consumed
+    REQUIRE(peak.load() <= static_cast<int>(depth));
+}
+
+TEST_CASE("ChunkPrefetcher rethrows producer errors", "[data][prefetch]")
+{
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{{0, 10}};
+    ChunkPrefetcher prefetcher(
+        ChunkPrefetcher::split(ranges, 4),
+        [](ChunkPrefetcher::Chunk& chunk)
+        {
+            if (chunk.start == 4)
+            {
+                throw std::runtime_error("decode failed");
+            }
+            chunk.genotype.resize(1, chunk.end - chunk.start);
+        });
+
+    REQUIRE(prefetcher.next() != nullptr);
+    REQUIRE_THROWS_AS(prefetcher.next(), std::runtime_error);
+}
+
+TEST_CASE("ChunkPrefetcher stops early without draining", "[data][prefetch]")
+{
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{{0, 100}};
+    std::atomic<int> produced{0};
+    {
+        ChunkPrefetcher prefetcher(
+            ChunkPrefetcher::split(ranges, 1),
+            [&produced](ChunkPrefetcher::Chunk&) { ++produced; });
+        REQUIRE(prefetcher.next() != nullptr);
+    }
+    REQUIRE(produced.load() <= 3);
+}
+
+TEST_CASE(
+    "ChunkPrefetcher splits the OpenMP threads with its producer",
+    "[data][prefetch]")
+{
+    REQUIRE(ChunkPrefetcher::split_threads(1) == std::pair{1, 1});
+    REQUIRE(ChunkPrefetcher::split_threads(2) == std::pair{1, 1});
+    REQUIRE(ChunkPrefetcher::split_threads(8) == std::pair{2, 6});
+    REQUIRE(ChunkPrefetcher::split_threads(32) == std::pair{8, 24});
+
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{{0, 4}};
+    const int budget = omp_get_max_threads();
+    omp_set_num_threads(8);
+    std::atomic<int> producer_threads{0};
+    {
+        ChunkPrefetcher prefetcher(
+            ChunkPrefetcher::split(ranges, 2),
+            [&producer_threads](ChunkPrefetcher::Chunk&)
+            { producer_threads = omp_get_max_threads(); });
+        REQUIRE(omp_get_max_threads() == 6);
+        while (prefetcher.next() != nullptr)
+        {
+        }
+        REQUIRE(producer_threads.load() == 2);
+    }
+    REQUIRE(omp_get_max_threads() == 8);
+    omp_set_num_threads(budget);
+}
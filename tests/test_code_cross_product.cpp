@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "data/grm/code_cross_product.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/types/genetic_effect_type.h"
+
+using Catch::Matchers::WithinAbs;
+using Eigen::Index;
+using gelex::detail::add_integer_cross_products;
+using gelex::detail::as_integer_locus;
+using gelex::detail::available_cross_product_kernels;
+using gelex::detail::cross_product_kernel;
+using gelex::detail::CrossProductKernel;
+using gelex::detail::IntegerLocus;
+
+namespace
+{
+
+constexpr Index kSamples = 70;
+constexpr Index kLoci = 1300;
+
+}  // namespace
+
+TEST_CASE(
+    "as_integer_locus recognizes offset integer levels",
+    "[data][grm][code_cross_product]")
+{
+    SECTION("centered dosage")
+    {
+        const double mean = 0.7;
+        const auto locus
+            = as_integer_locus(3, {2.0 - mean, 0.0, 1.0 - mean, -mean});
+        REQUIRE(locus.has_value());
+        REQUIRE(locus->index == 3);
+        REQUIRE(locus->levels[0b00] == 2);
+        REQUIRE(locus->levels[0b10] == 1);
+        REQUIRE(locus->levels[0b11] == 0);
+        REQUIRE_THAT(locus->offset, WithinAbs(mean, 1e-15));
+    }
+
+    SECTION("centered heterozygote indicator")
+    {
+        const auto locus = as_integer_locus(0, {-0.4, 0.0, 0.6, -0.4});
+        REQUIRE(locus.has_value());
+        REQUIRE(locus->levels[0b00] == 0);
+        REQUIRE(locus->levels[0b10] == 1);
+        REQUIRE(locus->levels[0b11] == 0);
+    }
+
+    SECTION("other tables")
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        // standardized
+        REQUIRE_FALSE(as_integer_locus(0, {1.5, 0.0, 0.2, -1.1}));
+        // missing calls not at zero
+        REQUIRE_FALSE(as_integer_locus(0, {1.3, 0.3, 0.3, -0.7}));
+        // levels past 2
+        REQUIRE_FALSE(as_integer_locus(0, {3.0, 0.0, 1.0, 0.0}));
+        // all calls missing
+        REQUIRE_FALSE(as_integer_locus(0, {nan, nan, nan, nan}));
+    }
+}
+
+TEST_CASE(
+    "Integer cross-products match the decoded product",
+    "[data][grm][code_cross_product]")
+{
+    // more loci than one block of bit planes, and a slice of rows
+    const auto [begin, end] = GENERATE(
+        std::pair<Index, Index>{0, kSamples}, std::pair<Index, Index>{30, 50});
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uniform;
+    gelex::PackedCodes codes
+        = gelex::PackedCodes::Zero(kSamples, (kLoci + 3) / 4);
+    std::vector<IntegerLocus> loci;
+    Eigen::MatrixXd z = Eigen::MatrixXd::Zero(kSamples, kLoci);
+    for (Index v = 0; v < kLoci; ++v)
+    {
+        // every other locus a heterozygote indicator
+        const bool dominance = v % 2 == 1;
+        const double offset = 2.0 * uniform(rng);
+        const double missing_rate = v % 5 == 0 ? 0.1 : 0.0;
+        IntegerLocus locus{
+            .index = v,
+            .levels = dominance ? std::array<uint8_t, 4>{0, 0, 1, 0}
+                                : std::array<uint8_t, 4>{2, 0, 1, 0},
+            .offset = offset};
+        for (Index i = 0; i < kSamples; ++i)
+        {
+            uint8_t code = std::array<uint8_t, 3>{0b00, 0b10, 0b11}[rng() % 3];
+            if (uniform(rng) < missing_rate)
+            {
+                code = gelex::kMissingGenotypeCode;
+            }
+            codes(i, v / 4) |= static_cast<uint8_t>(code << (2 * (v % 4)));
+            if (code != gelex::kMissingGenotypeCode)
+            {
+                z(i, v) = locus.levels[code] - offset;
+            }
+        }
+        loci.push_back(locus);
+    }
+    const Eigen::MatrixXd expected = z * z.transpose();
+
+    for (const CrossProductKernel* kernel : available_cross_product_kernels())
+    {
+        INFO("kernel " << kernel->name << ", rows " << begin << ".." << end);
+
+        // added to what is there; the upper triangle stays untouched
+        Eigen::MatrixXd grm = Eigen::MatrixXd::Constant(end - begin, end, 1.0);
+        add_integer_cross_products(grm, codes, loci, *kernel);
+        for (Index i = begin; i < end; ++i)
+        {
+            for (Index k = 0; k < end; ++k)
+            {
+                const double want = k <= i ? 1.0 + expected(i, k) : 1.0;
+                REQUIRE_THAT(grm(i - begin, k), WithinAbs(want, 1e-9));
+            }
+        }
+    }
+    const auto kernels = available_cross_product_kernels();
+    REQUIRE(kernels.front()->name == "portable");
+    REQUIRE(&cross_product_kernel() == kernels.back());
+}
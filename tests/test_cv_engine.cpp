@@ -0,0 +1,429 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <Eigen/Core>
+
+#include "bed_fixture.h"
+#include "gelex/algo/infer/mcmc.h"
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/exception.h"
+#include "gelex/model/bayes/model.h"
+#include "gelex/model/bayes/samplers/detail/common_op.h"
+#include "gelex/model/bayes/trait_model.h"
+#include "gelex/pipeline/cv_engine.h"
+#include "gelex/pipeline/geno_pipe.h"
+#include "gelex/pipeline/pheno_pipe.h"
+#include "pipeline/fit_detail.h"
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using Eigen::Index;
+using gelex::test::BedFixture;
+
+namespace
+{
+
+constexpr Index kSamples = 40;
+constexpr Index kSnps = 30;
+constexpr int kFolds = 4;
+constexpr int kSeed = 11;
+
+// BED and phenotype files of a small additive trait; every run on them
+// loads the same model.
+class CvFixture
+{
+   public:
+    CvFixture()
+    {
+        std::mt19937_64 rng(5);
+        std::binomial_distribution<int> allele(2, 0.3);
+        std::normal_distribution<double> normal;
+
+        Eigen::MatrixXd genotypes(kSamples, kSnps);
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            for (Index i = 0; i < kSamples; ++i)
+            {
+                genotypes(i, j) = allele(rng);
+            }
+        }
+        std::vector<std::string> iids;
+        for (Index i = 0; i < kSamples; ++i)
+        {
+            iids.push_back(std::format("s{:02d}", i));
+        }
+        bed_prefix_
+            = bed_.create_deterministic_bed_files(genotypes, iids).first;
+
+        Eigen::VectorXd effects(kSnps);
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            effects(j) = 0.5 * normal(rng);
+        }
+        const Eigen::VectorXd y = genotypes * effects;
+        std::string content = "FID\tIID\tPhenotype\n";
+        for (Index i = 0; i < kSamples; ++i)
+        {
+            content += std::format(
+                "fam{}\t{}\t{}\n",
+                (i % 5) + 1,
+                iids[static_cast<size_t>(i)],
+                y(i) + normal(rng));
+        }
+        pheno_path_
+            = bed_.get_file_fixture().create_text_file(content, ".phen");
+    }
+
+    auto pheno_pipe() const -> PhenoPipe
+    {
+        PhenoPipe pheno(
+            PhenoPipe::Config{
+                .phenotype_path = pheno_path_,
+                .phenotype_column = 2,
+                .bed_path = bed_prefix_,
+            });
+        pheno.load();
+        return pheno;
+    }
+
+    auto geno_pipe(PhenoPipe& pheno) const -> GenoPipe
+    {
+        GenoPipe geno(
+            GenoPipe::Config{
+                .bed_path = bed_prefix_,
+                .model_type = ModelType::A,
+                .genotype_method = GenotypeProcessMethod::Standardize,
+            });
+        geno.load(pheno.sample_manager());
+        return geno;
+    }
+
+    auto full_model() const -> BayesModel
+    {
+        auto pheno = pheno_pipe();
+        auto geno = geno_pipe(pheno);
+        return {pheno, geno};
+    }
+
+    auto config() -> CvEngine::Config
+    {
+        CvEngine::Config config{
+            .fit = {
+                .method = BayesAlphabet::RR,
+                .seed = kSeed,
+                .mcmc_params = MCMCParams(60, 20, 2),
+                .out_prefix
+                = bed_.get_file_fixture().generate_random_file_path().string(),
+            },
+            .n_folds = kFolds,
+        };
+        return config;
+    }
+
+   private:
+    BedFixture bed_;
+    std::filesystem::path bed_prefix_;
+    std::filesystem::path pheno_path_;
+};
+
+// Pearson correlation and slope of observed on predicted, by hand.
+auto accuracy_of(const Eigen::VectorXd& y, const Eigen::VectorXd& g)
+    -> std::pair<double, double>
+{
+    const double y_mean = y.mean();
+    const double g_mean = g.mean();
+    double syg = 0.0;
+    double syy = 0.0;
+    double sgg = 0.0;
+    for (Index i = 0; i < y.size(); ++i)
+    {
+        syg += (y(i) - y_mean) * (g(i) - g_mean);
+        syy += (y(i) - y_mean) * (y(i) - y_mean);
+        sgg += (g(i) - g_mean) * (g(i) - g_mean);
+    }
+    return {syg / std::sqrt(syy * sgg), syg / sgg};
+}
+
+auto rows_of_fold(const std::vector<int>& labels, int fold)
+    -> std::vector<Index>
+{
+    std::vector<Index> rows;
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (labels[i] == fold)
+        {
+            rows.push_back(static_cast<Index>(i));
+        }
+    }
+    return rows;
+}
+
+}  // namespace
+
+TEST_CASE("CvEngine - assign_folds", "[pipeline][cv]")
+{
+    SECTION("Happy path - folds are balanced and cover every sample")
+    {
+        const auto folds = CvEngine::assign_folds(23, 5, 42);
+
+        REQUIRE(folds.size() == 23);
+        for (int fold = 0; fold < 5; ++fold)
+        {
+            const auto count = std::ranges::count(folds, fold);
+            REQUIRE(count >= 4);
+            REQUIRE(count <= 5);
+        }
+    }
+
+    SECTION("Happy path - same seed gives the same split")
+    {
+        REQUIRE(
+            CvEngine::assign_folds(50, 4, 7)
+            == CvEngine::assign_folds(50, 4, 7));
+        REQUIRE(
+            CvEngine::assign_folds(50, 4, 7)
+            != CvEngine::assign_folds(50, 4, 8));
+    }
+}
+
+TEST_CASE("CvEngine - Config validation", "[pipeline][cv]")
+{
+    CvEngine::Config config{.fit = {.mcmc_params = MCMCParams(10, 5, 1)}};
+    config.n_folds = 1;
+
+    REQUIRE_THROWS_AS(CvEngine(config), gelex::ArgumentValidationException);
+}
+
+TEST_CASE(
+    "BayesModel - a fold matches a model of the training rows",
+    "[pipeline][cv]")
+{
+    const CvFixture data;
+    const BayesModel full = data.full_model();
+    const std::vector<Index> held_out{6, 1, 33, 20, 5, 6};
+    const std::vector<Index> unique_rows{1, 5, 6, 20, 33};
+
+    const BayesModel fold(full, held_out);
+
+    std::vector<Index> train;
+    for (Index i = 0; i < kSamples; ++i)
+    {
+        if (!std::ranges::binary_search(unique_rows, i))
+        {
+            train.push_back(i);
+        }
+    }
+    const auto n_train = static_cast<Index>(train.size());
+
+    REQUIRE(fold.held_out() == unique_rows);
+    REQUIRE(fold.num_individuals() == n_train);
+
+    SECTION("phenotype and its variance cover the training rows only")
+    {
+        Eigen::VectorXd y_train(n_train);
+        for (Index i = 0; i < n_train; ++i)
+        {
+            y_train(i) = full.phenotype()(train[static_cast<size_t>(i)]);
+            REQUIRE(
+                fold.phenotype()(train[static_cast<size_t>(i)]) == y_train(i));
+        }
+        for (const Index row : unique_rows)
+        {
+            REQUIRE(fold.phenotype()(row) == 0.0);
+            REQUIRE(fold.fixed()->X.row(row).isZero());
+        }
+        const double variance
+            = (y_train.array() - y_train.mean()).square().sum()
+              / static_cast<double>(n_train - 1);
+        REQUIRE_THAT(fold.phenotype_variance(), WithinAbs(variance, 1e-12));
+        REQUIRE_THAT(
+            fold.fixed()->cols_norm(0),
+            WithinAbs(static_cast<double>(n_train), 1e-12));
+    }
+
+    SECTION("marker norms are those of the training rows")
+    {
+        const auto X = bayes::get_matrix_ref(full.additive()->X);
+        // the fold views the full genotypes instead of copying them
+        REQUIRE(bayes::get_matrix_ref(fold.additive()->X).data() == X.data());
+
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            double expected = 0.0;
+            for (const Index row : train)
+            {
+                expected += X(row, j) * X(row, j);
+            }
+            REQUIRE_THAT(
+                fold.additive()->cols_norm(j), WithinAbs(expected, 1e-9));
+        }
+    }
+}
+
+TEST_CASE(
+    "ResidualState - held-out rows are masked from X'y_adj",
+    "[pipeline][cv]")
+{
+    const CvFixture data;
+    const BayesModel full = data.full_model();
+    const std::vector<Index> held_out{0, 7, 8, 39};
+    const BayesModel fold(full, held_out);
+
+    BayesState state(fold);
+    auto& residual = state.residual();
+    REQUIRE(residual.held_out == held_out);
+    for (const Index row : held_out)
+    {
+        REQUIRE(residual.y_adj(row) == 0.0);
+    }
+
+    // a marker update moves the held-out rows of y_adj with the gebv
+    const auto X = bayes::get_matrix_ref(fold.additive()->X);
+    Eigen::VectorXd gebv = Eigen::VectorXd::Zero(kSamples);
+    detail::update_residual_and_gebv(residual, gebv, X.col(0), 0.0, 0.75);
+    REQUIRE(residual.y_adj(7) != 0.0);
+    REQUIRE_THAT(gebv(7), WithinAbs(0.75 * X(7, 0), 1e-12));
+
+    for (Index j = 0; j < kSnps; ++j)
+    {
+        double expected = 0.0;
+        for (Index i = 0; i < kSamples; ++i)
+        {
+            if (!std::ranges::binary_search(held_out, i))
+            {
+                expected += X(i, j) * residual.y_adj(i);
+            }
+        }
+        REQUIRE_THAT(
+            detail::residual_dot(X.col(j), residual),
+            WithinAbs(expected, 1e-9));
+    }
+}
+
+TEST_CASE(
+    "CvEngine - out-of-fold GEBVs and accuracy match a hand computation",
+    "[pipeline][cv]")
+{
+    CvFixture data;
+    const auto config = data.config();
+
+    std::vector<CvFoldCompleteEvent> folds(kFolds);
+    std::optional<CvCompleteEvent> complete;
+    CvEngine(config).run(
+        data.pheno_pipe(),
+        [&]
+        {
+            auto pheno = data.pheno_pipe();
+            return data.geno_pipe(pheno);
+        }(),
+        [&](const CvEvent& event)
+        {
+            if (const auto* fold = std::get_if<CvFoldCompleteEvent>(&event))
+            {
+                folds[static_cast<size_t>(fold->fold - 1)] = *fold;
+            }
+            else if (const auto* done = std::get_if<CvCompleteEvent>(&event))
+            {
+                complete = *done;
+            }
+        });
+    REQUIRE(complete.has_value());
+
+    std::vector<int> written_folds;
+    std::vector<double> written_gebv;
+    {
+        std::ifstream cv(config.fit.out_prefix + ".cv");
+        std::string line;
+        std::getline(cv, line);
+        while (std::getline(cv, line))
+        {
+            std::istringstream fields(line);
+            std::string fid;
+            std::string iid;
+            int fold = 0;
+            double phenotype = 0.0;
+            double gebv = 0.0;
+            fields >> fid >> iid >> fold >> phenotype >> gebv;
+            written_folds.push_back(fold);
+            written_gebv.push_back(gebv);
+        }
+    }
+    REQUIRE(written_gebv.size() == static_cast<size_t>(kSamples));
+
+    // Replay every fold's chain and predict its test rows as X_test E[beta].
+    const BayesModel full = data.full_model();
+    const auto labels = CvEngine::assign_folds(kSamples, kFolds, kSeed);
+    const auto X = bayes::get_matrix_ref(full.additive()->X);
+    Eigen::VectorXd gebv = Eigen::VectorXd::Zero(kSamples);
+    double sum_accuracy = 0.0;
+    double sum_bias = 0.0;
+    for (int fold = 0; fold < kFolds; ++fold)
+    {
+        const auto rows = rows_of_fold(labels, fold);
+        BayesModel model(full, rows);
+        detail::configure_model_priors(model, config.fit);
+        MCMC mcmc(config.fit.mcmc_params, BayesRR{});
+        const MCMCResult result = mcmc.run(model, kSeed + fold);
+        const Eigen::VectorXd& beta = result.additive()->coeffs.mean;
+
+        const auto n_test = static_cast<Index>(rows.size());
+        Eigen::VectorXd observed(n_test);
+        Eigen::VectorXd predicted(n_test);
+        for (Index i = 0; i < n_test; ++i)
+        {
+            const Index row = rows[static_cast<size_t>(i)];
+            observed(i) = full.phenotype()(row);
+            predicted(i) = X.row(row).dot(beta);
+            gebv(row) = predicted(i);
+            REQUIRE(written_folds[static_cast<size_t>(row)] == fold + 1);
+            REQUIRE_THAT(
+                written_gebv[static_cast<size_t>(row)],
+                WithinAbs(predicted(i), 1e-6));
+        }
+
+        const auto [accuracy, bias] = accuracy_of(observed, predicted);
+        const auto& event = folds[static_cast<size_t>(fold)];
+        REQUIRE(event.n_test == n_test);
+        REQUIRE(event.n_train == kSamples - n_test);
+        REQUIRE_THAT(event.accuracy, WithinAbs(accuracy, 1e-9));
+        REQUIRE_THAT(event.bias, WithinAbs(bias, 1e-9));
+        sum_accuracy += accuracy;
+        sum_bias += bias;
+    }
+
+    REQUIRE_THAT(
+        complete->mean_accuracy, WithinAbs(sum_accuracy / kFolds, 1e-9));
+    REQUIRE_THAT(complete->mean_bias, WithinAbs(sum_bias / kFolds, 1e-9));
+    REQUIRE_THAT(
+        complete->pooled_accuracy,
+        WithinAbs(accuracy_of(full.phenotype(), gebv).first, 1e-9));
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "data/bed_pipe/decode_kernels.h"
+#include "gelex/types/genetic_effect_type.h"
+
+using gelex::detail::available_decode_kernels;
+using gelex::detail::decode_kernel;
+using gelex::detail::DecodeKernel;
+
+namespace
+{
+
+auto same_genotype(double a, double b) -> bool
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// The kernel called `name`, or nullptr when the CPU cannot run it.
+auto find_kernel(std::string_view name) -> const DecodeKernel*
+{
+    for (const DecodeKernel* kernel : available_decode_kernels())
+    {
+        if (kernel->name == name)
+        {
+            return kernel;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "Decode kernels agree with the scalar kernel",
+    "[data][bed_pipe][decode_kernels]")
+{
+    const Eigen::Index num_samples
+        = GENERATE(1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 1001);
+
+    std::mt19937 rng(static_cast<uint32_t>(num_samples));
+    std::vector<uint8_t> packed(static_cast<size_t>((num_samples + 3) / 4));
+    for (auto& byte : packed)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    // drop roughly a third of the samples for the sparse path
+    std::vector<Eigen::Index> raw_to_target(static_cast<size_t>(num_samples));
+    Eigen::Index num_targets = 0;
+    for (auto& target : raw_to_target)
+    {
+        target = rng() % 3 == 0 ? -1 : num_targets++;
+    }
+
+    const auto kernels = available_decode_kernels();
+    REQUIRE(kernels.front()->name == "scalar");
+    REQUIRE(&decode_kernel() == kernels.back());
+
+    std::vector<double> dense_ref(static_cast<size_t>(num_samples));
+    std::vector<double> sparse_ref(static_cast<size_t>(num_targets));
+    kernels.front()->dense(packed.data(), num_samples, dense_ref.data());
+    kernels.front()->sparse(
+        packed.data(), num_samples, raw_to_target.data(), sparse_ref.data());
+
+    constexpr double sentinel = -5.0;
+    constexpr size_t guard = 8;
+
+    for (const DecodeKernel* kernel : kernels)
+    {
+        INFO("kernel " << kernel->name << ", samples " << num_samples);
+
+        std::vector<double> dense(dense_ref.size() + guard, sentinel);
+        std::vector<double> sparse(sparse_ref.size() + guard, sentinel);
+        kernel->dense(packed.data(), num_samples, dense.data());
+        kernel->sparse(
+            packed.data(), num_samples, raw_to_target.data(), sparse.data());
+
+        for (size_t i = 0; i < dense_ref.size(); ++i)
+        {
+            REQUIRE(same_genotype(dense[i], dense_ref[i]));
+        }
+        for (size_t i = 0; i < sparse_ref.size(); ++i)
+        {
+            REQUIRE(same_genotype(sparse[i], sparse_ref[i]));
+        }
+        for (size_t i = 0; i < guard; ++i)
+        {
+            REQUIRE(dense[dense_ref.size() + i] == sentinel);
+            REQUIRE(sparse[sparse_ref.size() + i] == sentinel);
+        }
+    }
+}
+
+TEST_CASE(
+    "Mapped decode and code counts agree with a per-sample reference",
+    "[data][bed_pipe][decode_kernels]")
+{
+    const Eigen::Index num_samples = GENERATE(1, 5, 8, 31, 32, 33, 65, 1001);
+    const auto num_bytes = (num_samples + 3) / 4;
+
+    std::mt19937 rng(static_cast<uint32_t>(num_samples) + 7);
+    // trailing padding bits are random too and must not be counted
+    std::vector<uint8_t> packed(static_cast<size_t>(num_bytes));
+    for (auto& byte : packed)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<Eigen::Index> raw_to_target(static_cast<size_t>(num_samples));
+    std::vector<uint64_t> dense_keep(static_cast<size_t>((num_bytes + 7) / 8));
+    std::vector<uint64_t> sparse_keep(dense_keep.size());
+    Eigen::Index num_targets = 0;
+    gelex::GenotypeCodeCounts dense_ref{};
+    gelex::GenotypeCodeCounts sparse_ref{};
+    // 0.1 is not a float, so the single-precision paths must round it
+    const gelex::GenotypeCodeTable table{-1.5, 0.1, 0.25, 3.0};
+    std::vector<double> dense_values(static_cast<size_t>(num_samples));
+    std::vector<double> sparse_values;
+    for (Eigen::Index i = 0; i < num_samples; ++i)
+    {
+        const auto code = (packed[i / 4] >> (2 * (i % 4))) & 3;
+        const uint64_t bit = uint64_t{1} << (2 * (i % 32));
+        dense_keep[i / 32] |= bit;
+        ++dense_ref[code];
+        dense_values[i] = table[code];
+        if (rng() % 3 == 0)
+        {
+            raw_to_target[i] = -1;
+            continue;
+        }
+        raw_to_target[i] = num_targets++;
+        sparse_keep[i / 32] |= bit;
+        ++sparse_ref[code];
+        sparse_values.push_back(table[code]);
+    }
+
+    for (const DecodeKernel* kernel : available_decode_kernels())
+    {
+        INFO("kernel " << kernel->name << ", samples " << num_samples);
+
+        gelex::GenotypeCodeCounts dense_counts{};
+        gelex::GenotypeCodeCounts sparse_counts{};
+        kernel->count(packed.data(), num_bytes, dense_keep.data(), dense_counts);
+        kernel->count(
+            packed.data(), num_bytes, sparse_keep.data(), sparse_counts);
+        REQUIRE(dense_counts == dense_ref);
+        REQUIRE(sparse_counts == sparse_ref);
+
+        std::vector<double> dense(dense_values.size());
+        std::vector<double> sparse(sparse_values.size());
+        kernel->dense_mapped(packed.data(), num_samples, table, dense.data());
+        kernel->sparse_mapped(
+            packed.data(),
+            num_samples,
+            raw_to_target.data(),
+            table,
+            sparse.data());
+        REQUIRE(dense == dense_values);
+        REQUIRE(sparse == sparse_values);
+
+        // single precision: each value narrowed once
+        std::vector<float> dense_f32(dense_values.size());
+        std::vector<float> sparse_f32(sparse_values.size());
+        kernel->dense_mapped_f32(
+            packed.data(), num_samples, table, dense_f32.data());
+        kernel->sparse_mapped_f32(
+            packed.data(),
+            num_samples,
+            raw_to_target.data(),
+            table,
+            sparse_f32.data());
+        for (size_t i = 0; i < dense_values.size(); ++i)
+        {
+            REQUIRE(dense_f32[i] == static_cast<float>(dense_values[i]));
+        }
+        for (size_t i = 0; i < sparse_values.size(); ++i)
+        {
+            REQUIRE(sparse_f32[i] == static_cast<float>(sparse_values[i]));
+        }
+    }
+}
+
+TEST_CASE(
+    "Decode kernels take each slot from the faster implementation",
+    "[data][bed_pipe][decode_kernels]")
+{
+    const DecodeKernel* scalar = find_kernel("scalar");
+    const DecodeKernel* avx2 = find_kernel("avx2");
+    const DecodeKernel* avx512 = find_kernel("avx512");
+    REQUIRE(scalar != nullptr);
+
+    if (avx2 != nullptr)
+    {
+        // only the float permute and the popcount count are its own
+        REQUIRE(avx2->dense == scalar->dense);
+        REQUIRE(avx2->sparse == scalar->sparse);
+        REQUIRE(avx2->dense_mapped == scalar->dense_mapped);
+        REQUIRE(avx2->sparse_mapped == scalar->sparse_mapped);
+        REQUIRE(avx2->dense_mapped_f32 != scalar->dense_mapped_f32);
+        REQUIRE(avx2->sparse_mapped_f32 == scalar->sparse_mapped_f32);
+        REQUIRE(avx2->count != scalar->count);
+    }
+
+    if (avx512 != nullptr)
+    {
+        REQUIRE(avx2 != nullptr);
+        REQUIRE(avx512->dense != scalar->dense);
+        REQUIRE(avx512->sparse != scalar->sparse);
+        REQUIRE(avx512->dense_mapped != scalar->dense_mapped);
+        REQUIRE(avx512->sparse_mapped != scalar->sparse_mapped);
+        REQUIRE(avx512->sparse_mapped_f32 != scalar->sparse_mapped_f32);
+        // the AVX2 float permute beats the narrowed AVX-512 decode
+        REQUIRE(avx512->dense_mapped_f32 == avx2->dense_mapped_f32);
+        REQUIRE(avx512->count == avx2->count);
+    }
+
+    const std::string_view widest = avx512 != nullptr ? "avx512"
+                                    : avx2 != nullptr  ? "avx2"
+                                                       : "scalar";
+    REQUIRE(decode_kernel().name == widest);
+}
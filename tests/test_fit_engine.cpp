@@ -0,0 +1,302 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <Eigen/Core>
+
+#include "bed_fixture.h"
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/model/bayes/model.h"
+#include "gelex/pipeline/fit_engine.h"
+#include "gelex/pipeline/geno_pipe.h"
+#include "gelex/pipeline/pheno_pipe.h"
+#include "gelex/pipeline/predict/predict_engine.h"
+#include "gelex/types/sample_id.h"
+#include "pipeline/fit_detail.h"
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using Eigen::Index;
+using gelex::test::BedFixture;
+
+namespace
+{
+
+constexpr Index kTrainSamples = 40;
+constexpr Index kTargetSamples = 12;
+constexpr Index kSnps = 20;
+
+auto random_genotypes(Index rows, double freq, std::mt19937_64& rng)
+    -> Eigen::MatrixXd
+{
+    std::binomial_distribution<int> allele(2, freq);
+    Eigen::MatrixXd genotypes(rows, kSnps);
+    for (Index j = 0; j < kSnps; ++j)
+    {
+        for (Index i = 0; i < rows; ++i)
+        {
+            genotypes(i, j) = allele(rng);
+        }
+    }
+    return genotypes;
+}
+
+auto sample_ids(std::string_view stem, Index n) -> std::vector<std::string>
+{
+    std::vector<std::string> ids;
+    for (Index i = 0; i < n; ++i)
+    {
+        ids.push_back(std::format("{}{:02d}", stem, i));
+    }
+    return ids;
+}
+
+// Training and target BED files sharing one SNP panel. The target allele
+// frequency differs from the training one, so standardizing the targets
+// with their own statistics would give different scores. Genotypes use the
+// fit default, OrthStandardizeHWE, whose dominance coding `predict` assumes.
+class FitPredictFixture
+{
+   public:
+    FitPredictFixture()
+    {
+        std::mt19937_64 rng(17);
+        std::normal_distribution<double> normal;
+
+        std::vector<std::string> snp_ids;
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            snp_ids.push_back(std::format("rs{}", j + 1));
+        }
+        const std::vector<std::string> chroms(kSnps, "1");
+        const std::vector<std::pair<char, char>> alleles(kSnps, {'A', 'G'});
+
+        train_genotypes_ = random_genotypes(kTrainSamples, 0.3, rng);
+        const auto train_ids = sample_ids("train", kTrainSamples);
+        train_prefix_ = bed_.create_deterministic_bed_files(
+                                train_genotypes_,
+                                train_ids,
+                                snp_ids,
+                                chroms,
+                                alleles)
+                            .first;
+
+        target_genotypes_ = random_genotypes(kTargetSamples, 0.6, rng);
+        target_prefix_ = bed_.create_deterministic_bed_files(
+                                 target_genotypes_,
+                                 sample_ids("target", kTargetSamples),
+                                 snp_ids,
+                                 chroms,
+                                 alleles)
+                             .first;
+
+        Eigen::VectorXd effects(kSnps);
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            effects(j) = 0.5 * normal(rng);
+        }
+        const Eigen::VectorXd y = train_genotypes_ * effects;
+        std::string content = "FID\tIID\tPhenotype\n";
+        for (Index i = 0; i < kTrainSamples; ++i)
+        {
+            content += std::format(
+                "fam{}\t{}\t{}\n",
+                (i % 5) + 1,
+                train_ids[static_cast<size_t>(i)],
+                y(i) + normal(rng));
+        }
+        pheno_path_
+            = bed_.get_file_fixture().create_text_file(content, ".phen");
+    }
+
+    auto pheno_pipe() const -> PhenoPipe
+    {
+        PhenoPipe pheno(
+            PhenoPipe::Config{
+                .phenotype_path = pheno_path_,
+                .phenotype_column = 2,
+                .bed_path = train_prefix_,
+            });
+        pheno.load();
+        return pheno;
+    }
+
+    auto geno_pipe(PhenoPipe& pheno, ModelType model_type) const -> GenoPipe
+    {
+        GenoPipe geno(
+            GenoPipe::Config{
+                .bed_path = train_prefix_,
+                .model_type = model_type,
+                .genotype_method = GenotypeProcessMethod::OrthStandardizeHWE,
+            });
+        geno.load(pheno.sample_manager());
+        return geno;
+    }
+
+    auto out_prefix() -> std::string
+    {
+        return bed_.get_file_fixture().generate_random_file_path().string();
+    }
+
+    const Eigen::MatrixXd& train_genotypes() const { return train_genotypes_; }
+    const Eigen::MatrixXd& target_genotypes() const
+    {
+        return target_genotypes_;
+    }
+    const std::filesystem::path& train_prefix() const { return train_prefix_; }
+    const std::filesystem::path& target_prefix() const
+    {
+        return target_prefix_;
+    }
+
+   private:
+    BedFixture bed_;
+    Eigen::MatrixXd train_genotypes_;
+    Eigen::MatrixXd target_genotypes_;
+    std::filesystem::path train_prefix_;
+    std::filesystem::path target_prefix_;
+    std::filesystem::path pheno_path_;
+};
+
+// IID and posterior mean of every row of a .gebv file.
+auto read_gebv(const std::filesystem::path& path)
+    -> std::pair<std::vector<std::string>, std::vector<double>>
+{
+    std::vector<std::string> iids;
+    std::vector<double> means;
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string fid;
+        std::string iid;
+        double mean = 0.0;
+        fields >> fid >> iid >> mean;
+        iids.push_back(iid);
+        means.push_back(mean);
+    }
+    return {std::move(iids), std::move(means)};
+}
+
+}  // namespace
+
+TEST_CASE(
+    "load_target_genotypes standardizes with the training statistics",
+    "[pipeline][fit][predict]")
+{
+    const FitPredictFixture data;
+    auto pheno = data.pheno_pipe();
+    auto geno = data.geno_pipe(pheno, ModelType::A);
+    const BayesModel model(pheno, geno);
+
+    const auto target = detail::load_target_genotypes(
+        format_bed_path(data.target_prefix().string()),
+        variant_info_path(format_bed_path(data.train_prefix().string())),
+        {},
+        model,
+        GenotypeProcessMethod::OrthStandardizeHWE);
+
+    REQUIRE(target.sample_ids.size() == static_cast<size_t>(kTargetSamples));
+    REQUIRE(target.additive.rows() == kTargetSamples);
+    REQUIRE(target.additive.cols() == kSnps);
+    REQUIRE(target.dominant.size() == 0);
+
+    // rows follow the sorted sample IDs, not the order of the .fam file
+    const auto iids = sample_ids("target", kTargetSamples);
+    for (Index row = 0; row < kTargetSamples; ++row)
+    {
+        const auto iid
+            = split_sample_id(target.sample_ids[static_cast<size_t>(row)])
+                  .second;
+        const auto i = std::ranges::find(iids, iid) - iids.begin();
+        REQUIRE(i < kTargetSamples);
+        for (Index j = 0; j < kSnps; ++j)
+        {
+            const double p = data.train_genotypes().col(j).mean() / 2.0;
+            const double sd = std::sqrt(2.0 * p * (1.0 - p));
+            const double expected
+                = (data.target_genotypes()(i, j) - (2.0 * p)) / sd;
+            REQUIRE_THAT(
+                target.additive(row, j), WithinAbs(expected, 1e-10));
+        }
+    }
+}
+
+TEST_CASE(
+    "FitEngine - in-chain target GEBVs match predict on the posterior means",
+    "[pipeline][fit][predict]")
+{
+    const auto [method, model_type] = GENERATE(
+        std::pair{BayesAlphabet::RR, ModelType::A},
+        std::pair{BayesAlphabet::RRd, ModelType::AD});
+
+    FitPredictFixture data;
+    const std::string out_prefix = data.out_prefix();
+    FitEngine::Config config{
+        .bfile_prefix = data.train_prefix().string(),
+        .method = method,
+        .seed = 7,
+        .mcmc_params = MCMCParams(80, 20, 2),
+        .out_prefix = out_prefix,
+        .predict_bed_path = format_bed_path(data.target_prefix().string()),
+        .genotype_method = GenotypeProcessMethod::OrthStandardizeHWE,
+    };
+    {
+        auto pheno = data.pheno_pipe();
+        auto geno = data.geno_pipe(pheno, model_type);
+        FitEngine(config).run(std::move(pheno), std::move(geno));
+    }
+    const auto [iids, chain_gebv] = read_gebv(out_prefix + ".gebv");
+    REQUIRE(chain_gebv.size() == static_cast<size_t>(kTargetSamples));
+
+    PredictEngine predict(
+        PredictEngine::Config{
+            .bed_path = data.target_prefix(),
+            .snp_effect_path = out_prefix + ".snp.eff",
+            .covar_effect_path = out_prefix + ".params",
+            .qcovar_path = "",
+            .dcovar_path = "",
+            .output_path = out_prefix + ".predict",
+        });
+    predict.run();
+
+    // .snp.eff and .gebv keep six decimals, which bounds the agreement.
+    const auto& predicted = predict.snp_predictions();
+    REQUIRE(predicted.size() == kTargetSamples);
+    for (Index i = 0; i < kTargetSamples; ++i)
+    {
+        const auto row = static_cast<size_t>(i);
+        REQUIRE(predict.sample_ids()[row].ends_with(iids[row]));
+        REQUIRE_THAT(chain_gebv[row], WithinAbs(predicted(i), 1e-4));
+    }
+}
@@ -15,6 +15,7 @@
  */
 
 #include <fstream>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -293,4 +294,32 @@ TEST_CASE(
             }
         }
     }
+
+    SECTION("Scenario E: Unmatched model SNPs use the fill value")
+    {
+        FileFixture file_fixture;
+
+        std::string bim_content = "1\trs001\t0\t1000\tA\tC\n";
+        auto bim_path = file_fixture.create_text_file(bim_content, ".bim");
+        auto bed_prefix = bim_path;
+        bed_prefix.replace_extension("");
+
+        auto snp_effects = create_snp_effects(
+            file_fixture,
+            "Chrom\tPosition\tID\tA1\tA2\tA1Freq\tAdd\tDom",
+            {"1\t1000\trs001\tA\tC\t0.25\t0.123\t0.045",
+             "1\t2000\trs002\tT\tG\t0.75\t-0.456\t0.089"});
+
+        Eigen::MatrixXd genotypes(2, 1);
+        genotypes << 1.0, 2.0;
+
+        GenotypeAligner aligner(bed_prefix, snp_effects);
+        Eigen::MatrixXd filtered = aligner.align(
+            std::move(genotypes), std::numeric_limits<double>::quiet_NaN());
+
+        REQUIRE(filtered.cols() == 2);
+        REQUIRE(filtered(0, 0) == 1.0);
+        REQUIRE(filtered(1, 0) == 2.0);
+        REQUIRE(filtered.col(1).array().isNaN().all());
+    }
 }
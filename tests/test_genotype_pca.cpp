@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "bed_fixture.h"
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/grm/genotype_pca.h"
+#include "gelex/data/grm/grm.h"
+#include "gelex/exception.h"
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+using gelex::test::BedFixture;
+
+namespace
+{
+
+// Three populations of 20 with their own allele frequencies, so the top two
+// eigenvalues stand clear of the rest.
+auto make_structured_genotypes() -> Eigen::MatrixXd
+{
+    constexpr Eigen::Index kSamples = 60;
+    constexpr Eigen::Index kSnps = 400;
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> base(0.2, 0.8);
+    std::normal_distribution<double> drift(0.0, 0.15);
+
+    Eigen::MatrixXd genotypes(kSamples, kSnps);
+    for (Eigen::Index j = 0; j < kSnps; ++j)
+    {
+        const double p = base(rng);
+        for (Eigen::Index pop = 0; pop < 3; ++pop)
+        {
+            const double freq = std::clamp(p + drift(rng), 0.02, 0.98);
+            std::binomial_distribution<int> dosage(2, freq);
+            for (Eigen::Index i = pop * 20; i < (pop + 1) * 20; ++i)
+            {
+                genotypes(i, j) = dosage(rng);
+            }
+        }
+    }
+    return genotypes;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "GenotypePca matches the eigendecomposition of the GRM",
+    "[grm][pca]")
+{
+    BedFixture fixture;
+    const auto bed_prefix
+        = fixture.create_deterministic_bed_files(make_structured_genotypes())
+              .first;
+    constexpr auto kMethod = GenotypeProcessMethod::StandardizeHWE;
+    constexpr Eigen::Index kComponents = 4;
+
+    GRM grm(bed_prefix);
+    const auto dense = grm.compute<GeneticEffectType::Add>(kMethod, 64);
+    const Eigen::MatrixXd full
+        = Eigen::MatrixXd(dense.grm.selfadjointView<Eigen::Lower>())
+          / dense.denominator;
+    const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> exact(full);
+    const Eigen::Index n = full.rows();
+
+    GenotypePca pca(bed_prefix);
+    const auto result = pca.compute(
+        kMethod,
+        GenotypePca::Options{
+            .num_components = kComponents, .max_iter = 200, .tol = 1e-10},
+        37);
+
+    REQUIRE(result.converged);
+    REQUIRE(result.eigenvalues.size() == kComponents);
+    REQUIRE(result.eigenvectors.rows() == n);
+    REQUIRE(result.eigenvectors.cols() == kComponents);
+    for (Eigen::Index j = 0; j < kComponents; ++j)
+    {
+        REQUIRE_THAT(
+            result.eigenvalues(j),
+            WithinRel(exact.eigenvalues()(n - 1 - j), 1e-8));
+        const double alignment = result.eigenvectors.col(j).dot(
+            exact.eigenvectors().col(n - 1 - j));
+        REQUIRE_THAT(std::abs(alignment), WithinAbs(1.0, 1e-8));
+
+        Eigen::Index largest = 0;
+        result.eigenvectors.col(j).cwiseAbs().maxCoeff(&largest);
+        REQUIRE(result.eigenvectors(largest, j) > 0.0);
+    }
+    // the populations separate on the first component
+    REQUIRE(result.eigenvalues(1) > 2.0 * result.eigenvalues(2));
+}
+
+TEST_CASE("GenotypePca is reproducible", "[grm][pca]")
+{
+    BedFixture fixture;
+    const auto bed_prefix
+        = fixture.create_deterministic_bed_files(make_structured_genotypes())
+              .first;
+    const GenotypePca::Options options{.num_components = 3, .max_iter = 3};
+
+    GenotypePca pca(bed_prefix);
+    const auto method = GenotypeProcessMethod::Standardize;
+    const auto first = pca.compute(method, options, 50);
+    const auto again = pca.compute(method, options, 50);
+    REQUIRE(first.iterations == 3);
+    REQUIRE(first.eigenvectors == again.eigenvectors);
+    REQUIRE(first.eigenvalues == again.eigenvalues);
+}
+
+TEST_CASE("GenotypePca validates its options", "[grm][pca]")
+{
+    BedFixture fixture;
+    const auto bed_prefix = fixture.create_bed_files(10, 5, 0.0).first;
+    GenotypePca pca(bed_prefix);
+    const auto method = GenotypeProcessMethod::Standardize;
+
+    REQUIRE_THROWS_AS(
+        pca.compute(method, {.num_components = 0}, 10),
+        ArgumentValidationException);
+    // at most min(samples, variants) components
+    REQUIRE_THROWS_AS(
+        pca.compute(method, {.num_components = 6}, 10),
+        ArgumentValidationException);
+    REQUIRE_THROWS_AS(
+        pca.compute(method, {.num_components = 2, .max_iter = 0}, 10),
+        ArgumentValidationException);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+
+#include "bed_fixture.h"
+#include "gelex/data/genotype/genotype_pipe.h"
+#include "gelex/data/genotype/sample_manager.h"
+
+namespace fs = std::filesystem;
+
+using namespace gelex;  // NOLINT
+using gelex::test::BedFixture;
+
+TEST_CASE(
+    "GenotypePipe - preprocessing cache is reused only on a matching key",
+    "[data][genotype_pipe]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes] = fixture.create_bed_files(12, 30);
+    auto sample_manager = SampleManager::create_finalized(bed_prefix);
+    const auto out = fixture.get_file_fixture().generate_random_file_path();
+
+    Eigen::MatrixXd first;
+    {
+        GenotypePipe pipe(bed_prefix, sample_manager, out);
+        auto map = pipe.process<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Standardize);
+        REQUIRE_FALSE(pipe.reused_cache());
+        first = map.matrix();
+    }
+
+    auto with_suffix = [&](std::string_view suffix)
+    {
+        auto path = out;
+        path += suffix;
+        return path;
+    };
+    REQUIRE(fs::exists(with_suffix(".bmat")));
+    REQUIRE(fs::exists(with_suffix(".snpstats")));
+    REQUIRE(fs::exists(with_suffix(".cache")));
+    REQUIRE_FALSE(fs::exists(with_suffix(".bmat.tmp")));
+
+    SECTION("Same inputs reuse the cached matrix")
+    {
+        GenotypePipe pipe(bed_prefix, sample_manager, out);
+        auto map = pipe.process<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Standardize);
+        REQUIRE(pipe.reused_cache());
+        REQUIRE(map.matrix().isApprox(first));
+    }
+
+    SECTION("A different method regenerates the cache")
+    {
+        GenotypePipe pipe(bed_prefix, sample_manager, out);
+        auto map = pipe.process<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Center);
+        REQUIRE_FALSE(pipe.reused_cache());
+
+        GenotypePipe again(bed_prefix, sample_manager, out);
+        static_cast<void>(again.process<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Center));
+        REQUIRE(again.reused_cache());
+    }
+
+    SECTION("A different effect type regenerates the cache")
+    {
+        GenotypePipe pipe(bed_prefix, sample_manager, out);
+        static_cast<void>(pipe.process<GeneticEffectType::Dom>(
+            GenotypeProcessMethod::Standardize));
+        REQUIRE_FALSE(pipe.reused_cache());
+    }
+
+    SECTION("A corrupted cache key is treated as stale")
+    {
+        std::ofstream(with_suffix(".cache"), std::ios::trunc) << "garbage";
+
+        GenotypePipe pipe(bed_prefix, sample_manager, out);
+        auto map = pipe.process<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Standardize);
+        REQUIRE_FALSE(pipe.reused_cache());
+        REQUIRE(map.matrix().isApprox(first));
+    }
+}
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <array>
 #include <cmath>
 #include <initializer_list>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include "gelex/data/genotype/genotype_processor.h"
@@ -268,3 +271,68 @@ TEST_CASE("OrthStandardizeHWE<Dom> uses [0,2p,4p-2] HWE moments", "[data]")
          -0.32 / expected_stddev});
     require_vector_within_rel(variant, expected);
 }
+
+namespace
+{
+
+// Runs both the column processor and the code-count planner of `method`
+// on a locus given as 2-bit codes and checks they agree.
+template <GeneticEffectType GT>
+auto require_plan_matches_process(
+    GenotypeProcessMethod method,
+    const std::vector<uint8_t>& codes) -> void
+{
+    Eigen::VectorXd locus(static_cast<Eigen::Index>(codes.size()));
+    GenotypeCodeCounts counts{};
+    for (size_t i = 0; i < codes.size(); ++i)
+    {
+        locus(static_cast<Eigen::Index>(i)) = kGenotypeDosages[codes[i]];
+        ++counts[codes[i]];
+    }
+
+    const auto expected = get_genotype_process_method<GT>(method)(locus);
+    const auto plan = get_genotype_planner<GT>(method)(counts);
+
+    REQUIRE(plan.stats.is_monomorphic == expected.is_monomorphic);
+    REQUIRE_THAT(plan.stats.maf, WithinAbs(expected.maf, k_tolerance));
+    REQUIRE_THAT(plan.stats.mean, WithinAbs(expected.mean, k_tolerance));
+    REQUIRE_THAT(plan.stats.stddev, WithinAbs(expected.stddev, k_tolerance));
+    for (size_t i = 0; i < codes.size(); ++i)
+    {
+        const double value = plan.values[codes[i]];
+        const double reference = locus(static_cast<Eigen::Index>(i));
+        if (std::isnan(reference))
+        {
+            REQUIRE(std::isnan(value));
+        }
+        else
+        {
+            REQUIRE_THAT(value, WithinAbs(reference, 1e-9));
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Planner matches the column processor for every method", "[data]")
+{
+    const auto method = GENERATE(
+        GenotypeProcessMethod::StandardizeHWE,
+        GenotypeProcessMethod::CenterHWE,
+        GenotypeProcessMethod::OrthStandardizeHWE,
+        GenotypeProcessMethod::OrthCenterHWE,
+        GenotypeProcessMethod::Standardize,
+        GenotypeProcessMethod::Center,
+        GenotypeProcessMethod::OrthStandardize,
+        GenotypeProcessMethod::OrthCenter);
+
+    const auto codes = GENERATE(
+        std::vector<uint8_t>{0, 2, 3, 2, 1, 0, 3, 3, 2, 2},
+        std::vector<uint8_t>{3, 3, 1, 3, 3},
+        std::vector<uint8_t>{0, 0, 0, 2, 2},
+        std::vector<uint8_t>{1, 1, 1});
+
+    INFO("method " << static_cast<int>(method));
+    require_plan_matches_process<GeneticEffectType::Add>(method, codes);
+    require_plan_matches_process<GeneticEffectType::Dom>(method, codes);
+}
@@ -17,21 +17,25 @@
 #include <cmath>
 #include <filesystem>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Core>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include "bed_fixture.h"
 #include "gelex/data/genotype/genotype_processor.h"
 #include "gelex/data/grm/grm.h"
+#include "gelex/exception.h"
 
 namespace fs = std::filesystem;
 
 using namespace gelex;  // NOLINT
 using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
 using gelex::test::are_matrices_equal;
 using gelex::test::BedFixture;
 
@@ -393,3 +397,345 @@ TEST_CASE("GRM - numerical correctness", "[grm][compute][numerical]")
         }
     }
 }
+
+// ============================================================================
+// Grouped (LOCO) computation tests
+// ============================================================================
+
+TEST_CASE("GRM - compute_groups() matches per-group passes", "[grm][loco]")
+{
+    BedFixture fixture;
+    const Eigen::Index num_snps = 23;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(12, num_snps, 0.0, 0.05, 0.5, 7);
+
+    using Ranges = std::vector<std::pair<Eigen::Index, Eigen::Index>>;
+    const std::vector<Ranges> groups{{{0, 9}}, {{9, 9}}, {{9, 16}}, {{16, 23}}};
+
+    GRM reference(bed_prefix);
+    std::vector<Eigen::MatrixXd> expected;
+    for (const auto& group : groups)
+    {
+        expected.push_back(
+            reference
+                .compute<GeneticEffectType::Add>(
+                    GenotypeProcessMethod::Standardize, group, 4)
+                .grm);
+    }
+    const auto whole = reference.compute<GeneticEffectType::Add>(
+        GenotypeProcessMethod::Standardize, 4);
+
+    GRM grm(bed_prefix);
+    std::vector<size_t> seen;
+    const auto result = grm.compute_groups<GeneticEffectType::Add>(
+        GenotypeProcessMethod::Standardize,
+        groups,
+        4,
+        [&](size_t group, Eigen::MatrixXd& numerator)
+        {
+            seen.push_back(group);
+            Eigen::MatrixXd lower
+                = numerator.triangularView<Eigen::Lower>();
+            Eigen::MatrixXd reference_lower
+                = expected[group].triangularView<Eigen::Lower>();
+            REQUIRE(are_matrices_equal(lower, reference_lower, 1e-10));
+            // a sink may keep the buffer and leave an empty one behind
+            Eigen::MatrixXd taken;
+            taken.swap(numerator);
+        });
+
+    REQUIRE(seen == std::vector<size_t>{0, 1, 2, 3});
+    Eigen::MatrixXd lower = result.grm.triangularView<Eigen::Lower>();
+    Eigen::MatrixXd whole_lower = whole.grm.triangularView<Eigen::Lower>();
+    REQUIRE(are_matrices_equal(lower, whole_lower, 1e-10));
+    REQUIRE_THAT(result.denominator, WithinAbs(whole.denominator, 1e-10));
+
+    const std::vector<Ranges> overlapping{{{0, 10}}, {{5, 23}}};
+    REQUIRE_THROWS_AS(
+        grm.compute_groups<GeneticEffectType::Add>(
+            GenotypeProcessMethod::Standardize,
+            overlapping,
+            4,
+            [](size_t, Eigen::MatrixXd&) {}),
+        ArgumentValidationException);
+}
+
+TEST_CASE("GRM - mixed precision tracks double", "[grm][compute][precision]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(40, 120, 0.0, 0.05, 0.5, 11);
+
+    GRM reference(bed_prefix);
+    const auto expected = reference.compute<GeneticEffectType::Add>(
+        GenotypeProcessMethod::OrthStandardizeHWE, 16);
+
+    GRM grm(bed_prefix);
+    grm.set_precision(GrmPrecision::Mixed);
+    const auto result = grm.compute<GeneticEffectType::Add>(
+        GenotypeProcessMethod::OrthStandardizeHWE, 16);
+
+    Eigen::MatrixXd lower = result.grm.triangularView<Eigen::Lower>();
+    Eigen::MatrixXd expected_lower
+        = expected.grm.triangularView<Eigen::Lower>();
+    const double scale = expected_lower.cwiseAbs().maxCoeff();
+    REQUIRE((lower - expected_lower).cwiseAbs().maxCoeff() < 1e-5 * scale);
+    REQUIRE_THAT(
+        result.denominator, WithinRel(expected.denominator, 1e-6));
+}
+
+namespace
+{
+
+template <GeneticEffectType GT>
+auto require_packed_matches_dense(
+    const fs::path& bed_prefix,
+    GenotypeProcessMethod method) -> PackedKernelUsage
+{
+    GRM reference(bed_prefix);
+    const GrmResult expected = reference.compute<GT>(method, 18);
+
+    GRM grm(bed_prefix);
+    grm.set_kernel(GrmKernel::Packed);
+    const GrmResult result = grm.compute<GT>(method, 18);
+
+    Eigen::MatrixXd lower = result.grm.triangularView<Eigen::Lower>();
+    Eigen::MatrixXd expected_lower
+        = expected.grm.triangularView<Eigen::Lower>();
+    const double scale = expected_lower.cwiseAbs().maxCoeff();
+    REQUIRE((lower - expected_lower).cwiseAbs().maxCoeff() < 1e-12 * scale);
+    REQUIRE_THAT(result.denominator, WithinRel(expected.denominator, 1e-12));
+
+    const PackedKernelUsage usage = grm.packed_usage();
+    REQUIRE(usage.bitwise + usage.expanded == grm.num_snps());
+    return usage;
+}
+
+}  // namespace
+
+TEST_CASE("GRM - packed kernel matches dense", "[grm][compute][packed]")
+{
+    BedFixture fixture;
+    // 37 samples and 18-SNP chunks leave partial bytes on both axes
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(37, 101, 0.05, 0.05, 0.5, 23);
+
+    // Standardized values are never integer levels, so every variant is
+    // expanded. Centered ones take the popcount path unless they have a
+    // missing call: at 5% missingness both paths see variants.
+    SECTION("additive, standardized")
+    {
+        const auto usage = require_packed_matches_dense<GeneticEffectType::Add>(
+            bed_prefix, GenotypeProcessMethod::OrthStandardizeHWE);
+        REQUIRE(usage.bitwise == 0);
+    }
+
+    SECTION("additive, centered")
+    {
+        const auto method = GENERATE(
+            GenotypeProcessMethod::Center,
+            GenotypeProcessMethod::CenterHWE,
+            GenotypeProcessMethod::OrthCenter);
+        const auto usage = require_packed_matches_dense<GeneticEffectType::Add>(
+            bed_prefix, method);
+        REQUIRE(usage.bitwise > 0);
+        REQUIRE(usage.expanded > 0);
+    }
+
+    SECTION("dominance, standardized")
+    {
+        const auto usage = require_packed_matches_dense<GeneticEffectType::Dom>(
+            bed_prefix, GenotypeProcessMethod::OrthStandardizeHWE);
+        REQUIRE(usage.bitwise == 0);
+    }
+
+    SECTION("dominance, centered")
+    {
+        const auto usage = require_packed_matches_dense<GeneticEffectType::Dom>(
+            bed_prefix, GenotypeProcessMethod::CenterHWE);
+        REQUIRE(usage.bitwise > 0);
+    }
+}
+
+TEST_CASE(
+    "GRM - packed kernel without missing calls",
+    "[grm][compute][packed]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(37, 101, 0.0, 0.05, 0.5, 29);
+
+    const auto usage = require_packed_matches_dense<GeneticEffectType::Add>(
+        bed_prefix, GenotypeProcessMethod::CenterHWE);
+    REQUIRE(usage.bitwise == 101);
+}
+
+TEST_CASE(
+    "GRM - additive and dominance from one pass",
+    "[grm][compute][add_dom]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(30, 75, 0.05, 0.05, 0.5, 31);
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{
+        {0, 40}, {50, 75}};
+    const auto method = GenotypeProcessMethod::OrthStandardizeHWE;
+
+    GRM reference(bed_prefix);
+    const auto additive = reference.compute<GeneticEffectType::Add>(
+        method, ranges, 16);
+    const auto dominance = reference.compute<GeneticEffectType::Dom>(
+        method, ranges, 16);
+
+    auto require_close = [](const GrmResult& result, const GrmResult& expected)
+    {
+        Eigen::MatrixXd lower = result.grm.triangularView<Eigen::Lower>();
+        Eigen::MatrixXd expected_lower
+            = expected.grm.triangularView<Eigen::Lower>();
+        REQUIRE(are_matrices_equal(lower, expected_lower, 1e-10));
+        REQUIRE_THAT(
+            result.denominator, WithinRel(expected.denominator, 1e-10));
+    };
+
+    SECTION("dense")
+    {
+        GRM grm(bed_prefix);
+        const auto [add, dom] = grm.compute_add_dom(method, ranges, 16);
+        require_close(add, additive);
+        require_close(dom, dominance);
+    }
+
+    SECTION("packed")
+    {
+        GRM grm(bed_prefix);
+        grm.set_kernel(GrmKernel::Packed);
+        const auto [add, dom] = grm.compute_add_dom(method, ranges, 16);
+        require_close(add, additive);
+        require_close(dom, dominance);
+    }
+
+    SECTION("mixed precision, decoded straight to float")
+    {
+        GRM grm(bed_prefix);
+        grm.set_precision(GrmPrecision::Mixed);
+        const auto [add, dom] = grm.compute_add_dom(method, ranges, 16);
+        for (const auto& [result, expected] :
+             {std::pair{&add, &additive}, std::pair{&dom, &dominance}})
+        {
+            Eigen::MatrixXd lower
+                = result->grm.triangularView<Eigen::Lower>();
+            Eigen::MatrixXd expected_lower
+                = expected->grm.triangularView<Eigen::Lower>();
+            const double scale = expected_lower.cwiseAbs().maxCoeff();
+            REQUIRE(
+                (lower - expected_lower).cwiseAbs().maxCoeff()
+                < 1e-5 * scale);
+        }
+    }
+}
+
+TEST_CASE("GRM - parts assemble the whole matrix", "[grm][compute][part]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(29, 60, 0.05, 0.05, 0.5, 43);
+    const auto method = GenotypeProcessMethod::OrthStandardizeHWE;
+    const int num_parts = 3;
+
+    GRM reference(bed_prefix);
+    const auto whole
+        = reference.compute<GeneticEffectType::Add>(method, 16);
+    const Eigen::MatrixXd expected = whole.grm.triangularView<Eigen::Lower>();
+
+    const auto kernel = GENERATE(GrmKernel::Dense, GrmKernel::Packed);
+    double denominator = 0.0;
+    for (int index = 1; index <= num_parts; ++index)
+    {
+        const auto part = balanced_grm_part(29, index, num_parts);
+        GRM grm(bed_prefix);
+        grm.set_kernel(kernel);
+        grm.set_part(part);
+        const auto result = grm.compute<GeneticEffectType::Add>(method, 16);
+
+        REQUIRE(result.grm.rows() == part.num_rows());
+        REQUIRE(result.grm.cols() == part.row_end);
+        Eigen::MatrixXd rows = result.grm;
+        rows.rightCols(part.num_rows())
+            .triangularView<Eigen::StrictlyUpper>()
+            .setZero();
+        Eigen::MatrixXd expected_rows = expected.block(
+            part.row_begin, 0, part.num_rows(), part.row_end);
+        REQUIRE(are_matrices_equal(rows, expected_rows, 1e-10));
+        denominator += result.denominator;
+    }
+    REQUIRE_THAT(denominator, WithinRel(whole.denominator, 1e-12));
+
+    GRM loco(bed_prefix);
+    loco.set_part(balanced_grm_part(29, 1, num_parts));
+    REQUIRE_THROWS_AS(
+        loco.compute_groups<GeneticEffectType::Add>(
+            method,
+            {{{0, 30}}, {{30, 60}}},
+            16,
+            [](size_t, Eigen::MatrixXd&) {}),
+        InvalidOperationException);
+    REQUIRE_THROWS_AS(
+        loco.set_part(GrmPart{10, 30}), ArgumentValidationException);
+}
+
+TEST_CASE("GRM - records the code counts it decodes", "[grm][compute]")
+{
+    BedFixture fixture;
+    auto [bed_prefix, genotypes]
+        = fixture.create_bed_files(30, 75, 0.1, 0.05, 0.5, 47);
+    const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{
+        {0, 40}, {50, 75}};
+    const auto method = GenotypeProcessMethod::OrthStandardizeHWE;
+
+    GRM unrecorded(bed_prefix);
+    REQUIRE(unrecorded.compute<GeneticEffectType::Add>(method, ranges, 16)
+                .code_counts.empty());
+
+    // the packed kernel counts while transposing, not while decoding
+    GRM packed(bed_prefix);
+    packed.set_kernel(GrmKernel::Packed);
+    packed.set_record_counts(true);
+    const auto expected
+        = packed.compute<GeneticEffectType::Add>(method, ranges, 16)
+              .code_counts;
+    REQUIRE(expected.size() == 65);
+    for (const auto& counts : expected)
+    {
+        REQUIRE(counts[0] + counts[1] + counts[2] + counts[3] == 30);
+    }
+
+    SECTION("dense")
+    {
+        GRM grm(bed_prefix);
+        grm.set_record_counts(true);
+        REQUIRE(
+            grm.compute<GeneticEffectType::Dom>(method, ranges, 16)
+                .code_counts
+            == expected);
+    }
+
+    SECTION("mixed precision")
+    {
+        GRM grm(bed_prefix);
+        grm.set_precision(GrmPrecision::Mixed);
+        grm.set_record_counts(true);
+        REQUIRE(
+            grm.compute<GeneticEffectType::Add>(method, ranges, 16)
+                .code_counts
+            == expected);
+    }
+
+    SECTION("additive and dominance")
+    {
+        GRM grm(bed_prefix);
+        grm.set_record_counts(true);
+        const auto [add, dom] = grm.compute_add_dom(method, ranges, 16);
+        REQUIRE(add.code_counts == expected);
+        REQUIRE(dom.code_counts.empty());
+    }
+}
@@ -219,6 +219,81 @@ TEST_CASE("GrmBinWriter - Write medium matrix", "[grm_bin_writer][basic]")
     }
 }
 
+TEST_CASE(
+    "GrmBinWriter - Write spans several stage blocks",
+    "[grm_bin_writer][basic]")
+{
+    FileFixture files;
+    auto file_path = files.generate_random_file_path(".grm.bin");
+
+    // n (n + 1) / 2 floats just past one stage
+    const Eigen::Index n = 2900;
+    REQUIRE(expected_file_size(n) / sizeof(float) > GrmBinWriter::kStageFloats);
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(n, n);
+
+    {
+        GrmBinWriter writer(file_path);
+        writer.write(matrix);
+    }
+
+    REQUIRE(fs::file_size(file_path) == expected_file_size(n));
+    auto values = read_grm_file(file_path, n);
+    bool matches = true;
+    size_t idx = 0;
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        for (Eigen::Index j = 0; j <= i; ++j)
+        {
+            matches = matches
+                      && values[idx++] == static_cast<float>(matrix(i, j));
+        }
+    }
+    REQUIRE(matches);
+}
+
+TEST_CASE(
+    "GrmBinWriter - Hadamard product of two GRMs",
+    "[grm_bin_writer][hadamard]")
+{
+    FileFixture files;
+    auto file_path = files.generate_random_file_path(".grm.bin");
+
+    // over one stage, so tiles and stage blocks both split the product
+    const Eigen::Index n = 2900;
+    const Eigen::MatrixXd left = Eigen::MatrixXd::Random(n, n);
+    const Eigen::MatrixXd right = Eigen::MatrixXd::Random(n, n);
+    const double scale = 0.25;
+
+    {
+        GrmBinWriter writer(file_path);
+        writer.write_hadamard(left, right, scale);
+    }
+
+    REQUIRE(fs::file_size(file_path) == expected_file_size(n));
+    auto values = read_grm_file(file_path, n);
+    bool matches = true;
+    size_t idx = 0;
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        for (Eigen::Index j = 0; j <= i; ++j)
+        {
+            matches = matches
+                      && values[idx++]
+                             == static_cast<float>(
+                                 scale * left(i, j) * right(i, j));
+        }
+    }
+    REQUIRE(matches);
+
+    SECTION("Exception - operands of different sizes")
+    {
+        GrmBinWriter writer(file_path);
+        REQUIRE_THROWS_AS(
+            writer.write_hadamard(left, right.topLeftCorner(3, 3), scale),
+            gelex::InvalidInputException);
+    }
+}
+
 // ============================================================================
 // Numerical verification tests
 // ============================================================================
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <Eigen/Core>
+
+#include "file_fixture.h"
+#include "gelex/data/grm/grm_bin_writer.h"
+#include "gelex/data/grm/grm_eigen.h"
+#include "gelex/data/grm/grm_id_writer.h"
+#include "gelex/exception.h"
+#include "gelex/types/sample_id.h"
+
+namespace fs = std::filesystem;
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using gelex::test::FileFixture;
+
+namespace
+{
+
+constexpr Eigen::Index kSamples = 12;
+
+// Z Z' of a random standardized-looking Z, as `grm` accumulates it.
+auto random_numerator() -> Eigen::MatrixXd
+{
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd z(kSamples, 40);
+    for (Eigen::Index j = 0; j < z.cols(); ++j)
+    {
+        for (Eigen::Index i = 0; i < z.rows(); ++i)
+        {
+            z(i, j) = normal(rng);
+        }
+    }
+    return z * z.transpose();
+}
+
+auto sample_ids() -> std::vector<std::string>
+{
+    std::vector<std::string> ids;
+    for (Eigen::Index i = 0; i < kSamples; ++i)
+    {
+        ids.push_back(
+            make_sample_id(
+                "FAM" + std::to_string(i), "IND" + std::to_string(i)));
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST_CASE("decompose_grm reconstructs the scaled GRM", "[grm][eigen]")
+{
+    const Eigen::MatrixXd numerator = random_numerator();
+    const Eigen::MatrixXd grm
+        = numerator / (numerator.trace() / static_cast<double>(kSamples));
+
+    const auto eigen = decompose_grm(numerator);
+
+    REQUIRE(eigen.values.size() == kSamples);
+    REQUIRE(eigen.vectors.rows() == kSamples);
+    REQUIRE(eigen.vectors.cols() == kSamples);
+    for (Eigen::Index k = 1; k < kSamples; ++k)
+    {
+        REQUIRE(eigen.values(k - 1) <= eigen.values(k));
+    }
+    REQUIRE_THAT(
+        eigen.values.sum(), WithinAbs(static_cast<double>(kSamples), 1e-9));
+
+    const Eigen::MatrixXd rebuilt = eigen.vectors
+                                    * eigen.values.asDiagonal()
+                                    * eigen.vectors.transpose();
+    for (Eigen::Index i = 0; i < kSamples; ++i)
+    {
+        for (Eigen::Index j = 0; j < kSamples; ++j)
+        {
+            REQUIRE_THAT(rebuilt(i, j), WithinAbs(grm(i, j), 1e-10));
+        }
+    }
+
+    SECTION("non-square input")
+    {
+        REQUIRE_THROWS_AS(
+            decompose_grm(Eigen::MatrixXd::Identity(3, 4)),
+            ArgumentValidationException);
+    }
+}
+
+TEST_CASE(
+    "GrmEigenLoader maps the decomposition next to the GRM",
+    "[grm][eigen]")
+{
+    FileFixture files;
+    const auto prefix = files.generate_random_file_path();
+    const Eigen::MatrixXd numerator = random_numerator();
+    const auto ids = sample_ids();
+    GrmBinWriter(fs::path(prefix.string() + ".bin")).write(numerator);
+    GrmIdWriter(fs::path(prefix.string() + ".id")).write(ids);
+    const auto eigen = decompose_grm(numerator);
+    write_grm_eigen(eigen, fs::path(prefix.string() + ".eig"));
+
+    const detail::GrmEigenLoader loader(prefix);
+    REQUIRE(loader.num_samples() == kSamples);
+    REQUIRE(loader.sample_ids() == ids);
+    REQUIRE(loader.eigenvalues().isApprox(eigen.values));
+    REQUIRE(loader.eigenvectors().isApprox(eigen.vectors));
+
+    SECTION("rows follow the analysed sample order")
+    {
+        std::unordered_map<std::string, Eigen::Index> id_map;
+        for (Eigen::Index i = 0; i < kSamples; ++i)
+        {
+            id_map.emplace(ids[static_cast<size_t>(i)], kSamples - 1 - i);
+        }
+
+        const auto loaded = loader.load(id_map);
+
+        REQUIRE(loaded.values.isApprox(eigen.values));
+        for (Eigen::Index i = 0; i < kSamples; ++i)
+        {
+            REQUIRE(loaded.vectors.row(kSamples - 1 - i)
+                        .isApprox(eigen.vectors.row(i)));
+        }
+    }
+
+    SECTION("a subset of the samples is rejected")
+    {
+        std::unordered_map<std::string, Eigen::Index> id_map;
+        for (Eigen::Index i = 0; i + 1 < kSamples; ++i)
+        {
+            id_map.emplace(ids[static_cast<size_t>(i)], i);
+        }
+        REQUIRE_THROWS_AS(loader.load(id_map), InvalidInputException);
+    }
+
+    SECTION("a file of another shape is rejected")
+    {
+        write_grm_eigen(
+            decompose_grm(numerator.topLeftCorner(4, 4)),
+            fs::path(prefix.string() + ".eig"));
+        REQUIRE_THROWS_AS(detail::GrmEigenLoader(prefix), FileFormatException);
+    }
+}
@@ -17,11 +17,14 @@
 #include <cmath>
 #include <cstddef>
 #include <filesystem>
+#include <fstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
@@ -31,6 +34,7 @@
 #include "gelex/data/grm/grm_bin_writer.h"
 #include "gelex/data/grm/grm_id_writer.h"
 #include "gelex/data/grm/grm_loader.h"
+#include "gelex/data/grm/sparse_grm_writer.h"
 #include "gelex/exception.h"
 
 namespace fs = std::filesystem;
@@ -253,6 +257,32 @@ TEST_CASE("GrmLoader - sample_ids accessor", "[grm_loader][accessor]")
     }
 }
 
+TEST_CASE("GrmLoader - type from the file name", "[grm_loader][accessor]")
+{
+    FileFixture files;
+    const auto matrix = make_symmetric_matrix(2);
+    const std::vector<std::string> ids
+        = {gelex::make_sample_id("FAM1", "IND1"),
+           gelex::make_sample_id("FAM2", "IND2")};
+
+    const std::vector<std::pair<std::string, gelex::freq::GrmType>> cases{
+        {".add", gelex::freq::GrmType::A},
+        {".dom", gelex::freq::GrmType::D},
+        {".aa", gelex::freq::GrmType::AA},
+        {".ad", gelex::freq::GrmType::AD},
+        {".dd", gelex::freq::GrmType::DD},
+        {".grm", gelex::freq::GrmType::Unknown},
+    };
+    for (const auto& [suffix, type] : cases)
+    {
+        const auto prefix = files.generate_random_file_path(suffix);
+        gelex::GrmBinWriter(fs::path(prefix.string() + ".bin")).write(matrix);
+        gelex::GrmIdWriter(fs::path(prefix.string() + ".id")).write(ids);
+
+        REQUIRE(GrmLoader(prefix).type() == type);
+    }
+}
+
 TEST_CASE("GrmLoader - num_samples accessor", "[grm_loader][accessor]")
 {
     FileFixture files;
@@ -640,6 +670,176 @@ TEST_CASE(
     }
 }
 
+TEST_CASE(
+    "GrmLoader - Permutation load matches the naive expansion",
+    "[grm_loader][permutation]")
+{
+    FileFixture files;
+    GrmFileFixture grm_files(files);
+
+    const Eigen::Index n = 150;
+    auto original = make_symmetric_matrix(n);
+    auto ids = make_sample_ids(n);
+    grm_files.create(original, ids);
+    GrmLoader loader(grm_files.prefix());
+
+    // every third sample dropped, the rest reversed and spread out
+    std::unordered_map<std::string, Eigen::Index> id_map;
+    std::vector<std::pair<Eigen::Index, Eigen::Index>> mapped;
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        if (i % 3 != 1)
+        {
+            id_map[ids[static_cast<size_t>(i)]] = 2 * (n - 1 - i);
+            mapped.emplace_back(i, 2 * (n - 1 - i));
+        }
+    }
+
+    const auto permutation = loader.permutation(id_map);
+    const Eigen::Index size = permutation.target_size;
+    REQUIRE(permutation.sources.size() == id_map.size());
+    REQUIRE(size == (2 * (n - 1)) + 1);
+
+    Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(size, size);
+    for (const auto& [s_i, t_i] : mapped)
+    {
+        for (const auto& [s_j, t_j] : mapped)
+        {
+            expected(t_i, t_j)
+                = static_cast<double>(static_cast<float>(original(s_i, s_j)));
+        }
+    }
+
+    Eigen::MatrixXd loaded;
+    loader.load_unnormalized(permutation, loaded);
+    REQUIRE(loaded == expected);
+    REQUIRE(loader.load_unnormalized(id_map) == expected);
+
+    // a second file with the same samples reuses the permutation
+    GrmFileFixture other_files(files);
+    Eigen::MatrixXd doubled = 2.0 * original;
+    other_files.create(doubled, ids);
+    GrmLoader other(other_files.prefix());
+    other.load_unnormalized(permutation, loaded);
+    REQUIRE(loaded == 2.0 * expected);
+
+    GrmFileFixture smaller_files(files);
+    smaller_files.create(make_symmetric_matrix(4), make_sample_ids(4));
+    REQUIRE_THROWS_AS(
+        GrmLoader(smaller_files.prefix())
+            .load_unnormalized(permutation, loaded),
+        gelex::InvalidInputException);
+}
+
+TEST_CASE("GrmLoader - Packed view", "[grm_loader][packed]")
+{
+    FileFixture files;
+    GrmFileFixture grm_files(files);
+
+    const Eigen::Index n = 5;
+    auto original = make_symmetric_matrix(n);
+    grm_files.create(original, make_sample_ids(n));
+    GrmLoader loader(grm_files.prefix());
+
+    REQUIRE(loader.packed().size() == static_cast<size_t>(n * (n + 1) / 2));
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        const auto row = loader.packed_row(i);
+        REQUIRE(row.size() == static_cast<size_t>(i + 1));
+        for (Eigen::Index j = 0; j <= i; ++j)
+        {
+            REQUIRE(
+                row[static_cast<size_t>(j)]
+                == static_cast<float>(original(i, j)));
+        }
+    }
+}
+
+TEST_CASE("GrmLoader - Sparse file", "[grm_loader][sparse]")
+{
+    FileFixture files;
+    const auto prefix = files.generate_random_file_path("");
+
+    // trace / n = 2; a 0.1 cutoff keeps (1, 0) and (3, 2) only
+    Eigen::MatrixXd original(4, 4);
+    original << 2.0, 0.5, 0.05, 0.1,  //
+        0.5, 1.5, -0.4, 0.0,          //
+        0.05, -0.4, 2.5, 0.3,         //
+        0.1, 0.0, 0.3, 2.0;
+    Eigen::MatrixXd kept = original;
+    kept(2, 0) = kept(0, 2) = 0.0;
+    kept(3, 0) = kept(0, 3) = 0.0;
+    kept(2, 1) = kept(1, 2) = 0.0;
+
+    auto ids = make_sample_ids(4);
+    {
+        gelex::SparseGrmWriter writer(fs::path(prefix.string() + ".sp.bin"));
+        writer.write(original, 0.1);
+        gelex::GrmIdWriter id_writer(fs::path(prefix.string() + ".id"));
+        id_writer.write(ids);
+    }
+
+    GrmLoader loader(prefix);
+    REQUIRE(loader.is_sparse());
+    REQUIRE(loader.num_sparse_entries() == 6);
+    REQUIRE(loader.packed().empty());
+
+    SECTION("dense load fills dropped pairs with zeros")
+    {
+        const Eigen::MatrixXd expected = kept.cast<float>().cast<double>();
+        REQUIRE(loader.load_unnormalized() == expected);
+        REQUIRE(loader.load().isApprox(kept / 2.0, 1e-6));
+    }
+
+    SECTION("sparse load matches the dense one under an id map")
+    {
+        std::unordered_map<std::string, Eigen::Index> id_map{
+            {ids[3], 0}, {ids[2], 1}, {ids[0], 2}};
+        const Eigen::MatrixXd dense = loader.load(id_map);
+        const Eigen::SparseMatrix<double> sparse = loader.load_sparse(id_map);
+
+        REQUIRE(sparse.rows() == 3);
+        REQUIRE(sparse.nonZeros() == 5);
+        REQUIRE(Eigen::MatrixXd(sparse).isApprox(dense, 1e-12));
+        REQUIRE(dense(1, 0) > 0.0);
+        REQUIRE(dense(2, 0) == 0.0);
+    }
+}
+
+TEST_CASE("GrmLoader - Malformed sparse file", "[grm_loader][sparse]")
+{
+    FileFixture files;
+    const auto prefix = files.generate_random_file_path("");
+    {
+        gelex::GrmIdWriter writer(fs::path(prefix.string() + ".id"));
+        writer.write(make_sample_ids(2));
+    }
+    const auto write_raw = [&](const void* data, size_t bytes)
+    {
+        std::ofstream file(prefix.string() + ".sp.bin", std::ios::binary);
+        file.write(
+            static_cast<const char*>(data),
+            static_cast<std::streamsize>(bytes));
+    };
+
+    SECTION("size not a whole number of entries")
+    {
+        const std::vector<char> bytes(13, 0);
+        write_raw(bytes.data(), bytes.size());
+        REQUIRE_THROWS_AS(GrmLoader(prefix), gelex::FileFormatException);
+    }
+
+    SECTION("entry above the diagonal")
+    {
+        const std::vector<gelex::SparseGrmEntry> entries{
+            {0, 0, 1.0F}, {0, 1, 0.5F}, {1, 1, 1.0F}};
+        write_raw(
+            entries.data(), entries.size() * sizeof(gelex::SparseGrmEntry));
+        GrmLoader loader(prefix);
+        REQUIRE_THROWS_AS(loader.load(), gelex::FileFormatException);
+    }
+}
+
 // ============================================================================
 // ID parsing tests
 // ============================================================================
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+
+#include "file_fixture.h"
+#include "gelex/data/grm/grm_bin_writer.h"
+#include "gelex/data/grm/grm_id_writer.h"
+#include "gelex/data/grm/grm_part.h"
+#include "gelex/exception.h"
+#include "gelex/types/sample_id.h"
+
+namespace fs = std::filesystem;
+
+using namespace gelex;  // NOLINT
+using gelex::test::FileFixture;
+
+namespace
+{
+
+auto read_bytes(const fs::path& path) -> std::string
+{
+    std::ifstream file(path, std::ios::binary);
+    return {
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>()};
+}
+
+auto entries(const GrmPart& part) -> Eigen::Index
+{
+    return (part.row_end * (part.row_end + 1) / 2)
+           - (part.row_begin * (part.row_begin + 1) / 2);
+}
+
+}  // namespace
+
+TEST_CASE("balanced_grm_part tiles the rows evenly", "[grm][part]")
+{
+    SECTION("large matrix")
+    {
+        const Eigen::Index n = 10'000;
+        const int num_parts = 7;
+        const Eigen::Index share = n * (n + 1) / 2 / num_parts;
+        Eigen::Index next = 0;
+        for (int index = 1; index <= num_parts; ++index)
+        {
+            const auto part = balanced_grm_part(n, index, num_parts);
+            REQUIRE(part.row_begin == next);
+            REQUIRE(part.num_rows() > 0);
+            // within one row's worth of entries of an equal share
+            REQUIRE(std::abs(entries(part) - share) <= 2 * n);
+            next = part.row_end;
+        }
+        REQUIRE(next == n);
+    }
+
+    SECTION("as many parts as samples")
+    {
+        for (int index = 1; index <= 3; ++index)
+        {
+            const auto part = balanced_grm_part(3, index, 3);
+            REQUIRE(part.row_begin == index - 1);
+            REQUIRE(part.row_end == index);
+        }
+    }
+
+    REQUIRE_THROWS_AS(balanced_grm_part(3, 1, 4), ArgumentValidationException);
+    REQUIRE_THROWS_AS(balanced_grm_part(10, 0, 2), ArgumentValidationException);
+}
+
+TEST_CASE("parse_grm_part", "[grm][part]")
+{
+    REQUIRE(parse_grm_part("3/10") == std::pair{3, 10});
+    REQUIRE(parse_grm_part("1/1") == std::pair{1, 1});
+    REQUIRE_THROWS_AS(parse_grm_part("0/4"), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_grm_part("5/4"), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_grm_part("3"), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_grm_part("a/4"), ArgumentValidationException);
+    REQUIRE(grm_part_prefix("out", 2, 5) == "out.part_5_2");
+}
+
+TEST_CASE("merge_grm_parts rebuilds the whole GRM files", "[grm][part]")
+{
+    FileFixture files;
+    const fs::path dir = files.get_test_dir();
+    const Eigen::Index n = 23;
+    const int num_parts = 4;
+
+    Eigen::MatrixXd grm = Eigen::MatrixXd::Random(n, n);
+    std::vector<std::string> ids;
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        ids.push_back(
+            make_sample_id("f" + std::to_string(i), "i" + std::to_string(i)));
+    }
+    GrmBinWriter(dir / "whole.bin").write(grm);
+    GrmIdWriter(dir / "whole.id").write(ids);
+
+    std::vector<fs::path> parts;
+    for (int index = 1; index <= num_parts; ++index)
+    {
+        const auto part = balanced_grm_part(n, index, num_parts);
+        const fs::path prefix
+            = dir / (grm_part_prefix("grm", index, num_parts) + ".add");
+        GrmBinWriter(fs::path(prefix) += ".bin")
+            .write_rows(grm.block(
+                part.row_begin, 0, part.num_rows(), part.row_end));
+        GrmIdWriter(fs::path(prefix) += ".id")
+            .write(
+                std::span(ids).subspan(
+                    static_cast<size_t>(part.row_begin),
+                    static_cast<size_t>(part.num_rows())));
+        parts.push_back(prefix);
+    }
+
+    SECTION("in order")
+    {
+        merge_grm_parts(parts, dir / "merged");
+        REQUIRE(
+            read_bytes(dir / "merged.bin") == read_bytes(dir / "whole.bin"));
+        REQUIRE(read_bytes(dir / "merged.id") == read_bytes(dir / "whole.id"));
+    }
+
+    SECTION("out of order or missing parts are rejected")
+    {
+        std::swap(parts[1], parts[2]);
+        REQUIRE_THROWS_AS(
+            merge_grm_parts(parts, dir / "merged"), FileFormatException);
+        parts.pop_back();
+        std::swap(parts[1], parts[2]);
+        REQUIRE_THROWS_AS(
+            merge_grm_parts({parts[0], parts[2]}, dir / "merged"),
+            FileFormatException);
+        REQUIRE_FALSE(fs::exists(dir / "merged.bin"));
+    }
+}
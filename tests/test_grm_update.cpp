@@ -0,0 +1,318 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <Eigen/Core>
+
+#include "bed_fixture.h"
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/genotype_processor.h"
+#include "gelex/data/grm/grm.h"
+#include "gelex/data/grm/grm_bin_writer.h"
+#include "gelex/data/grm/grm_id_writer.h"
+#include "gelex/data/grm/grm_loader.h"
+#include "gelex/data/grm/grm_loci.h"
+#include "gelex/data/grm/grm_update.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/exception.h"
+#include "gelex/pipeline/grm_engine.h"
+#include "gelex/types/sample_id.h"
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using gelex::test::BedFixture;
+
+namespace
+{
+
+constexpr Eigen::Index kOld = 24;
+constexpr Eigen::Index kNew = 9;
+constexpr Eigen::Index kSnps = 80;
+constexpr auto kMethod = GenotypeProcessMethod::OrthStandardizeHWE;
+
+auto code_of(double dosage) -> size_t
+{
+    if (std::isnan(dosage))
+    {
+        return kMissingGenotypeCode;
+    }
+    return dosage == 2.0 ? 0 : dosage == 1.0 ? 2 : 3;
+}
+
+// The old cohort's GRM written as `grm` does, plus the code values its run
+// applied, which a full run with fixed frequencies would use for everyone.
+struct UpdateFixture
+{
+    BedFixture fixture;
+    Eigen::MatrixXd genotypes{kOld + kNew, kSnps};
+    std::filesystem::path old_bed;
+    std::filesystem::path all_bed;
+    std::filesystem::path grm_prefix;
+    std::vector<std::string> snp_ids;
+    std::vector<std::pair<char, char>> alleles
+        = std::vector<std::pair<char, char>>(kSnps, {'A', 'G'});
+    std::vector<GenotypeCodeTable> tables;
+
+    UpdateFixture()
+    {
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> freq(0.1, 0.9);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (Eigen::Index j = 0; j < kSnps; ++j)
+        {
+            std::binomial_distribution<int> dosage(2, freq(rng));
+            for (Eigen::Index i = 0; i < genotypes.rows(); ++i)
+            {
+                genotypes(i, j)
+                    = unit(rng) < 0.03
+                          ? std::numeric_limits<double>::quiet_NaN()
+                          : dosage(rng);
+            }
+        }
+
+        for (Eigen::Index j = 0; j < kSnps; ++j)
+        {
+            snp_ids.push_back("rs" + std::to_string(j + 1));
+        }
+        old_bed = fixture
+                      .create_deterministic_bed_files(
+                          genotypes.topRows(kOld), {}, snp_ids, {}, alleles)
+                      .first;
+
+        // the new file lists the first variant with its alleles swapped,
+        // counting the other allele
+        Eigen::MatrixXd swapped = genotypes;
+        swapped.col(0) = 2.0 - swapped.col(0).array();
+        auto swapped_alleles = alleles;
+        swapped_alleles[0] = {'G', 'A'};
+        all_bed = fixture
+                      .create_deterministic_bed_files(
+                          swapped, {}, snp_ids, {}, swapped_alleles)
+                      .first;
+
+        GRM grm(old_bed);
+        grm.set_record_counts(true);
+        const std::vector<std::pair<Eigen::Index, Eigen::Index>> ranges{
+            {0, kSnps}};
+        const auto result = grm.compute<GeneticEffectType::Add>(
+            kMethod, ranges, 16);
+        grm_prefix = fixture.get_file_fixture().generate_random_file_path();
+        GrmBinWriter(path(".bin")).write(result.grm);
+        GrmIdWriter(path(".id")).write(grm.sample_ids());
+
+        std::vector<LocusPlan> plans(result.code_counts.size());
+        std::ranges::transform(
+            result.code_counts,
+            plans.begin(),
+            get_genotype_planner<GeneticEffectType::Add>(kMethod));
+        const auto snps
+            = detail::BimLoader(variant_info_path(old_bed)).take_info();
+        std::vector<SnpMeta> metas(snps.begin(), snps.end());
+        GrmLociWriter(path(".loci")).write(metas, plans);
+        for (const auto& plan : plans)
+        {
+            tables.push_back(plan.values);
+        }
+    }
+
+    [[nodiscard]] auto path(const char* extension) const
+        -> std::filesystem::path
+    {
+        auto file = grm_prefix;
+        file += extension;
+        return file;
+    }
+
+    // Z Z' of the given samples under the old run's encoding.
+    [[nodiscard]] auto full_numerator(
+        const std::vector<std::string>& ids) const -> Eigen::MatrixXd
+    {
+        const auto n = static_cast<Eigen::Index>(ids.size());
+        Eigen::MatrixXd encoded(n, kSnps);
+        for (Eigen::Index i = 0; i < n; ++i)
+        {
+            // the fixture names the sample of row r "sample<r + 1>"
+            const auto iid
+                = split_sample_id(ids[static_cast<size_t>(i)]).second;
+            const Eigen::Index row
+                = std::stoi(std::string(iid.substr(6))) - 1;
+            for (Eigen::Index j = 0; j < kSnps; ++j)
+            {
+                encoded(i, j) = tables[static_cast<size_t>(j)]
+                                      [code_of(genotypes(row, j))];
+            }
+        }
+        return encoded * encoded.transpose();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("GrmLociWriter round-trips the code values", "[grm][update]")
+{
+    UpdateFixture setup;
+
+    const auto loci = load_grm_loci(setup.path(".loci"));
+
+    REQUIRE(loci.size() == static_cast<size_t>(kSnps));
+    REQUIRE(loci[0].id == "rs1");
+    REQUIRE(loci[0].A1 == 'A');
+    REQUIRE(loci[0].A2 == 'G');
+    for (size_t j = 0; j < loci.size(); ++j)
+    {
+        REQUIRE(loci[j].values == setup.tables[j]);
+    }
+}
+
+TEST_CASE(
+    "GrmUpdater rows match a full GRM with the original encodings",
+    "[grm][update]")
+{
+    UpdateFixture setup;
+
+    GrmUpdater updater(setup.all_bed, setup.grm_prefix);
+    REQUIRE(updater.num_old() == kOld);
+    REQUIRE(updater.num_new() == kNew);
+    REQUIRE(updater.num_snps() == kSnps);
+
+    // the GRM's samples in its order, then the new ones
+    auto ids = detail::GrmLoader(setup.grm_prefix).sample_ids();
+    ids.insert(
+        ids.end(),
+        updater.new_sample_ids().begin(),
+        updater.new_sample_ids().end());
+    const Eigen::MatrixXd expected = setup.full_numerator(ids);
+
+    const Eigen::MatrixXd rows = updater.compute(16);
+    REQUIRE(rows.rows() == kNew);
+    REQUIRE(rows.cols() == kOld + kNew);
+    for (Eigen::Index i = 0; i < kNew; ++i)
+    {
+        for (Eigen::Index j = 0; j < kOld + kNew; ++j)
+        {
+            REQUIRE_THAT(
+                rows(i, j), WithinAbs(expected(kOld + i, j), 1e-9));
+        }
+    }
+
+    SECTION("appended rows complete the GRM file")
+    {
+        GrmBinWriter(setup.path(".bin"), true).write_rows(rows);
+        GrmIdWriter(setup.path(".id"), true).write(updater.new_sample_ids());
+
+        const detail::GrmLoader loader(setup.grm_prefix);
+        REQUIRE(loader.num_samples() == kOld + kNew);
+        REQUIRE(loader.sample_ids() == ids);
+        const Eigen::MatrixXd loaded = loader.load_unnormalized();
+        for (Eigen::Index i = 0; i < kOld + kNew; ++i)
+        {
+            for (Eigen::Index j = 0; j <= i; ++j)
+            {
+                REQUIRE_THAT(loaded(i, j), WithinAbs(expected(i, j), 1e-4));
+            }
+        }
+    }
+}
+
+TEST_CASE(
+    "GrmEngine updates a GRM it wrote through temporary files",
+    "[grm][update]")
+{
+    UpdateFixture setup;
+    const auto prefix = setup.fixture.get_file_fixture()
+                            .generate_random_file_path()
+                            .string();
+    GrmEngine::Config config{
+        .bed_path = setup.old_bed,
+        .mode = freq::GrmType::A,
+        .method = kMethod,
+        .do_loco = false,
+        .out_prefix = prefix,
+        .chunk_size = 16,
+    };
+    GrmEngine(config).compute();
+    REQUIRE(
+        load_grm_loci(prefix + ".add.loci").size()
+        == static_cast<size_t>(kSnps));
+
+    // in place: the same prefix is read and replaced
+    config.bed_path = setup.all_bed;
+    config.update_prefix = prefix;
+    GrmEngine(config).compute();
+
+    for (const auto* extension : {".bin", ".id", ".loci"})
+    {
+        REQUIRE_FALSE(
+            std::filesystem::exists(prefix + ".add" + extension + ".tmp"));
+    }
+    const detail::GrmLoader loader(prefix + ".add");
+    REQUIRE(loader.num_samples() == kOld + kNew);
+    const Eigen::MatrixXd expected
+        = setup.full_numerator(loader.sample_ids());
+    const Eigen::MatrixXd loaded = loader.load_unnormalized();
+    for (Eigen::Index i = 0; i < kOld + kNew; ++i)
+    {
+        for (Eigen::Index j = 0; j <= i; ++j)
+        {
+            REQUIRE_THAT(loaded(i, j), WithinAbs(expected(i, j), 1e-4));
+        }
+    }
+}
+
+TEST_CASE("GrmUpdater rejects unusable inputs", "[grm][update]")
+{
+    UpdateFixture setup;
+
+    SECTION("no new samples")
+    {
+        REQUIRE_THROWS_AS(
+            GrmUpdater(setup.old_bed, setup.grm_prefix),
+            InvalidInputException);
+    }
+
+    SECTION("no recorded encodings")
+    {
+        std::filesystem::remove(setup.path(".loci"));
+        REQUIRE_THROWS_AS(
+            GrmUpdater(setup.all_bed, setup.grm_prefix),
+            FileNotFoundException);
+    }
+
+    SECTION("a GRM sample missing from the BED file")
+    {
+        const auto others = setup.fixture
+                                .create_deterministic_bed_files(
+                                    setup.genotypes.bottomRows(kNew + 2),
+                                    {},
+                                    setup.snp_ids,
+                                    {},
+                                    setup.alleles)
+                                .first;
+        REQUIRE_THROWS_AS(
+            GrmUpdater(others, setup.grm_prefix), InvalidInputException);
+    }
+}
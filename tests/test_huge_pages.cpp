@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <Eigen/Core>
+
+#include "gelex/infra/utils/huge_pages.h"
+
+using namespace gelex;  // NOLINT
+
+namespace
+{
+
+auto address(const void* ptr) -> std::uintptr_t
+{
+    return reinterpret_cast<std::uintptr_t>(ptr);
+}
+
+}  // namespace
+
+TEST_CASE("HugePageBuffer allocates zeroed aligned memory", "[infra][memory]")
+{
+    SECTION("small requests fall back to an aligned allocation")
+    {
+        HugePageBuffer buffer(1000);
+        REQUIRE(buffer.size() == 1000);
+        REQUIRE(buffer.mode() == HugePageMode::None);
+        REQUIRE(address(buffer.data()) % 64 == 0);
+        const auto* bytes = static_cast<const char*>(buffer.data());
+        REQUIRE(
+            std::all_of(
+                bytes, bytes + buffer.size(), [](char b) { return b == 0; }));
+    }
+
+    SECTION("large requests start on a huge page boundary")
+    {
+        HugePageBuffer buffer((3 * kHugePageSize) + 123);
+        REQUIRE(buffer.data() != nullptr);
+        REQUIRE(address(buffer.data()) % kHugePageSize == 0);
+        auto* bytes = static_cast<char*>(buffer.data());
+        REQUIRE(bytes[0] == 0);
+        REQUIRE(bytes[buffer.size() - 1] == 0);
+        bytes[buffer.size() - 1] = 1;
+    }
+
+    SECTION("empty buffer")
+    {
+        HugePageBuffer buffer(0);
+        REQUIRE(buffer.data() == nullptr);
+        REQUIRE(buffer.size() == 0);
+    }
+}
+
+TEST_CASE("HugePageBuffer transfers ownership on move", "[infra][memory]")
+{
+    HugePageBuffer first(kHugePageSize);
+    const void* data = first.data();
+
+    HugePageBuffer second(std::move(first));
+    REQUIRE(second.data() == data);
+    REQUIRE(first.data() == nullptr);  // NOLINT(bugprone-use-after-move)
+
+    HugePageBuffer third(64);
+    third = std::move(second);
+    REQUIRE(third.data() == data);
+    REQUIRE(third.size() == kHugePageSize);
+}
+
+TEST_CASE("HugePageMatrix maps its buffer column-major", "[infra][memory]")
+{
+    HugePageMatrix matrix(300, 1000);
+    REQUIRE(matrix.rows() == 300);
+    REQUIRE(matrix.cols() == 1000);
+    REQUIRE(matrix.map().isZero());
+
+    matrix.map().col(7).setConstant(2.0);
+    matrix.map()(5, 999) = -1.0;
+
+    const auto& view = std::as_const(matrix);
+    REQUIRE(view.map().col(7).sum() == 600.0);
+    REQUIRE(view.map()(5, 999) == -1.0);
+
+    HugePageMatrix moved = std::move(matrix);
+    REQUIRE(moved.map()(5, 999) == -1.0);
+}
+
+TEST_CASE("advise_huge_pages skips regions below a huge page", "[infra]")
+{
+    Eigen::MatrixXd small(8, 8);
+    REQUIRE(advise_huge_pages(small) == HugePageMode::None);
+    REQUIRE(advise_huge_pages(nullptr, 0) == HugePageMode::None);
+}
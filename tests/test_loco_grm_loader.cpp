@@ -171,3 +171,116 @@ TEST_CASE("LocoGRMLoader - Filtered Loading", "[data][grm][loco]")
         }
     }
 }
+
+TEST_CASE(
+    "LocoGRMLoader - Reuses the whole-genome permutation",
+    "[data][grm][loco]")
+{
+    FileFixture fixture;
+    auto tmp_dir = fixture.generate_random_file_path("loco_test_reuse");
+    fs::create_directories(tmp_dir);
+
+    std::vector<std::string> ids
+        = {sid("F1", "I1"), sid("F1", "I2"), sid("F1", "I3")};
+    Eigen::MatrixXd x_w = Eigen::MatrixXd::Random(3, 10);
+    Eigen::MatrixXd x_i = Eigen::MatrixXd::Random(3, 3);
+
+    GrmFiles whole_files{tmp_dir / "whole"};
+    whole_files.create(x_w * x_w.transpose(), ids);
+    GrmFiles chr_files{tmp_dir / "chr1"};
+    chr_files.create(x_i * x_i.transpose(), ids);
+    // same samples listed in another order: matched by ID again
+    GrmFiles shuffled_files{tmp_dir / "chr2"};
+    const std::vector<Eigen::Index> order{2, 0, 1};
+    Eigen::MatrixXd g_i = x_i * x_i.transpose();
+    Eigen::MatrixXd shuffled(3, 3);
+    std::vector<std::string> shuffled_ids;
+    for (Eigen::Index i = 0; i < 3; ++i)
+    {
+        for (Eigen::Index j = 0; j < 3; ++j)
+        {
+            shuffled(i, j) = g_i(order[i], order[j]);
+        }
+        shuffled_ids.push_back(ids[order[i]]);
+    }
+    shuffled_files.create(shuffled, shuffled_ids);
+
+    std::unordered_map<std::string, Eigen::Index> id_map
+        = {{sid("F1", "I3"), 0}, {sid("F1", "I1"), 1}};
+    gelex::LocoGRMLoader loco_loader(whole_files.prefix, id_map);
+    const Eigen::MatrixXd expected
+        = loco_loader.load_loco_grm(chr_files.prefix, id_map);
+
+    Eigen::MatrixXd loco_grm;
+    loco_loader.load_loco_grm(chr_files.prefix, loco_grm);
+    REQUIRE(loco_grm == expected);
+    loco_loader.load_loco_grm(shuffled_files.prefix, loco_grm);
+    REQUIRE(loco_grm == expected);
+}
+
+TEST_CASE(
+    "LocoGRMLoader - Assembles in place into the target",
+    "[data][grm][loco]")
+{
+    FileFixture fixture;
+    auto tmp_dir = fixture.generate_random_file_path("loco_test_in_place");
+    fs::create_directories(tmp_dir);
+
+    // several mirror tiles, and a reversed subset so neither file maps in
+    // order
+    const Eigen::Index n = 150;
+    std::vector<std::string> ids;
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+        ids.push_back(sid("F1", "I" + std::to_string(i)));
+    }
+    Eigen::MatrixXd x_w = Eigen::MatrixXd::Random(n, 400);
+    Eigen::MatrixXd x_i = Eigen::MatrixXd::Random(n, 40);
+    const Eigen::MatrixXd raw_g_w = x_w * x_w.transpose();
+    const Eigen::MatrixXd raw_g_i = x_i * x_i.transpose();
+    GrmFiles whole_files{tmp_dir / "whole"};
+    whole_files.create(raw_g_w, ids);
+    GrmFiles chr_files{tmp_dir / "chr1"};
+    chr_files.create(raw_g_i, ids);
+
+    const Eigen::Index kept = n - 10;
+    std::unordered_map<std::string, Eigen::Index> id_map;
+    for (Eigen::Index i = 0; i < kept; ++i)
+    {
+        id_map[ids[i]] = kept - 1 - i;
+    }
+    gelex::LocoGRMLoader loco_loader(whole_files.prefix, id_map);
+    REQUIRE(loco_loader.num_samples() == kept);
+
+    Eigen::MatrixXd loco_grm = Eigen::MatrixXd::Constant(kept, kept, 7.0);
+    const double* buffer = loco_grm.data();
+    loco_loader.load_loco_grm(chr_files.prefix, loco_grm);
+    REQUIRE(loco_grm.data() == buffer);
+
+    const auto subset = [&](const Eigen::MatrixXd& g)
+    {
+        Eigen::MatrixXd out(kept, kept);
+        for (Eigen::Index i = 0; i < kept; ++i)
+        {
+            for (Eigen::Index j = 0; j < kept; ++j)
+            {
+                out(kept - 1 - i, kept - 1 - j) = g(i, j);
+            }
+        }
+        return out;
+    };
+    const Eigen::MatrixXd g_w = subset(raw_g_w);
+    const Eigen::MatrixXd g_i = subset(raw_g_i);
+    const double k_loco
+        = (g_w.trace() - g_i.trace()) / static_cast<double>(kept);
+    const Eigen::MatrixXd expected = (g_w - g_i) / k_loco;
+    for (Eigen::Index i = 0; i < kept; ++i)
+    {
+        for (Eigen::Index j = 0; j < kept; ++j)
+        {
+            REQUIRE_THAT(
+                loco_grm(i, j),
+                Catch::Matchers::WithinAbs(expected(i, j), 1e-4));
+        }
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "gelex/exception.h"
+#include "gelex/pipeline/memory_planner.h"
+
+using namespace gelex;  // NOLINT
+
+namespace
+{
+
+constexpr size_t kGiB = size_t{1} << 30;
+
+auto fit_request() -> MemoryRequest
+{
+    // 10k samples x 500k SNPs: ~37 GiB of additive genotypes and
+    // ~3.7 GiB per 1000 draws stored in full
+    return MemoryRequest{
+        .workload = MemoryWorkload::Fit,
+        .num_samples = 10'000,
+        .num_snps = 500'000,
+        .chunk_size = 10'000,
+        .num_records = 1000,
+        .num_components = 2,
+    };
+}
+
+}  // namespace
+
+TEST_CASE("parse_memory_size accepts binary units", "[pipeline][memory]")
+{
+    REQUIRE(parse_memory_size("4096") == 4096);
+    REQUIRE(parse_memory_size("512M") == 512 * (size_t{1} << 20));
+    REQUIRE(parse_memory_size("16G") == 16 * kGiB);
+    REQUIRE(parse_memory_size("16GB") == 16 * kGiB);
+    REQUIRE(parse_memory_size("16GiB") == 16 * kGiB);
+    REQUIRE(parse_memory_size("1.5t") == 1536 * kGiB);
+
+    REQUIRE_THROWS_AS(parse_memory_size(""), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_memory_size("G"), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_memory_size("0G"), ArgumentValidationException);
+    REQUIRE_THROWS_AS(parse_memory_size("3X"), ArgumentValidationException);
+}
+
+TEST_CASE("format_memory_size", "[pipeline][memory]")
+{
+    REQUIRE(format_memory_size(512) == "512 B");
+    REQUIRE(format_memory_size(1536) == "1.50 KiB");
+    REQUIRE(format_memory_size(16 * kGiB) == "16.00 GiB");
+}
+
+TEST_CASE("plan_memory keeps the request without a limit", "[pipeline][memory]")
+{
+    const auto plan = plan_memory(fit_request());
+
+    REQUIRE(plan.fits());
+    REQUIRE_FALSE(plan.use_mmap);
+    REQUIRE(plan.chunk_size == 10'000);
+    REQUIRE(plan.sample_storage == SampleStorage::Streaming);
+
+    size_t total = 0;
+    for (const auto& item : plan.items)
+    {
+        total += item.bytes;
+    }
+    REQUIRE(plan.peak_bytes == total);
+    // the genotypes dominate; streamed draws do not grow with the records
+    REQUIRE(plan.peak_bytes > 37 * kGiB);
+    REQUIRE(plan.peak_bytes < 40 * kGiB);
+}
+
+TEST_CASE("plan_memory relaxes settings in order", "[pipeline][memory]")
+{
+    auto request = fit_request();
+
+    SECTION("streaming draws first")
+    {
+        request.sample_storage = SampleStorage::Full;
+        request.limit_bytes = 40 * kGiB;
+        const auto plan = plan_memory(request);
+        REQUIRE(plan.fits());
+        REQUIRE(plan.sample_storage == SampleStorage::Streaming);
+        REQUIRE_FALSE(plan.use_mmap);
+        REQUIRE(plan.chunk_size == 10'000);
+    }
+
+    SECTION("then memory-mapped genotypes")
+    {
+        request.limit_bytes = 8 * kGiB;
+        const auto plan = plan_memory(request);
+        REQUIRE(plan.fits());
+        REQUIRE(plan.sample_storage == SampleStorage::Streaming);
+        REQUIRE(plan.use_mmap);
+        REQUIRE(plan.chunk_size == 10'000);
+    }
+
+    SECTION("then smaller chunks")
+    {
+        request.limit_bytes = kGiB;
+        const auto plan = plan_memory(request);
+        REQUIRE(plan.fits());
+        REQUIRE(plan.use_mmap);
+        REQUIRE(plan.chunk_size < 10'000);
+        REQUIRE(plan.chunk_size >= kMinChunkSize);
+    }
+
+    SECTION("a fixed chunk size is kept")
+    {
+        request.limit_bytes = kGiB;
+        request.auto_chunk_size = false;
+        const auto plan = plan_memory(request);
+        REQUIRE_FALSE(plan.fits());
+        REQUIRE(plan.chunk_size == 10'000);
+    }
+}
+
+TEST_CASE("plan_memory reports GRMs that cannot fit", "[pipeline][memory]")
+{
+    const auto plan = plan_memory(
+        MemoryRequest{
+            .workload = MemoryWorkload::Grm,
+            .num_samples = 50'000,
+            .num_snps = 100'000,
+            .limit_bytes = 4 * kGiB,
+        });
+
+    // the 50k x 50k accumulator alone needs ~18.6 GiB
+    REQUIRE_FALSE(plan.fits());
+    REQUIRE(plan.chunk_size == kMinChunkSize);
+    REQUIRE(plan.sample_storage == SampleStorage::Streaming);
+}
+
+TEST_CASE(
+    "plan_memory drops overlapped LOCO writes first",
+    "[pipeline][memory]")
+{
+    MemoryRequest request{
+        .workload = MemoryWorkload::Grm,
+        .num_samples = 20'000,
+        .num_snps = 100'000,
+        .loco = true,
+    };
+
+    const auto unlimited = plan_memory(request);
+    REQUIRE(unlimited.overlap_writes);
+    REQUIRE(unlimited.items.size() == 4);
+
+    // ~4.5 GiB of chunks plus three (13.4 GiB) or two (10.4 GiB) GRMs
+    request.limit_bytes = 11 * kGiB;
+    const auto plan = plan_memory(request);
+    REQUIRE(plan.fits());
+    REQUIRE_FALSE(plan.overlap_writes);
+    REQUIRE(plan.chunk_size == 10'000);
+}
+
+TEST_CASE(
+    "plan_memory splits fused additive and dominance passes",
+    "[pipeline][memory]")
+{
+    MemoryRequest request{
+        .workload = MemoryWorkload::Grm,
+        .num_samples = 20'000,
+        .num_snps = 100'000,
+        .num_grms = 2,
+    };
+
+    const auto unlimited = plan_memory(request);
+    REQUIRE(unlimited.fuse_effects);
+
+    // fused: two GRMs (6.0 GiB) and two encodings of each chunk (8.9 GiB);
+    // one at a time: 3.0 GiB plus 4.5 GiB
+    request.limit_bytes = 10 * kGiB;
+    const auto plan = plan_memory(request);
+    REQUIRE(plan.fits());
+    REQUIRE_FALSE(plan.fuse_effects);
+    REQUIRE(plan.chunk_size == 10'000);
+
+    // packed chunks are shared by both encodings and tiny
+    request.packed_codes = true;
+    REQUIRE(plan_memory(request).fuse_effects);
+
+    request.loco = true;
+    REQUIRE_FALSE(plan_memory(request).fuse_effects);
+}
+
+TEST_CASE(
+    "plan_memory sizes sparse-GRM association by stored entries",
+    "[pipeline][memory]")
+{
+    MemoryRequest request{
+        .workload = MemoryWorkload::Assoc,
+        .num_samples = 200'000,
+        .num_snps = 500'000,
+        .chunk_size = 1000,
+        .limit_bytes = 8 * kGiB,
+    };
+
+    // a dense 200k x 200k GRM alone is ~298 GiB
+    REQUIRE_FALSE(plan_memory(request).fits());
+
+    // the diagonal plus about ten relatives per sample
+    request.sparse_grm_entries = 2'200'000;
+    const auto plan = plan_memory(request);
+    REQUIRE(plan.fits());
+    REQUIRE(plan.items[0].label == "sparse GRMs");
+    // the GRMs and REML take under 1 GiB; the genotype chunks dominate
+    REQUIRE(plan.items[0].bytes + plan.items[1].bytes < kGiB);
+}
+
+TEST_CASE("plan_memory sizes PCA without an n x n term", "[pipeline][memory]")
+{
+    const auto plan = plan_memory(
+        MemoryRequest{
+            .workload = MemoryWorkload::Pca,
+            .num_samples = 500'000,
+            .num_snps = 1'000'000,
+            .pca_width = 20,
+            .limit_bytes = 4 * kGiB,
+        });
+
+    // the subspace blocks take ~305 MiB; chunks shrink to fit the rest
+    REQUIRE(plan.fits());
+    REQUIRE(plan.items[1].label == "PCA subspace");
+    REQUIRE(plan.items[1].bytes == size_t{4} * 500'000 * 20 * sizeof(double));
+    REQUIRE(plan.chunk_size < 10'000);
+}
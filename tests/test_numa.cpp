@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <Eigen/Core>
+
+#include "gelex/exception.h"
+#include "gelex/infra/utils/huge_pages.h"
+#include "gelex/infra/utils/numa.h"
+
+using namespace gelex;  // NOLINT
+
+namespace
+{
+
+// restores the process-wide policy when a test case ends
+struct PolicyGuard
+{
+    PolicyGuard() = default;
+    PolicyGuard(const PolicyGuard&) = delete;
+    PolicyGuard& operator=(const PolicyGuard&) = delete;
+    ~PolicyGuard() { set_numa_policy(saved); }
+
+    NumaPolicy saved = numa_policy();
+};
+
+}  // namespace
+
+TEST_CASE("parse_numa_policy", "[infra][numa]")
+{
+    REQUIRE(parse_numa_policy("none") == NumaPolicy::None);
+    REQUIRE(parse_numa_policy("Interleave") == NumaPolicy::Interleave);
+    REQUIRE(parse_numa_policy("partition") == NumaPolicy::Partition);
+    REQUIRE_THROWS_AS(parse_numa_policy("local"), ArgumentValidationException);
+}
+
+TEST_CASE("numa_nodes always lists a node", "[infra][numa]")
+{
+    REQUIRE_FALSE(numa_nodes().empty());
+}
+
+TEST_CASE("numa_first_touch zero-fills under every policy", "[infra][numa]")
+{
+    PolicyGuard guard;
+    const auto policy = GENERATE(
+        NumaPolicy::None, NumaPolicy::Interleave, NumaPolicy::Partition);
+    set_numa_policy(policy);
+    REQUIRE(numa_policy() == policy);
+
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Constant(513, 1031, 7.0);
+    numa_first_touch(matrix);
+    REQUIRE(matrix.isZero());
+
+    HugePageMatrix huge(1024, 600);
+    REQUIRE(huge.map().isZero());
+
+    Eigen::MatrixXd empty;
+    numa_first_touch(empty);
+    REQUIRE(empty.size() == 0);
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "file_fixture.h"
+#include "gelex/data/genotype/bed_path.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/sample_manager.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/exception.h"
+
+using gelex::BedPipe;
+using gelex::SampleManager;
+using gelex::test::FileFixture;
+
+namespace
+{
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+auto to_bytes(const std::vector<uint8_t>& raw) -> std::vector<std::byte>
+{
+    std::vector<std::byte> out;
+    out.reserve(raw.size());
+    for (uint8_t value : raw)
+    {
+        out.push_back(static_cast<std::byte>(value));
+    }
+    return out;
+}
+
+// Variable-width .pgen with 4-bit record types and 1-byte record lengths,
+// holding a single variant block.
+auto make_pgen(
+    uint32_t num_samples,
+    const std::vector<uint8_t>& vrtypes,
+    const std::vector<std::vector<uint8_t>>& records) -> std::vector<uint8_t>
+{
+    const auto num_snps = static_cast<uint32_t>(records.size());
+    std::vector<uint8_t> out{0x6C, 0x1B, 0x10};
+    auto put_le = [&](uint64_t value, int num_bytes)
+    {
+        for (int i = 0; i < num_bytes; ++i)
+        {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    };
+    put_le(num_snps, 4);
+    put_le(num_samples, 4);
+    out.push_back(0x00);
+
+    const uint64_t first_record
+        = out.size() + 8 + ((num_snps + 1) / 2) + num_snps;
+    put_le(first_record, 8);
+    for (size_t i = 0; i < vrtypes.size(); i += 2)
+    {
+        const uint8_t high = i + 1 < vrtypes.size() ? vrtypes[i + 1] : 0;
+        out.push_back(static_cast<uint8_t>(vrtypes[i] | (high << 4)));
+    }
+    for (const auto& record : records)
+    {
+        out.push_back(static_cast<uint8_t>(record.size()));
+    }
+    for (const auto& record : records)
+    {
+        out.insert(out.end(), record.begin(), record.end());
+    }
+    return out;
+}
+
+// PLINK 2 genotypes, 0/1/2 ALT copies or 3 for missing, as dosages.
+auto to_dosages(const std::vector<std::vector<int>>& codes) -> Eigen::MatrixXd
+{
+    Eigen::MatrixXd out(
+        static_cast<Eigen::Index>(codes[0].size()),
+        static_cast<Eigen::Index>(codes.size()));
+    for (size_t j = 0; j < codes.size(); ++j)
+    {
+        for (size_t i = 0; i < codes[j].size(); ++i)
+        {
+            out(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j))
+                = codes[j][i] == 3 ? kNaN : codes[j][i];
+        }
+    }
+    return out;
+}
+
+auto same(const Eigen::MatrixXd& lhs, const Eigen::MatrixXd& rhs) -> bool
+{
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+    {
+        return false;
+    }
+    for (Eigen::Index j = 0; j < lhs.cols(); ++j)
+    {
+        for (Eigen::Index i = 0; i < lhs.rows(); ++i)
+        {
+            const bool both_nan
+                = std::isnan(lhs(i, j)) && std::isnan(rhs(i, j));
+            if (!both_nan && lhs(i, j) != rhs(i, j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void write_text_sidecars(FileFixture& files, int num_snps)
+{
+    std::string pvar
+        = "##fileformat=PVARv1.0\n"
+          "#CHROM\tPOS\tID\tREF\tALT\n";
+    for (int j = 0; j < num_snps; ++j)
+    {
+        pvar += std::format("1\t{}\trs{}\tG\tA\n", 100 * (j + 1), j);
+    }
+    (void)files.create_named_text_file("cohort.pvar", pvar);
+    (void)files.create_named_text_file(
+        "cohort.psam", "#IID\tSEX\ns1\t1\ns2\t2\ns3\t1\ns4\t2\ns5\t1\n");
+}
+
+auto open_pipe(const std::filesystem::path& pgen_path) -> BedPipe
+{
+    auto sample_manager
+        = std::make_shared<SampleManager>(gelex::sample_info_path(pgen_path));
+    sample_manager->finalize();
+    return BedPipe(pgen_path, sample_manager);
+}
+
+}  // namespace
+
+TEST_CASE("BedPipe - PLINK 2 .pgen records", "[data][bed_pipe][pgen]")
+{
+    FileFixture files;
+    write_text_sidecars(files, 5);
+
+    // expected genotypes per variant, PLINK 2 coding
+    const std::vector<std::vector<int>> codes{
+        {0, 1, 2, 3, 1},  // plain 2-bit
+        {0, 2, 0, 2, 1},  // 1-bit {0, 2} with a difflist
+        {3, 2, 1, 2, 1},  // LD against the previous, two differences
+        {2, 0, 2, 0, 1},  // LD inverted, no differences
+        {0, 0, 0, 3, 0},  // hom REF except a difflist
+    };
+    const std::vector<uint8_t> vrtypes{0, 1, 2, 3, 4};
+    const std::vector<std::vector<uint8_t>> records{
+        {0xE4, 0x01},
+        {0x02, 0x0A, 0x01, 0x04, 0x01},
+        {0x02, 0x00, 0x07, 0x02},
+        {0x00},
+        {0x01, 0x03, 0x03},
+    };
+    auto pgen_path = files.create_named_binary_file(
+        "cohort.pgen", to_bytes(make_pgen(5, vrtypes, records)));
+
+    SECTION("a bare prefix falls back to the .pgen")
+    {
+        auto prefix = pgen_path;
+        prefix.replace_extension();
+        REQUIRE(gelex::format_bed_path(prefix.string()) == pgen_path);
+        REQUIRE(
+            gelex::variant_info_path(pgen_path).extension() == ".pvar");
+    }
+
+    SECTION("decodes every record type")
+    {
+        auto pipe = open_pipe(pgen_path);
+        REQUIRE(pipe.num_samples() == 5);
+        REQUIRE(pipe.num_snps() == 5);
+        REQUIRE(same(pipe.load(), to_dosages(codes)));
+    }
+
+    SECTION("chunks starting on an LD record resolve their base")
+    {
+        auto pipe = open_pipe(pgen_path);
+        const auto full = to_dosages(codes);
+        REQUIRE(same(pipe.load_chunk(2, 5), full.middleCols(2, 3)));
+        REQUIRE(same(pipe.load_chunk(3, 4), full.middleCols(3, 1)));
+    }
+
+    SECTION(".pvar ALT is A1")
+    {
+        gelex::detail::BimLoader loader(gelex::variant_info_path(pgen_path));
+        REQUIRE(loader.size() == 5);
+        REQUIRE(loader.info()[1].id == "rs1");
+        REQUIRE(loader.info()[1].pos == 200);
+        REQUIRE(loader.info()[1].A1 == 'A');
+        REQUIRE(loader.info()[1].A2 == 'G');
+    }
+}
+
+TEST_CASE("BedPipe - PLINK 2 .pgen storage modes", "[data][bed_pipe][pgen]")
+{
+    FileFixture files;
+    write_text_sidecars(files, 2);
+
+    SECTION("mode 0x01 is read as BED rows")
+    {
+        // BED codes: 00 hom A1, 01 missing, 10 het, 11 hom A2
+        auto pgen_path = files.create_named_binary_file(
+            "cohort.pgen",
+            to_bytes({0x6C, 0x1B, 0x01, 0x1B, 0x03, 0xFF, 0x00}));
+        auto pipe = open_pipe(pgen_path);
+        const auto expected
+            = to_dosages({{0, 1, 3, 2, 0}, {0, 0, 0, 0, 2}});
+        REQUIRE(same(pipe.load(), expected));
+    }
+
+    SECTION("multiallelic hardcalls are rejected")
+    {
+        auto pgen_path = files.create_named_binary_file(
+            "cohort.pgen",
+            to_bytes(make_pgen(5, {0, 8}, {{0x00, 0x00}, {0x00, 0x00}})));
+        REQUIRE_THROWS_AS(open_pipe(pgen_path), gelex::FileFormatException);
+    }
+
+    SECTION("a header that disagrees with .pvar/.psam is rejected")
+    {
+        auto pgen_path = files.create_named_binary_file(
+            "cohort.pgen",
+            to_bytes(make_pgen(4, {0, 0}, {{0x00}, {0x00}})));
+        REQUIRE_THROWS_AS(open_pipe(pgen_path), gelex::FileFormatException);
+    }
+}
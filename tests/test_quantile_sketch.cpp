@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "gelex/exception.h"
+#include "gelex/infra/utils/quantile_sketch.h"
+
+namespace gelex
+{
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("QuantileSketch rejects invalid input", "[utils][quantile_sketch]")
+{
+    REQUIRE_THROWS_AS(QuantileSketch(3, 0.0), ArgumentValidationException);
+    REQUIRE_THROWS_AS(QuantileSketch(3, 1.0), ArgumentValidationException);
+
+    QuantileSketch sketch(3, 0.5);
+    Eigen::VectorXd draw = Eigen::VectorXd::Zero(2);
+    REQUIRE_THROWS_AS(sketch.update(draw), InvalidInputException);
+}
+
+TEST_CASE(
+    "QuantileSketch is exact for fewer than five draws",
+    "[utils][quantile_sketch]")
+{
+    QuantileSketch sketch(2, 0.5);
+    REQUIRE(sketch.result().isZero());
+
+    for (double x : {3.0, 1.0, 2.0})
+    {
+        Eigen::Vector2d draw(x, -x);
+        sketch.update(draw);
+    }
+
+    REQUIRE(sketch.count() == 3);
+    REQUIRE_THAT(sketch.result()(0), WithinAbs(2.0, 1e-12));
+    REQUIRE_THAT(sketch.result()(1), WithinAbs(-2.0, 1e-12));
+}
+
+TEST_CASE(
+    "QuantileSketch tracks tail quantiles of a long stream",
+    "[utils][quantile_sketch]")
+{
+    constexpr int n_draws = 20000;
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> normal;
+
+    QuantileSketch lower(2, 0.05);
+    QuantileSketch upper(2, 0.95);
+    std::vector<double> first;
+    std::vector<double> second;
+
+    for (int i = 0; i < n_draws; ++i)
+    {
+        Eigen::Vector2d draw(normal(rng), 2.0 + (3.0 * normal(rng)));
+        lower.update(draw);
+        upper.update(draw);
+        first.push_back(draw(0));
+        second.push_back(draw(1));
+    }
+    std::ranges::sort(first);
+    std::ranges::sort(second);
+
+    const auto lo = static_cast<size_t>(0.05 * n_draws);
+    const auto hi = static_cast<size_t>(0.95 * n_draws);
+
+    REQUIRE_THAT(lower.result()(0), WithinAbs(first[lo], 0.05));
+    REQUIRE_THAT(upper.result()(0), WithinAbs(first[hi], 0.05));
+    REQUIRE_THAT(lower.result()(1), WithinAbs(second[lo], 0.15));
+    REQUIRE_THAT(upper.result()(1), WithinAbs(second[hi], 0.15));
+}
+
+}  // namespace gelex
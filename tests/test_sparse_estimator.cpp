@@ -0,0 +1,208 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "bed_fixture.h"
+#include "file_fixture.h"
+#include "gelex/algo/infer/estimator.h"
+#include "gelex/algo/infer/sparse_estimator.h"
+#include "gelex/data/frame/dataframe_policy.h"
+#include "gelex/data/grm/grm_bin_writer.h"
+#include "gelex/data/grm/grm_id_writer.h"
+#include "gelex/data/grm/sparse_grm_writer.h"
+#include "gelex/exception.h"
+#include "gelex/model/freq/model.h"
+#include "gelex/pipeline/grm_pipe.h"
+#include "gelex/pipeline/pheno_pipe.h"
+
+namespace fs = std::filesystem;
+
+using namespace gelex;        // NOLINT
+using namespace gelex::test;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace
+{
+
+// A polygenic trait on BedFixture's samples with the GRM written both
+// dense and as a sparse file that keeps every pair.
+struct SparseRemlFixture
+{
+    static constexpr Eigen::Index kMarkers = 200;
+
+    Eigen::Index num_samples;
+
+    BedFixture bed_fixture;
+    fs::path bed_prefix;
+    fs::path pheno_path;
+    fs::path dense_prefix;
+    fs::path sparse_prefix;
+
+    explicit SparseRemlFixture(Eigen::Index samples = 40)
+        : num_samples(samples)
+    {
+        bed_prefix = bed_fixture.create_bed_files(num_samples, 5).first;
+        auto& files = bed_fixture.get_file_fixture();
+
+        // BedFixture creates samples as "fam{i%5+1}_sample{i+1}"
+        std::vector<std::string> ids;
+        for (Eigen::Index i = 0; i < num_samples; ++i)
+        {
+            ids.push_back(make_sample_id(
+                std::format("fam{}", (i % 5) + 1),
+                std::format("sample{}", i + 1)));
+        }
+
+        std::srand(7);
+        const Eigen::MatrixXd markers
+            = Eigen::MatrixXd::Random(num_samples, kMarkers);
+        const Eigen::MatrixXd grm
+            = markers * markers.transpose() / static_cast<double>(kMarkers);
+        const Eigen::VectorXd phenotype
+            = (markers * Eigen::VectorXd::Random(kMarkers) * 0.2)
+              + Eigen::VectorXd::Random(num_samples)
+              + Eigen::VectorXd::Constant(num_samples, 5.0);
+
+        std::string content = "FID\tIID\tPhenotype\n";
+        for (Eigen::Index i = 0; i < num_samples; ++i)
+        {
+            auto [fid, iid] = split_sample_id(ids[static_cast<size_t>(i)]);
+            content += std::format("{}\t{}\t{}\n", fid, iid, phenotype(i));
+        }
+        pheno_path = files.create_text_file(content, ".phen");
+
+        dense_prefix = files.generate_random_file_path("");
+        sparse_prefix = files.generate_random_file_path("");
+        GrmBinWriter(fs::path(dense_prefix.string() + ".bin")).write(grm);
+        SparseGrmWriter(fs::path(sparse_prefix.string() + ".sp.bin"))
+            .write(grm, -std::numeric_limits<double>::infinity());
+        for (const auto& prefix : {dense_prefix, sparse_prefix})
+        {
+            GrmIdWriter(fs::path(prefix.string() + ".id")).write(ids);
+        }
+    }
+
+    [[nodiscard]] auto make_model(const fs::path& grm_prefix) const
+        -> FreqModel
+    {
+        GrmPipe grm({grm_prefix});
+        PhenoPipe pheno(
+            PhenoPipe::Config{
+                .phenotype_path = pheno_path,
+                .phenotype_column = 2,
+                .bed_path = bed_prefix,
+            });
+        pheno.load(grm.sample_id_sets());
+        grm.load(pheno.sample_manager());
+        return FreqModel(pheno, grm);
+    }
+};
+
+}  // namespace
+
+TEST_CASE(
+    "SparseEstimator matches the dense REML when every pair is kept",
+    "[sparse_estimator]")
+{
+    SparseRemlFixture fixture;
+
+    const FreqModel dense_model = fixture.make_model(fixture.dense_prefix);
+    FreqState dense_state(dense_model);
+    Estimator dense(100, 1e-8);
+    const Eigen::MatrixXd v_inv = dense.fit(dense_model, dense_state);
+
+    const FreqModel sparse_model = fixture.make_model(fixture.sparse_prefix);
+    REQUIRE(sparse_model.genetic()[0].is_sparse());
+    FreqState sparse_state(sparse_model);
+    // fewer samples than probes: the traces are exact
+    SparseEstimator sparse(100, 1e-8);
+    const auto factor = sparse.fit(sparse_model, sparse_state);
+
+    REQUIRE(sparse.is_converged() == dense.is_converged());
+    REQUIRE_THAT(sparse.loglike(), WithinRel(dense.loglike(), 1e-8));
+    REQUIRE_THAT(
+        sparse_state.residual().variance,
+        WithinRel(dense_state.residual().variance, 1e-6));
+
+    const auto& dense_g = dense_state.genetic()[0];
+    const auto& sparse_g = sparse_state.genetic()[0];
+    REQUIRE_THAT(sparse_g.variance, WithinRel(dense_g.variance, 1e-6));
+    REQUIRE_THAT(sparse_g.variance_se, WithinRel(dense_g.variance_se, 1e-6));
+    REQUIRE_THAT(
+        sparse_g.heritability, WithinRel(dense_g.heritability, 1e-6));
+    REQUIRE(sparse_g.ebv.isApprox(dense_g.ebv, 1e-6));
+    REQUIRE(sparse_state.fixed().coeff.isApprox(
+        dense_state.fixed().coeff, 1e-8));
+
+    Eigen::MatrixXd v_inv_y;
+    solve_sparse_v(*factor, sparse_model.phenotype(), v_inv_y);
+    REQUIRE(v_inv_y.col(0).isApprox(v_inv * dense_model.phenotype(), 1e-8));
+}
+
+TEST_CASE("SparseEstimator rejects dense GRMs", "[sparse_estimator]")
+{
+    SparseRemlFixture fixture;
+    const FreqModel model = fixture.make_model(fixture.dense_prefix);
+    FreqState state(model);
+
+    REQUIRE_THROWS_AS(
+        SparseEstimator().fit(model, state), InvalidInputException);
+}
+
+TEST_CASE(
+    "SparseEstimator tracks the dense REML with stochastic traces",
+    "[sparse_estimator]")
+{
+    SparseRemlFixture fixture(300);
+
+    const FreqModel dense_model = fixture.make_model(fixture.dense_prefix);
+    FreqState dense_state(dense_model);
+    Estimator dense(100, 1e-8);
+    dense.fit(dense_model, dense_state);
+
+    const FreqModel sparse_model = fixture.make_model(fixture.sparse_prefix);
+    FreqState sparse_state(sparse_model);
+    SparseEstimator sparse(100, 1e-8, {}, 50);
+    sparse.fit(sparse_model, sparse_state);
+
+    // 50 probes for 300 samples: the traces of the EM and AI updates are
+    // Hutchinson estimates, so the components land near, not on, the
+    // dense optimum (about 0.5% off here); 5% leaves room for the probe
+    // noise. The likelihood itself is exact, and at the shifted components
+    // it stays within 1e-4 of the maximum.
+    REQUIRE(sparse.is_converged());
+    REQUIRE(sparse.loglike() <= dense.loglike() + 1e-6);
+    REQUIRE_THAT(sparse.loglike(), WithinRel(dense.loglike(), 1e-4));
+    REQUIRE_THAT(
+        sparse_state.residual().variance,
+        WithinRel(dense_state.residual().variance, 0.05));
+
+    const auto& dense_g = dense_state.genetic()[0];
+    const auto& sparse_g = sparse_state.genetic()[0];
+    REQUIRE_THAT(sparse_g.variance, WithinRel(dense_g.variance, 0.05));
+    REQUIRE_THAT(
+        sparse_g.heritability, WithinAbs(dense_g.heritability, 0.02));
+}
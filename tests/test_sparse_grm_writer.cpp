@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+
+#include "file_fixture.h"
+#include "gelex/data/grm/sparse_grm_writer.h"
+#include "gelex/exception.h"
+
+namespace fs = std::filesystem;
+
+using gelex::SparseGrmEntry;
+using gelex::SparseGrmWriter;
+using gelex::test::FileFixture;
+
+namespace
+{
+
+auto read_entries(const fs::path& file_path) -> std::vector<SparseGrmEntry>
+{
+    const auto bytes = fs::file_size(file_path);
+    REQUIRE(bytes % sizeof(SparseGrmEntry) == 0);
+    std::vector<SparseGrmEntry> entries(bytes / sizeof(SparseGrmEntry));
+    std::ifstream file(file_path, std::ios::binary);
+    file.read(
+        reinterpret_cast<char*>(entries.data()),
+        static_cast<std::streamsize>(bytes));
+    return entries;
+}
+
+// trace / n = 2, so the cutoff applies to half the stored value
+auto make_grm() -> Eigen::MatrixXd
+{
+    Eigen::MatrixXd grm(4, 4);
+    grm << 2.0, 0.5, 0.05, 0.1,   //
+        0.5, 1.5, -0.4, 0.0,      //
+        0.05, -0.4, 2.5, 0.3,     //
+        0.1, 0.0, 0.3, 2.0;
+    return grm;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "SparseGrmWriter keeps the diagonal and pairs above the cutoff",
+    "[sparse_grm_writer]")
+{
+    FileFixture files;
+    const auto path = files.generate_random_file_path(".sp.bin");
+    const Eigen::MatrixXd grm = make_grm();
+
+    size_t kept = 0;
+    {
+        SparseGrmWriter writer(path);
+        REQUIRE(writer.path() == path);
+        kept = writer.write(grm, 0.1);
+    }
+    REQUIRE(kept == 2);
+
+    const auto entries = read_entries(path);
+    REQUIRE(entries.size() == 6);
+    // column-major lower triangle, diagonal first in each column
+    const std::vector<std::pair<uint32_t, uint32_t>> expected{
+        {0, 0}, {1, 0}, {1, 1}, {2, 2}, {3, 2}, {3, 3}};
+    for (size_t k = 0; k < entries.size(); ++k)
+    {
+        REQUIRE(entries[k].row == expected[k].first);
+        REQUIRE(entries[k].col == expected[k].second);
+        REQUIRE(
+            entries[k].value
+            == static_cast<float>(grm(entries[k].row, entries[k].col)));
+    }
+}
+
+TEST_CASE("SparseGrmWriter cutoff extremes", "[sparse_grm_writer]")
+{
+    FileFixture files;
+    const Eigen::MatrixXd grm = make_grm();
+
+    SECTION("no cutoff keeps the whole triangle")
+    {
+        const auto path = files.generate_random_file_path(".sp.bin");
+        SparseGrmWriter writer(path);
+        REQUIRE(
+            writer.write(grm, -std::numeric_limits<double>::infinity()) == 6);
+    }
+
+    SECTION("a high cutoff keeps only the diagonal")
+    {
+        const auto path = files.generate_random_file_path(".sp.bin");
+        {
+            SparseGrmWriter writer(path);
+            REQUIRE(writer.write(grm, 10.0) == 0);
+        }
+        REQUIRE(read_entries(path).size() == 4);
+    }
+}
+
+TEST_CASE("SparseGrmWriter rejects invalid matrices", "[sparse_grm_writer]")
+{
+    FileFixture files;
+    SparseGrmWriter writer(files.generate_random_file_path(".sp.bin"));
+
+    REQUIRE_THROWS_AS(
+        writer.write(Eigen::MatrixXd::Ones(2, 3), 0.05),
+        gelex::InvalidInputException);
+    REQUIRE_THROWS_AS(
+        writer.write(Eigen::MatrixXd::Zero(3, 3), 0.05),
+        gelex::InvalidInputException);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2026 RuLei Chen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <Eigen/Core>
+
+#include "bed_fixture.h"
+#include "gelex/data/genotype/bed_pipe.h"
+#include "gelex/data/genotype/sample_manager.h"
+#include "gelex/data/genotype/variant_filter.h"
+#include "gelex/data/loader/bim_loader.h"
+#include "gelex/exception.h"
+
+using namespace gelex;  // NOLINT
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+using gelex::test::are_matrices_equal;
+using gelex::test::BedFixture;
+
+namespace
+{
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// 10 samples x 6 SNPs on chromosomes 1, 1, 2, 2, 3, 3:
+//   rs1 monomorphic, rs2 MAF 0.25, rs3 30% missing, rs4 no heterozygotes
+//   (HWE p ~ 0.0014), rs5 and rs6 common and in HWE.
+auto make_genotypes() -> Eigen::MatrixXd
+{
+    Eigen::MatrixXd genotypes(10, 6);
+    genotypes.col(0).setZero();
+    genotypes.col(1) << 0, 0, 0, 0, 0, 1, 1, 1, 1, 1;
+    genotypes.col(2) << 0, 1, 2, 1, 0, 1, 2, kNaN, kNaN, kNaN;
+    genotypes.col(3) << 0, 0, 0, 0, 0, 2, 2, 2, 2, 2;
+    genotypes.col(4) << 0, 1, 1, 2, 1, 0, 1, 1, 2, 1;
+    genotypes.col(5) << 1, 0, 1, 2, 1, 1, 0, 1, 2, 1;
+    return genotypes;
+}
+
+struct FilterFixture
+{
+    BedFixture bed_fixture;
+    std::filesystem::path bed_path;
+    Eigen::MatrixXd genotypes = make_genotypes();
+    std::shared_ptr<SampleManager> sample_manager;
+
+    FilterFixture()
+    {
+        bed_path = bed_fixture
+                       .create_deterministic_bed_files(
+                           genotypes,
+                           {},
+                           {"rs1", "rs2", "rs3", "rs4", "rs5", "rs6"},
+                           {"1", "1", "2", "2", "3", "3"})
+                       .first;
+        auto fam_path = bed_path;
+        fam_path.replace_extension(".fam");
+        sample_manager = std::make_shared<SampleManager>(fam_path);
+        sample_manager->finalize();
+    }
+
+    auto run(const VariantFilter& filter) -> std::vector<Eigen::Index>
+    {
+        BedPipe bed(bed_path, sample_manager);
+        auto bim_path = bed_path;
+        bim_path.replace_extension(".bim");
+        auto snps = detail::BimLoader(bim_path).take_info();
+        return apply_variant_filter(filter, bed, snps);
+    }
+};
+
+}  // namespace
+
+TEST_CASE(
+    "hwe_exact_pvalue matches exact enumeration",
+    "[data][variant_filter]")
+{
+    REQUIRE_THAT(hwe_exact_pvalue(0, 5, 5), WithinRel(0.0013639611, 1e-6));
+    REQUIRE_THAT(hwe_exact_pvalue(2, 4, 4), WithinRel(0.0751044621, 1e-6));
+    REQUIRE_THAT(hwe_exact_pvalue(57, 14, 50), WithinRel(0.8422797566, 1e-6));
+    REQUIRE_THAT(hwe_exact_pvalue(5, 3, 2), WithinAbs(1.0, 1e-12));
+    REQUIRE(hwe_exact_pvalue(0, 0, 0) == 1.0);
+}
+
+TEST_CASE("apply_variant_filter - metadata criteria", "[data][variant_filter]")
+{
+    FilterFixture fixture;
+
+    SECTION("default filter is empty")
+    {
+        REQUIRE(VariantFilter{}.empty());
+        REQUIRE_FALSE(VariantFilter{}.uses_genotypes());
+    }
+
+    SECTION("chromosome and window")
+    {
+        VariantFilter filter{.chromosomes = {"2", "3"}, .to_bp = 5};
+        REQUIRE(fixture.run(filter) == std::vector<Eigen::Index>{2, 3, 4});
+    }
+
+    SECTION("extract and exclude lists")
+    {
+        auto& files = fixture.bed_fixture.get_file_fixture();
+        VariantFilter filter{
+            .extract_path = files.create_text_file("rs2\nrs4 extra\nrs5\n"),
+            .exclude_path = files.create_text_file("rs4\n"),
+        };
+        REQUIRE(fixture.run(filter) == std::vector<Eigen::Index>{1, 4});
+    }
+
+    SECTION("nothing left")
+    {
+        VariantFilter filter{.chromosomes = {"22"}};
+        REQUIRE_THROWS_AS(fixture.run(filter), InvalidInputException);
+    }
+}
+
+TEST_CASE(
+    "apply_variant_filter - genotype criteria",
+    "[data][variant_filter]")
+{
+    FilterFixture fixture;
+
+    SECTION("minor allele frequency")
+    {
+        VariantFilter filter{.min_maf = 0.3};
+        REQUIRE(fixture.run(filter) == std::vector<Eigen::Index>{2, 3, 4, 5});
+    }
+
+    SECTION("missing call rate")
+    {
+        VariantFilter filter{.max_missing_rate = 0.2};
+        REQUIRE(
+            fixture.run(filter) == std::vector<Eigen::Index>{0, 1, 3, 4, 5});
+    }
+
+    SECTION("Hardy-Weinberg")
+    {
+        VariantFilter filter{.min_hwe_pvalue = 0.01};
+        REQUIRE(
+            fixture.run(filter) == std::vector<Eigen::Index>{0, 1, 2, 4, 5});
+    }
+
+    SECTION("combined with metadata")
+    {
+        VariantFilter filter{.chromosomes = {"1", "2"}, .min_maf = 0.01};
+        REQUIRE(fixture.run(filter) == std::vector<Eigen::Index>{1, 2, 3});
+    }
+}
+
+TEST_CASE(
+    "apply_variant_filter - reader and metadata stay aligned",
+    "[data][variant_filter]")
+{
+    FilterFixture fixture;
+    BedPipe bed(fixture.bed_path, fixture.sample_manager);
+    auto bim_path = fixture.bed_path;
+    bim_path.replace_extension(".bim");
+    auto snps = detail::BimLoader(bim_path).take_info();
+
+    const auto kept
+        = apply_variant_filter(
+            VariantFilter{.max_missing_rate = 0.2}, bed, snps);
+
+    REQUIRE(bed.num_snps() == 5);
+    REQUIRE(snps.size() == 5);
+    REQUIRE(snps[1].id == "rs2");
+    REQUIRE(snps[2].id == "rs4");
+
+    // the unfiltered reader gives the reference in the reader's sample order
+    const Eigen::MatrixXd full
+        = BedPipe(fixture.bed_path, fixture.sample_manager).load();
+    Eigen::MatrixXd expected(10, 5);
+    for (Eigen::Index j = 0; j < 5; ++j)
+    {
+        expected.col(j) = full.col(kept[static_cast<size_t>(j)]);
+    }
+    Eigen::MatrixXd loaded = bed.load();
+    REQUIRE(are_matrices_equal(loaded, expected));
+
+    // a chunk spanning a gap in the selection
+    Eigen::MatrixXd chunk(10, 2);
+    bed.load_chunk(chunk, 1, 3);
+    Eigen::MatrixXd expected_chunk = expected.middleCols(1, 2);
+    REQUIRE(are_matrices_equal(chunk, expected_chunk));
+}
+
+TEST_CASE("BedPipe::select_variants validation", "[data][variant_filter]")
+{
+    FilterFixture fixture;
+    BedPipe bed(fixture.bed_path, fixture.sample_manager);
+
+    REQUIRE_THROWS_AS(bed.select_variants({}), ArgumentValidationException);
+    REQUIRE_THROWS_AS(
+        bed.select_variants({3, 1}), ArgumentValidationException);
+    REQUIRE_THROWS_AS(
+        bed.select_variants({0, 6}), ArgumentValidationException);
+}